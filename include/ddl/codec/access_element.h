@@ -71,6 +71,66 @@ struct Accessor<T, typename std::enable_if<is_factory<T>::value>::type> {
     }
 };
 
+template <typename T>
+using has_element_index = std::is_member_function_pointer<decltype(&T::findElementIndex)>;
+
+template <typename T, typename Enable = void>
+struct Lookup {
+    static inline a_util::result::Result findIndex(const T& access_type,
+                                                   const std::string& element_name,
+                                                   size_t& index)
+    {
+        size_t element_count = Accessor<T>::getElementCount(access_type);
+        for (size_t element_index = 0; element_index < element_count; ++element_index) {
+            const StructElement* element;
+            if (isOk(Accessor<T>::getElement(access_type, element_index, element))) {
+                if (element->name == element_name) {
+                    index = element_index;
+                    return a_util::result::SUCCESS;
+                }
+            }
+        }
+
+        return ERR_NOT_FOUND;
+    }
+
+    static inline a_util::result::Result findIndexByPrefix(const T& access_type,
+                                                           const std::string& prefix,
+                                                           size_t& index)
+    {
+        size_t element_count = Accessor<T>::getElementCount(access_type);
+        for (size_t element_index = 0; element_index < element_count; ++element_index) {
+            const StructElement* element;
+            if (isOk(Accessor<T>::getElement(access_type, element_index, element))) {
+                if (a_util::strings::compare(
+                        element->name.c_str(), prefix.c_str(), 0, prefix.size()) == 0) {
+                    index = element_index;
+                    return a_util::result::SUCCESS;
+                }
+            }
+        }
+
+        return ERR_NOT_FOUND;
+    }
+};
+
+template <typename T>
+struct Lookup<T, typename std::enable_if<has_element_index<T>::value>::type> {
+    static inline a_util::result::Result findIndex(const T& access_type,
+                                                   const std::string& element_name,
+                                                   size_t& index)
+    {
+        return access_type.findElementIndex(element_name, index);
+    }
+
+    static inline a_util::result::Result findIndexByPrefix(const T& access_type,
+                                                           const std::string& prefix,
+                                                           size_t& index)
+    {
+        return access_type.findElementIndexByPrefix(prefix, index);
+    }
+};
+
 template <typename T>
 a_util::result::Result findComplexIndex(const T& decoder,
                                         const std::string& struct_name,
@@ -82,20 +142,7 @@ a_util::result::Result findComplexIndex(const T& decoder,
         return a_util::result::SUCCESS;
     }
 
-    size_t element_count = detail::Accessor<T>::getElementCount(decoder);
-    std::string prefix = struct_name + post_fix;
-    for (size_t element_index = 0; element_index < element_count; ++element_index) {
-        const StructElement* element;
-        if (isOk(detail::Accessor<T>::getElement(decoder, element_index, element))) {
-            if (a_util::strings::compare(element->name.c_str(), prefix.c_str(), 0, prefix.size()) ==
-                0) {
-                index = element_index;
-                return a_util::result::SUCCESS;
-            }
-        }
-    }
-
-    return ERR_NOT_FOUND;
+    return Lookup<T>::findIndexByPrefix(decoder, struct_name + post_fix, index);
 }
 
 /** @endcond */
@@ -112,18 +159,7 @@ a_util::result::Result findComplexIndex(const T& decoder,
 template <typename T>
 a_util::result::Result findIndex(const T& decoder, const std::string& element_name, size_t& index)
 {
-    size_t element_count = detail::Accessor<T>::getElementCount(decoder);
-    for (size_t element_index = 0; element_index < element_count; ++element_index) {
-        const StructElement* element;
-        if (isOk(detail::Accessor<T>::getElement(decoder, element_index, element))) {
-            if (element->name == element_name) {
-                index = element_index;
-                return a_util::result::SUCCESS;
-            }
-        }
-    }
-
-    return ERR_NOT_FOUND;
+    return detail::Lookup<T>::findIndex(decoder, element_name, index);
 }
 
 /**
@@ -419,6 +455,56 @@ ARRAY_TYPE* getArrayAddress(T& codec, const std::string& array_name)
     return NULL;
 }
 
+namespace detail {
+
+/** @cond INTERNAL_DOCUMENTATION */
+template <typename T, typename Enable = void>
+struct ArrayRange {
+    /// Gets the address and size of the array items in the single buffer of the decoder.
+    static inline a_util::result::Result get(const T& decoder,
+                                             size_t start_index,
+                                             size_t end_index,
+                                             const void*& start_address,
+                                             size_t& size)
+    {
+        start_address = decoder.getElementAddress(start_index);
+        if (!start_address) {
+            return ERR_UNEXPECTED;
+        }
+
+        const void* end_adress = decoder.getElementAddress(end_index);
+        if (end_adress) {
+            size = static_cast<const uint8_t*>(end_adress) -
+                   static_cast<const uint8_t*>(start_address);
+        }
+        else {
+            // it reaches til the end
+            size_t start_offset = static_cast<const uint8_t*>(start_address) -
+                                  static_cast<const uint8_t*>(decoder.getElementAddress(0));
+            size = decoder.getBufferSize(decoder.getRepresentation()) - start_offset;
+        }
+
+        return a_util::result::SUCCESS;
+    }
+};
+
+template <>
+struct ArrayRange<FragmentedDecoder> {
+    /// The array items may lie in different fragments, they are only available as a whole if
+    /// they lie within a single one.
+    static inline a_util::result::Result get(const FragmentedDecoder& decoder,
+                                             size_t start_index,
+                                             size_t end_index,
+                                             const void*& start_address,
+                                             size_t& size)
+    {
+        return decoder.getElementRange(start_index, end_index, start_address, size);
+    }
+};
+/** @endcond */
+
+} // namespace detail
+
 /**
  * Get information about an array.
  * @param[in] decoder The decoder.
@@ -426,6 +512,7 @@ ARRAY_TYPE* getArrayAddress(T& codec, const std::string& array_name)
  * @param[out] start_address The address of the first element of the array.
  * @param[out] size The amount of elements of the array.
  * @retval ERR_NOT_FOUND No array with the requested name was found.
+ * @retval ERR_NOT_SUPPORTED The array of a @ref FragmentedDecoder spans several fragments.
  */
 template <typename CODEC>
 a_util::result::Result getArray(const CODEC& decoder,
@@ -443,31 +530,96 @@ a_util::result::Result getArray(const CODEC& decoder,
     if (a_util::result::isFailed(res))
         return res;
 
-    start_address = decoder.getElementAddress(start_index);
-    if (!start_address) {
-        return ERR_UNEXPECTED;
+    return detail::ArrayRange<CODEC>::get(decoder, start_index, end_index, start_address, size);
+}
+
+namespace detail {
+
+/** @cond INTERNAL_DOCUMENTATION */
+template <typename T, typename Enable = void>
+struct ArrayConverter {
+    static inline bool convert(const T&, const std::string&, void*, a_util::result::Result&)
+    {
+        return false;
     }
+};
 
-    const void* end_adress = decoder.getElementAddress(end_index);
-    if (end_adress) {
-        size = static_cast<const uint8_t*>(end_adress) - static_cast<const uint8_t*>(start_address);
+template <typename T>
+struct ArrayConverter<T, typename std::enable_if<std::is_base_of<StaticDecoder, T>::value>::type> {
+    /// Converts the items of a serialized array of a simple type to the platform byte order.
+    /// @return Whether the array has been converted, otherwise it has to be copied as it is.
+    static inline bool convert(const T& decoder,
+                               const std::string& array_name,
+                               void* array_value,
+                               a_util::result::Result& result)
+    {
+        if (decoder.getRepresentation() != serialized) {
+            return false;
+        }
+
+        size_t start_index = 0;
+        if (isFailed(findArrayIndex(decoder, array_name, start_index))) {
+            return false;
+        }
+        const StructElement* element;
+        if (isFailed(decoder.getElement(start_index, element)) ||
+            element->name != array_name + "[0]") {
+            // arrays of structs keep their serialized layout
+            return false;
+        }
+
+        result = decoder.getElementValues(
+            start_index, getArraySize(decoder, array_name, start_index), array_value);
+        return true;
     }
-    else {
-        // it reaches til the end
-        size_t start_offset = static_cast<const uint8_t*>(start_address) -
-                              static_cast<const uint8_t*>(decoder.getElementAddress(0));
-        size = decoder.getBufferSize(decoder.getRepresentation()) - start_offset;
+
+    /// The items of an array of a simple type have consecutive indices, so the size can be
+    /// found with a binary search instead of comparing the names of all items.
+    static inline size_t getArraySize(const T& decoder,
+                                      const std::string& array_name,
+                                      size_t start_index)
+    {
+        // lower is always the index of an item, upper never
+        size_t lower = 0;
+        size_t upper = 1;
+        while (isArrayItem(decoder, array_name, start_index, upper)) {
+            lower = upper;
+            upper *= 2;
+        }
+        while (upper - lower > 1) {
+            const size_t middle = lower + (upper - lower) / 2;
+            if (isArrayItem(decoder, array_name, start_index, middle)) {
+                lower = middle;
+            }
+            else {
+                upper = middle;
+            }
+        }
+        return lower + 1;
     }
 
-    return a_util::result::SUCCESS;
-}
+    static inline bool isArrayItem(const T& decoder,
+                                   const std::string& array_name,
+                                   size_t start_index,
+                                   size_t item_index)
+    {
+        const StructElement* element;
+        return isOk(decoder.getElement(start_index + item_index, element)) &&
+               element->name == array_name + "[" + std::to_string(item_index) + "]";
+    }
+};
+/** @endcond */
+
+} // namespace detail
 
 /**
- * Copy an array out of the structure.
+ * Copy an array out of the structure as it is, in the data representation of the decoder.
  * @param[in] decoder The decoder.
  * @param[in] array_name The name of the array.
  * @param[out] array_value The location the array will be copied to.
  * @retval ERR_NOT_FOUND No array with the requested name was found.
+ * @retval ERR_NOT_SUPPORTED The array of a @ref FragmentedDecoder spans several fragments.
+ * @see getConvertedArrayValue() for the items of serialized arrays in platform byte order.
  */
 template <typename T, typename CODEC>
 a_util::result::Result getArrayValue(const CODEC& decoder,
@@ -484,6 +636,31 @@ a_util::result::Result getArrayValue(const CODEC& decoder,
     return a_util::result::SUCCESS;
 }
 
+/**
+ * Copy the items of an array out of the structure with their deserialized values.
+ * The items of serialized arrays of simple types are converted to the platform byte order, in
+ * bulk where possible, and bit-packed items are extended to the size of their type. All other
+ * arrays are copied as they are, like with getArrayValue().
+ * @remark For a serialized array of a simple type @p array_value must hold the number of items
+ * times the size of their type, which is more than the serialized array if it is bit-packed.
+ * @param[in] decoder The decoder.
+ * @param[in] array_name The name of the array.
+ * @param[out] array_value The location the array will be copied to.
+ * @retval ERR_NOT_FOUND No array with the requested name was found.
+ * @retval ERR_NOT_SUPPORTED The array of a @ref FragmentedDecoder spans several fragments.
+ */
+template <typename T, typename CODEC>
+a_util::result::Result getConvertedArrayValue(const CODEC& decoder,
+                                              const std::string& array_name,
+                                              T* array_value)
+{
+    a_util::result::Result res;
+    if (detail::ArrayConverter<CODEC>::convert(decoder, array_name, array_value, res)) {
+        return res;
+    }
+    return getArrayValue(decoder, array_name, array_value);
+}
+
 /**
  * Set the value of the requested element to zero.
  * @param[in] codec The codec.
@@ -506,16 +683,74 @@ a_util::result::Result reset(T& codec, const std::string& element_name)
 #define DDL_GET_ENUM_CASE(__variant_type, __data_type)                                             \
     case a_util::variant::VT_##__variant_type: {                                                   \
         __data_type xValue = value.get##__variant_type();                                          \
-        for (AccessEnumType::const_iterator it = element->p_enum->begin();                         \
-             it != element->p_enum->end();                                                         \
+        for (AccessEnumType::const_iterator it = element.p_enum->begin();                          \
+             it != element.p_enum->end();                                                          \
              ++it) {                                                                               \
             if (xValue == it->second.as##__variant_type()) {                                       \
-                return it->first;                                                                  \
+                return &it->first;                                                                 \
             }                                                                                      \
         }                                                                                          \
         break;                                                                                     \
     }
 
+namespace detail {
+/**
+ * For internal use only. @internal
+ * Finds the enum value name of a value of an element.
+ * @return The name or NULL if the element has no enum or the value has no name.
+ */
+inline const std::string* findEnumValueName(const StructElement& element,
+                                            const a_util::variant::Variant& value)
+{
+    if (!element.p_enum) {
+        return nullptr;
+    }
+
+    if (element.p_enum_names) {
+        // precomputed by the struct layout for integral values
+        switch (value.getType()) {
+        case a_util::variant::VT_Int8:
+        case a_util::variant::VT_Int16:
+        case a_util::variant::VT_Int32:
+        case a_util::variant::VT_Int64:
+            return element.p_enum_names->find(value.asInt64());
+        case a_util::variant::VT_UInt8:
+        case a_util::variant::VT_UInt16:
+        case a_util::variant::VT_UInt32:
+        case a_util::variant::VT_UInt64:
+            return element.p_enum_names->find(static_cast<int64_t>(value.asUInt64()));
+        default:
+            break;
+        }
+    }
+
+    switch (value.getType()) {
+        DDL_GET_ENUM_CASE(Bool, bool)
+        DDL_GET_ENUM_CASE(Int8, int8_t)
+        DDL_GET_ENUM_CASE(UInt8, uint8_t)
+        DDL_GET_ENUM_CASE(Int16, int16_t)
+        DDL_GET_ENUM_CASE(UInt16, uint16_t)
+        DDL_GET_ENUM_CASE(Int32, int32_t)
+        DDL_GET_ENUM_CASE(UInt32, uint32_t)
+        DDL_GET_ENUM_CASE(Int64, int64_t)
+        DDL_GET_ENUM_CASE(UInt64, uint64_t)
+        DDL_GET_ENUM_CASE(Float, float)
+        DDL_GET_ENUM_CASE(Double, double)
+    default:
+        break;
+    }
+    return nullptr;
+}
+
+/// For internal use only. @internal
+inline const std::string& getEmptyString()
+{
+    static const std::string empty;
+    return empty;
+}
+
+} // namespace detail
+
 /**
  * Get the value of an element as a string, using enum value names if available.
  * @param[in] decoder The decoder.
@@ -529,22 +764,9 @@ std::string getValueAsString(const T& decoder, size_t element_index)
     const StructElement* element;
     if (isOk(decoder.getElement(element_index, element))) {
         if (isOk(decoder.getElementValue(element_index, value))) {
-            if (element->p_enum) {
-                switch (value.getType()) {
-                    DDL_GET_ENUM_CASE(Bool, bool)
-                    DDL_GET_ENUM_CASE(Int8, int8_t)
-                    DDL_GET_ENUM_CASE(UInt8, uint8_t)
-                    DDL_GET_ENUM_CASE(Int16, int16_t)
-                    DDL_GET_ENUM_CASE(UInt16, uint16_t)
-                    DDL_GET_ENUM_CASE(Int32, int32_t)
-                    DDL_GET_ENUM_CASE(UInt32, uint32_t)
-                    DDL_GET_ENUM_CASE(Int64, int64_t)
-                    DDL_GET_ENUM_CASE(UInt64, uint64_t)
-                    DDL_GET_ENUM_CASE(Float, float)
-                    DDL_GET_ENUM_CASE(Double, double)
-                default:
-                    break;
-                }
+            const std::string* value_name = detail::findEnumValueName(*element, value);
+            if (value_name) {
+                return *value_name;
             }
         }
     }
@@ -568,6 +790,47 @@ std::string getValueAsString(const T& decoder, const std::string& element_name)
     return "";
 }
 
+/**
+ * Get the enum value name of the value of an element without copying it.
+ * @param[in] decoder The decoder.
+ * @param[in] element_index The index of the element.
+ * @return The enum value name or an empty string if the element has no enum, the value has no
+ *         name or the element cannot be read. Use @ref getValueAsString in that case.
+ */
+template <typename T>
+const std::string& getEnumValueName(const T& decoder, size_t element_index)
+{
+    const StructElement* element;
+    if (isOk(decoder.getElement(element_index, element)) && element->p_enum) {
+        a_util::variant::Variant value;
+        if (isOk(decoder.getElementValue(element_index, value))) {
+            const std::string* value_name = detail::findEnumValueName(*element, value);
+            if (value_name) {
+                return *value_name;
+            }
+        }
+    }
+
+    return detail::getEmptyString();
+}
+
+/**
+ * Get the enum value name of the value of an element without copying it.
+ * @param[in] decoder The decoder.
+ * @param[in] element_name The name of the element.
+ * @return The enum value name or an empty string if the element has no enum, the value has no
+ *         name or the element cannot be read. Use @ref getValueAsString in that case.
+ */
+template <typename T>
+const std::string& getEnumValueName(const T& decoder, const std::string& element_name)
+{
+    size_t element_index;
+    if (isOk(findIndex(decoder, element_name, element_index))) {
+        return getEnumValueName(decoder, element_index);
+    }
+    return detail::getEmptyString();
+}
+
 } // namespace access_element
 
 } // namespace ddl
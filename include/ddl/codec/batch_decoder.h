@@ -0,0 +1,153 @@
+/**
+ * @file
+ * Decoding of selected elements of many samples of the same struct type into columns.
+ *
+ * @copyright
+ * @verbatim
+Copyright @ 2021 VW Group. All rights reserved.
+
+    This Source Code Form is subject to the terms of the Mozilla
+    Public License, v. 2.0. If a copy of the MPL was not distributed
+    with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+ */
+
+#ifndef DDL_BATCH_DECODER_CLASS_HEADER
+#define DDL_BATCH_DECODER_CLASS_HEADER
+
+#include "a_util/result.h"
+#include "a_util/variant.h"
+#include "ddl/codec/codec_factory.h"
+
+#include <string>
+#include <vector>
+
+namespace ddl {
+/**
+ * Decoder for a batch of samples of the same struct type.
+ *
+ * The element selection is resolved once from a @ref CodecFactory. Each call to decode() then
+ * reads the selected elements of all given samples in a single pass and writes them column-major
+ * into one output array per element, i.e. the value of column c of sample s is stored at index s
+ * of the array for column c. The values are written with the native type of the element (see
+ * getColumnType()), byte aligned elements are copied directly, only bit-packed serialized
+ * elements are read through the @ref a_util::memory::BitSerializer.
+ *
+ * Only static elements can be selected, so all samples share the same layout.
+ */
+class BatchDecoder {
+public:
+    /**
+     * Default constructor. Creates an invalid batch decoder.
+     */
+    BatchDecoder();
+
+    /**
+     * Resolves the selected elements.
+     * @param[in] factory The factory of the struct type of the samples.
+     * @param[in] element_names The full names of the static elements that should be decoded.
+     * @param[in] rep The data representation of the samples.
+     */
+    BatchDecoder(const CodecFactory& factory,
+                 const std::vector<std::string>& element_names,
+                 DataRepresentation rep = deserialized);
+
+    /**
+     * @return Whether or not the selected elements could be resolved.
+     * @retval ERR_NOT_FOUND One of the elements could not be found.
+     * @retval ERR_NOT_SUPPORTED One of the elements has an unsupported type.
+     */
+    a_util::result::Result isValid() const;
+
+    /**
+     * @return The number of columns, i.e. the number of selected elements.
+     */
+    size_t getColumnCount() const;
+
+    /**
+     * @param[in] column The index of the column.
+     * @return The value type of the column.
+     */
+    a_util::variant::VariantType getColumnType(size_t column) const;
+
+    /**
+     * @param[in] column The index of the column.
+     * @return The size of a single value of the column in bytes.
+     */
+    size_t getColumnTypeSize(size_t column) const;
+
+    /**
+     * @return The minimum size of a single sample.
+     */
+    size_t getSampleSize() const;
+
+    /**
+     * Decodes samples that are stored in a contiguous array.
+     * @param[in] samples The first sample.
+     * @param[in] sample_count The number of samples.
+     * @param[in] sample_stride The distance between two samples in bytes.
+     * @param[out] columns One array per column, each with room for @p sample_count values of
+     *                     the column type.
+     * @retval ERR_INVALID_ARG The stride is smaller than the sample size or the number of
+     *                         columns does not match.
+     * @retval ERR_POINTER One of the pointers is null.
+     */
+    a_util::result::Result decode(const void* samples,
+                                  size_t sample_count,
+                                  size_t sample_stride,
+                                  const std::vector<void*>& columns) const;
+
+    /**
+     * Decodes samples that are stored in separate buffers.
+     * @param[in] samples The samples.
+     * @param[in] sample_size The size of each sample buffer.
+     * @param[out] columns One array per column, each with room for samples.size() values of the
+     *                     column type.
+     * @retval ERR_INVALID_ARG The sample size is too small or the number of columns does not
+     *                         match.
+     * @retval ERR_POINTER One of the pointers is null.
+     */
+    a_util::result::Result decode(const std::vector<const void*>& samples,
+                                  size_t sample_size,
+                                  const std::vector<void*>& columns) const;
+
+private:
+    /// For internal use only. @internal
+    a_util::result::Result checkColumns(const std::vector<void*>& columns) const;
+    /// For internal use only. @internal
+    a_util::result::Result decodeSample(const void* sample,
+                                        size_t sample_size,
+                                        size_t sample_index,
+                                        const std::vector<void*>& columns) const;
+
+private:
+    /// For internal use only. @internal
+    struct Column {
+        const StructLayoutElement* element;
+        size_t byte_offset;
+        size_t type_size;
+        bool byte_aligned;
+        bool swap_bytes;
+    };
+
+    /// For internal use only. @internal The layout of the samples.
+    a_util::memory::shared_ptr<const StructLayout> _layout;
+    /// For internal use only. @internal The resolved columns.
+    std::vector<Column> _columns;
+    /// For internal use only. @internal The data representation of the samples.
+    DataRepresentation _representation;
+    /// For internal use only. @internal The minimum size of a single sample.
+    size_t _sample_size;
+    /// For internal use only. @internal The resolution result.
+    a_util::result::Result _result;
+};
+
+} // namespace ddl
+
+#endif
@@ -24,6 +24,13 @@ You may add additional accurate notices of copyright ownership.
 #include "a_util/result.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#ifdef _MSC_VER
+#include <stdlib.h>
+#endif
 
 namespace a_util {
 namespace memory {
@@ -46,6 +53,117 @@ typedef enum {
 Endianess get_platform_endianess();
 
 namespace detail {
+/// Unsigned integer type of the given byte size together with its byte swap operation.
+template <size_t size>
+struct ByteSwap;
+
+/// Byte swap for single bytes (identity)
+template <>
+struct ByteSwap<1> {
+    /// The unsigned integer type of this size
+    typedef std::uint8_t type;
+    /// @return @p value unchanged
+    static inline type swap(type value)
+    {
+        return value;
+    }
+};
+
+/// Byte swap for 16 bit values
+template <>
+struct ByteSwap<2> {
+    /// The unsigned integer type of this size
+    typedef std::uint16_t type;
+    /// @return @p value with reversed byte order
+    static inline type swap(type value)
+    {
+#ifdef _MSC_VER
+        return _byteswap_ushort(value);
+#else
+        return __builtin_bswap16(value);
+#endif
+    }
+};
+
+/// Byte swap for 32 bit values
+template <>
+struct ByteSwap<4> {
+    /// The unsigned integer type of this size
+    typedef std::uint32_t type;
+    /// @return @p value with reversed byte order
+    static inline type swap(type value)
+    {
+#ifdef _MSC_VER
+        return _byteswap_ulong(value);
+#else
+        return __builtin_bswap32(value);
+#endif
+    }
+};
+
+/// Byte swap for 64 bit values
+template <>
+struct ByteSwap<8> {
+    /// The unsigned integer type of this size
+    typedef std::uint64_t type;
+    /// @return @p value with reversed byte order
+    static inline type swap(type value)
+    {
+#ifdef _MSC_VER
+        return _byteswap_uint64(value);
+#else
+        return __builtin_bswap64(value);
+#endif
+    }
+};
+
+/**
+ * Reverse the byte order of an arithmetic value.
+ * Inline counterpart of @ref a_util::memory::swapEndianess for use within hot paths,
+ * which additionally supports floating point values.
+ *
+ * @param [in] value The value to swap.
+ * @return The value with reversed byte order.
+ */
+template <typename T>
+inline T swapBytes(T value)
+{
+    static_assert(std::is_arithmetic<T>::value, "only arithmetic types can be swapped");
+    typename ByteSwap<sizeof(T)>::type raw;
+    std::memcpy(&raw, &value, sizeof(T));
+    raw = ByteSwap<sizeof(T)>::swap(raw);
+    std::memcpy(&value, &raw, sizeof(T));
+    return value;
+}
+
+/**
+ * Check whether the platform is little endian, known at compile time if the compiler provides
+ * the byte order of the platform.
+ * @return Whether the platform is little endian.
+ */
+inline bool isLittleEndianPlatform()
+{
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+    return __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+#elif defined(_MSC_VER)
+    return true;
+#else
+    return get_platform_endianess() == bit_little_endian;
+#endif
+}
+
+/**
+ * Check whether the bytes of a signal have to be swapped to get the value on this platform.
+ * Signals of unknown endianess are treated like signals of the platform endianess.
+ *
+ * @param [in] endianess The endianess of the signal.
+ * @return Whether the byte order of the signal differs from the platform.
+ */
+inline bool needsByteSwap(Endianess endianess)
+{
+    return endianess == (isLittleEndianPlatform() ? bit_big_endian : bit_little_endian);
+}
+
 /**
  * Format the bit pattern of a uint64_t value to a string
  * Used for debug purposes.
@@ -89,6 +207,8 @@ protected:
      * @param [in]  bit_length   Number of bits to read.
      * @param [out] value       Pointer to the variable to store the read value in.
      * @param [in]  endianess   Parameter describing the endianess of the bitfield to read from.
+     * @param [in]  buffer_size  Size of the memory buffer, 0 if unknown. If the buffer is large
+     *                           enough, whole 64 bit windows are loaded at once.
      *
      * @return Returns a standard result code.
      */
@@ -96,8 +216,19 @@ protected:
                                              size_t start_bit,
                                              size_t bit_length,
                                              T* value,
-                                             Endianess endianess = get_platform_endianess())
+                                             Endianess endianess = get_platform_endianess(),
+                                             size_t buffer_size = 0)
     {
+        if (start_bit % 8 == 0 && bit_length == sizeof(T) * 8) {
+            readAligned(buffer + start_bit / 8, value, endianess);
+            return a_util::result::SUCCESS;
+        }
+        if (isLittleEndianPlatform()) {
+            readWindow(buffer, start_bit, bit_length, value, endianess, buffer_size);
+            return a_util::result::SUCCESS;
+        }
+
+        // Unaligned signals on big endian platforms.
         /*
          *   offset_end         offset_start
          *        _                   ____
@@ -299,6 +430,16 @@ protected:
                                               T value,
                                               Endianess endianess = get_platform_endianess())
     {
+        if (start_bit % 8 == 0 && bit_length == sizeof(T) * 8) {
+            writeAligned(buffer + start_bit / 8, value, endianess);
+            return a_util::result::SUCCESS;
+        }
+        if (isLittleEndianPlatform()) {
+            writeWindow(buffer, start_bit, bit_length, value, endianess);
+            return a_util::result::SUCCESS;
+        }
+
+        // Unaligned signals on big endian platforms.
         // 1) Copy relevant bytes of Buffer content to be overwritten.
         uint64_t buffer_copy = 0;
         uint64_t ninth_byte = 0; // storage variable for the ninth bit from buffer
@@ -379,6 +520,164 @@ protected:
         return a_util::result::SUCCESS;
     }
 
+    /// The unsigned integer type with the size of T
+    typedef typename ByteSwap<sizeof(T)>::type RawType;
+
+    /**
+     * Read a byte aligned value of full size with a single load.
+     *
+     * @param [in]  buffer      Pointer to the first byte of the value.
+     * @param [out] value       Pointer to the variable to store the read value in.
+     * @param [in]  endianess   Parameter describing the endianess of the value.
+     */
+    static void readAligned(const uint8_t* buffer, T* value, Endianess endianess)
+    {
+        RawType raw;
+        std::memcpy(&raw, buffer, sizeof(T));
+        if (needsByteSwap(endianess)) {
+            raw = ByteSwap<sizeof(T)>::swap(raw);
+        }
+        std::memcpy(value, &raw, sizeof(T));
+    }
+
+    /**
+     * Write a byte aligned value of full size with a single store.
+     *
+     * @param [in]  buffer      Pointer to the first byte of the value.
+     * @param [in]  value       Value to write.
+     * @param [in]  endianess   Parameter describing the endianess of the value.
+     */
+    static void writeAligned(uint8_t* buffer, T value, Endianess endianess)
+    {
+        RawType raw;
+        std::memcpy(&raw, &value, sizeof(T));
+        if (needsByteSwap(endianess)) {
+            raw = ByteSwap<sizeof(T)>::swap(raw);
+        }
+        std::memcpy(buffer, &raw, sizeof(T));
+    }
+
+    /**
+     * Convert the bits of a BE signal in buffer order into its value.
+     * The first bit_length % 8 bits of the signal form its most significant byte, each following
+     * eight bits one of the less significant bytes.
+     *
+     * @param [in] bits         The bits of the signal, the first one at index 0.
+     * @param [in] bit_length   Number of bits of the signal.
+     *
+     * @return The value of the signal.
+     */
+    static uint64_t bitsToBigEndianValue(uint64_t bits, size_t bit_length)
+    {
+        const size_t partial_bits = bit_length % 8;
+        if (partial_bits != 0) {
+            bits = (bits & ((1ULL << partial_bits) - 1)) | ((bits >> partial_bits) << 8);
+        }
+        return ByteSwap<8>::swap(bits) >> (64 - ((bit_length + 7) / 8) * 8);
+    }
+
+    /**
+     * Inverse of bitsToBigEndianValue.
+     *
+     * @param [in] value        The value of the signal, cut to bit_length bits.
+     * @param [in] bit_length   Number of bits of the signal.
+     *
+     * @return The bits of the signal, the first one at index 0.
+     */
+    static uint64_t bigEndianValueToBits(uint64_t value, size_t bit_length)
+    {
+        uint64_t bits = ByteSwap<8>::swap(value) >> (64 - ((bit_length + 7) / 8) * 8);
+        const size_t partial_bits = bit_length % 8;
+        if (partial_bits != 0) {
+            bits = (bits & ((1ULL << partial_bits) - 1)) | ((bits >> 8) << partial_bits);
+        }
+        return bits;
+    }
+
+    /**
+     * Read a signal through a 64 bit window of the buffer on a little endian platform.
+     * The window is loaded at once and the signal is extracted with a shift and a mask. The bits
+     * of unaligned 64 bit signals that do not fit into the window are taken from the ninth byte.
+     *
+     * @param [in]  buffer      Pointer to the memory buffer to read from.
+     * @param [in]  start_bit    Bit position to start reading from.
+     * @param [in]  bit_length   Number of bits to read.
+     * @param [out] value       Pointer to the variable to store the read value in.
+     * @param [in]  endianess   Parameter describing the endianess of the bitfield to read from.
+     * @param [in]  buffer_size  Size of the memory buffer, 0 if unknown.
+     */
+    static void readWindow(const uint8_t* buffer,
+                           size_t start_bit,
+                           size_t bit_length,
+                           T* value,
+                           Endianess endianess,
+                           size_t buffer_size)
+    {
+        const size_t start_byte = start_bit / 8;
+        const size_t byte_count = (start_bit % 8 + bit_length + 7) / 8;
+        size_t shift = start_bit % 8;
+        uint64_t window = 0;
+        if (buffer_size >= sizeof(window)) {
+            // A load of constant size compiles to a single instruction. At the end of the buffer
+            // the window is moved back, it still contains the whole signal then.
+            const size_t window_byte = std::min(start_byte, buffer_size - sizeof(window));
+            std::memcpy(&window, buffer + window_byte, sizeof(window));
+            shift += (start_byte - window_byte) * 8;
+        }
+        else {
+            std::memcpy(&window, buffer + start_byte, std::min(byte_count, sizeof(window)));
+        }
+        window >>= shift;
+        if (byte_count > sizeof(window)) {
+            window |= static_cast<uint64_t>(buffer[start_byte + sizeof(window)]) << (64 - shift);
+        }
+        cutLeadingBits(&window, bit_length);
+        if (endianess == bit_big_endian) {
+            window = bitsToBigEndianValue(window, bit_length);
+        }
+        const RawType raw = static_cast<RawType>(window);
+        std::memcpy(value, &raw, sizeof(T));
+    }
+
+    /**
+     * Write a signal through a 64 bit window of the buffer on a little endian platform.
+     * The window is loaded, the signal is merged in with a shift and a mask and stored back. The
+     * bits of unaligned 64 bit signals that do not fit into the window go to the ninth byte.
+     *
+     * @param [in]  buffer      Pointer to the memory buffer to write to.
+     * @param [in]  start_bit    Bit position to start writing to.
+     * @param [in]  bit_length   Number of bits to write.
+     * @param [in]  value       Value to write to the bitfield.
+     * @param [in]  endianess   Parameter describing the endianess of the bitfield to write to.
+     */
+    static void writeWindow(
+        uint8_t* buffer, size_t start_bit, size_t bit_length, T value, Endianess endianess)
+    {
+        RawType raw;
+        std::memcpy(&raw, &value, sizeof(T));
+        uint64_t signal = raw;
+        cutLeadingBits(&signal, bit_length);
+        if (endianess == bit_big_endian) {
+            signal = bigEndianValueToBits(signal, bit_length);
+        }
+
+        const size_t offset_start = start_bit % 8;
+        const size_t byte_count = (offset_start + bit_length + 7) / 8;
+        uint8_t* window_start = buffer + start_bit / 8;
+        uint64_t mask = ~0ULL;
+        cutLeadingBits(&mask, bit_length);
+        uint64_t window = 0;
+        std::memcpy(&window, window_start, std::min(byte_count, sizeof(window)));
+        window = (window & ~(mask << offset_start)) | (signal << offset_start);
+        std::memcpy(window_start, &window, std::min(byte_count, sizeof(window)));
+        if (byte_count > sizeof(window)) {
+            const uint8_t ninth_mask = static_cast<uint8_t>(mask >> (64 - offset_start));
+            window_start[sizeof(window)] =
+                static_cast<uint8_t>((window_start[sizeof(window)] & ~ninth_mask) |
+                                     ((signal >> (64 - offset_start)) & ninth_mask));
+        }
+    }
+
     /**
      * Set the highest bits of a uint64_t value to zero. The number of bit_length lowest bits
      * remain unchanged.
@@ -474,13 +773,19 @@ public:
      * @param [in]  bit_length   Number of bits to read.
      * @param [out] value       Pointer to the variable to store the read value in.
      * @param [in]  endianess   Parameter describing the endianess of the bitfield to read from.
+     * @param [in]  buffer_size  Size of the memory buffer, 0 if unknown.
      *
      * @return Returns a standard result code.
      */
-    static a_util::result::Result read(
-        uint8_t* buffer, size_t start_bit, size_t bit_length, T* value, Endianess endianess)
+    static a_util::result::Result read(uint8_t* buffer,
+                                       size_t start_bit,
+                                       size_t bit_length,
+                                       T* value,
+                                       Endianess endianess,
+                                       size_t buffer_size = 0)
     {
-        return ConverterBase<T>::readSignal(buffer, start_bit, bit_length, value, endianess);
+        return ConverterBase<T>::readSignal(
+            buffer, start_bit, bit_length, value, endianess, buffer_size);
     }
 
     /**
@@ -515,14 +820,19 @@ public:
      * @param [in]  bit_length   Number of bits to read.
      * @param [out] value       Pointer to the variable to store the read value in.
      * @param [in]  endianess   Parameter describing the endianess of the bitfield to read from.
+     * @param [in]  buffer_size  Size of the memory buffer, 0 if unknown.
      *
      * @return Returns a standard result code.
      */
-    static a_util::result::Result read(
-        uint8_t* buffer, size_t start_bit, size_t bit_length, T* value, Endianess endianess)
+    static a_util::result::Result read(uint8_t* buffer,
+                                       size_t start_bit,
+                                       size_t bit_length,
+                                       T* value,
+                                       Endianess endianess,
+                                       size_t buffer_size = 0)
     {
-        a_util::result::Result res =
-            ConverterBase<T>::readSignal(buffer, start_bit, bit_length, value, endianess);
+        a_util::result::Result res = ConverterBase<T>::readSignal(
+            buffer, start_bit, bit_length, value, endianess, buffer_size);
         if (res != a_util::result::SUCCESS) {
             return res;
         }
@@ -567,15 +877,21 @@ public:
      * @param [in]  bit_length   Number of bits to read.
      * @param [out] value       Pointer to the variable to store the read value in.
      * @param [in]  endianess   Parameter describing the endianess of the bitfield to read from.
+     * @param [in]  buffer_size  Size of the memory buffer, 0 if unknown.
      *
      * @return Returns a standard result code.
      */
-    static a_util::result::Result read(
-        uint8_t* buffer, size_t start_bit, size_t bit_length, T* value, Endianess endianess)
+    static a_util::result::Result read(uint8_t* buffer,
+                                       size_t start_bit,
+                                       size_t bit_length,
+                                       T* value,
+                                       Endianess endianess,
+                                       size_t buffer_size = 0)
     {
         // Read only values of size tFloat
         if (sizeof(T) * 8 == bit_length) {
-            return ConverterBase<T>::readSignal(buffer, start_bit, bit_length, value, endianess);
+            return ConverterBase<T>::readSignal(
+                buffer, start_bit, bit_length, value, endianess, buffer_size);
         }
         else {
             return ERR_INVALID_ARG;
@@ -659,13 +975,32 @@ public:
             return result_code;
         }
 
-        // Call template function
-        detail::Converter<T, std::is_signed<T>::value, std::is_floating_point<T>::value>::read(
-            _buffer, start_bit, bit_length, value, endianess);
-
+        readUnchecked(start_bit, bit_length, value, endianess);
         return a_util::result::SUCCESS;
     }
 
+    /**
+     * Read value from bitfield without checking the arguments.
+     * For callers that have validated the buffer and the bit range before, e.g. once per sample.
+     * Byte aligned values of full size are loaded directly, other values that fit into a 64 bit
+     * window of the buffer are extracted with a single load, a shift and a mask.
+     *
+     * @param [in]  start_bit    Bit position to start reading from. The least significant bit
+     *                           has the index 0.
+     * @param [in]  bit_length   Number of bits to read, at least 1 and at most the bit size of T.
+     * @param [out] value       Pointer to the variable to store the read value in.
+     * @param [in]  endianess   Parameter describing the endianess of the bitfield to read from.
+     */
+    template <typename T>
+    void readUnchecked(size_t start_bit,
+                       size_t bit_length,
+                       T* value,
+                       Endianess endianess = get_platform_endianess()) const
+    {
+        detail::Converter<T, std::is_signed<T>::value, std::is_floating_point<T>::value>::read(
+            _buffer, start_bit, bit_length, value, endianess, _buffer_bytes);
+    }
+
     /**
      * Write value to bitfield. Value can be of type tFloat or an unsigned or signed integer.
      *
@@ -696,11 +1031,30 @@ public:
             return result_code;
         }
 
-        // Call template function
+        writeUnchecked(start_bit, bit_length, value, endianess);
+        return a_util::result::SUCCESS;
+    }
+
+    /**
+     * Write value to bitfield without checking the arguments.
+     * For callers that have validated the buffer and the bit range before, e.g. once per sample.
+     * Byte aligned values of full size are stored directly, other values that fit into a 64 bit
+     * window of the buffer are merged in with a single load and store.
+     *
+     * @param [in]  start_bit    Bit position to start writing to. The least significant bit
+     *                           has the index 0.
+     * @param [in]  bit_length   Number of bits to write, at least 1 and at most the bit size of T.
+     * @param [in]  value       Value to write to the bitfield.
+     * @param [in]  endianess   Parameter describing the endianess of the bitfield to write to.
+     */
+    template <typename T>
+    void writeUnchecked(size_t start_bit,
+                        size_t bit_length,
+                        T value,
+                        Endianess endianess = get_platform_endianess())
+    {
         detail::Converter<T, std::is_signed<T>::value, std::is_floating_point<T>::value>::write(
             _buffer, start_bit, bit_length, value, endianess);
-
-        return a_util::result::SUCCESS;
     }
 
 private:
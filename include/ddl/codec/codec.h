@@ -21,14 +21,23 @@ You may add additional accurate notices of copyright ownership.
 #ifndef DDL_CODEC_CLASS_HEADER
 #define DDL_CODEC_CLASS_HEADER
 
+#include "a_util/memory.h"
 #include "a_util/result.h"
 #include "static_codec.h"
 
+#include <atomic>
+#include <vector>
+
 namespace ddl {
 class Codec;
+class DynamicLayout;
+class DynamicLayoutCache;
+struct DynamicLayoutState;
 
 /**
  * Decoder for dynamic structures defined by a DataDefinition definition.
+ * The dynamic elements are only calculated on first access to them, layouts for the same array
+ * sizes are shared between all decoders of a factory.
  */
 class Decoder : public StaticDecoder {
 public:
@@ -40,12 +49,12 @@ public:
     /**
      * Move constructor.
      */
-    Decoder(Decoder&&) = default;
+    Decoder(Decoder&&);
 
     /**
      * Move assignment operator.
      */
-    Decoder& operator=(Decoder&&) = default;
+    Decoder& operator=(Decoder&&);
 
     /**
      * No copy constructor.
@@ -67,6 +76,18 @@ public:
      */
     virtual size_t getElementCount() const;
 
+    /**
+     * @copydoc StaticDecoder::findElementIndex
+     */
+    virtual a_util::result::Result findElementIndex(const std::string& element_name,
+                                                    size_t& index) const;
+
+    /**
+     * @copydoc StaticDecoder::findElementIndexByPrefix
+     */
+    virtual a_util::result::Result findElementIndexByPrefix(const std::string& prefix,
+                                                            size_t& index) const;
+
     /**
      * @param[in] rep The data representation for which the buffer size should be returned.
      * @return The size of the structure in the requested data representation.
@@ -84,8 +105,11 @@ public:
 
 protected:
     friend class CodecFactory;
+    friend class TransformPlan;
+    friend class ValidatedDecoderView;
     /// For internal use only. @internal
     Decoder(a_util::memory::shared_ptr<const StructLayout> layout,
+            a_util::memory::shared_ptr<DynamicLayoutCache> dynamic_layouts,
             const void* data,
             size_t data_size,
             DataRepresentation rep);
@@ -93,47 +117,28 @@ protected:
     Decoder(const Decoder& decoder, const void* data, size_t data_size, DataRepresentation rep);
     /// For internal use only. @internal
     virtual const StructLayoutElement* getLayoutElement(size_t index) const;
-
-private:
-    /// For internal use only. @internal
-    a_util::result::Result calculateDynamicElements();
     /// For internal use only. @internal
-    a_util::result::Result addDynamicElements(const DynamicStructLayoutElement& dynamic_element,
-                                              Offsets& overall_offsets,
-                                              const std::string& prefix);
-    /// For internal use only. @internal
-    a_util::result::Result addDynamicElement(const DynamicStructLayoutElement& dynamic_element,
-                                             const std::string& array_index,
-                                             Offsets& overall_offsets,
-                                             const std::string& prefix);
-    /// For internal use only. @internal
-    a_util::result::Result addStaticStructElements(
-        const DynamicStructLayoutElement& dynamic_element,
-        const std::string& array_index,
-        Offsets& overall_offsets,
-        const std::string& prefix);
-    /// For internal use only. @internal
-    a_util::result::Result addDynamicStructElements(
-        const DynamicStructLayoutElement& dynamic_element,
-        const std::string& array_index,
-        Offsets& overall_offsets,
-        const std::string& prefix);
-    /// For internal use only. @internal
-    a_util::result::Result addDynamicStructElement(const StructLayoutElement& element);
-    /// For internal use only. @internal
-    void moveToAlignment(size_t& bit_offset, size_t alignment);
+    virtual const StructLayoutElement* getNamedLayoutElement(size_t index) const;
+    /// For internal use only. @internal Calculates the dynamic elements on first use.
+    const DynamicLayout* getDynamicLayout() const;
+    /// For internal use only. @internal Locates a dynamic element of a projection on first use.
+    const StructLayoutElement* getProjectedElement(size_t dynamic_index) const;
 
 protected:
-    /// For internal use only. @internal
-    a_util::memory::shared_ptr<std::vector<StructLayoutElement>> _dynamic_elements;
-    /// For internal use only. @internal
-    Offsets _buffer_sizes;
+    /// For internal use only. @internal The dynamic layouts shared with the factory.
+    a_util::memory::shared_ptr<DynamicLayoutCache> _dynamic_layouts;
+    /// For internal use only. @internal The dynamic layout of the data and the located dynamic
+    /// elements of a projection, if already calculated. It is set on first use, so it is only
+    /// accessed atomically within const methods.
+    mutable a_util::memory::shared_ptr<const DynamicLayoutState> _dynamic_state;
+    /// For internal use only. @internal The dynamic state once it is set.
+    mutable std::atomic<const DynamicLayoutState*> _dynamic_state_ptr{nullptr};
 };
 
 /**
  * Decoder for dynamic structures defined by a DataDefinition definition.
- * Currently the amount of dynamic elements is determined during construction
- * only (by the current values in the structure).
+ * The amount of dynamic elements is determined during construction (by the current values in
+ * the structure), use @ref resizeDynamicArray to change it afterwards.
  */
 class Codec : public Decoder {
 public:
@@ -182,16 +187,47 @@ public:
      */
     a_util::result::Result setConstants();
 
+    /**
+     * Changes the size of the dynamic arrays whose size is stored in the given element and sets
+     * the element to the new size. The data following the arrays is moved, new array entries are
+     * set to zero. Only the offsets of the elements following the arrays are recalculated if the
+     * size difference keeps their alignment.
+     * @param[in] size_element_name The name of the array size element.
+     * @param[in] array_size The new array size.
+     * @param[in,out] buffer The buffer holding the data of the codec. If it is too small, it is
+     *                       replaced by a buffer that is at least half again as large, so that
+     *                       growing arrays step by step does not reallocate every time. The size
+     *                       of the data is @ref getBufferSize afterwards.
+     * @retval ERR_INVALID_ARG The buffer does not hold the data of the codec, the element is no
+     *                         array size or the new size does not fit into it.
+     * @retval ERR_NOT_FOUND No element with the given name was found.
+     * @retval ERR_NOT_SUPPORTED The arrays contain dynamic arrays themselves or the codec only
+     *                           handles selected elements.
+     * @retval ERR_MEMORY The buffer could not be enlarged. The data is left unchanged on this
+     *                    and all other errors.
+     */
+    a_util::result::Result resizeDynamicArray(const std::string& size_element_name,
+                                              size_t array_size,
+                                              a_util::memory::MemoryBuffer& buffer);
+
 protected:
     friend class CodecFactory;
     friend class Decoder;
     /// For internal use only. @internal
     Codec(a_util::memory::shared_ptr<const StructLayout> layout,
+          a_util::memory::shared_ptr<DynamicLayoutCache> dynamic_layouts,
           void* data,
           size_t data_size,
           DataRepresentation rep);
     /// For internal use only. @internal
     Codec(const Decoder& decoder, void* data, size_t data_size, DataRepresentation rep);
+    /// For internal use only. @internal Moves the data of one array to the resized layout,
+    /// the buffer is large enough for it.
+    a_util::result::Result resizeArray(
+        size_t array,
+        size_t array_size,
+        const a_util::memory::shared_ptr<const DynamicLayout>& resized_layout,
+        a_util::memory::MemoryBuffer& buffer);
 };
 
 } // namespace ddl
@@ -22,6 +22,7 @@ You may add additional accurate notices of copyright ownership.
 #define DDL_CODEC_FACTORY_CLASS_HEADER
 
 #include "ddl/codec/codec.h"
+#include "ddl/codec/fragmented_decoder.h"
 #include "ddl/codec/static_codec.h"
 #include "ddl/codec/struct_element.h"
 #include "ddl/dd/dd.h"
@@ -110,7 +111,7 @@ public:
                                   size_t data_size,
                                   DataRepresentation rep = deserialized) const
     {
-        return Decoder(_layout, data, data_size, rep);
+        return Decoder(_layout, _dynamic_layouts, data, data_size, rep);
     }
 
     /**
@@ -124,7 +125,20 @@ public:
                               size_t data_size,
                               DataRepresentation rep = deserialized) const
     {
-        return Codec(_layout, data, data_size, rep);
+        return Codec(_layout, _dynamic_layouts, data, data_size, rep);
+    }
+
+    /**
+     * Creates a decoder for data that is split into several fragments.
+     * @param[in] fragments The fragments of the data in their order, which must stay valid as
+     *                      long as the decoder is used.
+     * @param[in] rep The representation that the data is encoded in.
+     * @return a fragmented decoder.
+     */
+    inline FragmentedDecoder makeFragmentedDecoderFor(const std::vector<DataFragment>& fragments,
+                                                      DataRepresentation rep = deserialized) const
+    {
+        return FragmentedDecoder(_layout, _dynamic_layouts, fragments, rep);
     }
 
     /**
@@ -140,15 +154,73 @@ public:
      */
     a_util::result::Result getStaticElement(size_t index, const StructElement*& element) const;
 
+    /**
+     * Find the index of a static element by its full name using the hashed name index.
+     * @param[in] element_name The full name of the element.
+     * @param[out] index The index of the found element.
+     * @retval ERR_NOT_FOUND No element with the requested name was found.
+     */
+    a_util::result::Result findElementIndex(const std::string& element_name, size_t& index) const;
+
+    /**
+     * Find the index of the first static element whose name starts with the given prefix.
+     * Only prefixes ending with a '.' (sub-structures) or '[' (arrays) are supported.
+     * @param[in] prefix The name prefix including the trailing separator.
+     * @param[out] index The index of the found element.
+     * @retval ERR_NOT_FOUND No element with the requested prefix was found.
+     */
+    a_util::result::Result findElementIndexByPrefix(const std::string& prefix,
+                                                    size_t& index) const;
+
     /**
      * @param[in] rep The data representation for which the buffer size should be returned.
      * @return The size of the structure in the requested data representation.
      */
     size_t getStaticBufferSize(DataRepresentation rep = deserialized) const;
 
+    /**
+     * Provides the static part of a sample with every element set to its default value from the
+     * DataDefinition, to its constant value or to zero otherwise. The sample is rendered once on
+     * first request and shared by all factories of the same layout, so initializing a buffer is
+     * a single copy, e.g. when resetting a sample before filling it.
+     * @param[in] rep The data representation of the sample.
+     * @return The sample of getStaticBufferSize(rep) bytes, all zero if the factory is invalid.
+     */
+    const std::vector<uint8_t>& getDefaultSample(DataRepresentation rep = deserialized) const;
+
+    /**
+     * Creates a factory for a projection of the struct that only contains the selected leaf
+     * elements, with dense indices starting at 0. Codecs of the projection work on the same
+     * data as the codecs of this factory, but only calculate and access the selected elements.
+     *
+     * A pattern is either the full name of an element or a glob pattern that is matched against
+     * the full names of all static elements, where '*' matches any sequence of characters and
+     * '?' matches a single character, e.g. "wheels[*].torque". The static elements come first, in
+     * the order of the patterns, each pattern in the order of the struct. Full names that do not
+     * match any static element refer to elements after the first dynamic array. They follow the
+     * static elements and are located per sample, an index of an element that the sample does
+     * not contain is invalid. Elements within the dynamic section are only calculated if such
+     * an element is selected.
+     *
+     * @param[in] patterns The full names or glob patterns of the selected elements.
+     * @return The factory of the projection, which is invalid with ERR_NOT_FOUND if one of the
+     *         patterns does not match any element.
+     */
+    CodecFactory makeProjection(const std::vector<std::string>& patterns) const;
+
+private:
+    /// For internal use only. @internal
+    CodecFactory(a_util::memory::shared_ptr<const StructLayout> layout,
+                 a_util::memory::shared_ptr<DynamicLayoutCache> dynamic_layouts,
+                 a_util::result::Result constructor_result);
+
 private:
+    friend class BatchDecoder;
+    friend class DeltaCodec;
     /// For internal use only.  @internal The struct layout.
     a_util::memory::shared_ptr<const StructLayout> _layout;
+    /// For internal use only. @internal The dynamic layouts shared by all decoders.
+    a_util::memory::shared_ptr<DynamicLayoutCache> _dynamic_layouts;
     /// For internal use only. @internal The constructor result.
     a_util::result::Result _constructor_result;
 };
@@ -0,0 +1,115 @@
+/**
+ * @file
+ * Element-level differences between two samples of the same struct type.
+ *
+ * @copyright
+ * @verbatim
+Copyright @ 2021 VW Group. All rights reserved.
+
+    This Source Code Form is subject to the terms of the Mozilla
+    Public License, v. 2.0. If a copy of the MPL was not distributed
+    with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+ */
+
+#ifndef DDL_DELTA_CODEC_CLASS_HEADER
+#define DDL_DELTA_CODEC_CLASS_HEADER
+
+#include "a_util/result.h"
+#include "ddl/codec/codec_factory.h"
+
+#include <vector>
+
+namespace ddl {
+/**
+ * Encodes a sample as the list of elements that changed compared to a base sample and applies
+ * such a list to the base sample on the receiving side.
+ *
+ * A delta consists of a header with the size and the array sizes of the sample and one entry per
+ * changed element, which holds the distance to the index of the previous entry and the value of
+ * the element in the data representation of the codec. Unchanged spans are skipped by comparing
+ * both samples word by word, only the elements around a difference are compared one by one.
+ *
+ * The elements of the sample are compared with the bytes of the base sample at the same
+ * position, so samples with different array sizes are supported as well, bytes beyond the end of
+ * the base sample count as zero. Padding bytes are not part of a delta and keep the value they
+ * have in the base sample. If the array sizes of a sample cannot be read without a name lookup,
+ * the whole sample is encoded instead.
+ */
+class DeltaCodec {
+public:
+    /**
+     * Default constructor. Creates an invalid delta codec.
+     */
+    DeltaCodec();
+
+    /**
+     * Constructor.
+     * @param[in] factory The factory of the struct type of the samples.
+     * @param[in] rep The data representation of the samples.
+     */
+    DeltaCodec(const CodecFactory& factory, DataRepresentation rep = deserialized);
+
+    /**
+     * @return Whether or not the codec can be used.
+     * @retval ERR_NOT_SUPPORTED The factory is a projection.
+     */
+    a_util::result::Result isValid() const;
+
+    /**
+     * Encodes the differences of a sample to a base sample.
+     * @param[in] base The base sample, which the receiver already has.
+     * @param[in] base_size The size of the base sample.
+     * @param[in] sample The sample to encode.
+     * @param[in] sample_size The size of the sample.
+     * @param[out] delta The encoded delta, replaces the previous content. If the sample grows
+     *                   by more than the size of its changed elements, it is the whole sample.
+     * @retval ERR_POINTER The sample is null.
+     * @retval ERR_INVALID_ARG The sample is smaller than its layout requires.
+     */
+    a_util::result::Result encode(const void* base,
+                                  size_t base_size,
+                                  const void* sample,
+                                  size_t sample_size,
+                                  std::vector<uint8_t>& delta) const;
+
+    /**
+     * Applies a delta to a base sample.
+     * @param[in] delta The delta created by encode().
+     * @param[in] delta_size The size of the delta.
+     * @param[in,out] sample The base sample, which is resized to the size of the encoded sample
+     *                       and then updated to its values. It is left unchanged if the delta
+     *                       is rejected.
+     * @retval ERR_POINTER The delta is null.
+     * @retval ERR_INVALID_ARG The delta is corrupt or does not match the struct type, or its
+     *                         array sizes or sample size do not fit to its length.
+     */
+    a_util::result::Result apply(const void* delta,
+                                 size_t delta_size,
+                                 std::vector<uint8_t>& sample) const;
+
+private:
+    /// For internal use only. @internal
+    const StructLayoutElement* getElement(const DynamicLayout* dynamic_layout,
+                                          size_t index) const;
+
+private:
+    /// For internal use only. @internal The layout of the samples.
+    a_util::memory::shared_ptr<const StructLayout> _layout;
+    /// For internal use only. @internal The dynamic layouts shared with the factory.
+    a_util::memory::shared_ptr<DynamicLayoutCache> _dynamic_layouts;
+    /// For internal use only. @internal The data representation of the samples.
+    DataRepresentation _representation;
+    /// For internal use only. @internal The construction result.
+    a_util::result::Result _result;
+};
+
+} // namespace ddl
+
+#endif // DDL_DELTA_CODEC_CLASS_HEADER
@@ -0,0 +1,252 @@
+/**
+ * @file
+ * Typed, precompiled element handles for direct access to codec data.
+ *
+ * @copyright
+ * @verbatim
+Copyright @ 2021 VW Group. All rights reserved.
+
+    This Source Code Form is subject to the terms of the Mozilla
+    Public License, v. 2.0. If a copy of the MPL was not distributed
+    with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+ */
+
+#ifndef DDL_ELEMENT_HANDLE_CLASS_HEADER
+#define DDL_ELEMENT_HANDLE_CLASS_HEADER
+
+#include "a_util/result.h"
+#include "ddl/codec/bitserializer.h"
+#include "ddl/codec/codec_factory.h"
+#include "ddl/codec/static_codec.h"
+
+#include <assert.h>
+#include <cstring>
+
+namespace ddl {
+namespace detail {
+/** @cond INTERNAL_DOCUMENTATION */
+_MAKE_RESULT(-37, ERR_NOT_INITIALIZED);
+
+template <typename T>
+struct HandleType;
+
+#define DDL_HANDLE_TYPE(__data_type, __variant_type)                                               \
+    template <>                                                                                    \
+    struct HandleType<__data_type> {                                                               \
+        static constexpr a_util::variant::VariantType value = a_util::variant::__variant_type;     \
+    };
+
+DDL_HANDLE_TYPE(bool, VT_Bool)
+DDL_HANDLE_TYPE(int8_t, VT_Int8)
+DDL_HANDLE_TYPE(uint8_t, VT_UInt8)
+DDL_HANDLE_TYPE(int16_t, VT_Int16)
+DDL_HANDLE_TYPE(uint16_t, VT_UInt16)
+DDL_HANDLE_TYPE(int32_t, VT_Int32)
+DDL_HANDLE_TYPE(uint32_t, VT_UInt32)
+DDL_HANDLE_TYPE(int64_t, VT_Int64)
+DDL_HANDLE_TYPE(uint64_t, VT_UInt64)
+DDL_HANDLE_TYPE(float, VT_Float)
+DDL_HANDLE_TYPE(double, VT_Double)
+
+#undef DDL_HANDLE_TYPE
+
+/**
+ * Precomputed access information of an element handle.
+ */
+struct ElementHandleInfo {
+    size_t byte_offset;
+    size_t bit_offset;
+    size_t bit_size;
+    bool byte_aligned;
+    bool swap_bytes;
+    a_util::memory::Endianess byte_order;
+    DataRepresentation representation;
+};
+
+/**
+ * Resolves the access information of a static element of a factory.
+ * @param[in] factory The factory.
+ * @param[in] element_index The index of the static element.
+ * @param[in] rep The data representation the handle will operate on.
+ * @param[in] type The value type of the handle, which must match the element type.
+ * @param[in] type_size The size of the value type in bytes.
+ * @param[out] info The resolved access information.
+ * @retval ERR_INVALID_INDEX Invalid element index.
+ * @retval ERR_INVALID_TYPE The element type does not match the handle type.
+ */
+a_util::result::Result resolveElementHandle(const CodecFactory& factory,
+                                            size_t element_index,
+                                            DataRepresentation rep,
+                                            a_util::variant::VariantType type,
+                                            size_t type_size,
+                                            ElementHandleInfo& info);
+/** @endcond */
+} // namespace detail
+
+/**
+ * Typed handle to a static element of a structure.
+ *
+ * The handle is resolved once from a @ref CodecFactory and records offset, representation and
+ * byte order of the element. Reading and writing byte aligned elements through the handle is a
+ * single inlined load or store (plus a byte swap if required) without any virtual dispatch,
+ * type switch or result handling. Bit-packed serialized elements are still supported, but take
+ * the slower path through the @ref a_util::memory::BitSerializer.
+ *
+ * The accessors do not check the buffer bounds, so only use them with decoders and codecs that
+ * passed their isValid() check.
+ *
+ * @tparam T The value type of the element, must match the element type exactly.
+ */
+template <typename T>
+class ElementHandle {
+public:
+    /**
+     * Default constructor. Creates an invalid handle.
+     */
+    ElementHandle() : _info(), _result(detail::ERR_NOT_INITIALIZED)
+    {
+    }
+
+    /**
+     * Resolves a handle by element index.
+     * @param[in] factory The factory of the structure.
+     * @param[in] element_index The index of the static element.
+     * @param[in] rep The data representation the handle will operate on.
+     */
+    ElementHandle(const CodecFactory& factory,
+                  size_t element_index,
+                  DataRepresentation rep = deserialized)
+        : _info()
+    {
+        _result = detail::resolveElementHandle(
+            factory, element_index, rep, detail::HandleType<T>::value, sizeof(T), _info);
+    }
+
+    /**
+     * Resolves a handle by element name.
+     * @param[in] factory The factory of the structure.
+     * @param[in] element_name The full name of the static element.
+     * @param[in] rep The data representation the handle will operate on.
+     */
+    ElementHandle(const CodecFactory& factory,
+                  const std::string& element_name,
+                  DataRepresentation rep = deserialized)
+        : _info()
+    {
+        size_t element_index = 0;
+        _result = factory.findElementIndex(element_name, element_index);
+        if (isOk(_result)) {
+            _result = detail::resolveElementHandle(
+                factory, element_index, rep, detail::HandleType<T>::value, sizeof(T), _info);
+        }
+    }
+
+    /**
+     * @return Whether or not the handle could be resolved.
+     * @retval ERR_NOT_FOUND No element with the requested name was found.
+     * @retval ERR_INVALID_INDEX Invalid element index.
+     * @retval ERR_INVALID_TYPE The element type does not match the handle type.
+     */
+    a_util::result::Result isValid() const
+    {
+        return _result;
+    }
+
+    /**
+     * @return The data representation the handle operates on.
+     */
+    DataRepresentation getRepresentation() const
+    {
+        return _info.representation;
+    }
+
+    /**
+     * Reads the value of the element from a raw data buffer.
+     * @param[in] data The data buffer in the representation of the handle.
+     * @return The value of the element.
+     */
+    inline T getValue(const void* data) const
+    {
+        if (_info.byte_aligned) {
+            T value;
+            std::memcpy(&value, static_cast<const uint8_t*>(data) + _info.byte_offset, sizeof(T));
+            return _info.swap_bytes ? a_util::memory::detail::swapBytes(value) : value;
+        }
+        return readBits(data);
+    }
+
+    /**
+     * Writes the value of the element to a raw data buffer.
+     * @param[in] data The data buffer in the representation of the handle.
+     * @param[in] value The new value of the element.
+     */
+    inline void setValue(void* data, T value) const
+    {
+        if (_info.byte_aligned) {
+            if (_info.swap_bytes) {
+                value = a_util::memory::detail::swapBytes(value);
+            }
+            std::memcpy(static_cast<uint8_t*>(data) + _info.byte_offset, &value, sizeof(T));
+        }
+        else {
+            writeBits(data, value);
+        }
+    }
+
+    /**
+     * Reads the value of the element through a decoder.
+     * @param[in] decoder A valid decoder of the same representation as the handle.
+     * @return The value of the element.
+     */
+    inline T getValue(const StaticDecoder& decoder) const
+    {
+        assert(decoder.getRepresentation() == _info.representation);
+        return getValue(decoder._data);
+    }
+
+    /**
+     * Writes the value of the element through a codec.
+     * @param[in] codec A valid codec of the same representation as the handle.
+     * @param[in] value The new value of the element.
+     */
+    inline void setValue(StaticCodec& codec, T value) const
+    {
+        assert(codec.getRepresentation() == _info.representation);
+        setValue(const_cast<void*>(codec._data), value);
+    }
+
+private:
+    /// For internal use only. @internal
+    T readBits(const void* data) const
+    {
+        T value = T();
+        a_util::memory::BitSerializer(const_cast<void*>(data),
+                                      (_info.bit_offset + _info.bit_size + 7) / 8)
+            .readUnchecked(_info.bit_offset, _info.bit_size, &value, _info.byte_order);
+        return value;
+    }
+
+    /// For internal use only. @internal
+    void writeBits(void* data, T value) const
+    {
+        a_util::memory::BitSerializer(data, (_info.bit_offset + _info.bit_size + 7) / 8)
+            .writeUnchecked(_info.bit_offset, _info.bit_size, value, _info.byte_order);
+    }
+
+private:
+    /// For internal use only. @internal The precomputed access information.
+    detail::ElementHandleInfo _info;
+    /// For internal use only. @internal The resolution result.
+    a_util::result::Result _result;
+};
+
+} // namespace ddl
+
+#endif
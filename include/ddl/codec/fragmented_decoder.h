@@ -0,0 +1,206 @@
+/**
+ * @file
+ * Decoder for samples that are split into several non-contiguous fragments.
+ *
+ * @copyright
+ * @verbatim
+Copyright @ 2021 VW Group. All rights reserved.
+
+    This Source Code Form is subject to the terms of the Mozilla
+    Public License, v. 2.0. If a copy of the MPL was not distributed
+    with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+ */
+
+#ifndef DDL_FRAGMENTED_DECODER_CLASS_HEADER
+#define DDL_FRAGMENTED_DECODER_CLASS_HEADER
+
+#include "a_util/memory.h"
+#include "a_util/result.h"
+#include "a_util/variant.h"
+#include "ddl/codec/struct_element.h"
+
+#include <string>
+#include <vector>
+
+namespace ddl {
+class StructLayout;
+class DynamicLayout;
+class DynamicLayoutCache;
+
+/**
+ * A contiguous part of a sample.
+ */
+struct DataFragment {
+    const void* data; ///< The start of the fragment.
+    size_t size;      ///< The size of the fragment in bytes.
+};
+
+/**
+ * Decoder for samples that are delivered as a list of fragments, e.g. by a transport that splits
+ * large samples, without copying them into one buffer first. The fragments are concatenated in
+ * the given order.
+ *
+ * It provides the element access methods of @ref Decoder, so the helpers in @ref access_element
+ * can be used with it as well. Elements are read directly from their fragment, only elements that
+ * span two fragments are assembled in a small local buffer first. Therefore getElementAddress()
+ * only returns an address for byte aligned elements that lie within a single fragment, and
+ * access_element::getArray() and access_element::getArrayValue() fail for arrays that span
+ * several fragments. It is no @ref StaticDecoder, since there is no single buffer holding the
+ * sample, so it can not be passed to transformToBuffer() or the other users of one.
+ *
+ * The fragments must stay valid as long as the decoder is used.
+ */
+class FragmentedDecoder {
+public:
+    /**
+     * Default constructor. Creates an invalid decoder.
+     */
+    FragmentedDecoder();
+
+    /**
+     * @return Whether or not the fragments contain a complete sample.
+     * @retval ERR_INVALID_ARG The fragments are smaller than the sample.
+     * @retval ERR_NOT_SUPPORTED The factory is a projection with elements of the dynamic section.
+     */
+    a_util::result::Result isValid() const;
+
+    /**
+     * @return The amount of elements contained in the data structure.
+     */
+    size_t getElementCount() const;
+
+    /**
+     * Access information about an element.
+     * @param[in] index The index of the element.
+     * @param[out] element Pointer that will be updated to point to the element information.
+     * @retval ERR_INVALID_INDEX Invalid element index.
+     */
+    a_util::result::Result getElement(size_t index, const StructElement*& element) const;
+
+    /**
+     * Find the index of an element by its full name using the hashed name index.
+     * @param[in] element_name The full name of the element.
+     * @param[out] index The index of the found element.
+     * @retval ERR_NOT_FOUND No element with the requested name was found.
+     */
+    a_util::result::Result findElementIndex(const std::string& element_name,
+                                            size_t& index) const;
+
+    /**
+     * Find the index of the first element whose name starts with the given prefix.
+     * @param[in] prefix The name prefix including the trailing separator.
+     * @param[out] index The index of the found element.
+     * @retval ERR_NOT_FOUND No element with the requested prefix was found.
+     */
+    a_util::result::Result findElementIndexByPrefix(const std::string& prefix,
+                                                    size_t& index) const;
+
+    /**
+     * Returns the current value of the given element by copying its data
+     * to the passed-in location.
+     * @param[in] index The index of the element.
+     * @param[out] value The location where the value should be copied to.
+     * @retval ERR_INVALID_INDEX Invalid element index.
+     */
+    a_util::result::Result getElementValue(size_t index, void* value) const;
+
+    /**
+     * Returns the current value of the given element as a variant.
+     * @param[in] index The index of the element.
+     * @param[out] value The variant that will hold the current value.
+     * @retval ERR_INVALID_INDEX Invalid element index.
+     */
+    a_util::result::Result getElementValue(size_t index, a_util::variant::Variant& value) const;
+
+    /**
+     * Copies the current values of consecutive elements one after another to the passed-in
+     * location.
+     * @param[in] first_index The index of the first element.
+     * @param[in] count The number of elements.
+     * @param[out] values The location where the values should be copied to.
+     * @retval ERR_INVALID_INDEX Invalid element index.
+     */
+    a_util::result::Result getElementValues(size_t first_index, size_t count, void* values) const;
+
+    /**
+     * @param[in] index The index of the element.
+     * @return A pointer to the element or NULL if the element is bit-packed, spans two fragments
+     *         or in case of an error.
+     */
+    const void* getElementAddress(size_t index) const;
+
+    /**
+     * Get the address of consecutive elements, if they lie within a single fragment.
+     * @param[in] first_index The index of the first element.
+     * @param[in] end_index The index following the last element, the element count for elements
+     *                      reaching to the end of the sample.
+     * @param[out] start_address The address of the first element.
+     * @param[out] size The size of the elements in bytes.
+     * @retval ERR_INVALID_INDEX Invalid element index.
+     * @retval ERR_NOT_SUPPORTED The elements are not byte aligned or span several fragments.
+     */
+    a_util::result::Result getElementRange(size_t first_index,
+                                           size_t end_index,
+                                           const void*& start_address,
+                                           size_t& size) const;
+
+    /**
+     * @param[in] rep The data representation for which the buffer size should be returned.
+     * @return The size of the static part of the structure in the requested data representation.
+     */
+    size_t getStaticBufferSize(DataRepresentation rep = deserialized) const;
+
+    /**
+     * @param[in] rep The data representation for which the buffer size should be returned.
+     * @return The size of the structure in the requested data representation.
+     */
+    size_t getBufferSize(DataRepresentation rep = deserialized) const;
+
+    /**
+     * @return The data representation which this decoder handles.
+     */
+    DataRepresentation getRepresentation() const;
+
+private:
+    friend class CodecFactory;
+    /// For internal use only. @internal
+    FragmentedDecoder(a_util::memory::shared_ptr<const StructLayout> layout,
+                      a_util::memory::shared_ptr<DynamicLayoutCache> dynamic_layouts,
+                      const std::vector<DataFragment>& fragments,
+                      DataRepresentation rep);
+    /// For internal use only. @internal
+    const StructLayoutElement* getLayoutElement(size_t index) const;
+    /// For internal use only. @internal
+    a_util::result::Result readValue(const StructLayoutElement& element,
+                                     size_t bit_offset,
+                                     void* value) const;
+    /// For internal use only. @internal
+    size_t findFragment(size_t byte_offset) const;
+
+private:
+    /// For internal use only. @internal The struct layout.
+    a_util::memory::shared_ptr<const StructLayout> _layout;
+    /// For internal use only. @internal The dynamic layout of the sample, if any.
+    a_util::memory::shared_ptr<const DynamicLayout> _dynamic_layout;
+    /// For internal use only. @internal The fragments.
+    std::vector<DataFragment> _fragments;
+    /// For internal use only. @internal The offset of each fragment within the sample.
+    std::vector<size_t> _fragment_offsets;
+    /// For internal use only. @internal The overall size of all fragments.
+    size_t _data_size;
+    /// For internal use only. @internal The data representation of the sample.
+    DataRepresentation _representation;
+    /// For internal use only. @internal The construction result.
+    a_util::result::Result _result;
+};
+
+} // namespace ddl
+
+#endif // DDL_FRAGMENTED_DECODER_CLASS_HEADER
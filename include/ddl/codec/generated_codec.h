@@ -0,0 +1,235 @@
+/**
+ * @file
+ * Support for the compile-time codecs generated by ddlcodegen.
+ *
+ * @copyright
+ * @verbatim
+Copyright @ 2021 VW Group. All rights reserved.
+
+    This Source Code Form is subject to the terms of the Mozilla
+    Public License, v. 2.0. If a copy of the MPL was not distributed
+    with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+ */
+
+#ifndef DDL_GENERATED_CODEC_HEADER
+#define DDL_GENERATED_CODEC_HEADER
+
+#include "a_util/result.h"
+#include "ddl/codec/bitserializer.h"
+#include "ddl/dd/dd_common_types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ddl {
+/**
+ * Compile-time codecs.
+ *
+ * The headers generated by ddlcodegen contain a plain struct for each struct type of a data
+ * definition, whose memory layout matches the deserialized representation of the type. For each
+ * of these structs they specialize @ref CodecTraits with the serialization code and
+ * @ref ElementTable with the offsets of all elements. The results of serialize() and
+ * deserialize() are bit-for-bit identical to a transformation with a @ref ddl::Codec.
+ */
+namespace codegen {
+/** @cond INTERNAL_DOCUMENTATION */
+namespace detail {
+_MAKE_RESULT(-4, ERR_POINTER);
+_MAKE_RESULT(-5, ERR_INVALID_ARG);
+} // namespace detail
+/** @endcond */
+
+/**
+ * Position of a leaf element of a generated struct in both data representations.
+ */
+struct ElementInfo {
+    const char* name;                ///< The full name of the element.
+    size_t deserialized_byte_offset; ///< The byte offset within the deserialized representation.
+    size_t deserialized_byte_size;   ///< The byte size within the deserialized representation.
+    size_t serialized_bit_offset;    ///< The bit offset within the serialized representation.
+    size_t serialized_bit_size;      ///< The bit size within the serialized representation.
+    dd::ByteOrder byte_order;        ///< The byte order of the serialized representation.
+};
+
+/**
+ * Serialization code of a generated struct, specialized by the generated headers.
+ *
+ * Each specialization provides:
+ * @li static constexpr const char* getStructName()
+ * @li static constexpr size_t getDeserializedSize()
+ * @li static constexpr size_t getSerializedSize()
+ * @li static void serialize(const T& value, uint8_t* buffer)
+ * @li static void deserialize(const uint8_t* buffer, T& value)
+ *
+ * The buffers passed to serialize() and deserialize() must have at least the serialized size.
+ */
+template <typename T>
+struct CodecTraits;
+
+/**
+ * Offset table of a generated struct, specialized by the generated headers.
+ *
+ * Each specialization provides a static constexpr array of @ref ElementInfo called elements,
+ * listing the leaf elements in the same order as a @ref ddl::CodecFactory for the struct type.
+ * The second parameter is only needed to define the table within a header.
+ */
+template <typename T, typename Dummy = void>
+struct ElementTable;
+
+/**
+ * @return The number of leaf elements of a generated struct.
+ */
+template <typename T>
+constexpr size_t getElementCount()
+{
+    return sizeof(ElementTable<T>::elements) / sizeof(ElementInfo);
+}
+
+/** @cond INTERNAL_DOCUMENTATION */
+namespace detail {
+/// Bit-packed elements, handled by the same bit serializer the dynamic codec uses.
+template <typename T, size_t bit_offset, size_t bit_size, bool byte_aligned>
+struct ElementSerializer {
+    static void serialize(const T& value,
+                          uint8_t* buffer,
+                          size_t buffer_size,
+                          a_util::memory::Endianess byte_order)
+    {
+        a_util::memory::BitSerializer(buffer, buffer_size)
+            .writeUnchecked<T>(bit_offset, bit_size, value, byte_order);
+    }
+
+    static void deserialize(const uint8_t* buffer,
+                            size_t buffer_size,
+                            T& value,
+                            a_util::memory::Endianess byte_order)
+    {
+        a_util::memory::BitSerializer(const_cast<uint8_t*>(buffer), buffer_size)
+            .readUnchecked<T>(bit_offset, bit_size, &value, byte_order);
+    }
+};
+
+/// Byte aligned elements of full size, copied and swapped if necessary.
+template <typename T, size_t bit_offset, size_t bit_size>
+struct ElementSerializer<T, bit_offset, bit_size, true> {
+    typedef typename a_util::memory::detail::ByteSwap<sizeof(T)>::type Bytes;
+
+    static void serialize(const T& value, uint8_t* buffer, size_t, a_util::memory::Endianess order)
+    {
+        Bytes bytes;
+        std::memcpy(&bytes, &value, sizeof(T));
+        if (a_util::memory::detail::needsByteSwap(order)) {
+            bytes = a_util::memory::detail::ByteSwap<sizeof(T)>::swap(bytes);
+        }
+        std::memcpy(buffer + bit_offset / 8, &bytes, sizeof(T));
+    }
+
+    static void deserialize(const uint8_t* buffer,
+                            size_t,
+                            T& value,
+                            a_util::memory::Endianess order)
+    {
+        Bytes bytes;
+        std::memcpy(&bytes, buffer + bit_offset / 8, sizeof(T));
+        if (a_util::memory::detail::needsByteSwap(order)) {
+            bytes = a_util::memory::detail::ByteSwap<sizeof(T)>::swap(bytes);
+        }
+        std::memcpy(&value, &bytes, sizeof(T));
+    }
+};
+
+} // namespace detail
+/** @endcond */
+
+/**
+ * Writes a single element into a serialized buffer, used by the generated code.
+ * @tparam bit_offset The bit offset of the element within the serialized representation.
+ * @tparam bit_size The bit size of the element within the serialized representation.
+ * @tparam byte_order The byte order of the element within the serialized representation.
+ * @param[in] value The value of the element.
+ * @param[out] buffer The serialized buffer.
+ * @param[in] buffer_size The size of the serialized buffer, at least the serialized size.
+ */
+template <size_t bit_offset, size_t bit_size, dd::ByteOrder byte_order, typename T>
+inline void serializeElement(const T& value, uint8_t* buffer, size_t buffer_size)
+{
+    detail::ElementSerializer<T,
+                              bit_offset,
+                              bit_size,
+                              bit_offset % 8 == 0 && bit_size == sizeof(T) * 8>::
+        serialize(value, buffer, buffer_size, static_cast<a_util::memory::Endianess>(byte_order));
+}
+
+/**
+ * Reads a single element from a serialized buffer, used by the generated code.
+ * @tparam bit_offset The bit offset of the element within the serialized representation.
+ * @tparam bit_size The bit size of the element within the serialized representation.
+ * @tparam byte_order The byte order of the element within the serialized representation.
+ * @param[in] buffer The serialized buffer.
+ * @param[in] buffer_size The size of the serialized buffer, at least the serialized size.
+ * @param[out] value The value of the element.
+ */
+template <size_t bit_offset, size_t bit_size, dd::ByteOrder byte_order, typename T>
+inline void deserializeElement(const uint8_t* buffer, size_t buffer_size, T& value)
+{
+    detail::ElementSerializer<T,
+                              bit_offset,
+                              bit_size,
+                              bit_offset % 8 == 0 && bit_size == sizeof(T) * 8>::
+        deserialize(buffer, buffer_size, value, static_cast<a_util::memory::Endianess>(byte_order));
+}
+
+/**
+ * Serializes a generated struct.
+ * @param[in] value The struct in its deserialized representation.
+ * @param[out] buffer The buffer for the serialized representation.
+ * @param[in] buffer_size The size of the buffer.
+ * @retval ERR_POINTER The buffer is null.
+ * @retval ERR_INVALID_ARG The buffer is smaller than the serialized size of the struct.
+ */
+template <typename T>
+a_util::result::Result serialize(const T& value, void* buffer, size_t buffer_size)
+{
+    if (!buffer) {
+        return detail::ERR_POINTER;
+    }
+    if (buffer_size < CodecTraits<T>::getSerializedSize()) {
+        return detail::ERR_INVALID_ARG;
+    }
+    CodecTraits<T>::serialize(value, static_cast<uint8_t*>(buffer));
+    return a_util::result::SUCCESS;
+}
+
+/**
+ * Deserializes a generated struct.
+ * @param[in] buffer The buffer with the serialized representation.
+ * @param[in] buffer_size The size of the buffer.
+ * @param[out] value The struct in its deserialized representation.
+ * @retval ERR_POINTER The buffer is null.
+ * @retval ERR_INVALID_ARG The buffer is smaller than the serialized size of the struct.
+ */
+template <typename T>
+a_util::result::Result deserialize(const void* buffer, size_t buffer_size, T& value)
+{
+    if (!buffer) {
+        return detail::ERR_POINTER;
+    }
+    if (buffer_size < CodecTraits<T>::getSerializedSize()) {
+        return detail::ERR_INVALID_ARG;
+    }
+    CodecTraits<T>::deserialize(static_cast<const uint8_t*>(buffer), value);
+    return a_util::result::SUCCESS;
+}
+
+} // namespace codegen
+} // namespace ddl
+
+#endif
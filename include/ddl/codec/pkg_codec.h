@@ -22,10 +22,18 @@ You may add additional accurate notices of copyright ownership.
 #define DDL_CODEC_PKG_HEADER
 
 #include "ddl/codec/access_element.h"
+#include "ddl/codec/batch_decoder.h"
 #include "ddl/codec/bitserializer.h"
 #include "ddl/codec/codec.h"
 #include "ddl/codec/codec_factory.h"
+#include "ddl/codec/delta_codec.h"
+#include "ddl/codec/element_handle.h"
+#include "ddl/codec/fragmented_decoder.h"
+#include "ddl/codec/generated_codec.h"
 #include "ddl/codec/static_codec.h"
+#include "ddl/codec/struct_converter.h"
 #include "ddl/codec/struct_element.h"
+#include "ddl/codec/struct_layout_cache.h"
+#include "ddl/codec/validated_view.h"
 
 #endif // DDL_CODEC_PKG_HEADER
@@ -29,6 +29,10 @@ You may add additional accurate notices of copyright ownership.
 namespace ddl {
 class StructLayout;
 class ElementAccessor;
+class TransformPlan;
+class ValidatedDecoderView;
+template <typename T>
+class ElementHandle;
 
 /**
  * Decoder for static structures defined by a DataDefinition definition.
@@ -78,6 +82,25 @@ public:
      */
     a_util::result::Result getElement(size_t index, const StructElement*& element) const;
 
+    /**
+     * Find the index of an element by its full name using the hashed name index.
+     * @param[in] element_name The full name of the element.
+     * @param[out] index The index of the found element.
+     * @retval ERR_NOT_FOUND No element with the requested name was found.
+     */
+    virtual a_util::result::Result findElementIndex(const std::string& element_name,
+                                                    size_t& index) const;
+
+    /**
+     * Find the index of the first element whose name starts with the given prefix.
+     * Only prefixes ending with a '.' (sub-structures) or '[' (arrays) are supported.
+     * @param[in] prefix The name prefix including the trailing separator.
+     * @param[out] index The index of the found element.
+     * @retval ERR_NOT_FOUND No element with the requested prefix was found.
+     */
+    virtual a_util::result::Result findElementIndexByPrefix(const std::string& prefix,
+                                                            size_t& index) const;
+
     /**
      * Returns the current value of the given element by copying its data
      * to the passed-in location.
@@ -95,6 +118,18 @@ public:
      */
     a_util::result::Result getElementValue(size_t index, a_util::variant::Variant& value) const;
 
+    /**
+     * Copies the current values of consecutive elements, for example all items of an array,
+     * one after another to the passed-in location. Runs of byte aligned elements are copied
+     * en bloc and their byte order is converted in bulk where necessary.
+     * @param[in] first_index The index of the first element.
+     * @param[in] count The number of elements.
+     * @param[out] values The location where the values should be copied to.
+     * @retval ERR_INVALID_INDEX Invalid element index.
+     * @retval ERR_INVALID_ARG The data is smaller than the elements require.
+     */
+    a_util::result::Result getElementValues(size_t first_index, size_t count, void* values) const;
+
     /**
      * @param[in] index The index of the element.
      * @return A pointer to the element or NULL in case of an error.
@@ -114,6 +149,10 @@ public:
 
 protected:
     friend class CodecFactory;
+    friend class TransformPlan;
+    template <typename T>
+    friend class ElementHandle;
+    friend class ValidatedDecoderView;
 
     /// For internal use only. @internal
     StaticDecoder(a_util::memory::shared_ptr<const StructLayout> layout,
@@ -122,6 +161,8 @@ protected:
                   DataRepresentation rep);
     /// For internal use only. @internal
     virtual const StructLayoutElement* getLayoutElement(size_t index) const;
+    /// For internal use only. @internal Same as getLayoutElement, but with the name set.
+    virtual const StructLayoutElement* getNamedLayoutElement(size_t index) const;
 
 protected:
     /// For internal use only. @internal
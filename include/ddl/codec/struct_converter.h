@@ -0,0 +1,167 @@
+/**
+ * @file
+ * Conversion of samples between different versions of a struct type.
+ *
+ * @copyright
+ * @verbatim
+Copyright @ 2021 VW Group. All rights reserved.
+
+    This Source Code Form is subject to the terms of the Mozilla
+    Public License, v. 2.0. If a copy of the MPL was not distributed
+    with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+ */
+
+#ifndef DDL_STRUCT_CONVERTER_CLASS_HEADER
+#define DDL_STRUCT_CONVERTER_CLASS_HEADER
+
+#include "a_util/memory.h"
+#include "a_util/result.h"
+#include "ddl/codec/struct_element.h"
+#include "ddl/dd/dd.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ddl {
+class StructLayout;
+
+/**
+ * Converts samples of one version of a struct type into samples of another version, e.g. for
+ * migrating recorded data.
+ *
+ * The elements of both versions are matched by their full names once on construction, which
+ * compiles them into a flat program: runs of bytes that can be copied as they are, values of
+ * elements whose type, byte order or bit position differs that are cast into the destination
+ * type, and the default values of the destination for all elements without a source and all
+ * constants. Converting a sample then only executes this program, without any lookup.
+ *
+ * Only structs without dynamic arrays are supported.
+ */
+class StructConverter {
+public:
+    /**
+     * Default constructor. Creates an invalid converter.
+     */
+    StructConverter();
+
+    /**
+     * Compiles the conversion program.
+     * @param[in] source The source version of the struct.
+     * @param[in] destination The destination version of the struct.
+     * @param[in] renamed_elements Full destination names mapped to the full names of the source
+     *                             elements they are read from, for elements whose name changed.
+     *                             The names may also denote arrays or substructs, which are
+     *                             matched element by element.
+     * @param[in] source_rep The data representation of the source samples.
+     * @param[in] destination_rep The data representation of the destination samples.
+     */
+    StructConverter(const dd::StructTypeAccess& source,
+                    const dd::StructTypeAccess& destination,
+                    const std::map<std::string, std::string>& renamed_elements = {},
+                    DataRepresentation source_rep = deserialized,
+                    DataRepresentation destination_rep = deserialized);
+
+    /**
+     * @return Whether or not the program could be compiled.
+     * @retval ERR_INVALID_DDL One of the struct types is invalid.
+     * @retval ERR_NOT_SUPPORTED One of the struct types contains dynamic arrays.
+     * @retval ERR_NOT_FOUND A source element of @p renamed_elements does not exist.
+     */
+    a_util::result::Result isValid() const;
+
+    /**
+     * @return The size of a source sample.
+     */
+    size_t getSourceSize() const;
+
+    /**
+     * @return The size of a destination sample.
+     */
+    size_t getDestinationSize() const;
+
+    /**
+     * @return The number of destination elements that are copied as they are.
+     */
+    size_t getCopiedElementCount() const;
+
+    /**
+     * @return The number of destination elements that are cast from a source element.
+     */
+    size_t getConvertedElementCount() const;
+
+    /**
+     * @return The number of destination elements that are set to their default value.
+     */
+    size_t getDefaultedElementCount() const;
+
+    /**
+     * Converts a sample.
+     * @param[in] source The source sample.
+     * @param[in] source_size The size of the source sample.
+     * @param[out] destination The destination sample, all its elements are written.
+     * @param[in] destination_size The size of the destination sample.
+     * @retval ERR_POINTER One of the samples is null.
+     * @retval ERR_INVALID_ARG One of the samples is too small.
+     */
+    a_util::result::Result convert(const void* source,
+                                   size_t source_size,
+                                   void* destination,
+                                   size_t destination_size) const;
+
+private:
+    /// For internal use only. @internal Converts a single value of one type into another.
+    typedef void (*ConvertFunction)(const void* source_value, void* destination_value);
+
+    /// For internal use only. @internal
+    struct CopyRun {
+        size_t source_offset;
+        size_t destination_offset;
+        size_t size;
+    };
+
+    /// For internal use only. @internal
+    struct Conversion {
+        const StructLayoutElement* source;
+        const StructLayoutElement* destination;
+        ConvertFunction convert;
+    };
+
+    /// For internal use only. @internal
+    a_util::result::Result compile(const std::map<std::string, std::string>& renamed_elements);
+    /// For internal use only. @internal
+    const StructLayoutElement* findSourceElement(
+        const std::string& destination_name,
+        const std::map<std::string, std::string>& renamed_elements) const;
+
+private:
+    /// For internal use only. @internal The layout of the source samples.
+    a_util::memory::shared_ptr<const StructLayout> _source_layout;
+    /// For internal use only. @internal The layout of the destination samples.
+    a_util::memory::shared_ptr<const StructLayout> _destination_layout;
+    /// For internal use only. @internal The data representation of the source samples.
+    DataRepresentation _source_representation;
+    /// For internal use only. @internal The data representation of the destination samples.
+    DataRepresentation _destination_representation;
+    /// For internal use only. @internal The runs of bytes that are copied.
+    std::vector<CopyRun> _copy_runs;
+    /// For internal use only. @internal The elements that are cast.
+    std::vector<Conversion> _conversions;
+    /// For internal use only. @internal The number of copied elements.
+    size_t _copied_element_count;
+    /// For internal use only. @internal The number of defaulted elements.
+    size_t _defaulted_element_count;
+    /// For internal use only. @internal The compilation result.
+    a_util::result::Result _result;
+};
+
+} // namespace ddl
+
+#endif // DDL_STRUCT_CONVERTER_CLASS_HEADER
@@ -25,8 +25,11 @@ You may add additional accurate notices of copyright ownership.
 #include "a_util/variant.h"
 #include "ddl/dd/dd_common_types.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace ddl {
@@ -51,13 +54,98 @@ using tDataRepresentation = DataRepresentation;
  */
 typedef std::map<std::string, a_util::variant::Variant> AccessEnumType;
 
+/**
+ * Reverse lookup value -> name for the integral values of an enumeration.
+ * Uses a dense table if the values are close to each other and a hash map otherwise. If several
+ * names share a value, the first one in the order of the AccessEnumType is found.
+ */
+class EnumValueNames {
+public:
+    /// Creates an empty lookup.
+    EnumValueNames() : _dense_minimum(0)
+    {
+    }
+
+    /**
+     * Creates the lookup for an enumeration.
+     * @param[in] enum_type The enumeration, which must outlive the lookup.
+     */
+    explicit EnumValueNames(const AccessEnumType& enum_type) : _dense_minimum(0)
+    {
+        std::vector<std::pair<int64_t, const std::string*>> values;
+        values.reserve(enum_type.size());
+        for (const auto& value: enum_type) {
+            values.emplace_back(toKey(value.second), &value.first);
+        }
+        if (values.empty()) {
+            return;
+        }
+
+        int64_t minimum = values.front().first, maximum = values.front().first;
+        for (const auto& value: values) {
+            minimum = std::min(minimum, value.first);
+            maximum = std::max(maximum, value.first);
+        }
+        const uint64_t range = static_cast<uint64_t>(maximum) - static_cast<uint64_t>(minimum);
+        if (range < 4 * values.size() + 64) {
+            _dense_minimum = minimum;
+            _dense_names.resize(static_cast<size_t>(range) + 1, nullptr);
+            for (const auto& value: values) {
+                const std::string*& name =
+                    _dense_names[static_cast<size_t>(static_cast<uint64_t>(value.first) -
+                                                     static_cast<uint64_t>(minimum))];
+                if (!name) {
+                    name = value.second;
+                }
+            }
+        }
+        else {
+            for (const auto& value: values) {
+                _sparse_names.emplace(value.first, value.second);
+            }
+        }
+    }
+
+    /**
+     * Finds the name of a value.
+     * @param[in] value The value, unsigned values are reinterpreted as signed.
+     * @return The name or NULL if the enumeration has no name for the value.
+     */
+    const std::string* find(int64_t value) const
+    {
+        if (!_dense_names.empty()) {
+            const uint64_t position =
+                static_cast<uint64_t>(value) - static_cast<uint64_t>(_dense_minimum);
+            return position < _dense_names.size() ? _dense_names[position] : nullptr;
+        }
+        const auto found = _sparse_names.find(value);
+        return found != _sparse_names.end() ? found->second : nullptr;
+    }
+
+private:
+    static int64_t toKey(const a_util::variant::Variant& value)
+    {
+        // the enum values are stored as strings, only negative ones fit into signed values
+        if (value.getType() == a_util::variant::VT_String && value.getString()[0] != '-') {
+            return static_cast<int64_t>(value.asUInt64());
+        }
+        return value.asInt64();
+    }
+
+private:
+    int64_t _dense_minimum;
+    std::vector<const std::string*> _dense_names;
+    std::unordered_map<int64_t, const std::string*> _sparse_names;
+};
+
 /**
  * Information about an element accessible with a decoder or codec.
  */
 struct StructElement {
-    std::string name;                  ///< The full name of the element.
-    a_util::variant::VariantType type; ///< The type of the element.
-    const AccessEnumType* p_enum;      ///< pointer to an enum, can be NULL.
+    std::string name;                   ///< The full name of the element.
+    a_util::variant::VariantType type;  ///< The type of the element.
+    const AccessEnumType* p_enum;       ///< pointer to an enum, can be NULL.
+    const EnumValueNames* p_enum_names; ///< reverse lookup for p_enum, can be NULL.
 };
 
 // The following classes are for internal use only
@@ -76,16 +164,35 @@ struct StructLayoutElement : public StructElement {
     const a_util::variant::Variant* constant;
 };
 
+/**
+ * Location of the array size element of a dynamic array relative to the enclosing scope, which is
+ * either the whole struct or one instance of the parent dynamic element.
+ */
+struct ArraySizeReference {
+    enum Kind {
+        unresolved,   ///< only resolvable by name
+        scope_static, ///< element of the static elements of the scope
+        sibling       ///< element of a preceding non-array dynamic element of the same scope
+    };
+    Kind kind;
+    size_t sibling_index;
+    size_t element_index;
+};
+
 struct DynamicStructLayoutElement {
     std::string name;
     size_t alignment;
     std::string size_element_name;
+    ArraySizeReference size_reference;
     std::vector<StructLayoutElement> static_elements;
     std::vector<DynamicStructLayoutElement> dynamic_elements;
 
-    DynamicStructLayoutElement() = default;
+    DynamicStructLayoutElement() : size_reference{ArraySizeReference::unresolved, 0, 0}
+    {
+    }
 
-    DynamicStructLayoutElement(size_t alignment) : alignment(alignment)
+    DynamicStructLayoutElement(size_t alignment)
+        : alignment(alignment), size_reference{ArraySizeReference::unresolved, 0, 0}
     {
     }
 
@@ -105,6 +212,54 @@ struct Offsets {
     size_t serialized;
 };
 
+/**
+ * Hashed name lookup for the elements of a layout.
+ * Besides the full element names it stores every name prefix that ends with a '.' or '['
+ * separator, mapped to the index of the first element starting with that prefix.
+ * Indices must be added in ascending order.
+ */
+class StructElementIndex {
+public:
+    void add(const std::string& name, size_t index)
+    {
+        _names.emplace(name, index);
+        for (size_t pos = name.find_first_of(".["); pos != std::string::npos;
+             pos = name.find_first_of(".[", pos + 1)) {
+            _prefixes.emplace(name.substr(0, pos + 1), index);
+        }
+    }
+
+    bool find(const std::string& name, size_t& index) const
+    {
+        const auto found = _names.find(name);
+        if (found == _names.end()) {
+            return false;
+        }
+        index = found->second;
+        return true;
+    }
+
+    bool findPrefix(const std::string& prefix, size_t& index) const
+    {
+        const auto found = _prefixes.find(prefix);
+        if (found == _prefixes.end()) {
+            return false;
+        }
+        index = found->second;
+        return true;
+    }
+
+    void clear()
+    {
+        _names.clear();
+        _prefixes.clear();
+    }
+
+private:
+    std::unordered_map<std::string, size_t> _names;
+    std::unordered_map<std::string, size_t> _prefixes;
+};
+
 /** @endcond */
 
 } // namespace ddl
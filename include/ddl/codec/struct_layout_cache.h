@@ -0,0 +1,137 @@
+/**
+ * @file
+ * Process-wide cache of the struct layouts used by the codec factories.
+ *
+ * @copyright
+ * @verbatim
+Copyright @ 2021 VW Group. All rights reserved.
+
+    This Source Code Form is subject to the terms of the Mozilla
+    Public License, v. 2.0. If a copy of the MPL was not distributed
+    with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+ */
+
+#ifndef DDL_STRUCT_LAYOUT_CACHE_CLASS_HEADER
+#define DDL_STRUCT_LAYOUT_CACHE_CLASS_HEADER
+
+#include "a_util/result.h"
+#include "ddl/dd/dd.h"
+
+#include <memory>
+#include <string>
+
+namespace ddl {
+class StructLayout;
+
+/**
+ * Process-wide, thread-safe cache of the struct layouts and parsed data definitions used by all
+ * @ref CodecFactory constructors.
+ *
+ * Layouts are keyed by the struct name and a content hash of the description: the description
+ * string itself for factories created from a string, and the definitions of the struct and all
+ * types it depends on for factories created from a DataDefinition. Factories for equal content
+ * therefore share one layout, regardless of where the content comes from. The hash is not
+ * collision resistant, so the entries keep the content and compare it on a matching hash. Both
+ * caches are bounded and evict the least recently used entry first.
+ */
+class StructLayoutCache {
+public:
+    /**
+     * Usage statistics of the cache.
+     */
+    struct Statistics {
+        size_t layout_hits;       ///< Number of layouts found in the cache.
+        size_t layout_misses;     ///< Number of layouts that had to be calculated.
+        size_t layout_count;      ///< Number of layouts currently cached.
+        size_t definition_hits;   ///< Number of parsed descriptions found in the cache.
+        size_t definition_misses; ///< Number of descriptions that had to be parsed.
+        size_t definition_count;  ///< Number of parsed descriptions currently cached.
+    };
+
+    /// The default number of layouts and of parsed descriptions that are cached.
+    static constexpr size_t default_capacity = 256;
+
+    /**
+     * @return The process-wide instance.
+     */
+    static StructLayoutCache& getInstance();
+
+    /**
+     * Noncopyable
+     */
+    StructLayoutCache(const StructLayoutCache&) = delete;
+
+    /**
+     * Noncopyable
+     */
+    StructLayoutCache& operator=(const StructLayoutCache&) = delete;
+
+    /**
+     * Destructor.
+     */
+    ~StructLayoutCache();
+
+    /**
+     * @return The current usage statistics.
+     */
+    Statistics getStatistics() const;
+
+    /**
+     * Resets the hit and miss counters of the statistics.
+     */
+    void resetStatistics();
+
+    /**
+     * @return The maximum number of layouts and of parsed descriptions that are cached.
+     */
+    size_t getCapacity() const;
+
+    /**
+     * Sets the maximum number of layouts and of parsed descriptions that are cached and evicts
+     * the least recently used entries beyond it. Existing factories keep their layouts.
+     * @param[in] capacity The new capacity, 0 disables the cache.
+     */
+    void setCapacity(size_t capacity);
+
+    /**
+     * Removes all entries. Existing factories keep their layouts.
+     */
+    void clear();
+
+    /**
+     * For internal use only. @internal
+     * Looks up or calculates the layout of a struct within a description string.
+     * @param[in] struct_name The name of the struct.
+     * @param[in] description The description string.
+     * @param[out] layout The layout, only set if the description is valid and contains the struct.
+     * @retval ERR_INVALID_DDL The description is invalid or does not contain the struct.
+     */
+    a_util::result::Result getLayout(const std::string& struct_name,
+                                     const std::string& description,
+                                     std::shared_ptr<const StructLayout>& layout);
+
+    /**
+     * For internal use only. @internal
+     * Looks up or calculates the layout of a struct type access.
+     * @param[in] struct_type_access The struct type access.
+     * @return The layout.
+     */
+    std::shared_ptr<const StructLayout> getLayout(const dd::StructTypeAccess& struct_type_access);
+
+private:
+    StructLayoutCache();
+
+    class Implementation;
+    std::unique_ptr<Implementation> _impl;
+};
+
+} // namespace ddl
+
+#endif // DDL_STRUCT_LAYOUT_CACHE_CLASS_HEADER
@@ -0,0 +1,171 @@
+/**
+ * @file
+ * Element access without per call checks for samples that have been validated once.
+ *
+ * @copyright
+ * @verbatim
+Copyright @ 2021 VW Group. All rights reserved.
+
+    This Source Code Form is subject to the terms of the Mozilla
+    Public License, v. 2.0. If a copy of the MPL was not distributed
+    with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+ */
+
+#ifndef DDL_VALIDATED_VIEW_CLASS_HEADER
+#define DDL_VALIDATED_VIEW_CLASS_HEADER
+
+#include "a_util/result.h"
+#include "a_util/variant.h"
+#include "ddl/codec/codec.h"
+
+#include <vector>
+
+namespace ddl {
+/**
+ * Validated view of the elements of a decoder.
+ *
+ * The view checks the decoder once on construction, i.e. whether its layout is valid and its
+ * buffer is large enough for all static and dynamic elements. Afterwards every element is known
+ * to fit into the buffer, so the accessors of the view skip the bounds checks of the decoder and
+ * the @ref a_util::memory::BitSerializer and do not return a result. The checked API of the
+ * decoder stays available through getDecoder().
+ *
+ * The view refers to the decoder, which must outlive it and must not be changed (e.g. by
+ * resizing its dynamic arrays) while the view is used.
+ */
+class ValidatedDecoderView {
+public:
+    /**
+     * Default constructor. Creates an invalid view.
+     */
+    ValidatedDecoderView();
+
+    /**
+     * Validates a static decoder.
+     * @param[in] decoder The decoder.
+     */
+    explicit ValidatedDecoderView(const StaticDecoder& decoder);
+
+    /**
+     * Validates a decoder including its dynamic elements.
+     * @param[in] decoder The decoder.
+     */
+    explicit ValidatedDecoderView(const Decoder& decoder);
+
+    /**
+     * @return The result of the validation, the accessors must only be used if it succeeded.
+     * @retval ERR_NOT_INITIALIZED The view has been default constructed.
+     * @retval ERR_INVALID_ARG The buffer of the decoder is too small.
+     */
+    a_util::result::Result isValid() const;
+
+    /**
+     * @return The decoder for the checked API.
+     */
+    const StaticDecoder& getDecoder() const;
+
+    /**
+     * @return The amount of elements, including the dynamic ones.
+     */
+    size_t getElementCount() const;
+
+    /**
+     * Returns the current value of the given element by copying its data
+     * to the passed-in location.
+     * @param[in] index The index of the element, must be less than getElementCount().
+     * @param[out] value The location where the value should be copied to.
+     */
+    void getElementValue(size_t index, void* value) const;
+
+    /**
+     * Returns the current value of the given element as a variant.
+     * @param[in] index The index of the element, must be less than getElementCount().
+     * @return The value of the element.
+     */
+    a_util::variant::Variant getElementValue(size_t index) const;
+
+protected:
+    /// For internal use only. @internal
+    const StructLayoutElement& getLayoutElement(size_t index) const
+    {
+        if (index < _static_count) {
+            return _static_elements[index];
+        }
+        return _projected_elements.empty() ? _dynamic_elements[index - _static_count] :
+                                             *_projected_elements[index - _static_count];
+    }
+
+    /// For internal use only. @internal Collects the dynamic elements of a decoder.
+    void initDynamicElements(const Decoder& decoder);
+
+protected:
+    /// For internal use only. @internal
+    const StaticDecoder* _decoder;
+    /// For internal use only. @internal
+    const StructLayoutElement* _static_elements;
+    /// For internal use only. @internal
+    size_t _static_count;
+    /// For internal use only. @internal
+    const StructLayoutElement* _dynamic_elements;
+    /// For internal use only. @internal
+    size_t _dynamic_count;
+    /// For internal use only. @internal The located dynamic elements of a projection.
+    std::vector<const StructLayoutElement*> _projected_elements;
+    /// For internal use only. @internal
+    const void* _data;
+    /// For internal use only. @internal
+    size_t _data_size;
+    /// For internal use only. @internal
+    DataRepresentation _representation;
+    /// For internal use only. @internal
+    a_util::result::Result _result;
+};
+
+/**
+ * Validated view of the elements of a codec, see @ref ValidatedDecoderView.
+ */
+class ValidatedCodecView : public ValidatedDecoderView {
+public:
+    /**
+     * Default constructor. Creates an invalid view.
+     */
+    ValidatedCodecView();
+
+    /**
+     * Validates a static codec.
+     * @param[in] codec The codec.
+     */
+    explicit ValidatedCodecView(StaticCodec& codec);
+
+    /**
+     * Validates a codec including its dynamic elements.
+     * @param[in] codec The codec.
+     */
+    explicit ValidatedCodecView(Codec& codec);
+
+    /**
+     * Sets the current value of the given element by copying its data
+     * from the passed-in location.
+     * @param[in] index The index of the element, must be less than getElementCount().
+     * @param[in] value The location where the data should be copied from.
+     */
+    void setElementValue(size_t index, const void* value);
+
+    /**
+     * Sets the current value of the given element to the given value.
+     * @param[in] index The index of the element, must be less than getElementCount().
+     * @param[in] value The value.
+     */
+    void setElementValue(size_t index, const a_util::variant::Variant& value);
+};
+
+} // namespace ddl
+
+#endif
@@ -107,6 +107,14 @@ public:
      * @return DataDefinition&
      */
     DataDefinition& operator=(const DataDefinition& other);
+    /**
+     * @brief resets the current content and shares the items of the \p other instead of copying
+     * them. A shared item is copied with its infos when it is accessed for changes (see @ref
+     * utility::TypeAccessMap::shareItemsOf). The header and the infos of the model are copied.
+     *
+     * @param other the other to share the items of, these must not be changed anymore.
+     */
+    void shareContentOf(const DataDefinition& other);
 
     virtual ~DataDefinition() = default;
 
@@ -324,6 +332,14 @@ public:
      */
     bool isEmpty() const;
 
+    /**
+     * @brief Get the id of the current content of the model. It is unique within the process and
+     * changes whenever the model or one of its types changes, so it can be used to check whether
+     * information calculated for the model is still up to date.
+     * @return uint64_t the change id (never 0).
+     */
+    uint64_t getChangeId() const;
+
 private:
     bool validateContains(const BaseUnits::access_type& base_unit) const;
     bool validateContains(const UnitPrefixes::access_type& unit_prefix) const;
@@ -373,6 +389,7 @@ private:
     StreamMetaTypes _stream_meta_types;
     Streams _streams;
     bool _empty_model;
+    uint64_t _change_id;
 };
 
 } // namespace datamodel
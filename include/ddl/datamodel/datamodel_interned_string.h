@@ -0,0 +1,148 @@
+/**
+ * @file
+ * OO DataDefinition Redesign
+ *
+ * @copyright
+ * @verbatim
+Copyright @ 2021 VW Group. All rights reserved.
+
+    This Source Code Form is subject to the terms of the Mozilla
+    Public License, v. 2.0. If a copy of the MPL was not distributed
+    with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+ */
+
+#ifndef DD_DATA_MODEL_INTERNED_STRING_H_INCLUDED
+#define DD_DATA_MODEL_INTERNED_STRING_H_INCLUDED
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace ddl {
+
+namespace dd {
+
+namespace datamodel {
+
+/**
+ * @brief String held once per process for all values that are equal.
+ * Used for the type and unit names repeated in many elements of a large description, so each of
+ * them only holds a pointer into the process wide pool.
+ * @remark A pool entry is removed with the last InternedString holding it. Only interning a
+ * value locks the pool (one of several locks, chosen by the hash of the value), copies just
+ * count the references.
+ */
+class InternedString {
+public:
+    /**
+     * @brief default CTOR for an empty string.
+     */
+    InternedString() = default;
+    /**
+     * @brief CTOR
+     *
+     * @param value the value to intern.
+     */
+    InternedString(const std::string& value);
+    /**
+     * @brief copy CTOR
+     *
+     * @param other the string to copy, shares its pool entry.
+     */
+    InternedString(const InternedString& other);
+    /**
+     * @brief move CTOR
+     *
+     * @param other the string to move, is empty afterwards.
+     */
+    InternedString(InternedString&& other);
+    /**
+     * @brief copy assignment operator
+     *
+     * @param other the string to copy, shares its pool entry.
+     * @return InternedString&
+     */
+    InternedString& operator=(const InternedString& other);
+    /**
+     * @brief move assignment operator
+     *
+     * @param other the string to move, is empty afterwards.
+     * @return InternedString&
+     */
+    InternedString& operator=(InternedString&& other);
+    /**
+     * @brief assignment operator
+     *
+     * @param value the value to intern.
+     * @return InternedString&
+     */
+    InternedString& operator=(const std::string& value);
+    /**
+     * @brief DTOR, releases the pool entry.
+     */
+    ~InternedString();
+
+    /**
+     * @brief Get the value
+     *
+     * @return const std::string& valid as long as this string holds the value.
+     */
+    const std::string& get() const
+    {
+        return _entry ? _entry->first : empty();
+    }
+    /**
+     * @brief equality operator, compares the pool entries only.
+     *
+     * @param other the other string to compare to.
+     * @return true the strings are equal.
+     * @return false the strings are not equal.
+     */
+    bool operator==(const InternedString& other) const
+    {
+        return _entry == other._entry;
+    }
+    /**
+     * @brief non equality operator.
+     *
+     * @param other the other string to compare to.
+     * @return false the strings are equal.
+     * @return true the strings are not equal.
+     */
+    bool operator!=(const InternedString& other) const
+    {
+        return _entry != other._entry;
+    }
+
+    /**
+     * @brief Get the number of different values held in the pool.
+     *
+     * @return size_t the number of values.
+     */
+    static size_t getPoolSize();
+
+private:
+    /// an entry of the pool: the value and the number of InternedString holding it
+    using Entry = std::pair<const std::string, std::atomic<size_t>>;
+
+    static const std::string& empty();
+    static Entry* intern(const std::string& value);
+    static void release(Entry* entry);
+
+    /// the entry in the pool, nullptr for an empty string
+    Entry* _entry = nullptr;
+};
+
+} // namespace datamodel
+} // namespace dd
+} // namespace ddl
+
+#endif // DD_DATA_MODEL_INTERNED_STRING_H_INCLUDED
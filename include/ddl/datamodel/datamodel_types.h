@@ -22,6 +22,7 @@ You may add additional accurate notices of copyright ownership.
 #define DD_DATA_MODEL_TYPES_H_INCLUDED
 
 #include "ddl/datamodel/datamodel_base.h"
+#include "ddl/datamodel/datamodel_interned_string.h"
 #include "ddl/datamodel/datamodel_keyvalue.h"
 #include "ddl/datamodel/infomodel_base.h"
 #include "ddl/dd/dd_common_types.h"
@@ -1006,9 +1007,10 @@ public:
 
     private:
         std::string _name;
-        std::string _type_name;
+        // the type and unit names repeated in many elements are held once per process
+        InternedString _type_name;
         std::string _description;
-        std::string _unit_name;
+        InternedString _unit_name;
         std::string _comment;
         ArraySize _array_size = 1;
         std::string _value;
@@ -1140,6 +1142,11 @@ public:
      * @return Elements&
      */
     Elements& getElements();
+    /**
+     * @brief Replaces the shared infos of the struct type and its elements by copies (see @ref
+     * InfoMap::copyInfos). The copies of a struct type share the infos of the elements.
+     */
+    void copyInfos();
 
 private:
     void notify(ModelEventCode code,
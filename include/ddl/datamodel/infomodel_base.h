@@ -23,6 +23,7 @@ You may add additional accurate notices of copyright ownership.
 
 #include "a_util/preprocessor/detail/disable_warnings.h"
 #include "ddl/dd/dd_error.h"
+#include "ddl/dd/dd_infomodel_type.h"
 #include "ddl/utilities/dd_access_observer.h"
 
 #include <memory>
@@ -52,6 +53,16 @@ public:
      * @return uint8_t the Type ID
      */
     virtual uint8_t getInfoType() const = 0;
+    /**
+     * @brief Copies the info for a copy of the item it belongs to (see @ref InfoMap::copyInfos).
+     *
+     * @return std::shared_ptr<IInfo> the copy, or an empty pointer if the copies of the item may
+     * share the info.
+     */
+    virtual std::shared_ptr<IInfo> clone() const
+    {
+        return {};
+    }
 };
 
 /**
@@ -77,9 +88,49 @@ protected:
 /**
  * @brief Info Map for the datamodel to hold a set of optional @ref IInfo instances.
  * Only one instance of one Info type is possible.
+ * The infos of the types defined in @ref dd::InfoType are held in fixed slots, since every
+ * element of a large description has an info map. Infos of other types are held in a map which
+ * is only created on demand.
  */
 class InfoMap {
 public:
+    /**
+     * @brief default CTOR
+     */
+    InfoMap() = default;
+    /**
+     * @brief copy CTOR, the copy shares the infos.
+     *
+     * @param other the info map to copy.
+     */
+    InfoMap(const InfoMap& other)
+    {
+        copyFrom(other);
+    }
+    /**
+     * @brief move CTOR
+     */
+    InfoMap(InfoMap&&) = default;
+    /**
+     * @brief copy assignment operator, the copy shares the infos.
+     *
+     * @param other the info map to copy.
+     * @return InfoMap&
+     */
+    InfoMap& operator=(const InfoMap& other)
+    {
+        if (this != &other) {
+            copyFrom(other);
+        }
+        return *this;
+    }
+    /**
+     * @brief move assignment operator
+     *
+     * @return InfoMap&
+     */
+    InfoMap& operator=(InfoMap&&) = default;
+
     /**
      * @brief Get the Info Pointer
      *
@@ -123,30 +174,71 @@ public:
         }
     }
 
+    /**
+     * @brief Replaces the shared infos by copies (see @ref IInfo::clone), i.e. for a copy that is
+     * changed independently of the original.
+     */
+    void copyInfos()
+    {
+        for (auto& info: _infos) {
+            copyInfo(info);
+        }
+        if (_other_infos) {
+            for (auto& info: *_other_infos) {
+                copyInfo(info.second);
+            }
+        }
+    }
+
 private:
+    typedef std::unordered_map<uint8_t, std::shared_ptr<IInfo>> OtherInfos;
+
     IInfo* getInfo(uint8_t info_type)
     {
-        auto found = _infos.find(info_type);
-        if (found != _infos.end()) {
-            return found->second.get();
+        return const_cast<IInfo*>(static_cast<const InfoMap*>(this)->getInfo(info_type));
+    }
+    const IInfo* getInfo(uint8_t info_type) const
+    {
+        if (info_type < InfoType::last_info) {
+            return _infos[info_type].get();
         }
-        else {
-            return nullptr;
+        if (_other_infos) {
+            auto found = _other_infos->find(info_type);
+            if (found != _other_infos->cend()) {
+                return found->second.get();
+            }
         }
+        return nullptr;
     }
-    const IInfo* getInfo(uint8_t info_type) const
+    void setInfo(const std::shared_ptr<IInfo>& info)
     {
-        auto found = _infos.find(info_type);
-        if (found != _infos.cend()) {
-            return found->second.get();
+        const auto info_type = info->getInfoType();
+        if (info_type < InfoType::last_info) {
+            _infos[info_type] = info;
         }
         else {
-            return nullptr;
+            if (!_other_infos) {
+                _other_infos.reset(new OtherInfos());
+            }
+            (*_other_infos)[info_type] = info;
         }
     }
-    void setInfo(const std::shared_ptr<IInfo>& info)
+    static void copyInfo(std::shared_ptr<IInfo>& info)
+    {
+        if (info) {
+            auto copied_info = info->clone();
+            if (copied_info) {
+                info = copied_info;
+            }
+        }
+    }
+
+    void copyFrom(const InfoMap& other)
     {
-        _infos[info->getInfoType()] = info;
+        for (size_t info_type = 0; info_type < InfoType::last_info; ++info_type) {
+            _infos[info_type] = other._infos[info_type];
+        }
+        _other_infos.reset(other._other_infos ? new OtherInfos(*other._other_infos) : nullptr);
     }
 
 #if defined(__GNUC__) && ((__GNUC__ == 5) && (__GNUC_MINOR__ == 2))
@@ -154,13 +246,30 @@ private:
 #pragma GCC diagnostic ignored "-Wattributes"
 #endif // defined(__GNUC__) && ((__GNUC__ == 5) && (__GNUC_MINOR__ == 2))
 
-    std::unordered_map<uint8_t, std::shared_ptr<IInfo>> _infos;
+    std::shared_ptr<IInfo> _infos[InfoType::last_info];
+    std::unique_ptr<OtherInfos> _other_infos;
 
 #if defined(__GNUC__) && ((__GNUC__ == 5) && (__GNUC_MINOR__ == 2))
 #pragma GCC diagnostic pop
 #endif // defined(__GNUC__) && ((__GNUC__ == 5) && (__GNUC_MINOR__ == 2))
 };
 
+/**
+ * @brief Copies an item of the datamodel together with its infos (see @ref InfoMap::copyInfos).
+ *
+ * @tparam T the type of the item
+ * @param item the item to copy
+ * @return std::shared_ptr<T> the copy
+ */
+template <typename T>
+std::shared_ptr<T> copyWithInfos(const T& item)
+{
+    auto copied_item = std::make_shared<T>(item);
+    copied_item->InfoMap::operator=(item);
+    copied_item->copyInfos();
+    return copied_item;
+}
+
 } // namespace datamodel
 } // namespace dd
 } // namespace ddl
@@ -26,6 +26,7 @@ You may add additional accurate notices of copyright ownership.
 #include "ddl/dd/dd_struct_access.h"
 #include "ddl/dd/dd_validationinfomodel.h"
 
+#include <memory>
 #include <string>
 
 namespace ddl {
@@ -104,6 +105,10 @@ public:
     DataDefinition(Version ddl_version);
     /**
      * @brief Construct a new DataDefinition object and \b copies the datamodel.
+     * The copied datamodel shares the types of a snapshot of the datamodel of \p other, a type is
+     * copied when it is accessed for changes (see @ref datamodel::DataDefinition::shareContentOf).
+     * The snapshot keeps the validation and type infos, so the copy is not validated again.
+     * \p other keeps the snapshot for further copies and copies only the types changed since.
      *
      * @param other The other data definition to copy.
      */
@@ -115,7 +120,7 @@ public:
      */
     DataDefinition(DataDefinition&& other);
     /**
-     * @brief Assigns the DataDefinition object and \b copies the datamodel.
+     * @brief Assigns the DataDefinition object and \b copies the datamodel (see copy CTOR).
      *
      * @param other The other data definition to copy from.
      * @return the resulting data definition.
@@ -144,8 +149,11 @@ public:
      * @brief Sets and references the datamodel object, that is to validate and observe.
      *
      * @param datamodel the datamodel to validate and observe.
+     * @param parallelism the maximum number of threads to use for the validation and calculation
+     * of the struct types, including the calling one (see @ref validate).
      */
-    void setModel(const std::shared_ptr<datamodel::DataDefinition>& datamodel);
+    void setModel(const std::shared_ptr<datamodel::DataDefinition>& datamodel,
+                  size_t parallelism = 1);
     /**
      * @brief Gets the datamodel reference.
      *
@@ -396,10 +404,19 @@ public:
      * validation level yet or is below ValidationLevel::valid
      * @see @ref ValidationServiceInfo, @ref ValidationInfo.
      *
+     * The struct types can be validated on several threads: they are validated in waves, each
+     * wave contains the struct types whose used struct types are already validated. The result is
+     * the same as without parallelism. The waves run on a process wide pool of threads that is
+     * kept for later calls. The parallelism is limited to the number of hardware threads, on a
+     * single core the struct types are validated sequentially. Splitting up the waves only pays
+     * off for large models on several cores, which is why the validation is sequential by
+     * default.
+     *
      * @param force_revalidation if a validation level was already calculated to
      * ValidationLevel::valid this will force a recalculation!
+     * @param parallelism the maximum number of threads to use, including the calling one.
      */
-    void validate(bool force_revalidation = false);
+    void validate(bool force_revalidation = false, size_t parallelism = 1);
     /**
      * @brief Gets a collection of all problems obtained while validating the DataDefinition
      * Objects-
@@ -421,10 +438,14 @@ public:
      * @param type_of_type if type name is empty, this parameter can choose the types to
      * recalculate.
      * @param force_recalculation if set to true this will force the recalculation.
+     * @param parallelism the maximum number of threads to use for the calculation of all struct
+     * types, including the calling one. The struct types are calculated in waves like in @ref
+     * validate.
      */
     void calculatePositions(const std::string& type_name = {},
                             TypeOfType type_of_type = TypeOfType::invalid_type,
-                            bool force_recalculation = false);
+                            bool force_recalculation = false,
+                            size_t parallelism = 1);
     /**
      * @brief Get the Struct Type Access, where to enter the type and calculated element position
      * information.
@@ -539,9 +560,19 @@ public:
     void add(const DataDefinition& source_dd);
 
 private:
+    struct Snapshot;
     std::shared_ptr<datamodel::DataDefinition> _datamodel;
     void attachToModel();
     void detachFromModel();
+    void copyModel(const DataDefinition& other);
+    std::shared_ptr<const datamodel::DataDefinition> takeSnapshot() const;
+    void invalidateSnapshot();
+    ValidationServiceInfo::InvalidatedTypes recordTypeChange(
+        datamodel::ModelEventCode event_code,
+        const datamodel::TypeBase& type,
+        const std::string& additional_info);
+    void resolveSharedTypes(const datamodel::TypeBase& type,
+                            const ValidationServiceInfo::InvalidatedTypes& users);
     void modelChanged(datamodel::ModelEventCode event_code,
                       datamodel::Header& changed_subject,
                       const std::string& additional_info) override;
@@ -572,6 +603,10 @@ private:
 
     Version _last_known_ddl_version;
     ValidationLevel _validation_level = ValidationLevel::dont_know;
+    /// the snapshot for the copies and the types changed since it was taken
+    mutable std::unique_ptr<Snapshot> _snapshot;
+    /// whether the datamodel shares types with a snapshot (see copy CTOR)
+    bool _shares_types = false;
     std::unordered_map<std::string, std::string> _recursion_detection_stream_meta_types;
     std::unordered_map<std::string, std::string> _recursion_detection_struct;
 };
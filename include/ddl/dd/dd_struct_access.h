@@ -409,10 +409,13 @@ public:
      * possible: \li "element_1.sub_2/subsub_3" -> invalid. No mixture of separator possible! \li
      * "element_2[24]"  -> invalid, if the element_2 is no array or arraysize is below 24!
      *
+     * The element found for a path is kept in an index of the struct type, so looking up the same
+     * path again does neither split the path nor walk the struct types.
+     *
      * @param name_path The path to the element.
      * @return StructElementAccess
      */
-    StructElementAccess getElementByPath(const std::string name_path) const;
+    StructElementAccess getElementByPath(const std::string& name_path) const;
     /**
      * @brief The Struct access is a valid access type.
      *
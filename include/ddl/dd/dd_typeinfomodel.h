@@ -24,12 +24,131 @@ You may add additional accurate notices of copyright ownership.
 #include "ddl/datamodel/datamodel_datadefinition.h"
 #include "ddl/dd/dd_infomodel_type.h"
 
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 namespace ddl {
+class DDBinary;
 
 namespace dd {
 
+/**
+ * Index of the elements of a struct type resolved by their path (see @ref
+ * StructTypeAccess::getElementByPath). It is filled on lookup, may be used from several threads
+ * and is cleared whenever the positions of the struct type are updated or the elements of a struct
+ * type are added, removed or renamed. A copy of the index is empty.
+ */
+class ElementPathIndex {
+public:
+    /**
+     * @brief An element resolved by its path.
+     */
+    struct ResolvedElement {
+        /// the element
+        std::shared_ptr<const datamodel::StructType::Element> _element;
+        /// the serialized bit offset of the struct containing the element
+        size_t _serialized_struct_bit_offset;
+        /// the deserialized byte offset of the struct containing the element
+        size_t _deserialized_struct_byte_offset;
+        /// the array position given in the path
+        OptionalSize _array_pos;
+    };
+
+    /**
+     * @brief default CTOR
+     */
+    ElementPathIndex() = default;
+    /**
+     * @brief copy CTOR, creates an empty index.
+     */
+    ElementPathIndex(const ElementPathIndex&);
+    /**
+     * @brief copy assignment operator, clears the index.
+     * @return ElementPathIndex&
+     */
+    ElementPathIndex& operator=(const ElementPathIndex&);
+
+    /**
+     * @brief Finds a resolved element.
+     *
+     * @param name_path the path of the element.
+     * @param resolved_element the resolved element, if found.
+     * @return true the path was resolved before.
+     * @return false the path is unknown.
+     */
+    bool find(const std::string& name_path, ResolvedElement& resolved_element) const;
+    /**
+     * @brief Adds a resolved element.
+     *
+     * @param name_path the path of the element.
+     * @param resolved_element the resolved element.
+     */
+    void add(const std::string& name_path, const ResolvedElement& resolved_element) const;
+    /**
+     * @brief Removes all resolved elements.
+     */
+    void clear() const;
+
+private:
+    mutable std::mutex _mutex;
+    mutable std::unordered_map<std::string, ResolvedElement> _resolved_elements;
+};
+
+/**
+ * Stable 128 bit structural hash of a struct type (see @ref TypeInfo::getLayoutFingerprint and
+ * @ref TypeInfo::getFullFingerprint). It does neither depend on the platform nor on the process.
+ */
+struct TypeFingerprint {
+    /// the upper 64 bit
+    uint64_t _high = 0;
+    /// the lower 64 bit
+    uint64_t _low = 0;
+
+    /**
+     * @brief equality operator.
+     * @param other the other fingerprint
+     * @return true the fingerprints are equal
+     * @return false the fingerprints are not equal
+     */
+    bool operator==(const TypeFingerprint& other) const;
+    /**
+     * @brief non equality operator.
+     * @param other the other fingerprint
+     * @return true the fingerprints are not equal
+     * @return false the fingerprints are equal
+     */
+    bool operator!=(const TypeFingerprint& other) const;
+};
+
+/// A fingerprint which is invalid if it is not available.
+using OptionalTypeFingerprint = utility::Optional<TypeFingerprint>;
+
+/**
+ * For internal use only. @internal The fingerprints of a struct type calculated for a content of
+ * the datamodel (see @ref datamodel::DataDefinition::getChangeId). A copy is empty.
+ */
+class TypeFingerprintCache {
+public:
+    /// Kind of the fingerprint.
+    enum Kind { layout = 0, full = 1 };
+    /// default CTOR
+    TypeFingerprintCache() = default;
+    /// copy CTOR, creates an empty cache.
+    TypeFingerprintCache(const TypeFingerprintCache&);
+    /// copy assignment operator, clears the cache.
+    TypeFingerprintCache& operator=(const TypeFingerprintCache&);
+    /// Finds the fingerprint calculated for the content with the given change id.
+    bool find(Kind kind, uint64_t change_id, OptionalTypeFingerprint& fingerprint) const;
+    /// Keeps the fingerprint calculated for the content with the given change id.
+    void add(Kind kind, uint64_t change_id, const OptionalTypeFingerprint& fingerprint) const;
+
+private:
+    mutable std::mutex _mutex;
+    mutable uint64_t _change_ids[2] = {0, 0};
+    mutable OptionalTypeFingerprint _fingerprints[2];
+};
+
 /**
  * TypeInfo model will check for type.
  * The TypeInfo is needed to:
@@ -61,6 +180,12 @@ public:
      * @param parent_dd the parent DD to retrieve dependencies from
      */
     TypeInfo(const datamodel::EnumType& enum_type, datamodel::DataDefinition& parent_dd);
+    /**
+     * @brief Copies the info for a copy of the item it belongs to.
+     *
+     * @return std::shared_ptr<datamodel::IInfo> the copy
+     */
+    std::shared_ptr<datamodel::IInfo> clone() const override;
 
     /**
      * @brief Get the Type Bit Size
@@ -139,7 +264,47 @@ public:
                 datamodel::DataDefinition& parent_dd,
                 bool recalculate_all = false);
 
+    /**
+     * @brief Get the index of the elements resolved by their path (only used for struct_type).
+     *
+     * @return const ElementPathIndex&
+     */
+    const ElementPathIndex& getElementPathIndex() const;
+
+    /**
+     * @brief Get the layout fingerprint of a struct_type. It covers the positions, sizes,
+     * alignments, data types and byte orders of all elements including the used struct types, but
+     * no names. Struct types with the same layout fingerprint describe the same binary layout (see
+     * @ref DDCompare::isBinaryEqual).
+     * The fingerprint is calculated bottom-up on first use and kept until the datamodel changes.
+     *
+     * @param struct_type the struct_type this info belongs to
+     * @param parent_dd the parent DD
+     * @retval a valid fingerprint
+     * @retval an invalid fingerprint if the struct_type is not valid or uses data types that are
+     *         not predefined (see @ref PredefinedDataTypes).
+     */
+    OptionalTypeFingerprint getLayoutFingerprint(const datamodel::StructType& struct_type,
+                                                 const datamodel::DataDefinition& parent_dd) const;
+    /**
+     * @brief Get the full fingerprint of a struct_type. In addition to the layout it covers all
+     * names, versions, comments, descriptions, units, constant values, visualization attributes
+     * and enum values. Struct types with the same full fingerprint are equal (see @ref
+     * DDCompare::isEqual) whatever is compared.
+     * The fingerprint is calculated bottom-up on first use and kept until the datamodel changes.
+     *
+     * @param struct_type the struct_type this info belongs to
+     * @param parent_dd the parent DD
+     * @retval a valid fingerprint
+     * @retval an invalid fingerprint if the struct_type is not valid.
+     */
+    OptionalTypeFingerprint getFullFingerprint(const datamodel::StructType& struct_type,
+                                               const datamodel::DataDefinition& parent_dd) const;
+
 private:
+    friend class ddl::DDBinary;
+    ElementPathIndex _element_path_index;
+    TypeFingerprintCache _fingerprints;
     size_t _type_bit_size = 0;
     size_t _type_alignment = 0;
     size_t _type_byte_size = 0;
@@ -162,6 +327,12 @@ public:
      *
      */
     static constexpr const uint8_t INFO_TYPE_ID = dd::InfoType::element_type_info;
+    /**
+     * @brief Copies the info for a copy of the item it belongs to.
+     *
+     * @return std::shared_ptr<datamodel::IInfo> the copy
+     */
+    std::shared_ptr<datamodel::IInfo> clone() const override;
 
     /**
      * @brief Get the Deserialized Byte Pos
@@ -299,8 +470,16 @@ public:
                 const std::shared_ptr<datamodel::StructType::Element>& previous_element,
                 const Version& struct_ddl_version,
                 datamodel::DataDefinition& parent_dd);
+    /**
+     * @brief Sets the type references to the types with the same names in \p parent_dd, i.e. in a
+     * copy of the DD the references were resolved in. All other information is kept.
+     *
+     * @param parent_dd the parent DD to retrieve the types from.
+     */
+    void resolveTypes(const datamodel::DataDefinition& parent_dd);
 
 private:
+    friend class ddl::DDBinary;
     OptionalSize _deserialized_byte_pos = {};
     OptionalSize _deserialized_byte_size = {};
     size_t _deserialized_type_byte_size = 0;
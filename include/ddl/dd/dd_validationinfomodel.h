@@ -26,8 +26,10 @@ You may add additional accurate notices of copyright ownership.
 
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace ddl {
+class DDBinary;
 
 namespace dd {
 
@@ -40,6 +42,12 @@ class ValidationServiceInfo : public datamodel::Info<ValidationServiceInfo> {
 public:
     /// definiton of info type to use the @ref datamodel::Info
     static constexpr const uint8_t INFO_TYPE_ID = dd::InfoType::validation_service_info;
+    /**
+     * @brief Copies the info for a copy of the item it belongs to.
+     *
+     * @return std::shared_ptr<datamodel::IInfo> the copy
+     */
+    std::shared_ptr<datamodel::IInfo> clone() const override;
 
     /**
      * @brief dependency type for loose coupling
@@ -124,6 +132,39 @@ public:
      * @param dependency to add.
      */
     void addDependency(const Dependency& dependency);
+
+    /**
+     * @brief Collects the dependencies found by validations on the current thread instead of
+     * adding them to the dependency model, so types can be validated on several threads.
+     * While an instance exists, all validations on its thread add their dependencies to it.
+     * The collected dependencies must be added with @ref addDependency afterwards.
+     */
+    class DependencyCollector {
+    public:
+        /**
+         * @brief CTOR, starts collecting on the current thread.
+         */
+        DependencyCollector();
+        /**
+         * @brief no copy CTOR
+         */
+        DependencyCollector(const DependencyCollector&) = delete;
+        /**
+         * @brief no copy assignment
+         */
+        DependencyCollector& operator=(const DependencyCollector&) = delete;
+        /**
+         * @brief DTOR, stops collecting on the current thread.
+         */
+        ~DependencyCollector();
+        /**
+         * @brief The dependencies collected so far, in the order they were found.
+         */
+        std::vector<Dependency> _dependencies;
+
+    private:
+        DependencyCollector* _previous_collector;
+    };
     /**
      * @brief A base unit was removed.
      *
@@ -278,9 +319,10 @@ public:
     bool validationNeeded() const;
     /**
      * @brief  dependencies are stored in ToFrom maps (not in FromTo maps) to raise performance.
+     * Each item name is stored only once per "to" item, so adding a known dependency is cheap.
      *
      */
-    typedef std::unordered_map<std::string, std::vector<std::string>> ToFromMap;
+    typedef std::unordered_map<std::string, std::unordered_set<std::string>> ToFromMap;
 
     /**
      * @brief Return structure for @ref forceRevalidationOfTypeDependencies call.
@@ -301,14 +343,37 @@ public:
      * @param type_name the type_name looking for dependencies
      * @param type the type of the given \p type_name
      * @param parent_dd the dd where to set forceRevalidation
-     * @return return all typenames depending on the given type
+     * @return return all typenames depending on the given type, each name is contained once.
+     *         The struct type names are ordered so that every struct type follows the struct
+     *         types it uses, updating them in that order never uses an outdated info.
      */
     InvalidatedTypes forceRevalidationOfTypeDependencies(
         const std::string& type_name,
         ddl::dd::TypeOfType type,
         datamodel::DataDefinition& parent_dd) const;
+    /**
+     * Collect all types depending on the given one, directly or by other types. Unlike @ref
+     * forceRevalidationOfTypeDependencies the types are neither accessed nor invalidated.
+     * @param type_name the type_name looking for dependencies
+     * @param type the type of the given \p type_name
+     * @return return all typenames depending on the given type, each name is contained once.
+     */
+    InvalidatedTypes getDependentTypes(const std::string& type_name,
+                                       ddl::dd::TypeOfType type) const;
 
 private:
+    friend class ddl::DDBinary;
+    /// For internal use only. @internal Removes all dependencies of the item \p from.
+    void removeInMapFrom(const std::string& from, DependencyType type);
+    /// For internal use only. @internal Removes and returns all items depending on \p to.
+    std::vector<std::string> removeInMapTo(const std::string& to, DependencyType type);
+    /// For internal use only. @internal Renames the item \p from_old in its dependencies.
+    void renameInMapFrom(const std::string& from_old,
+                         const std::string& from_new,
+                         DependencyType type);
+    /// For internal use only. @internal Copies the dependencies shared with copies of this info
+    /// before they are changed.
+    void changeDependencies();
     /**
      * @brief dependencies are stored in ToFrom maps (not in FromTo maps)
      */
@@ -318,7 +383,13 @@ private:
 #pragma GCC diagnostic ignored "-Wattributes"
 #endif // defined(__GNUC__) && ((__GNUC__ == 5) && (__GNUC_MINOR__ == 2))
 
-    std::unordered_map<uint8_t, ToFromMap> _dependencies;
+    /// The copies of this info share the dependencies until one of them changes them.
+    std::shared_ptr<std::unordered_map<uint8_t, ToFromMap>> _dependencies =
+        std::make_shared<std::unordered_map<uint8_t, ToFromMap>>();
+    /// For internal use only. @internal The same dependencies stored in FromTo maps, so
+    /// removing or renaming the "from" item does not need to search all ToFrom maps.
+    std::shared_ptr<std::unordered_map<uint8_t, ToFromMap>> _dependencies_from =
+        std::make_shared<std::unordered_map<uint8_t, ToFromMap>>();
 
 #if defined(__GNUC__) && ((__GNUC__ == 5) && (__GNUC_MINOR__ == 2))
 #pragma GCC diagnostic pop
@@ -374,6 +445,12 @@ public:
      *
      */
     virtual ~ValidationInfo();
+    /**
+     * @brief Copies the info for a copy of the item it belongs to.
+     *
+     * @return std::shared_ptr<datamodel::IInfo> the copy
+     */
+    std::shared_ptr<datamodel::IInfo> clone() const override;
 
     /**
      * @brief Validation level
@@ -502,6 +579,7 @@ public:
     void update(datamodel::Stream& stream, datamodel::DataDefinition& parent_dd);
 
 private:
+    friend class ddl::DDBinary;
     ValidationLevel _valid = ValidationLevel::invalid;
     bool _currently_on_validation = false; // to prevent recursive validation calls if somebody
                                            // defines this type as a part of the type
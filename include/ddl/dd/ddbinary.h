@@ -0,0 +1,143 @@
+/**
+ * @file
+ * OO DataDefinition binary cache header
+ *
+ * @copyright
+ * @verbatim
+Copyright @ 2021 VW Group. All rights reserved.
+
+    This Source Code Form is subject to the terms of the Mozilla
+    Public License, v. 2.0. If a copy of the MPL was not distributed
+    with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+
+If it is not possible or desirable to put the notice in a particular file, then
+You may include the notice in a location (such as a LICENSE file in a
+relevant directory) where a recipient would be likely to look for such a notice.
+
+You may add additional accurate notices of copyright ownership.
+@endverbatim
+ */
+
+#ifndef DDBINARY_H_INCLUDED
+#define DDBINARY_H_INCLUDED
+
+#include "ddl/dd/dd.h"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ddl {
+namespace detail {
+class BinaryWriter;
+class BinaryReader;
+} // namespace detail
+
+/**
+ * @brief Binary serialization of a validated Data Definition to speed up loading.
+ *
+ * The binary form contains the datamodel together with the validation and type infos (positions
+ * and sizes of all elements) that have been calculated for it, so loading it neither parses XML
+ * nor validates or calculates the positions again.
+ * The data is written in the byte order of the platform and starts with a magic number, the
+ * format version and a hash of the source it was created from. Data with a different format
+ * version, byte order or source hash is rejected as stale.
+ * <br> This implementation can be used as follows:
+ * @code
+ * // loads the cache if it is up to date, otherwise the xml file and rewrites the cache
+ * auto my_dd = DDBinary::fromXMLFileCached("my_description.description",
+ *                                          "my_description.description.bin");
+ * @endcode
+ *
+ * @see @ref DDFile::fromXMLFile
+ */
+class DDBinary {
+public:
+    /// The version of the binary format, data written with another version is stale.
+    static constexpr uint32_t format_version = 1;
+
+    /**
+     * @brief Calculates the hash of a source (i.e. the content of a xml file) to check whether
+     * binary data is up to date.
+     *
+     * @param data the source data.
+     * @param data_size the size of the source data in bytes.
+     * @return uint64_t the 64 bit FNV-1a hash of the data.
+     */
+    static uint64_t hashSource(const void* data, size_t data_size);
+
+    /**
+     * @brief Writes a Data Definition into its binary form.
+     *
+     * @param ddl_to_write the Data Definition, it should be validated (see @ref
+     *                     dd::DataDefinition::validate) to store its infos.
+     * @param source_hash the hash of the source the Data Definition was created from.
+     * @return std::vector<uint8_t> the binary data.
+     */
+    static std::vector<uint8_t> toBinary(const dd::DataDefinition& ddl_to_write,
+                                         uint64_t source_hash);
+
+    /**
+     * @brief Reads a Data Definition from its binary form.
+     *
+     * @param data the binary data, e.g. a memory mapped file.
+     * @param data_size the size of the binary data in bytes.
+     * @param source_hash the expected hash of the source.
+     * @throw ddl::dd::Error if the data is stale (see @ref DDBinary) or corrupt.
+     * @return dd::DataDefinition the Data Definition.
+     */
+    static dd::DataDefinition fromBinary(const void* data, size_t data_size, uint64_t source_hash);
+
+    /**
+     * @brief Writes a Data Definition into a binary file.
+     *
+     * @param ddl_to_write the Data Definition.
+     * @param source_hash the hash of the source the Data Definition was created from.
+     * @param binary_filepath the path of the binary file.
+     * @throw ddl::dd::Error if the file could not be written.
+     */
+    static void toBinaryFile(const dd::DataDefinition& ddl_to_write,
+                             uint64_t source_hash,
+                             const std::string& binary_filepath);
+
+    /**
+     * @brief Reads a Data Definition from a binary file.
+     *
+     * @param binary_filepath the path of the binary file.
+     * @param source_hash the expected hash of the source.
+     * @throw ddl::dd::Error if the file could not be read, is stale or corrupt.
+     * @return dd::DataDefinition the Data Definition.
+     */
+    static dd::DataDefinition fromBinaryFile(const std::string& binary_filepath,
+                                             uint64_t source_hash);
+
+    /**
+     * @brief Reads a Data Definition from a xml file using a binary cache file.
+     *
+     * The cache file is used if it was written for the current content of the xml file.
+     * Otherwise the content which was read and hashed is parsed like @ref DDFile::fromXMLFile
+     * does and the cache file is (re)written, failing to write it is ignored.
+     *
+     * @param xml_filepath a valid filesystem path for loading a DataDefinition xmlfile.
+     * @param cache_filepath the path of the binary cache file.
+     * @param strict set to true to load the datamodel exactly like defined (no mixture of DDL
+     * tag definitions allowed).
+     * @throw ddl::dd::Error if the xml file could not be read or is not valid (see @ref
+     *                       DDFile::fromXMLFile).
+     * @return dd::DataDefinition the valid Data Definiton of the file.
+     */
+    static dd::DataDefinition fromXMLFileCached(const std::string& xml_filepath,
+                                                const std::string& cache_filepath,
+                                                bool strict = false);
+
+private:
+    /// For internal use only. @internal Writes the infos calculated for the datamodel.
+    static void writeInfos(detail::BinaryWriter& writer,
+                           const dd::datamodel::DataDefinition& ddl_model);
+    /// For internal use only. @internal Restores the infos calculated for the datamodel.
+    static void readInfos(detail::BinaryReader& reader, dd::datamodel::DataDefinition& ddl_model);
+};
+
+} // namespace ddl
+
+#endif // DDBINARY_H_INCLUDED
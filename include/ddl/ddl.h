@@ -71,6 +71,7 @@ namespace rt {
 #include "datamodel/datamodel_datadefinition.h"
 // access and creating API
 #include "dd/dd.h"
+#include "dd/ddbinary.h"
 #include "dd/ddcompare.h"
 #include "dd/ddfile.h"
 #include "dd/ddstring.h"
@@ -84,7 +84,8 @@ public:
                                   SourceMap& sources);
 
     /**
-     * Reset target Buffers
+     * Reset target Buffers to the default values and constants, which are rendered once on
+     * creation
      * @param[in] map_config - The Configuration instance
      * @return error code
      */
@@ -157,6 +158,7 @@ private:
     uint64_t _counter;
     a_util::memory::unique_ptr<ddl::StaticCodec> _codec;
     MemoryBuffer _buffer;
+    MemoryBuffer _reset_buffer;
     mutable a_util::concurrency::shared_mutex _buffer_mutex;
     IMappingEnvironment& _env;
     ///@endcond nodoc
@@ -55,17 +55,47 @@ a_util::result::Result transform(const DECODER& decoder, ENCODER& encoder)
     return a_util::result::SUCCESS;
 }
 
+/**
+ * Copies all elements from a static decoder to a static codec.
+ * If both have been created by the same factory for opposite data representations, the
+ * precomputed transformation plan is used, which copies byte aligned elements in blocks and
+ * converts arrays with a foreign byte order in bulk. Otherwise the elements are copied one by one.
+ * @param[in] decoder The source decoder.
+ * @param[out] encoder The destination codec.
+ * @return Standard result.
+ */
+a_util::result::Result transform(const StaticDecoder& decoder, StaticCodec& encoder);
+
+/**
+ * Copies all elements from a decoder to a codec.
+ * If the codec has been created by the decoder for the opposite data representation, the
+ * precomputed transformation plan is used, which copies byte aligned elements in blocks and
+ * converts arrays with a foreign byte order in bulk. Otherwise the elements are copied one by one.
+ * @param[in] decoder The source decoder.
+ * @param[out] encoder The destination codec.
+ * @return Standard result.
+ */
+a_util::result::Result transform(const Decoder& decoder, Codec& encoder);
+
 /**
  * Tranforms the data from a given decoder into the opposite data representation.
  * Allocates the buffer accordingly.
+ * Uses a transformation plan precomputed per struct layout, which copies adjacent byte aligned
+ * elements in blocks and only falls back to element wise copies for bit-packed elements.
+ * Large samples can be transformed on several threads, each of them writing a separate byte range
+ * of the buffer. Samples of less than 128 KiB are always transformed on the calling thread.
+ * The threads are kept in a process wide pool and reused by later calls, their number is limited
+ * by the number of hardware threads.
  * @param[in] decoder The source decoder.
  * @param[out] buffer The destination buffer object.
  * @param[in] zero Whether or not to memzero the buffer before writing the elements to it.
+ * @param[in] parallelism The maximum number of threads to use, including the calling one.
  * @return Standard result.
  */
 a_util::result::Result transformToBuffer(const Decoder& decoder,
                                          a_util::memory::MemoryBuffer& buffer,
-                                         bool zero = false);
+                                         bool zero = false,
+                                         size_t parallelism = 1);
 
 } // namespace serialization
 
@@ -68,7 +68,9 @@ template <typename T>
 using TypeAccessMapObserver = ModelObserverUtility<T, TypeAccessMapEventCode>;
 
 /**
- * @brief Utility class for observable named items where the order is NOT important
+ * @brief Utility class for observable named items where the order is NOT important.
+ * The map may share items with other maps (see @ref shareItemsOf), which are copied before they
+ * are handed out for changes.
  *
  * @tparam DDL_TYPE_TO_ACCESS the value type
  * @tparam TYPE_VALIDATOR_CLASS the validator class to inform on changes
@@ -96,6 +98,8 @@ public:
     typedef typename parent_type::event_code_type event_code_type;
     /// local definition of the subject type
     typedef typename parent_type::subject_type subject_type;
+    /// local definition of the function to copy a shared item before it is changed
+    typedef value_type (*copy_function_type)(const DDL_TYPE_TO_ACCESS&);
     /// friend validator class
     friend TYPE_VALIDATOR_CLASS;
 
@@ -140,14 +144,18 @@ public:
         clear();
         _validation_info = std::move(other._validation_info);
         _types = std::move(other._types);
+        _copy_shared_item = other._copy_shared_item;
+        _has_shared_items = other._has_shared_items;
         // the other will remove itself as observer with clear
         for (const auto& current: _types) {
-            // the other will not observe this anymore
-            (static_cast<map_subject_type*>(current.second.get()))
-                ->detachObserver(static_cast<observer_type*>(&other));
-            // i want to observe this
-            (static_cast<map_subject_type*>(current.second.get()))
-                ->attachObserver(static_cast<observer_type*>(this));
+            auto subject = static_cast<map_subject_type*>(current.second.get());
+            // shared items are not observed
+            if (subject->isObservedBy(static_cast<observer_type*>(&other))) {
+                // the other will not observe this anymore
+                subject->detachObserver(static_cast<observer_type*>(&other));
+                // i want to observe this
+                subject->attachObserver(static_cast<observer_type*>(this));
+            }
         }
         _validator = nullptr;
         return *this;
@@ -333,6 +341,49 @@ public:
                 TypeAccessMapEventCode::map_item_added, *new_type_value, new_type_value->getName());
         }
     }
+    /**
+     * @brief shares the items of the \p other map instead of copying them. The items are not
+     * observed until they are accessed for changes (see @ref access), then a copy replaces them.
+     * The current content is cleared.
+     *
+     * @param other the map to share the items of, these must not be changed anymore.
+     * @param copy_shared_item the function to copy a shared item when it is accessed for changes.
+     */
+    void shareItemsOf(const TypeAccessMap& other, copy_function_type copy_shared_item)
+    {
+        clear();
+        // copying the container at once is faster than adding the items one by one
+        _types = other._types;
+        _copy_shared_item = copy_shared_item;
+        _has_shared_items = !_types.empty();
+    }
+    /**
+     * @brief adds the given item, which is shared with other maps, without validation.
+     * The item is not observed until it is accessed for changes (see @ref shareItemsOf).
+     *
+     * @param shared_item the item to share, it must not be changed anymore.
+     * @param copy_shared_item the function to copy a shared item when it is accessed for changes.
+     */
+    void addShared(const std::shared_ptr<const DDL_TYPE_TO_ACCESS>& shared_item,
+                   copy_function_type copy_shared_item)
+    {
+        // a shared item is handed out for changes only after it is copied
+        _types[shared_item->getName()] = std::const_pointer_cast<DDL_TYPE_TO_ACCESS>(shared_item);
+        _copy_shared_item = copy_shared_item;
+        _has_shared_items = true;
+    }
+    /**
+     * @brief determines if the item with the given name \p type_name is shared with other maps.
+     *
+     * @param type_name the item name
+     * @return true the item is shared and not copied for changes yet
+     * @return false the item is not shared or does not exist
+     */
+    bool isShared(const std::string& type_name) const
+    {
+        auto it_find = _types.find(type_name);
+        return it_find != _types.cend() && !isOwned(it_find->second);
+    }
     /**
      * @brief item to remove
      *
@@ -355,7 +406,7 @@ public:
             _validation_info + "::remove", {type_name}, "value with the given name does not exist");
     }
     /**
-     * @brief change access to an item
+     * @brief change access to an item, a shared item is copied before (see @ref shareItemsOf).
      *
      * @param type_name the item name
      * @return std::shared_ptr<DDL_TYPE_TO_ACCESS>
@@ -364,6 +415,9 @@ public:
     {
         auto it_find = _types.find(type_name);
         if (it_find != _types.end()) {
+            if (_has_shared_items && !isOwned(it_find->second)) {
+                unshare(it_find->second);
+            }
             return it_find->second;
         }
         return {};
@@ -378,12 +432,21 @@ public:
         return _types.size();
     }
     /**
-     * @brief the range based begin iterator
+     * @brief the range based begin iterator, the items are accessible for changes, so the shared
+     * items are copied before (see @ref shareItemsOf). Use the const access to read only.
      *
      * @return iterator
      */
     iterator begin()
     {
+        if (_has_shared_items) {
+            for (auto& current: _types) {
+                if (!isOwned(current.second)) {
+                    unshare(current.second);
+                }
+            }
+            _has_shared_items = false;
+        }
         return _types.begin();
     }
     /**
@@ -464,14 +527,15 @@ public:
      */
     void clear()
     {
-        auto it = begin();
-        while (it != end()) {
+        auto it = _types.begin();
+        while (it != _types.end()) {
             // unregister me as observer
             (static_cast<map_subject_type*>(it->second.get()))
                 ->detachObserver(static_cast<observer_type*>(this));
             _types.erase(it);
-            it = begin();
+            it = _types.begin();
         }
+        _has_shared_items = false;
     }
 
 public:
@@ -528,9 +592,28 @@ private:
         destination = *this;
         destination._validator = validator;
     }
+
+    bool isOwned(const value_type& item) const
+    {
+        // only the owning map observes an item
+        return static_cast<const map_subject_type*>(item.get())
+            ->isObservedBy(static_cast<const observer_type*>(this));
+    }
+
+    void unshare(value_type& shared_item)
+    {
+        auto copied_item = _copy_shared_item(*shared_item);
+        // i want to observe this
+        (static_cast<map_subject_type*>(copied_item.get()))
+            ->attachObserver(static_cast<observer_type*>(this));
+        shared_item = copied_item;
+    }
+
     container_type _types;
     TYPE_VALIDATOR_CLASS* _validator;
     std::string _validation_info;
+    copy_function_type _copy_shared_item = nullptr;
+    bool _has_shared_items = false;
 };
 
 } // namespace utility
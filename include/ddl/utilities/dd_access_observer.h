@@ -138,6 +138,22 @@ public:
             }
         }
     }
+    /**
+     * @brief determines if the observer is notified.
+     *
+     * @param observer the observer instance
+     * @return true the observer is in list
+     * @return false the observer is not in list
+     */
+    bool isObservedBy(const observer_type* observer) const
+    {
+        for (const auto& current: _observers) {
+            if (current == observer) {
+                return true;
+            }
+        }
+        return false;
+    }
 
 protected:
     /**
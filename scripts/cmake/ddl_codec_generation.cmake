@@ -0,0 +1,40 @@
+# Copyright @ 2021 VW Group. All rights reserved.
+#
+#     This Source Code Form is subject to the terms of the Mozilla
+#     Public License, v. 2.0. If a copy of the MPL was not distributed
+#     with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+#
+# If it is not possible or desirable to put the notice in a particular file, then
+# You may include the notice in a location (such as a LICENSE file in a
+# relevant directory) where a recipient would be likely to look for such a notice.
+#
+# You may add additional accurate notices of copyright ownership.
+
+if(NOT TARGET ddlcodegen)
+    add_executable(ddlcodegen IMPORTED)
+    set_target_properties(ddlcodegen PROPERTIES
+        IMPORTED_LOCATION ${dev_essential_DIR}/../../../bin/ddlcodegen
+    )
+endif(NOT TARGET ddlcodegen)
+
+# Generates the compile-time codecs of a description file into a header. Every target listing the
+# header as source is regenerated whenever the description file changes.
+#   DESCRIPTION_FILE: the description file
+#   HEADER_FILE: the generated header
+#   NAMESPACE: the namespace of the generated structs
+#   optional further arguments: the struct types to generate, all struct types if omitted
+macro(ddl_generate_codec DESCRIPTION_FILE HEADER_FILE NAMESPACE)
+    message(STATUS "will generate ddl codecs to ${HEADER_FILE}")
+    set(_ddl_codec_struct_args)
+    foreach(_ddl_codec_struct ${ARGN})
+        list(APPEND _ddl_codec_struct_args --struct=${_ddl_codec_struct})
+    endforeach()
+    add_custom_command(OUTPUT ${HEADER_FILE}
+                       COMMAND ddlcodegen --description=${DESCRIPTION_FILE}
+                                          --output=${HEADER_FILE}
+                                          --namespace=${NAMESPACE}
+                                          ${_ddl_codec_struct_args}
+                       DEPENDS ${DESCRIPTION_FILE} ddlcodegen
+                       WORKING_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}
+                       COMMENT "generating ddl codecs ${HEADER_FILE}")
+endmacro(ddl_generate_codec)
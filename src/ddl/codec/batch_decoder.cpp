@@ -0,0 +1,216 @@
+/**
+ * @file
+ * Implementation of the batch decoder.
+ *
+ * Copyright @ 2021 VW Group. All rights reserved.
+ *
+ *     This Source Code Form is subject to the terms of the Mozilla
+ *     Public License, v. 2.0. If a copy of the MPL was not distributed
+ *     with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * If it is not possible or desirable to put the notice in a particular file, then
+ * You may include the notice in a location (such as a LICENSE file in a
+ * relevant directory) where a recipient would be likely to look for such a notice.
+ *
+ * You may add additional accurate notices of copyright ownership.
+ */
+
+#include "ddl/codec/batch_decoder.h"
+
+#include "a_util/result/error_def.h"
+#include "ddl/codec/bitserializer.h"
+#include "ddl/legacy_error_macros.h"
+#include "element_accessor.h"
+#include "struct_layout.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ddl {
+// define all needed error types and values locally
+_MAKE_RESULT(-4, ERR_POINTER);
+_MAKE_RESULT(-5, ERR_INVALID_ARG);
+_MAKE_RESULT(-19, ERR_NOT_SUPPORTED);
+_MAKE_RESULT(-37, ERR_NOT_INITIALIZED);
+
+namespace {
+template <size_t size>
+inline void copyValue(const uint8_t* source, uint8_t* destination, bool swap_bytes)
+{
+    typedef typename a_util::memory::detail::ByteSwap<size>::type Value;
+    Value value;
+    std::memcpy(&value, source, size);
+    if (swap_bytes) {
+        value = a_util::memory::detail::ByteSwap<size>::swap(value);
+    }
+    std::memcpy(destination, &value, size);
+}
+
+} // namespace
+
+BatchDecoder::BatchDecoder()
+    : _representation(deserialized), _sample_size(0), _result(ERR_NOT_INITIALIZED)
+{
+}
+
+BatchDecoder::BatchDecoder(const CodecFactory& factory,
+                           const std::vector<std::string>& element_names,
+                           DataRepresentation rep)
+    : _layout(factory._layout), _representation(rep), _sample_size(0), _result(factory.isValid())
+{
+    for (const auto& element_name: element_names) {
+        if (a_util::result::isFailed(_result)) {
+            break;
+        }
+
+        size_t element_index = 0;
+        _result = factory.findElementIndex(element_name, element_index);
+        if (a_util::result::isFailed(_result)) {
+            break;
+        }
+
+        const StructLayoutElement& element = _layout->getStaticElements()[element_index];
+        const Position& position = rep == deserialized ? element.deserialized : element.serialized;
+        Column column;
+        column.element = &element;
+        column.byte_offset = position.bit_offset / 8;
+        column.type_size = element.deserialized.bit_size / 8;
+        column.byte_aligned =
+            position.bit_offset % 8 == 0 && position.bit_size == element.deserialized.bit_size;
+        column.swap_bytes = rep == serialized && column.type_size > 1 &&
+                            a_util::memory::detail::needsByteSwap(
+                                static_cast<a_util::memory::Endianess>(element.byte_order));
+        if (column.type_size != 1 && column.type_size != 2 && column.type_size != 4 &&
+            column.type_size != 8) {
+            _result = ERR_NOT_SUPPORTED;
+            break;
+        }
+
+        _sample_size = std::max(_sample_size, (position.bit_offset + position.bit_size + 7) / 8);
+        _columns.push_back(column);
+    }
+
+    if (a_util::result::isFailed(_result)) {
+        _columns.clear();
+    }
+}
+
+a_util::result::Result BatchDecoder::isValid() const
+{
+    return _result;
+}
+
+size_t BatchDecoder::getColumnCount() const
+{
+    return _columns.size();
+}
+
+a_util::variant::VariantType BatchDecoder::getColumnType(size_t column) const
+{
+    return _columns[column].element->type;
+}
+
+size_t BatchDecoder::getColumnTypeSize(size_t column) const
+{
+    return _columns[column].type_size;
+}
+
+size_t BatchDecoder::getSampleSize() const
+{
+    return _sample_size;
+}
+
+a_util::result::Result BatchDecoder::decode(const void* samples,
+                                            size_t sample_count,
+                                            size_t sample_stride,
+                                            const std::vector<void*>& columns) const
+{
+    RETURN_IF_FAILED(checkColumns(columns));
+    if (sample_count == 0) {
+        return a_util::result::SUCCESS;
+    }
+    if (!samples) {
+        return ERR_POINTER;
+    }
+    if (sample_stride < _sample_size) {
+        return ERR_INVALID_ARG;
+    }
+
+    const uint8_t* sample = static_cast<const uint8_t*>(samples);
+    for (size_t sample_index = 0; sample_index < sample_count; ++sample_index) {
+        RETURN_IF_FAILED(decodeSample(sample, sample_stride, sample_index, columns));
+        sample += sample_stride;
+    }
+
+    return a_util::result::SUCCESS;
+}
+
+a_util::result::Result BatchDecoder::decode(const std::vector<const void*>& samples,
+                                            size_t sample_size,
+                                            const std::vector<void*>& columns) const
+{
+    RETURN_IF_FAILED(checkColumns(columns));
+    if (sample_size < _sample_size) {
+        return ERR_INVALID_ARG;
+    }
+
+    for (size_t sample_index = 0; sample_index < samples.size(); ++sample_index) {
+        if (!samples[sample_index]) {
+            return ERR_POINTER;
+        }
+        RETURN_IF_FAILED(decodeSample(samples[sample_index], sample_size, sample_index, columns));
+    }
+
+    return a_util::result::SUCCESS;
+}
+
+a_util::result::Result BatchDecoder::checkColumns(const std::vector<void*>& columns) const
+{
+    RETURN_IF_FAILED(_result);
+    if (columns.size() != _columns.size()) {
+        return ERR_INVALID_ARG;
+    }
+    if (std::find(columns.begin(), columns.end(), nullptr) != columns.end()) {
+        return ERR_POINTER;
+    }
+
+    return a_util::result::SUCCESS;
+}
+
+a_util::result::Result BatchDecoder::decodeSample(const void* sample,
+                                                  size_t sample_size,
+                                                  size_t sample_index,
+                                                  const std::vector<void*>& columns) const
+{
+    const uint8_t* sample_bytes = static_cast<const uint8_t*>(sample);
+    for (size_t column_index = 0; column_index < _columns.size(); ++column_index) {
+        const Column& column = _columns[column_index];
+        uint8_t* destination =
+            static_cast<uint8_t*>(columns[column_index]) + sample_index * column.type_size;
+        if (!column.byte_aligned) {
+            RETURN_IF_FAILED(SerializedAccessor::getInstance().getValue(
+                *column.element, sample, sample_size, destination));
+            continue;
+        }
+
+        const uint8_t* source = sample_bytes + column.byte_offset;
+        switch (column.type_size) {
+        case 1:
+            *destination = *source;
+            break;
+        case 2:
+            copyValue<2>(source, destination, column.swap_bytes);
+            break;
+        case 4:
+            copyValue<4>(source, destination, column.swap_bytes);
+            break;
+        default:
+            copyValue<8>(source, destination, column.swap_bytes);
+            break;
+        }
+    }
+
+    return a_util::result::SUCCESS;
+}
+
+} // namespace ddl
@@ -0,0 +1,181 @@
+/**
+ * @file
+ * Implementation of the bulk byte order conversion.
+ *
+ * Copyright @ 2021 VW Group. All rights reserved.
+ *
+ *     This Source Code Form is subject to the terms of the Mozilla
+ *     Public License, v. 2.0. If a copy of the MPL was not distributed
+ *     with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * If it is not possible or desirable to put the notice in a particular file, then
+ * You may include the notice in a location (such as a LICENSE file in a
+ * relevant directory) where a recipient would be likely to look for such a notice.
+ *
+ * You may add additional accurate notices of copyright ownership.
+ */
+
+#include "byte_swap.h"
+
+#include "ddl/codec/bitserializer.h"
+
+#include <assert.h>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define DDL_BYTE_SWAP_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+// MSVC allows all intrinsics without enabling the instruction set for the whole file
+#define DDL_TARGET_SSSE3
+#define DDL_TARGET_AVX2
+#else
+#define DDL_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define DDL_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace ddl {
+namespace {
+template <size_t size>
+void swapScalar(const uint8_t* source, uint8_t* destination, size_t count)
+{
+    typedef typename a_util::memory::detail::ByteSwap<size>::type Item;
+    for (size_t index = 0; index < count; ++index, source += size, destination += size) {
+        Item item;
+        std::memcpy(&item, source, size);
+        item = a_util::memory::detail::ByteSwap<size>::swap(item);
+        std::memcpy(destination, &item, size);
+    }
+}
+
+void swapScalar(const uint8_t* source, uint8_t* destination, size_t item_size, size_t count)
+{
+    switch (item_size) {
+    case 2:
+        swapScalar<2>(source, destination, count);
+        break;
+    case 4:
+        swapScalar<4>(source, destination, count);
+        break;
+    default:
+        swapScalar<8>(source, destination, count);
+        break;
+    }
+}
+
+#ifdef DDL_BYTE_SWAP_X86
+/// Shuffle masks reversing the bytes of each 2, 4 or 8 byte item, repeated for both AVX2 lanes.
+alignas(32) const uint8_t shuffle_masks[3][32] = {
+    {1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+     1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14},
+    {3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+     3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12},
+    {7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+     7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8}};
+
+const uint8_t* getShuffleMask(size_t item_size)
+{
+    return shuffle_masks[item_size == 2 ? 0 : item_size == 4 ? 1 : 2];
+}
+
+/// @return The number of bytes that have been swapped, always a multiple of the item size.
+DDL_TARGET_SSSE3 size_t swapSsse3(const uint8_t* source,
+                                  uint8_t* destination,
+                                  size_t item_size,
+                                  size_t byte_count)
+{
+    const __m128i mask =
+        _mm_load_si128(reinterpret_cast<const __m128i*>(getShuffleMask(item_size)));
+    size_t offset = 0;
+    for (; offset + 16 <= byte_count; offset += 16) {
+        const __m128i items = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + offset));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + offset),
+                         _mm_shuffle_epi8(items, mask));
+    }
+    return offset;
+}
+
+/// @return The number of bytes that have been swapped, always a multiple of the item size.
+DDL_TARGET_AVX2 size_t swapAvx2(const uint8_t* source,
+                                uint8_t* destination,
+                                size_t item_size,
+                                size_t byte_count)
+{
+    const __m256i mask =
+        _mm256_load_si256(reinterpret_cast<const __m256i*>(getShuffleMask(item_size)));
+    size_t offset = 0;
+    for (; offset + 64 <= byte_count; offset += 64) {
+        const __m256i first =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + offset));
+        const __m256i second =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + offset + 32));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + offset),
+                            _mm256_shuffle_epi8(first, mask));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + offset + 32),
+                            _mm256_shuffle_epi8(second, mask));
+    }
+    for (; offset + 32 <= byte_count; offset += 32) {
+        const __m256i items =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + offset));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + offset),
+                            _mm256_shuffle_epi8(items, mask));
+    }
+    return offset;
+}
+
+enum class Kernel { scalar, ssse3, avx2 };
+
+Kernel detectKernel()
+{
+#ifdef _MSC_VER
+    int info[4] = {};
+    __cpuid(info, 0);
+    const int max_leaf = info[0];
+    __cpuid(info, 1);
+    const bool ssse3 = (info[2] & (1 << 9)) != 0;
+    const bool os_saves_avx = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    bool avx2 = false;
+    if (max_leaf >= 7 && os_saves_avx) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    const bool ssse3 = __builtin_cpu_supports("ssse3");
+    const bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+    return avx2 ? Kernel::avx2 : ssse3 ? Kernel::ssse3 : Kernel::scalar;
+}
+#endif
+
+} // namespace
+
+void swapByteOrder(const void* source, void* destination, size_t item_size, size_t item_count)
+{
+    assert(item_size == 2 || item_size == 4 || item_size == 8);
+    const uint8_t* source_bytes = static_cast<const uint8_t*>(source);
+    uint8_t* destination_bytes = static_cast<uint8_t*>(destination);
+    size_t swapped = 0;
+
+#ifdef DDL_BYTE_SWAP_X86
+    static const Kernel kernel = detectKernel();
+    const size_t byte_count = item_size * item_count;
+    if (kernel == Kernel::avx2) {
+        swapped = swapAvx2(source_bytes, destination_bytes, item_size, byte_count);
+    }
+    if (kernel != Kernel::scalar) {
+        swapped += swapSsse3(
+            source_bytes + swapped, destination_bytes + swapped, item_size, byte_count - swapped);
+    }
+#endif
+
+    swapScalar(source_bytes + swapped,
+               destination_bytes + swapped,
+               item_size,
+               item_count - swapped / item_size);
+}
+
+} // namespace ddl
@@ -0,0 +1,37 @@
+/**
+ * @file
+ * Bulk byte order conversion of arrays.
+ *
+ * Copyright @ 2021 VW Group. All rights reserved.
+ *
+ *     This Source Code Form is subject to the terms of the Mozilla
+ *     Public License, v. 2.0. If a copy of the MPL was not distributed
+ *     with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * If it is not possible or desirable to put the notice in a particular file, then
+ * You may include the notice in a location (such as a LICENSE file in a
+ * relevant directory) where a recipient would be likely to look for such a notice.
+ *
+ * You may add additional accurate notices of copyright ownership.
+ */
+
+#ifndef DDL_BYTE_SWAP_HEADER
+#define DDL_BYTE_SWAP_HEADER
+
+#include <cstddef>
+
+namespace ddl {
+/**
+ * @internal
+ * Reverses the byte order of each item of an array. Uses AVX2 or SSSE3 kernels if the CPU
+ * supports them and a scalar loop otherwise.
+ * @param[in] source The source items.
+ * @param[out] destination The destination items, either equal to @p source or not overlapping.
+ * @param[in] item_size The size of a single item, must be 2, 4 or 8.
+ * @param[in] item_count The number of items.
+ */
+void swapByteOrder(const void* source, void* destination, size_t item_size, size_t item_count);
+
+} // namespace ddl
+
+#endif
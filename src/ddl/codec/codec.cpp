@@ -22,50 +22,99 @@
 #include "ddl/codec/access_element.h"
 #include "ddl/codec/static_codec.h"
 #include "ddl/legacy_error_macros.h"
+#include "dynamic_layout.h"
 #include "element_accessor.h"
 #include "struct_layout.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace ddl {
 // define all needed error types and values locally
 _MAKE_RESULT(-5, ERR_INVALID_ARG);
 _MAKE_RESULT(-10, ERR_INVALID_INDEX);
+_MAKE_RESULT(-12, ERR_MEMORY);
+_MAKE_RESULT(-19, ERR_NOT_SUPPORTED);
+_MAKE_RESULT(-20, ERR_NOT_FOUND);
 
-static inline void BitToBytes(size_t& size)
+namespace {
+/// Whether an array size can be stored in the given element.
+bool isArraySizeInRange(const StructLayoutElement& oElement, DataRepresentation eRep, size_t nSize)
 {
-    if (size % 8) {
-        size = size / 8 + 1;
-    }
-    else {
-        size /= 8;
+    const size_t nBitSize =
+        eRep == deserialized ? oElement.deserialized.bit_size : oElement.serialized.bit_size;
+    switch (oElement.type) {
+    case a_util::variant::VT_Float:
+    case a_util::variant::VT_Double:
+        return true;
+    case a_util::variant::VT_Bool:
+        return nSize <= 1;
+    case a_util::variant::VT_Int8:
+    case a_util::variant::VT_Int16:
+    case a_util::variant::VT_Int32:
+    case a_util::variant::VT_Int64:
+        return nBitSize > 64 || (nSize >> (nBitSize - 1)) == 0;
+    default:
+        return nBitSize >= 64 || (nSize >> nBitSize) == 0;
     }
 }
 
+size_t getOffset(const StructLayoutElement& oElement, DataRepresentation eRep)
+{
+    return eRep == deserialized ? oElement.deserialized.bit_offset :
+                                  oElement.serialized.bit_offset;
+}
+
+size_t getOffset(const Offsets& oOffsets, DataRepresentation eRep)
+{
+    return eRep == deserialized ? oOffsets.deserialized : oOffsets.serialized;
+}
+
+} // namespace
+
+/// The dynamic layout of a decoder, which does not change once it is published.
+struct DynamicLayoutState {
+    a_util::memory::shared_ptr<const DynamicLayout> layout;
+    /// The dynamic elements selected by a projection, missing ones are null.
+    std::vector<const StructLayoutElement*> projected_elements;
+};
+
 Decoder::Decoder(const Decoder& oDecoder,
                  const void* pData,
                  size_t nDataSize,
                  DataRepresentation eRep)
     : StaticDecoder(oDecoder._layout, pData, nDataSize, eRep),
-      _dynamic_elements(oDecoder._dynamic_elements),
-      _buffer_sizes(oDecoder._buffer_sizes)
+      _dynamic_layouts(oDecoder._dynamic_layouts)
+{
+    oDecoder.getDynamicLayout();
+    _dynamic_state = std::atomic_load(&oDecoder._dynamic_state);
+    _dynamic_state_ptr = _dynamic_state.get();
+}
+
+Decoder::Decoder(Decoder&& oDecoder)
+    : StaticDecoder(std::move(oDecoder)),
+      _dynamic_layouts(std::move(oDecoder._dynamic_layouts)),
+      _dynamic_state(std::move(oDecoder._dynamic_state)),
+      _dynamic_state_ptr(oDecoder._dynamic_state_ptr.exchange(nullptr))
 {
 }
 
+Decoder& Decoder::operator=(Decoder&& oDecoder)
+{
+    StaticDecoder::operator=(std::move(oDecoder));
+    _dynamic_layouts = std::move(oDecoder._dynamic_layouts);
+    _dynamic_state = std::move(oDecoder._dynamic_state);
+    _dynamic_state_ptr = oDecoder._dynamic_state_ptr.exchange(nullptr);
+    return *this;
+}
+
 Decoder::Decoder(a_util::memory::shared_ptr<const StructLayout> pLayout,
+                 a_util::memory::shared_ptr<DynamicLayoutCache> pDynamicLayouts,
                  const void* pData,
                  size_t nDataSize,
                  DataRepresentation eRep)
-    : StaticDecoder(pLayout, pData, nDataSize, eRep),
-      _buffer_sizes(pLayout->getStaticBufferBitSizes())
+    : StaticDecoder(pLayout, pData, nDataSize, eRep), _dynamic_layouts(pDynamicLayouts)
 {
-    if (_layout->hasDynamicElements()) {
-        a_util::result::Result oResult = calculateDynamicElements();
-        if (isFailed(oResult)) {
-            LOG_ERROR("Failed to calculate dynamic elements");
-        }
-    }
-
-    BitToBytes(_buffer_sizes.deserialized);
-    BitToBytes(_buffer_sizes.serialized);
 }
 
 a_util::result::Result Decoder::isValid() const
@@ -78,158 +127,132 @@ a_util::result::Result Decoder::isValid() const
     return a_util::result::SUCCESS;
 }
 
-a_util::result::Result Decoder::calculateDynamicElements()
+const DynamicLayout* Decoder::getDynamicLayout() const
 {
-    _dynamic_elements.reset(new std::vector<StructLayoutElement>());
-
-    for (std::vector<DynamicStructLayoutElement>::const_iterator itDynamicElement =
-             _layout->getDynamicElements().begin();
-         itDynamicElement != _layout->getDynamicElements().end();
-         ++itDynamicElement) {
-        RETURN_IF_FAILED(addDynamicElements(*itDynamicElement, _buffer_sizes, ""));
+    const DynamicLayoutState* pState = _dynamic_state_ptr.load(std::memory_order_acquire);
+    if (pState) {
+        return pState->layout.get();
     }
-
-    return a_util::result::SUCCESS;
-}
-
-void Decoder::moveToAlignment(size_t& bit_offset, size_t alignment)
-{
-    size_t nBitRest = bit_offset % 8;
-    if (nBitRest) {
-        bit_offset += 8 - nBitRest;
+    if (!_layout->hasDynamicElements()) {
+        return NULL;
     }
 
-    size_t nByteOffset = bit_offset / 8;
-    size_t nRest = nByteOffset % alignment;
-    if (nRest) {
-        bit_offset += (alignment - nRest) * 8;
+    const auto pCalculated = std::make_shared<DynamicLayoutState>();
+    if (_dynamic_layouts) {
+        pCalculated->layout = _dynamic_layouts->getLayout(_data, _data_size, getRepresentation());
     }
-}
-
-a_util::result::Result Decoder::addDynamicElements(
-    const DynamicStructLayoutElement& sDynamicElement,
-    Offsets& sOverallOffsets,
-    const std::string& strPrefix)
-{
-    moveToAlignment(sOverallOffsets.deserialized, sDynamicElement.alignment);
-
-    if (sDynamicElement.isAlignmentElement()) {
-        return a_util::result::SUCCESS;
+    else {
+        pCalculated->layout = std::make_shared<const DynamicLayout>(
+            *_layout, _data, _data_size, getRepresentation());
     }
 
-    a_util::variant::Variant oArraySize((uint64_t)1);
-    bool bIsArray = sDynamicElement.isDynamicArray();
-    if (bIsArray) {
-        oArraySize = access_element::getValue(*this, strPrefix + sDynamicElement.size_element_name);
+    const StructLayout* pSource = _layout->getSource();
+    if (pSource) {
+        // the dynamic layout contains the elements of the full layout, missing ones stay null
+        const std::vector<std::string>& oNames = _layout->getProjectedDynamicNames();
+        const size_t nSourceStaticCount = pSource->getStaticElements().size();
+        pCalculated->projected_elements.resize(oNames.size(), NULL);
+        for (size_t nName = 0; nName < oNames.size(); ++nName) {
+            size_t nSourceIndex = 0;
+            if (pCalculated->layout->getElementIndex().find(oNames[nName], nSourceIndex) &&
+                nSourceIndex >= nSourceStaticCount) {
+                pCalculated->projected_elements[nName] =
+                    &pCalculated->layout->getNamedElements()[nSourceIndex - nSourceStaticCount];
+            }
+        }
     }
-    size_t nArraySize = static_cast<size_t>(oArraySize.asUInt64());
 
-    for (size_t nArrayIndex = 0; nArrayIndex < nArraySize; ++nArrayIndex) {
-        RETURN_IF_FAILED(
-            addDynamicElement(sDynamicElement,
-                              bIsArray ? a_util::strings::format("[%d]", nArrayIndex) : "",
-                              sOverallOffsets,
-                              strPrefix));
+    // threads reading the same decoder calculate the same layout, the first one is kept
+    a_util::memory::shared_ptr<const DynamicLayoutState> pExpected;
+    a_util::memory::shared_ptr<const DynamicLayoutState> pPublished = pCalculated;
+    if (std::atomic_compare_exchange_strong(&_dynamic_state, &pExpected, pPublished)) {
+        if (isFailed(pPublished->layout->getCalculationResult())) {
+            LOG_ERROR("Failed to calculate dynamic elements");
+        }
     }
-
-    moveToAlignment(sOverallOffsets.deserialized, sDynamicElement.alignment);
-
-    return a_util::result::SUCCESS;
+    else {
+        pPublished = pExpected;
+    }
+    _dynamic_state_ptr.store(pPublished.get(), std::memory_order_release);
+    return pPublished->layout.get();
 }
 
-a_util::result::Result Decoder::addDynamicElement(const DynamicStructLayoutElement& sDynamicElement,
-                                                  const std::string& strArrayIndex,
-                                                  Offsets& sOverallOffsets,
-                                                  const std::string& strPrefix)
+const StructLayoutElement* Decoder::getProjectedElement(size_t nDynamicIndex) const
 {
-    RETURN_IF_FAILED(
-        addStaticStructElements(sDynamicElement, strArrayIndex, sOverallOffsets, strPrefix));
-    RETURN_IF_FAILED(
-        addDynamicStructElements(sDynamicElement, strArrayIndex, sOverallOffsets, strPrefix));
+    if (!getDynamicLayout()) {
+        return NULL;
+    }
 
-    return a_util::result::SUCCESS;
+    // the elements are located once per decoder together with its dynamic layout
+    const DynamicLayoutState* pState = _dynamic_state_ptr.load(std::memory_order_acquire);
+    if (nDynamicIndex >= pState->projected_elements.size()) {
+        return NULL;
+    }
+    return pState->projected_elements[nDynamicIndex];
 }
 
-a_util::result::Result Decoder::addStaticStructElements(
-    const DynamicStructLayoutElement& sDynamicElement,
-    const std::string& strArrayIndex,
-    Offsets& nOverallBitOffset,
-    const std::string& strPrefix)
+size_t Decoder::getElementCount() const
 {
-    const Offsets start_offsets = nOverallBitOffset;
-    for (std::vector<StructLayoutElement>::const_iterator itStaticElement =
-             sDynamicElement.static_elements.begin();
-         itStaticElement != sDynamicElement.static_elements.end();
-         ++itStaticElement) {
-        StructLayoutElement sElement = *itStaticElement;
-        sElement.deserialized.bit_offset += start_offsets.deserialized;
-        sElement.serialized.bit_offset += start_offsets.serialized;
-        nOverallBitOffset.deserialized =
-            sElement.deserialized.bit_offset + sElement.deserialized.bit_size;
-        nOverallBitOffset.serialized =
-            sElement.serialized.bit_offset + sElement.serialized.bit_size;
-        if (!sElement.name.empty()) {
-            sElement.name = a_util::strings::format("%s%s%s.%s",
-                                                    strPrefix.c_str(),
-                                                    sDynamicElement.name.c_str(),
-                                                    strArrayIndex.c_str(),
-                                                    itStaticElement->name.c_str());
-        }
-        else {
-            // not part of a struct, just a plain array element
-            sElement.name = a_util::strings::format(
-                "%s%s%s", strPrefix.c_str(), sDynamicElement.name.c_str(), strArrayIndex.c_str());
-        }
-        RETURN_IF_FAILED(addDynamicStructElement(sElement));
+    if (_layout->hasProjectedDynamicElements()) {
+        return _layout->getStaticElements().size() + _layout->getProjectedDynamicNames().size();
     }
 
-    return a_util::result::SUCCESS;
-}
-
-a_util::result::Result Decoder::addDynamicStructElements(
-    const DynamicStructLayoutElement& sDynamicElement,
-    const std::string& strArrayIndex,
-    Offsets& sOverallOffsets,
-    const std::string& strPrefix)
-{
-    std::string strChildPrefix = a_util::strings::format(
-        "%s%s%s.", strPrefix.c_str(), sDynamicElement.name.c_str(), strArrayIndex.c_str());
-    for (std::vector<DynamicStructLayoutElement>::const_iterator itDynamicChildElement =
-             sDynamicElement.dynamic_elements.begin();
-         itDynamicChildElement != sDynamicElement.dynamic_elements.end();
-         ++itDynamicChildElement) {
-        RETURN_IF_FAILED(
-            addDynamicElements(*itDynamicChildElement, sOverallOffsets, strChildPrefix));
+    const DynamicLayout* pDynamicLayout = getDynamicLayout();
+    if (pDynamicLayout) {
+        return _layout->getStaticElements().size() + pDynamicLayout->getElements().size();
     }
 
-    return a_util::result::SUCCESS;
+    return _layout->getStaticElements().size();
 }
 
-a_util::result::Result Decoder::addDynamicStructElement(const StructLayoutElement& sElement)
+a_util::result::Result Decoder::findElementIndex(const std::string& element_name,
+                                                 size_t& index) const
 {
-    const Position& sPos = _element_accessor->getRepresentation() == deserialized ?
-                               sElement.deserialized :
-                               sElement.serialized;
-    if (sPos.bit_offset + sPos.bit_size > _data_size * 8) {
-        return ERR_INVALID_ARG;
+    if (_layout->getStaticElementIndex().find(element_name, index)) {
+        return a_util::result::SUCCESS;
     }
-
-    _dynamic_elements->push_back(sElement);
-    return a_util::result::SUCCESS;
+    if (_layout->hasProjectedDynamicElements()) {
+        if (_layout->getProjectedDynamicIndex().find(element_name, index)) {
+            return a_util::result::SUCCESS;
+        }
+        return ERR_NOT_FOUND;
+    }
+    const DynamicLayout* pDynamicLayout = getDynamicLayout();
+    if (pDynamicLayout && pDynamicLayout->getElementIndex().find(element_name, index)) {
+        return a_util::result::SUCCESS;
+    }
+    return ERR_NOT_FOUND;
 }
 
-size_t Decoder::getElementCount() const
+a_util::result::Result Decoder::findElementIndexByPrefix(const std::string& prefix,
+                                                         size_t& index) const
 {
-    if (_dynamic_elements) {
-        return _layout->getStaticElements().size() + _dynamic_elements->size();
+    // static elements always precede the dynamic ones, so the static index wins
+    if (_layout->getStaticElementIndex().findPrefix(prefix, index)) {
+        return a_util::result::SUCCESS;
     }
-
-    return _layout->getStaticElements().size();
+    if (_layout->hasProjectedDynamicElements()) {
+        if (_layout->getProjectedDynamicIndex().findPrefix(prefix, index)) {
+            return a_util::result::SUCCESS;
+        }
+        return ERR_NOT_FOUND;
+    }
+    const DynamicLayout* pDynamicLayout = getDynamicLayout();
+    if (pDynamicLayout && pDynamicLayout->getElementIndex().findPrefix(prefix, index)) {
+        return a_util::result::SUCCESS;
+    }
+    return ERR_NOT_FOUND;
 }
 
 size_t Decoder::getBufferSize(DataRepresentation eRep) const
 {
-    return eRep == deserialized ? _buffer_sizes.deserialized : _buffer_sizes.serialized;
+    const DynamicLayout* pDynamicLayout = getDynamicLayout();
+    if (pDynamicLayout) {
+        return eRep == deserialized ? pDynamicLayout->getBufferSizes().deserialized :
+                                      pDynamicLayout->getBufferSizes().serialized;
+    }
+
+    return _layout->getStaticBufferSize(eRep);
 }
 
 Codec Decoder::makeCodecFor(void* pData, size_t nDataSize, DataRepresentation eRep) const
@@ -244,19 +267,46 @@ const StructLayoutElement* Decoder::getLayoutElement(size_t nIndex) const
     if (nIndex < nStaticElementCount) {
         pElement = &_layout->getStaticElements()[nIndex];
     }
-    else if (_dynamic_elements && nIndex - nStaticElementCount < _dynamic_elements->size()) {
-        pElement = &(*_dynamic_elements)[nIndex - nStaticElementCount];
+    else if (_layout->hasProjectedDynamicElements()) {
+        pElement = getProjectedElement(nIndex - nStaticElementCount);
+    }
+    else {
+        const DynamicLayout* pDynamicLayout = getDynamicLayout();
+        if (pDynamicLayout && nIndex - nStaticElementCount < pDynamicLayout->getElements().size()) {
+            pElement = &pDynamicLayout->getElements()[nIndex - nStaticElementCount];
+        }
     }
 
     return pElement;
 }
 
+const StructLayoutElement* Decoder::getNamedLayoutElement(size_t nIndex) const
+{
+    size_t nStaticElementCount = _layout->getStaticElements().size();
+    if (nIndex < nStaticElementCount) {
+        return &_layout->getStaticElements()[nIndex];
+    }
+    if (_layout->hasProjectedDynamicElements()) {
+        return getProjectedElement(nIndex - nStaticElementCount);
+    }
+
+    const DynamicLayout* pDynamicLayout = getDynamicLayout();
+    if (pDynamicLayout && nIndex - nStaticElementCount < pDynamicLayout->getElements().size()) {
+        return &pDynamicLayout->getNamedElements()[nIndex - nStaticElementCount];
+    }
+
+    return NULL;
+}
+
 Codec::Codec(a_util::memory::shared_ptr<const StructLayout> pLayout,
+             a_util::memory::shared_ptr<DynamicLayoutCache> pDynamicLayouts,
              void* pData,
              size_t nDataSize,
              DataRepresentation eRep)
-    : Decoder(pLayout, pData, nDataSize, eRep)
+    : Decoder(pLayout, pDynamicLayouts, pData, nDataSize, eRep)
 {
+    // the layout of a codec is determined by the data at construction time
+    getDynamicLayout();
 }
 
 Codec::Codec(const Decoder& oDecoder, void* pData, size_t nDataSize, DataRepresentation eRep)
@@ -287,11 +337,155 @@ void* Codec::getElementAddress(size_t nIndex)
     return const_cast<void*>(StaticDecoder::getElementAddress(nIndex));
 }
 
+a_util::result::Result Codec::resizeDynamicArray(const std::string& strSizeElementName,
+                                                 size_t nArraySize,
+                                                 a_util::memory::MemoryBuffer& oBuffer)
+{
+    if (oBuffer.getPtr() != _data || oBuffer.getSize() < _data_size) {
+        return ERR_INVALID_ARG;
+    }
+    if (_layout->hasProjectedDynamicElements()) {
+        return ERR_NOT_SUPPORTED;
+    }
+    size_t nSizeElement = 0;
+    RETURN_IF_FAILED(findElementIndex(strSizeElementName, nSizeElement));
+    const DynamicLayout* pDynamicLayout = getDynamicLayout();
+    if (!pDynamicLayout) {
+        return ERR_INVALID_ARG;
+    }
+    RETURN_IF_FAILED(pDynamicLayout->getCalculationResult());
+    RETURN_IF_FAILED(isValid());
+
+    // check everything before the data is changed
+    bool bIsArraySize = false;
+    for (const DynamicLayout::Array& oArray: pDynamicLayout->getArrays()) {
+        if (oArray.size_element == nSizeElement) {
+            if (!oArray.element->dynamic_elements.empty()) {
+                return ERR_NOT_SUPPORTED;
+            }
+            bIsArraySize = true;
+        }
+    }
+    if (!bIsArraySize ||
+        !isArraySizeInRange(*getLayoutElement(nSizeElement), getRepresentation(), nArraySize)) {
+        return ERR_INVALID_ARG;
+    }
+
+    // the arrays sharing the size element are resized one after the other, the array size
+    // element precedes all of them and keeps its index. All layouts and the buffer are
+    // prepared before any data is moved, so a failure leaves the data unchanged.
+    const DataRepresentation eRep = getRepresentation();
+    std::vector<std::pair<size_t, a_util::memory::shared_ptr<const DynamicLayout>>> oSteps;
+    a_util::memory::shared_ptr<const DynamicLayout> pLayout = _dynamic_state->layout;
+    size_t nMaxSize = _data_size;
+    for (size_t nArray = 0; nArray < pLayout->getArrays().size(); ++nArray) {
+        if (pLayout->getArrays()[nArray].size_element != nSizeElement ||
+            pLayout->getArrays()[nArray].array_size == nArraySize) {
+            continue;
+        }
+        pLayout = _dynamic_layouts ?
+                      _dynamic_layouts->getResizedLayout(*pLayout, nArray, nArraySize) :
+                      DynamicLayout::resize(*_layout, *pLayout, nArray, nArraySize);
+        RETURN_IF_FAILED(pLayout->getCalculationResult());
+        nMaxSize = std::max(nMaxSize, getOffset(pLayout->getBufferSizes(), eRep));
+        oSteps.emplace_back(nArray, pLayout);
+    }
+
+    if (nMaxSize > oBuffer.getSize()) {
+        a_util::memory::MemoryBuffer oEnlarged;
+        if (!oEnlarged.allocate(std::max(nMaxSize, oBuffer.getSize() + oBuffer.getSize() / 2))) {
+            return ERR_MEMORY;
+        }
+        std::memcpy(oEnlarged.getPtr(), oBuffer.getPtr(), _data_size);
+        oBuffer.swap(oEnlarged);
+        _data = oBuffer.getPtr();
+    }
+    for (const auto& oStep: oSteps) {
+        RETURN_IF_FAILED(resizeArray(oStep.first, nArraySize, oStep.second, oBuffer));
+    }
+
+    return setElementValue(nSizeElement,
+                           a_util::variant::Variant(static_cast<uint64_t>(nArraySize)));
+}
+
+a_util::result::Result Codec::resizeArray(
+    size_t nArray,
+    size_t nArraySize,
+    const a_util::memory::shared_ptr<const DynamicLayout>& pResized,
+    a_util::memory::MemoryBuffer& oBuffer)
+{
+    const a_util::memory::shared_ptr<const DynamicLayout> pPrevious = _dynamic_state->layout;
+    const DynamicLayout::Array oArray = pPrevious->getArrays()[nArray];
+    const bool bUniform = DynamicLayout::isUniformResize(*_layout, *pPrevious, nArray, nArraySize);
+
+    // the buffer has been enlarged by resizeDynamicArray() already
+    const DataRepresentation eRep = getRepresentation();
+    const size_t nOldSize = getOffset(pPrevious->getBufferSizes(), eRep);
+    const size_t nNewSize = getOffset(pResized->getBufferSizes(), eRep);
+    uint8_t* pData = static_cast<uint8_t*>(oBuffer.getPtr());
+
+    // all positions in bits, the data following the array starts with its next element
+    const size_t nEntryElements = oArray.element->static_elements.size();
+    const size_t nKeptElements =
+        oArray.first_element + std::min(oArray.array_size, nArraySize) * nEntryElements;
+    const size_t nOldFollowing = oArray.first_element + oArray.array_size * nEntryElements;
+    const size_t nNewFollowing = oArray.first_element + nArraySize * nEntryElements;
+    const size_t nKeptEnd = getOffset(oArray.start, eRep) +
+                            std::min(oArray.array_size, nArraySize) *
+                                getOffset(oArray.entry_size, eRep);
+    const bool bHasFollowing = nOldFollowing < pPrevious->getElements().size();
+    const size_t nOldTail =
+        bHasFollowing ? getOffset(pPrevious->getElements()[nOldFollowing], eRep) : nOldSize * 8;
+    const size_t nNewTail =
+        bHasFollowing ? getOffset(pResized->getElements()[nNewFollowing], eRep) : nNewSize * 8;
+
+    if (bUniform && nKeptEnd % 8 == 0 && nOldTail % 8 == 0 && nNewTail % 8 == 0) {
+        // the following data is moved as a whole
+        if (bHasFollowing) {
+            std::memmove(pData + nNewTail / 8, pData + nOldTail / 8, nOldSize - nOldTail / 8);
+        }
+        if (nNewTail > nKeptEnd) {
+            std::memset(pData + nKeptEnd / 8, 0, nNewTail / 8 - nKeptEnd / 8);
+        }
+    }
+    else {
+        // the alignment of the following elements changes, copy them one by one
+        const std::vector<uint8_t> oPrevious(pData, pData + nOldSize);
+        std::memset(pData, 0, nNewSize);
+        std::memcpy(pData, oPrevious.data(), _layout->getStaticBufferSize(eRep));
+        const std::vector<StructLayoutElement>& oElements = pResized->getElements();
+        for (size_t nElement = 0; nElement < oElements.size(); ++nElement) {
+            if (nElement >= nKeptElements && nElement < nNewFollowing) {
+                continue;
+            }
+            const size_t nPreviousElement =
+                nElement < nKeptElements ? nElement : nElement - nNewFollowing + nOldFollowing;
+            uint64_t nValue = 0;
+            RETURN_IF_FAILED(_element_accessor->getValue(pPrevious->getElements()[nPreviousElement],
+                                                         oPrevious.data(),
+                                                         oPrevious.size(),
+                                                         &nValue));
+            RETURN_IF_FAILED(
+                _element_accessor->setValue(oElements[nElement], pData, nNewSize, &nValue));
+        }
+    }
+
+    _data_size = nNewSize;
+    // codecs are no projections, so there are no projected elements to locate
+    _dynamic_state = std::make_shared<const DynamicLayoutState>(DynamicLayoutState{pResized, {}});
+    _dynamic_state_ptr = _dynamic_state.get();
+    return a_util::result::SUCCESS;
+}
+
 a_util::result::Result Codec::setConstants()
 {
     if (_layout->hasEnums()) {
+        // the static elements are copied from the precalculated default sample
+        RETURN_IF_FAILED(
+            _layout->setConstants(const_cast<void*>(_data), _data_size, getRepresentation()));
         size_t nElementCount = getElementCount();
-        for (size_t nElement = 0; nElement < nElementCount; ++nElement) {
+        for (size_t nElement = _layout->getStaticElements().size(); nElement < nElementCount;
+             ++nElement) {
             const StructLayoutElement* pElement = getLayoutElement(nElement);
             if (pElement->constant) {
                 RETURN_IF_FAILED(_element_accessor->setValue(
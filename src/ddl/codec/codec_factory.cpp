@@ -17,59 +17,78 @@
 
 #include "ddl/codec/codec_factory.h"
 
-#include "a_util/strings.h"
-#include "ddl/dd/ddstring.h"
+#include "ddl/codec/struct_layout_cache.h"
+#include "dynamic_layout.h"
 #include "struct_layout.h"
 
+#include <algorithm>
+
 namespace ddl {
 // define all needed error types and values locally
 _MAKE_RESULT(-10, ERR_INVALID_INDEX);
 _MAKE_RESULT(-20, ERR_NOT_FOUND);
 _MAKE_RESULT(-37, ERR_NOT_INITIALIZED);
-_MAKE_RESULT(-38, ERR_INVALID_DDL);
-
-CodecFactory::CodecFactory() : _layout(new StructLayout()), _constructor_result(ERR_NOT_INITIALIZED)
-{
-}
 
-CodecFactory::CodecFactory(const std::string& struct_name, const std::string& ddl_string)
+namespace {
+/// Glob matching where '*' matches any sequence of characters and '?' a single one.
+bool matchesPattern(const std::string& name, const std::string& pattern)
 {
-    DataDefinition created_dd;
-    try {
-        created_dd = DDString::fromXMLString(struct_name, ddl_string);
-        _constructor_result = a_util::result::SUCCESS;
-    }
-    catch (const dd::Error& dd_err) {
-        std::string error_desc =
-            a_util::strings::join(dd::transformProblemList(dd_err.problems()), ";");
-        _constructor_result = a_util::result::Result(
-            ERR_INVALID_DDL, error_desc.c_str(), __LINE__, __FILE__, "CodecFactory::CodecFactory");
-    }
-    if (isOk(_constructor_result)) {
-        auto struct_access = created_dd.getStructTypeAccess(struct_name);
-        if (struct_access) {
-            _layout.reset(new StructLayout(struct_access));
-            _constructor_result = _layout->isValid();
+    size_t name_pos = 0;
+    size_t pattern_pos = 0;
+    size_t star_pos = std::string::npos;
+    size_t star_name_pos = 0;
+    while (name_pos < name.size()) {
+        if (pattern_pos < pattern.size() &&
+            (pattern[pattern_pos] == '?' || pattern[pattern_pos] == name[name_pos])) {
+            ++name_pos;
+            ++pattern_pos;
+        }
+        else if (pattern_pos < pattern.size() && pattern[pattern_pos] == '*') {
+            // remember the star and let it match nothing first
+            star_pos = pattern_pos++;
+            star_name_pos = name_pos;
+        }
+        else if (star_pos != std::string::npos) {
+            // let the last star match one more character
+            pattern_pos = star_pos + 1;
+            name_pos = ++star_name_pos;
         }
         else {
-            _constructor_result = ERR_NOT_FOUND;
+            return false;
         }
     }
+    while (pattern_pos < pattern.size() && pattern[pattern_pos] == '*') {
+        ++pattern_pos;
+    }
+    return pattern_pos == pattern.size();
+}
 
+} // namespace
+
+CodecFactory::CodecFactory() : _layout(new StructLayout()), _constructor_result(ERR_NOT_INITIALIZED)
+{
+}
+
+CodecFactory::CodecFactory(const std::string& struct_name, const std::string& ddl_string)
+{
+    _constructor_result =
+        StructLayoutCache::getInstance().getLayout(struct_name, ddl_string, _layout);
     if (!_layout) {
         _layout.reset(new StructLayout());
     }
+    _dynamic_layouts = DynamicLayoutCache::create(_layout);
 }
 
 CodecFactory::CodecFactory(const ddl::dd::StructType& struct_type, const dd::DataDefinition& ddl)
-    : _layout(std::make_shared<StructLayout>(ddl.getStructTypeAccess(struct_type.getName())))
+    : CodecFactory(ddl.getStructTypeAccess(struct_type.getName()))
 {
-    _constructor_result = _layout->isValid();
 }
+
 CodecFactory::CodecFactory(const ddl::dd::StructTypeAccess& struct_type_access)
-    : _layout(std::make_shared<StructLayout>(struct_type_access))
+    : _layout(StructLayoutCache::getInstance().getLayout(struct_type_access))
 {
     _constructor_result = _layout->isValid();
+    _dynamic_layouts = DynamicLayoutCache::create(_layout);
 }
 
 CodecFactory::CodecFactory(const ddl::DDStructure& ddl_struct)
@@ -77,6 +96,13 @@ CodecFactory::CodecFactory(const ddl::DDStructure& ddl_struct)
 {
 }
 
+CodecFactory::CodecFactory(a_util::memory::shared_ptr<const StructLayout> layout,
+                           a_util::memory::shared_ptr<DynamicLayoutCache> dynamic_layouts,
+                           a_util::result::Result constructor_result)
+    : _layout(layout), _dynamic_layouts(dynamic_layouts), _constructor_result(constructor_result)
+{
+}
+
 a_util::result::Result CodecFactory::isValid() const
 {
     return _constructor_result;
@@ -98,9 +124,85 @@ a_util::result::Result CodecFactory::getStaticElement(size_t nIndex,
     return a_util::result::SUCCESS;
 }
 
+a_util::result::Result CodecFactory::findElementIndex(const std::string& element_name,
+                                                      size_t& index) const
+{
+    if (_layout->getStaticElementIndex().find(element_name, index)) {
+        return a_util::result::SUCCESS;
+    }
+    return ERR_NOT_FOUND;
+}
+
+a_util::result::Result CodecFactory::findElementIndexByPrefix(const std::string& prefix,
+                                                              size_t& index) const
+{
+    if (_layout->getStaticElementIndex().findPrefix(prefix, index)) {
+        return a_util::result::SUCCESS;
+    }
+    return ERR_NOT_FOUND;
+}
+
 size_t CodecFactory::getStaticBufferSize(DataRepresentation eRep) const
 {
     return _layout->getStaticBufferSize(eRep);
 }
 
+const std::vector<uint8_t>& CodecFactory::getDefaultSample(DataRepresentation eRep) const
+{
+    return _layout->getDefaultSample(eRep);
+}
+
+CodecFactory CodecFactory::makeProjection(const std::vector<std::string>& patterns) const
+{
+    if (isFailed(_constructor_result)) {
+        return CodecFactory(_layout, _dynamic_layouts, _constructor_result);
+    }
+
+    const std::vector<StructLayoutElement>& static_elements = _layout->getStaticElements();
+    std::vector<size_t> static_indices;
+    std::vector<std::string> dynamic_names;
+    std::vector<bool> selected(static_elements.size(), false);
+    auto select = [&](size_t index) {
+        if (!selected[index]) {
+            selected[index] = true;
+            static_indices.push_back(index);
+        }
+    };
+
+    a_util::result::Result result;
+    for (const auto& pattern: patterns) {
+        size_t index = 0;
+        if (pattern.find_first_of("*?") == std::string::npos) {
+            if (_layout->getStaticElementIndex().find(pattern, index)) {
+                select(index);
+            }
+            else if (!_dynamic_layouts || !_layout->isDynamicElementName(pattern)) {
+                result = ERR_NOT_FOUND;
+            }
+            else if (std::find(dynamic_names.begin(), dynamic_names.end(), pattern) ==
+                     dynamic_names.end()) {
+                // elements after the first dynamic array can only be located per sample
+                dynamic_names.push_back(pattern);
+            }
+            continue;
+        }
+
+        bool matched = false;
+        for (index = 0; index < static_elements.size(); ++index) {
+            if (matchesPattern(static_elements[index].name, pattern)) {
+                select(index);
+                matched = true;
+            }
+        }
+        if (!matched) {
+            result = ERR_NOT_FOUND;
+        }
+    }
+
+    return CodecFactory(
+        std::make_shared<const StructLayout>(_layout, static_indices, dynamic_names),
+        dynamic_names.empty() ? nullptr : _dynamic_layouts,
+        result);
+}
+
 } // namespace ddl
@@ -0,0 +1,429 @@
+/**
+ * @file
+ * Implementation of the delta codec.
+ *
+ * Copyright @ 2021 VW Group. All rights reserved.
+ *
+ *     This Source Code Form is subject to the terms of the Mozilla
+ *     Public License, v. 2.0. If a copy of the MPL was not distributed
+ *     with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * If it is not possible or desirable to put the notice in a particular file, then
+ * You may include the notice in a location (such as a LICENSE file in a
+ * relevant directory) where a recipient would be likely to look for such a notice.
+ *
+ * You may add additional accurate notices of copyright ownership.
+ */
+
+#include "ddl/codec/delta_codec.h"
+
+#include "a_util/result/error_def.h"
+#include "ddl/legacy_error_macros.h"
+#include "dynamic_layout.h"
+#include "element_accessor.h"
+#include "struct_layout.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ddl {
+// define all needed error types and values locally
+_MAKE_RESULT(-4, ERR_POINTER);
+_MAKE_RESULT(-5, ERR_INVALID_ARG);
+_MAKE_RESULT(-19, ERR_NOT_SUPPORTED);
+_MAKE_RESULT(-37, ERR_NOT_INITIALIZED);
+
+namespace {
+/// The kinds of a delta, stored in its first byte.
+enum DeltaKind : uint8_t {
+    changed_elements = 0, ///< the changed elements of a sample
+    whole_sample = 1      ///< the whole sample
+};
+
+void writeVarUInt(std::vector<uint8_t>& delta, size_t value)
+{
+    while (value >= 0x80) {
+        delta.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    delta.push_back(static_cast<uint8_t>(value));
+}
+
+void writeWholeSample(std::vector<uint8_t>& delta, const uint8_t* sample, size_t sample_size)
+{
+    delta.clear();
+    delta.reserve(sample_size + 11);
+    delta.push_back(whole_sample);
+    writeVarUInt(delta, sample_size);
+    delta.insert(delta.end(), sample, sample + sample_size);
+}
+
+bool readVarUInt(const uint8_t*& position, const uint8_t* end, size_t& value)
+{
+    value = 0;
+    for (size_t shift = 0; position < end && shift < sizeof(size_t) * 8; shift += 7) {
+        const uint8_t byte = *position++;
+        value |= static_cast<size_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Finds the first byte at or after @p offset in which the sample differs from the base, bytes
+ * beyond the end of the base count as zero. Equal spans are compared word by word.
+ * @return The offset of the difference or the sample size if there is none.
+ */
+size_t findDifference(const uint8_t* base,
+                      size_t base_size,
+                      const uint8_t* sample,
+                      size_t sample_size,
+                      size_t offset)
+{
+    const size_t common_size = std::min(base_size, sample_size);
+    for (; offset + sizeof(uint64_t) <= common_size; offset += sizeof(uint64_t)) {
+        uint64_t base_word, sample_word;
+        std::memcpy(&base_word, base + offset, sizeof(uint64_t));
+        std::memcpy(&sample_word, sample + offset, sizeof(uint64_t));
+        if (base_word != sample_word) {
+            break;
+        }
+    }
+    for (; offset < common_size; ++offset) {
+        if (base[offset] != sample[offset]) {
+            return offset;
+        }
+    }
+    for (; offset + sizeof(uint64_t) <= sample_size; offset += sizeof(uint64_t)) {
+        uint64_t sample_word;
+        std::memcpy(&sample_word, sample + offset, sizeof(uint64_t));
+        if (sample_word != 0) {
+            break;
+        }
+    }
+    for (; offset < sample_size && sample[offset] == 0; ++offset) {
+    }
+    return offset;
+}
+
+/// The bytes of an element within the data and the size of its value within a delta.
+struct ElementBytes {
+    size_t first;
+    size_t end;
+    size_t value_size;
+    bool byte_aligned;
+};
+
+ElementBytes getElementBytes(const StructLayoutElement& element, DataRepresentation rep)
+{
+    const Position& position = rep == deserialized ? element.deserialized : element.serialized;
+    ElementBytes bytes;
+    bytes.first = position.bit_offset / 8;
+    bytes.end = (position.bit_offset + position.bit_size + 7) / 8;
+    bytes.byte_aligned = position.bit_offset % 8 == 0 && position.bit_size % 8 == 0;
+    // bit-packed elements are transferred with the size of their type
+    bytes.value_size =
+        bytes.byte_aligned ? position.bit_size / 8 : (element.deserialized.bit_size + 7) / 8;
+    return bytes;
+}
+
+/**
+ * Compares elements of a sample with a base sample, skipping spans which are known to be equal.
+ */
+class DifferenceScanner {
+public:
+    DifferenceScanner(const uint8_t* base,
+                      size_t base_size,
+                      const uint8_t* sample,
+                      size_t sample_size,
+                      const ElementAccessor& accessor)
+        : _base(base),
+          _base_size(base_size),
+          _sample(sample),
+          _sample_size(sample_size),
+          _accessor(accessor),
+          _equal_begin(0),
+          _equal_end(findDifference(base, base_size, sample, sample_size, 0))
+    {
+    }
+
+    bool hasChanged(const StructLayoutElement& element, const ElementBytes& bytes)
+    {
+        if (bytes.first >= _equal_begin && bytes.end <= _equal_end) {
+            return false;
+        }
+        if (bytes.first > _equal_end) {
+            // the element lies behind the last difference, search the next one
+            _equal_begin = bytes.first;
+            _equal_end = findDifference(_base, _base_size, _sample, _sample_size, bytes.first);
+            if (bytes.end <= _equal_end) {
+                return false;
+            }
+        }
+
+        if (bytes.end <= _base_size) {
+            if (bytes.byte_aligned) {
+                const size_t size = bytes.end - bytes.first;
+                return std::memcmp(_base + bytes.first, _sample + bytes.first, size) != 0;
+            }
+            // the bytes are shared with other bit-packed elements
+            uint64_t base_value = 0, sample_value = 0;
+            return isFailed(_accessor.getValue(element, _base, _base_size, &base_value)) ||
+                   isFailed(_accessor.getValue(element, _sample, _sample_size, &sample_value)) ||
+                   base_value != sample_value;
+        }
+        return true;
+    }
+
+private:
+    const uint8_t* _base;
+    size_t _base_size;
+    const uint8_t* _sample;
+    size_t _sample_size;
+    const ElementAccessor& _accessor;
+    /// The bytes in [_equal_begin, _equal_end) are known to be equal.
+    size_t _equal_begin;
+    size_t _equal_end;
+};
+
+} // namespace
+
+DeltaCodec::DeltaCodec() : _representation(deserialized), _result(ERR_NOT_INITIALIZED)
+{
+}
+
+DeltaCodec::DeltaCodec(const CodecFactory& factory, DataRepresentation rep)
+    : _layout(factory._layout),
+      _dynamic_layouts(factory._dynamic_layouts),
+      _representation(rep),
+      _result(factory.isValid())
+{
+    if (isOk(_result) && _layout->getSource()) {
+        _result = ERR_NOT_SUPPORTED;
+    }
+}
+
+a_util::result::Result DeltaCodec::isValid() const
+{
+    return _result;
+}
+
+const StructLayoutElement* DeltaCodec::getElement(const DynamicLayout* dynamic_layout,
+                                                  size_t index) const
+{
+    const std::vector<StructLayoutElement>& static_elements = _layout->getStaticElements();
+    if (index < static_elements.size()) {
+        return &static_elements[index];
+    }
+    index -= static_elements.size();
+    if (dynamic_layout && index < dynamic_layout->getElements().size()) {
+        return &dynamic_layout->getElements()[index];
+    }
+    return nullptr;
+}
+
+a_util::result::Result DeltaCodec::encode(const void* base,
+                                          size_t base_size,
+                                          const void* sample,
+                                          size_t sample_size,
+                                          std::vector<uint8_t>& delta) const
+{
+    RETURN_IF_FAILED(_result);
+    if (!sample) {
+        return ERR_POINTER;
+    }
+    if (!base) {
+        base_size = 0;
+    }
+    if (sample_size < _layout->getStaticBufferSize(_representation)) {
+        return ERR_INVALID_ARG;
+    }
+
+    const uint8_t* sample_bytes = static_cast<const uint8_t*>(sample);
+    delta.clear();
+
+    a_util::memory::shared_ptr<const DynamicLayout> dynamic_layout;
+    std::vector<size_t> array_sizes;
+    if (_dynamic_layouts) {
+        if (!DynamicLayout::collectArraySizes(
+                *_layout, sample, sample_size, _representation, array_sizes)) {
+            // the receiver could not calculate the layout from the array sizes alone
+            dynamic_layout = std::make_shared<const DynamicLayout>(
+                *_layout, sample, sample_size, _representation);
+            RETURN_IF_FAILED(dynamic_layout->getCalculationResult());
+            writeWholeSample(delta, sample_bytes, sample_size);
+            return a_util::result::SUCCESS;
+        }
+        dynamic_layout = _dynamic_layouts->getLayout(array_sizes);
+        RETURN_IF_FAILED(dynamic_layout->getCalculationResult());
+        const Offsets& buffer_sizes = dynamic_layout->getBufferSizes();
+        if (sample_size < (_representation == deserialized ? buffer_sizes.deserialized :
+                                                             buffer_sizes.serialized)) {
+            return ERR_INVALID_ARG;
+        }
+    }
+
+    delta.push_back(changed_elements);
+    writeVarUInt(delta, sample_size);
+    writeVarUInt(delta, array_sizes.size());
+    for (size_t array_size: array_sizes) {
+        writeVarUInt(delta, array_size);
+    }
+    const size_t header_size = delta.size();
+
+    const ElementAccessor& accessor = _representation == deserialized ?
+                                          DeserializedAccessor::getInstance() :
+                                          SerializedAccessor::getInstance();
+    DifferenceScanner scanner(
+        static_cast<const uint8_t*>(base), base_size, sample_bytes, sample_size, accessor);
+    size_t next_index = 0;
+    const size_t element_count =
+        _layout->getStaticElements().size() +
+        (dynamic_layout ? dynamic_layout->getElements().size() : 0);
+    for (size_t index = 0; index < element_count; ++index) {
+        const StructLayoutElement& element = *getElement(dynamic_layout.get(), index);
+        const ElementBytes bytes = getElementBytes(element, _representation);
+        if (!scanner.hasChanged(element, bytes)) {
+            continue;
+        }
+
+        writeVarUInt(delta, index - next_index);
+        next_index = index + 1;
+        const size_t value_offset = delta.size();
+        delta.resize(value_offset + bytes.value_size);
+        if (bytes.byte_aligned) {
+            std::memcpy(&delta[value_offset], sample_bytes + bytes.first, bytes.value_size);
+        }
+        else {
+            RETURN_IF_FAILED(accessor.getValue(element, sample, sample_size, &delta[value_offset]));
+        }
+    }
+
+    // the receiver only accepts samples growing by at most the size of the changed elements
+    if (sample_size > base_size + (delta.size() - header_size)) {
+        writeWholeSample(delta, sample_bytes, sample_size);
+    }
+    return a_util::result::SUCCESS;
+}
+
+a_util::result::Result DeltaCodec::apply(const void* delta,
+                                         size_t delta_size,
+                                         std::vector<uint8_t>& sample) const
+{
+    RETURN_IF_FAILED(_result);
+    if (!delta) {
+        return ERR_POINTER;
+    }
+
+    const uint8_t* position = static_cast<const uint8_t*>(delta);
+    const uint8_t* const end = position + delta_size;
+    if (position == end) {
+        return ERR_INVALID_ARG;
+    }
+    const uint8_t kind = *position++;
+    size_t sample_size = 0;
+    if (!readVarUInt(position, end, sample_size)) {
+        return ERR_INVALID_ARG;
+    }
+    if (kind == whole_sample) {
+        if (static_cast<size_t>(end - position) != sample_size) {
+            return ERR_INVALID_ARG;
+        }
+        sample.assign(position, end);
+        return a_util::result::SUCCESS;
+    }
+    if (kind != changed_elements || sample_size < _layout->getStaticBufferSize(_representation)) {
+        return ERR_INVALID_ARG;
+    }
+
+    size_t array_size_count = 0;
+    if (!readVarUInt(position, end, array_size_count) ||
+        array_size_count > static_cast<size_t>(end - position)) {
+        return ERR_INVALID_ARG;
+    }
+    std::vector<size_t> array_sizes(array_size_count);
+    for (size_t& array_size: array_sizes) {
+        if (!readVarUInt(position, end, array_size)) {
+            return ERR_INVALID_ARG;
+        }
+    }
+
+    // the sample grows by at most the size of the changed elements (see encode()), and each
+    // array entry takes at least one bit of it, so the sizes are checked before any allocation
+    if (sample_size > sample.size() &&
+        sample_size - sample.size() > static_cast<size_t>(end - position)) {
+        return ERR_INVALID_ARG;
+    }
+    size_t entry_count = 0;
+    for (const size_t array_size: array_sizes) {
+        entry_count += array_size;
+        if (array_size > sample_size * 8 || entry_count > sample_size * 8) {
+            return ERR_INVALID_ARG;
+        }
+    }
+
+    a_util::memory::shared_ptr<const DynamicLayout> dynamic_layout;
+    if (_dynamic_layouts) {
+        dynamic_layout = _dynamic_layouts->getLayout(std::move(array_sizes));
+        if (isFailed(dynamic_layout->getCalculationResult())) {
+            return ERR_INVALID_ARG;
+        }
+        const Offsets& buffer_sizes = dynamic_layout->getBufferSizes();
+        if (sample_size < (_representation == deserialized ? buffer_sizes.deserialized :
+                                                             buffer_sizes.serialized)) {
+            return ERR_INVALID_ARG;
+        }
+    }
+    else if (array_size_count != 0) {
+        return ERR_INVALID_ARG;
+    }
+
+    // all entries are checked before the first write, so a corrupt delta leaves the sample as
+    // it is
+    const uint8_t* const first_entry = position;
+    for (size_t index = 0; position < end; ++index) {
+        size_t gap = 0;
+        if (!readVarUInt(position, end, gap)) {
+            return ERR_INVALID_ARG;
+        }
+        index += gap;
+        const StructLayoutElement* element = getElement(dynamic_layout.get(), index);
+        if (!element) {
+            return ERR_INVALID_ARG;
+        }
+        const ElementBytes bytes = getElementBytes(*element, _representation);
+        if (bytes.value_size > static_cast<size_t>(end - position) || bytes.end > sample_size) {
+            return ERR_INVALID_ARG;
+        }
+        position += bytes.value_size;
+    }
+
+    sample.resize(sample_size, 0);
+    const ElementAccessor& accessor = _representation == deserialized ?
+                                          DeserializedAccessor::getInstance() :
+                                          SerializedAccessor::getInstance();
+    position = first_entry;
+    size_t index = 0;
+    while (position < end) {
+        size_t gap = 0;
+        readVarUInt(position, end, gap);
+        index += gap;
+        const StructLayoutElement* element = getElement(dynamic_layout.get(), index);
+        ++index;
+
+        const ElementBytes bytes = getElementBytes(*element, _representation);
+        if (bytes.byte_aligned) {
+            std::memcpy(&sample[bytes.first], position, bytes.value_size);
+        }
+        else {
+            RETURN_IF_FAILED(accessor.setValue(*element, sample.data(), sample.size(), position));
+        }
+        position += bytes.value_size;
+    }
+
+    return a_util::result::SUCCESS;
+}
+
+} // namespace ddl
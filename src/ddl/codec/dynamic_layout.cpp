@@ -0,0 +1,792 @@
+/**
+ * @file
+ * Implementation of the dynamic layout calculation.
+ *
+ * Copyright @ 2021 VW Group. All rights reserved.
+ *
+ *     This Source Code Form is subject to the terms of the Mozilla
+ *     Public License, v. 2.0. If a copy of the MPL was not distributed
+ *     with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * If it is not possible or desirable to put the notice in a particular file, then
+ * You may include the notice in a location (such as a LICENSE file in a
+ * relevant directory) where a recipient would be likely to look for such a notice.
+ *
+ * You may add additional accurate notices of copyright ownership.
+ */
+
+#include "dynamic_layout.h"
+
+#include "a_util/result/error_def.h"
+#include "a_util/strings.h"
+#include "ddl/codec/bitserializer.h"
+#include "ddl/legacy_error_macros.h"
+#include "element_accessor.h"
+#include "struct_layout.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ddl {
+// define all needed error types and values locally
+_MAKE_RESULT(-5, ERR_INVALID_ARG);
+
+namespace {
+const size_t no_index = static_cast<size_t>(-1);
+
+void moveToAlignment(size_t& bit_offset, size_t alignment)
+{
+    size_t bit_rest = bit_offset % 8;
+    if (bit_rest) {
+        bit_offset += 8 - bit_rest;
+    }
+
+    size_t byte_offset = bit_offset / 8;
+    size_t rest = byte_offset % alignment;
+    if (rest) {
+        bit_offset += (alignment - rest) * 8;
+    }
+}
+
+size_t bitsToBytes(size_t bit_size)
+{
+    return bit_size % 8 ? bit_size / 8 + 1 : bit_size / 8;
+}
+
+/// The size of one entry of a dynamic array without nested dynamic elements.
+Offsets getEntrySize(const DynamicStructLayoutElement& dynamic_element)
+{
+    if (dynamic_element.static_elements.empty()) {
+        return {0, 0};
+    }
+    const StructLayoutElement& last = dynamic_element.static_elements.back();
+    return {last.deserialized.bit_offset + last.deserialized.bit_size,
+            last.serialized.bit_offset + last.serialized.bit_size};
+}
+
+size_t getMaximumAlignment(const std::vector<DynamicStructLayoutElement>& dynamic_elements)
+{
+    size_t alignment = 1;
+    for (const auto& dynamic_element: dynamic_elements) {
+        alignment = std::max(alignment, dynamic_element.alignment);
+        alignment = std::max(alignment, getMaximumAlignment(dynamic_element.dynamic_elements));
+    }
+    return alignment;
+}
+
+/// Copies all but the name of an element and moves it by the given offsets.
+StructLayoutElement makeElement(const StructLayoutElement& source, const Offsets& start)
+{
+    StructLayoutElement element;
+    element.type = source.type;
+    element.p_enum = source.p_enum;
+    element.p_enum_names = source.p_enum_names;
+    element.deserialized.bit_offset = source.deserialized.bit_offset + start.deserialized;
+    element.deserialized.bit_size = source.deserialized.bit_size;
+    element.serialized.bit_offset = source.serialized.bit_offset + start.serialized;
+    element.serialized.bit_size = source.serialized.bit_size;
+    element.byte_order = source.byte_order;
+    element.constant = source.constant;
+    return element;
+}
+
+template <typename T>
+bool readTypedArraySize(const StructLayoutElement& element,
+                        const Offsets& start,
+                        const void* data,
+                        size_t data_size,
+                        DataRepresentation rep,
+                        size_t& array_size)
+{
+    T value = T();
+    if (rep == deserialized) {
+        const size_t byte_offset = (element.deserialized.bit_offset + start.deserialized) / 8;
+        if (byte_offset + sizeof(T) > data_size) {
+            return false;
+        }
+        std::memcpy(&value, static_cast<const uint8_t*>(data) + byte_offset, sizeof(T));
+    }
+    else {
+        const size_t bit_offset = element.serialized.bit_offset + start.serialized;
+        if (bit_offset + element.serialized.bit_size > data_size * 8) {
+            return false;
+        }
+        a_util::memory::BitSerializer serializer(const_cast<void*>(data), data_size);
+        if (a_util::result::isFailed(
+                serializer.read<T>(bit_offset,
+                                   element.serialized.bit_size,
+                                   &value,
+                                   static_cast<a_util::memory::Endianess>(element.byte_order)))) {
+            return false;
+        }
+    }
+
+    // use the same conversion as the lookup by name
+    array_size = static_cast<size_t>(a_util::variant::Variant(value).asUInt64());
+    return true;
+}
+
+#define READ_CASE_TYPE(__variant_type, __data_type)                                                \
+    case a_util::variant::__variant_type: {                                                        \
+        return readTypedArraySize<__data_type>(element, start, data, data_size, rep, array_size);  \
+    }
+
+bool readArraySize(const StructLayoutElement& element,
+                   const Offsets& start,
+                   const void* data,
+                   size_t data_size,
+                   DataRepresentation rep,
+                   size_t& array_size)
+{
+    switch (element.type) {
+        READ_CASE_TYPE(VT_Bool, bool)
+        READ_CASE_TYPE(VT_Int8, int8_t)
+        READ_CASE_TYPE(VT_UInt8, uint8_t)
+        READ_CASE_TYPE(VT_Int16, int16_t)
+        READ_CASE_TYPE(VT_UInt16, uint16_t)
+        READ_CASE_TYPE(VT_Int32, int32_t)
+        READ_CASE_TYPE(VT_UInt32, uint32_t)
+        READ_CASE_TYPE(VT_Int64, int64_t)
+        READ_CASE_TYPE(VT_UInt64, uint64_t)
+        READ_CASE_TYPE(VT_Float32, float)
+        READ_CASE_TYPE(VT_Float64, double)
+    default:
+        return false;
+    }
+}
+
+#undef READ_CASE_TYPE
+
+/// Reads the array sizes from contiguous data.
+struct ContiguousArraySizeReader {
+    const void* data;
+    size_t data_size;
+    DataRepresentation rep;
+
+    bool operator()(const StructLayoutElement& element,
+                    const Offsets& start,
+                    size_t& array_size) const
+    {
+        return readArraySize(element, start, data, data_size, rep, array_size);
+    }
+};
+
+/**
+ * Walks the dynamic elements, only keeping track of the offsets and reading the array sizes
+ * through their precomputed references.
+ */
+template <typename ArraySizeReader>
+class ArraySizeCollector {
+public:
+    struct Scope {
+        const std::vector<StructLayoutElement>* elements;
+        Offsets start;
+    };
+
+    ArraySizeCollector(const ArraySizeReader& read_array_size,
+                       size_t data_size,
+                       DataRepresentation rep,
+                       std::vector<size_t>& array_sizes)
+        : _read_array_size(read_array_size),
+          _data_size(data_size),
+          _rep(rep),
+          _array_sizes(array_sizes)
+    {
+    }
+
+    bool collect(const std::vector<DynamicStructLayoutElement>& dynamic_elements,
+                 const Scope& scope,
+                 Offsets& offsets)
+    {
+        const size_t sibling_base = _sibling_starts.size();
+        _sibling_starts.resize(sibling_base + dynamic_elements.size());
+
+        for (size_t index = 0; index < dynamic_elements.size(); ++index) {
+            const DynamicStructLayoutElement& dynamic_element = dynamic_elements[index];
+            moveToAlignment(offsets.deserialized, dynamic_element.alignment);
+            if (dynamic_element.isAlignmentElement()) {
+                continue;
+            }
+
+            size_t array_size = 1;
+            if (dynamic_element.isDynamicArray()) {
+                const ArraySizeReference& reference = dynamic_element.size_reference;
+                if (reference.kind == ArraySizeReference::scope_static) {
+                    if (!_read_array_size(
+                            (*scope.elements)[reference.element_index], scope.start, array_size)) {
+                        return false;
+                    }
+                }
+                else if (reference.kind == ArraySizeReference::sibling) {
+                    const DynamicStructLayoutElement& sibling =
+                        dynamic_elements[reference.sibling_index];
+                    if (!_read_array_size(
+                            sibling.static_elements[reference.element_index],
+                            _sibling_starts[sibling_base + reference.sibling_index],
+                            array_size)) {
+                        return false;
+                    }
+                }
+                else {
+                    return false;
+                }
+                _array_sizes.push_back(array_size);
+            }
+
+            if (dynamic_element.dynamic_elements.empty()) {
+                // all array elements have the same size, no need to walk them one by one
+                if (array_size &&
+                    !skipArray(dynamic_element, array_size, sibling_base + index, offsets)) {
+                    return false;
+                }
+                moveToAlignment(offsets.deserialized, dynamic_element.alignment);
+                continue;
+            }
+
+            for (size_t array_index = 0; array_index < array_size; ++array_index) {
+                const Offsets start = offsets;
+                if (array_index == 0) {
+                    _sibling_starts[sibling_base + index] = start;
+                }
+                for (const auto& static_element: dynamic_element.static_elements) {
+                    offsets.deserialized = static_element.deserialized.bit_offset +
+                                           start.deserialized +
+                                           static_element.deserialized.bit_size;
+                    offsets.serialized = static_element.serialized.bit_offset + start.serialized +
+                                         static_element.serialized.bit_size;
+                    const size_t end =
+                        _rep == deserialized ? offsets.deserialized : offsets.serialized;
+                    if (end > _data_size * 8) {
+                        return false;
+                    }
+                }
+                if (!collect(dynamic_element.dynamic_elements,
+                             Scope{&dynamic_element.static_elements, start},
+                             offsets)) {
+                    return false;
+                }
+            }
+
+            moveToAlignment(offsets.deserialized, dynamic_element.alignment);
+        }
+
+        _sibling_starts.resize(sibling_base);
+        return true;
+    }
+
+private:
+    bool skipArray(const DynamicStructLayoutElement& dynamic_element,
+                   size_t array_size,
+                   size_t sibling_index,
+                   Offsets& offsets)
+    {
+        _sibling_starts[sibling_index] = offsets;
+        const Offsets stride = getEntrySize(dynamic_element);
+
+        const size_t rep_stride = _rep == deserialized ? stride.deserialized : stride.serialized;
+        if (rep_stride && array_size - 1 > _data_size * 8 / rep_stride) {
+            return false;
+        }
+
+        // the elements of the last array element end last
+        const Offsets start = {offsets.deserialized + (array_size - 1) * stride.deserialized,
+                               offsets.serialized + (array_size - 1) * stride.serialized};
+        for (const auto& static_element: dynamic_element.static_elements) {
+            const size_t end = _rep == deserialized ?
+                                   static_element.deserialized.bit_offset + start.deserialized +
+                                       static_element.deserialized.bit_size :
+                                   static_element.serialized.bit_offset + start.serialized +
+                                       static_element.serialized.bit_size;
+            if (end > _data_size * 8) {
+                return false;
+            }
+        }
+        offsets.deserialized = start.deserialized + stride.deserialized;
+        offsets.serialized = start.serialized + stride.serialized;
+        return true;
+    }
+
+    const ArraySizeReader& _read_array_size;
+    size_t _data_size;
+    DataRepresentation _rep;
+    std::vector<size_t>& _array_sizes;
+    std::vector<Offsets> _sibling_starts;
+};
+
+template <typename ArraySizeReader>
+bool collectArraySizesWith(const StructLayout& layout,
+                           const ArraySizeReader& read_array_size,
+                           size_t data_size,
+                           DataRepresentation rep,
+                           std::vector<size_t>& array_sizes)
+{
+    typedef ArraySizeCollector<ArraySizeReader> Collector;
+    Offsets offsets = layout.getStaticBufferBitSizes();
+    Collector collector(read_array_size, data_size, rep, array_sizes);
+    return collector.collect(layout.getDynamicElements(),
+                             typename Collector::Scope{&layout.getStaticElements(), {0, 0}},
+                             offsets);
+}
+
+} // namespace
+
+/**
+ * Walks the dynamic elements and creates them, either for known array sizes or by reading the
+ * array sizes by name.
+ */
+class DynamicLayout::Builder {
+public:
+    Builder(DynamicLayout& dynamic_layout,
+            const StructLayout& layout,
+            const std::vector<size_t>* array_sizes,
+            const void* data,
+            size_t data_size,
+            DataRepresentation rep)
+        : _dynamic_layout(dynamic_layout),
+          _layout(layout),
+          _array_sizes(array_sizes),
+          _next_array_size(0),
+          _data(data),
+          _data_size(data_size),
+          _rep(rep)
+    {
+    }
+
+    a_util::result::Result build()
+    {
+        Offsets offsets = _layout.getStaticBufferBitSizes();
+        a_util::result::Result result =
+            addDynamicElements(_layout.getDynamicElements(), no_index, offsets);
+        _dynamic_layout._buffer_bit_sizes = offsets;
+        _dynamic_layout._buffer_sizes.deserialized = bitsToBytes(offsets.deserialized);
+        _dynamic_layout._buffer_sizes.serialized = bitsToBytes(offsets.serialized);
+        return result;
+    }
+
+private:
+    bool byName() const
+    {
+        return _array_sizes == nullptr;
+    }
+
+    a_util::result::Result addDynamicElements(
+        const std::vector<DynamicStructLayoutElement>& dynamic_elements,
+        size_t scope,
+        Offsets& offsets)
+    {
+        // the first instances of the preceding elements, for array sizes read from siblings
+        std::vector<size_t> sibling_instances(dynamic_elements.size(), no_index);
+        for (size_t index = 0; index < dynamic_elements.size(); ++index) {
+            const DynamicStructLayoutElement& dynamic_element = dynamic_elements[index];
+            moveToAlignment(offsets.deserialized, dynamic_element.alignment);
+            if (dynamic_element.isAlignmentElement()) {
+                continue;
+            }
+
+            const bool is_array = dynamic_element.isDynamicArray();
+            size_t array_size = 1;
+            if (is_array) {
+                size_t size_element = no_index;
+                array_size = getArraySize(dynamic_element, scope, sibling_instances, size_element);
+                _dynamic_layout._arrays.push_back({size_element,
+                                                   scope,
+                                                   _dynamic_layout._elements.size(),
+                                                   _dynamic_layout._instances.size(),
+                                                   array_size,
+                                                   offsets,
+                                                   getEntrySize(dynamic_element),
+                                                   &dynamic_element});
+            }
+            sibling_instances[index] = _dynamic_layout._instances.size();
+            for (size_t array_index = 0; array_index < array_size; ++array_index) {
+                RETURN_IF_FAILED(addDynamicElement(
+                    dynamic_element, is_array ? array_index : no_index, scope, offsets));
+            }
+
+            moveToAlignment(offsets.deserialized, dynamic_element.alignment);
+        }
+
+        return a_util::result::SUCCESS;
+    }
+
+    a_util::result::Result addDynamicElement(const DynamicStructLayoutElement& dynamic_element,
+                                             size_t array_index,
+                                             size_t scope,
+                                             Offsets& offsets)
+    {
+        const size_t instance = _dynamic_layout._instances.size();
+        _dynamic_layout._instances.push_back(
+            {scope, &dynamic_element, array_index, _dynamic_layout._elements.size()});
+
+        const Offsets start = offsets;
+        for (const auto& static_element: dynamic_element.static_elements) {
+            StructLayoutElement element = makeElement(static_element, start);
+            offsets.deserialized = element.deserialized.bit_offset + element.deserialized.bit_size;
+            offsets.serialized = element.serialized.bit_offset + element.serialized.bit_size;
+            if (byName()) {
+                const Position& position =
+                    _rep == deserialized ? element.deserialized : element.serialized;
+                if (position.bit_offset + position.bit_size > _data_size * 8) {
+                    return ERR_INVALID_ARG;
+                }
+            }
+            _dynamic_layout._elements.push_back(std::move(element));
+            _dynamic_layout._name_sources.push_back({instance, &static_element});
+        }
+
+        if (byName()) {
+            // the following array sizes may refer to the new elements
+            _dynamic_layout.buildNames();
+        }
+
+        return addDynamicElements(dynamic_element.dynamic_elements, instance, offsets);
+    }
+
+    size_t getArraySize(const DynamicStructLayoutElement& dynamic_element,
+                        size_t scope,
+                        const std::vector<size_t>& sibling_instances,
+                        size_t& size_element_index)
+    {
+        if (!byName()) {
+            size_element_index = getSizeElementIndex(dynamic_element, scope, sibling_instances);
+            return _next_array_size < _array_sizes->size() ? (*_array_sizes)[_next_array_size++] :
+                                                             0;
+        }
+
+        std::string size_element_name = dynamic_element.size_element_name;
+        if (scope != no_index) {
+            size_element_name =
+                _dynamic_layout._instance_names[scope] + "." + dynamic_element.size_element_name;
+        }
+
+        const StructLayoutElement* size_element = nullptr;
+        size_t index = 0;
+        if (_layout.getStaticElementIndex().find(size_element_name, index)) {
+            size_element = &_layout.getStaticElements()[index];
+            size_element_index = index;
+        }
+        else if (_dynamic_layout._element_index.find(size_element_name, index)) {
+            size_element = &_dynamic_layout._elements[index - _layout.getStaticElements().size()];
+            size_element_index = index;
+        }
+
+        a_util::variant::Variant array_size;
+        if (size_element) {
+            const ElementAccessor& accessor = _rep == deserialized ?
+                                                  DeserializedAccessor::getInstance() :
+                                                  SerializedAccessor::getInstance();
+            accessor.getValue(*size_element, _data, _data_size, array_size);
+        }
+        return static_cast<size_t>(array_size.asUInt64());
+    }
+
+    /// The index of the array size element as found by its precomputed reference.
+    size_t getSizeElementIndex(const DynamicStructLayoutElement& dynamic_element,
+                               size_t scope,
+                               const std::vector<size_t>& sibling_instances) const
+    {
+        const ArraySizeReference& reference = dynamic_element.size_reference;
+        if (reference.kind == ArraySizeReference::scope_static) {
+            if (scope == no_index) {
+                return reference.element_index;
+            }
+            return _layout.getStaticElements().size() +
+                   _dynamic_layout._instances[scope].first_element + reference.element_index;
+        }
+        if (reference.kind == ArraySizeReference::sibling &&
+            sibling_instances[reference.sibling_index] != no_index) {
+            return _layout.getStaticElements().size() +
+                   _dynamic_layout._instances[sibling_instances[reference.sibling_index]]
+                       .first_element +
+                   reference.element_index;
+        }
+        return no_index;
+    }
+
+private:
+    DynamicLayout& _dynamic_layout;
+    const StructLayout& _layout;
+    const std::vector<size_t>* _array_sizes;
+    size_t _next_array_size;
+    const void* _data;
+    size_t _data_size;
+    DataRepresentation _rep;
+};
+
+DynamicLayout::DynamicLayout(const StructLayout& layout,
+                             const void* data,
+                             size_t data_size,
+                             DataRepresentation rep)
+    : _static_element_count(layout.getStaticElements().size()), _named_element_count(0)
+{
+    _calculation_result = Builder(*this, layout, nullptr, data, data_size, rep).build();
+    getNamedElements();
+}
+
+DynamicLayout::DynamicLayout(const StructLayout& layout, const std::vector<size_t>& array_sizes)
+    : _static_element_count(layout.getStaticElements().size()), _named_element_count(0)
+{
+    _calculation_result = Builder(*this, layout, &array_sizes, nullptr, 0, deserialized).build();
+}
+
+DynamicLayout::DynamicLayout(const DynamicLayout& previous, size_t array, size_t array_size)
+    : _static_element_count(previous._static_element_count),
+      _calculation_result(previous._calculation_result),
+      _named_element_count(0)
+{
+    const Array& resized = previous._arrays[array];
+    const std::vector<StructLayoutElement>& entry_elements = resized.element->static_elements;
+    const Offsets& entry_size = resized.entry_size;
+    const size_t kept_entries = std::min(resized.array_size, array_size);
+    // the differences wrap around for smaller arrays, which still works for adding them
+    const size_t element_shift = (array_size - resized.array_size) * entry_elements.size();
+    const size_t instance_shift = array_size - resized.array_size;
+    const Offsets shift = {(array_size - resized.array_size) * entry_size.deserialized,
+                           (array_size - resized.array_size) * entry_size.serialized};
+    const size_t kept_elements = resized.first_element + kept_entries * entry_elements.size();
+    const size_t kept_instances = resized.first_instance + kept_entries;
+    const size_t following_element =
+        resized.first_element + resized.array_size * entry_elements.size();
+    const size_t following_instance = resized.first_instance + resized.array_size;
+
+    _elements.reserve(previous._elements.size() + element_shift);
+    _name_sources.reserve(previous._name_sources.size() + element_shift);
+    for (size_t element = 0; element < kept_elements; ++element) {
+        _elements.push_back(makeElement(previous._elements[element], {0, 0}));
+        _name_sources.push_back(previous._name_sources[element]);
+    }
+    _instances.assign(previous._instances.begin(), previous._instances.begin() + kept_instances);
+
+    for (size_t entry = kept_entries; entry < array_size; ++entry) {
+        const Offsets start = {resized.start.deserialized + entry * entry_size.deserialized,
+                               resized.start.serialized + entry * entry_size.serialized};
+        _instances.push_back({resized.scope, resized.element, entry, _elements.size()});
+        for (const StructLayoutElement& entry_element: entry_elements) {
+            _elements.push_back(makeElement(entry_element, start));
+            _name_sources.push_back({_instances.size() - 1, &entry_element});
+        }
+    }
+
+    // the array has no nested dynamic elements, so none of the following ones is part of it
+    const auto move_instance = [&](size_t instance) {
+        return instance != no_index && instance >= following_instance ? instance + instance_shift :
+                                                                        instance;
+    };
+    for (size_t element = following_element; element < previous._elements.size(); ++element) {
+        _elements.push_back(makeElement(previous._elements[element], shift));
+        _name_sources.push_back({move_instance(previous._name_sources[element].instance),
+                                 previous._name_sources[element].element});
+    }
+    for (size_t instance = following_instance; instance < previous._instances.size();
+         ++instance) {
+        Instance moved = previous._instances[instance];
+        moved.parent = move_instance(moved.parent);
+        moved.first_element += element_shift;
+        _instances.push_back(moved);
+    }
+
+    _arrays = previous._arrays;
+    _arrays[array].array_size = array_size;
+    const size_t following_size_element = _static_element_count + following_element;
+    for (size_t following = array + 1; following < _arrays.size(); ++following) {
+        Array& moved = _arrays[following];
+        if (moved.size_element != no_index && moved.size_element >= following_size_element) {
+            moved.size_element += element_shift;
+        }
+        moved.scope = move_instance(moved.scope);
+        moved.first_element += element_shift;
+        moved.first_instance += instance_shift;
+        moved.start.deserialized += shift.deserialized;
+        moved.start.serialized += shift.serialized;
+    }
+
+    _buffer_bit_sizes = {previous._buffer_bit_sizes.deserialized + shift.deserialized,
+                         previous._buffer_bit_sizes.serialized + shift.serialized};
+    _buffer_sizes = {bitsToBytes(_buffer_bit_sizes.deserialized),
+                     bitsToBytes(_buffer_bit_sizes.serialized)};
+}
+
+std::vector<size_t> DynamicLayout::getArraySizes() const
+{
+    std::vector<size_t> array_sizes;
+    array_sizes.reserve(_arrays.size());
+    for (const Array& array: _arrays) {
+        array_sizes.push_back(array.array_size);
+    }
+    return array_sizes;
+}
+
+bool DynamicLayout::isUniformResize(const StructLayout& layout,
+                                    const DynamicLayout& previous,
+                                    size_t array,
+                                    size_t array_size)
+{
+    if (array >= previous._arrays.size() || isFailed(previous._calculation_result)) {
+        return false;
+    }
+    const DynamicStructLayoutElement& element = *previous._arrays[array].element;
+    if (!element.dynamic_elements.empty()) {
+        return false;
+    }
+
+    // the serialized representation has no alignment, the deserialized one is unchanged if the
+    // size difference is a multiple of every alignment
+    const size_t old_size = previous._arrays[array].array_size;
+    const size_t difference = array_size > old_size ? array_size - old_size : old_size - array_size;
+    const size_t alignment = getMaximumAlignment(layout.getDynamicElements());
+    return (difference * previous._arrays[array].entry_size.deserialized) % (alignment * 8) == 0;
+}
+
+a_util::memory::shared_ptr<const DynamicLayout> DynamicLayout::resize(
+    const StructLayout& layout, const DynamicLayout& previous, size_t array, size_t array_size)
+{
+    if (isUniformResize(layout, previous, array, array_size)) {
+        return a_util::memory::shared_ptr<const DynamicLayout>(
+            new DynamicLayout(previous, array, array_size));
+    }
+
+    std::vector<size_t> array_sizes = previous.getArraySizes();
+    if (array < array_sizes.size()) {
+        array_sizes[array] = array_size;
+    }
+    return std::make_shared<const DynamicLayout>(layout, array_sizes);
+}
+
+const std::vector<StructLayoutElement>& DynamicLayout::getNamedElements() const
+{
+    std::call_once(_names_built, [this]() {
+        buildNames();
+        std::vector<std::string>().swap(_instance_names);
+    });
+    return _elements;
+}
+
+const StructElementIndex& DynamicLayout::getElementIndex() const
+{
+    getNamedElements();
+    return _element_index;
+}
+
+void DynamicLayout::buildNames() const
+{
+    for (size_t instance = _instance_names.size(); instance < _instances.size(); ++instance) {
+        const Instance& info = _instances[instance];
+        std::string name =
+            info.parent == no_index ? std::string() : _instance_names[info.parent] + ".";
+        name += info.element->name;
+        if (info.array_index != no_index) {
+            name += a_util::strings::format("[%d]", info.array_index);
+        }
+        _instance_names.push_back(std::move(name));
+    }
+
+    for (size_t element = _named_element_count; element < _elements.size(); ++element) {
+        const NameSource& source = _name_sources[element];
+        const std::string& instance_name = _instance_names[source.instance];
+        _elements[element].name = source.element->name.empty() ?
+                                      instance_name :
+                                      instance_name + "." + source.element->name;
+        _element_index.add(_elements[element].name, _static_element_count + element);
+    }
+    _named_element_count = _elements.size();
+}
+
+bool DynamicLayout::collectArraySizes(const StructLayout& layout,
+                                      const void* data,
+                                      size_t data_size,
+                                      DataRepresentation rep,
+                                      std::vector<size_t>& array_sizes)
+{
+    return collectArraySizesWith(
+        layout, ContiguousArraySizeReader{data, data_size, rep}, data_size, rep, array_sizes);
+}
+
+bool DynamicLayout::collectArraySizes(const StructLayout& layout,
+                                      const ArraySizeReader& read_array_size,
+                                      size_t data_size,
+                                      DataRepresentation rep,
+                                      std::vector<size_t>& array_sizes)
+{
+    return collectArraySizesWith(layout, read_array_size, data_size, rep, array_sizes);
+}
+
+a_util::memory::shared_ptr<DynamicLayoutCache> DynamicLayoutCache::create(
+    const a_util::memory::shared_ptr<const StructLayout>& layout)
+{
+    if (!layout || !layout->hasDynamicElements()) {
+        return {};
+    }
+    return std::make_shared<DynamicLayoutCache>(layout, 256);
+}
+
+DynamicLayoutCache::DynamicLayoutCache(const a_util::memory::shared_ptr<const StructLayout>& layout,
+                                       size_t capacity)
+    : _layout(layout), _capacity(capacity)
+{
+}
+
+a_util::memory::shared_ptr<const DynamicLayout> DynamicLayoutCache::getLayout(
+    const void* data, size_t data_size, DataRepresentation rep)
+{
+    std::vector<size_t> array_sizes;
+    if (!data || !DynamicLayout::collectArraySizes(*_layout, data, data_size, rep, array_sizes)) {
+        // array sizes that can only be found by name or invalid data, calculate it the slow way
+        return std::make_shared<const DynamicLayout>(*_layout, data, data_size, rep);
+    }
+    return getLayout(std::move(array_sizes));
+}
+
+a_util::memory::shared_ptr<const DynamicLayout> DynamicLayoutCache::getLayout(
+    std::vector<size_t> array_sizes)
+{
+    auto dynamic_layout = find(array_sizes);
+    if (dynamic_layout) {
+        return dynamic_layout;
+    }
+    dynamic_layout = std::make_shared<const DynamicLayout>(*_layout, array_sizes);
+    return insert(std::move(array_sizes), dynamic_layout);
+}
+
+a_util::memory::shared_ptr<const DynamicLayout> DynamicLayoutCache::getResizedLayout(
+    const DynamicLayout& previous, size_t array, size_t array_size)
+{
+    std::vector<size_t> array_sizes = previous.getArraySizes();
+    array_sizes[array] = array_size;
+    auto dynamic_layout = find(array_sizes);
+    if (dynamic_layout) {
+        return dynamic_layout;
+    }
+    dynamic_layout = DynamicLayout::resize(*_layout, previous, array, array_size);
+    return insert(std::move(array_sizes), dynamic_layout);
+}
+
+a_util::memory::shared_ptr<const DynamicLayout> DynamicLayoutCache::find(
+    const std::vector<size_t>& array_sizes)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto found = _layouts.find(array_sizes);
+    return found != _layouts.end() ? found->second :
+                                     a_util::memory::shared_ptr<const DynamicLayout>();
+}
+
+a_util::memory::shared_ptr<const DynamicLayout> DynamicLayoutCache::insert(
+    std::vector<size_t> array_sizes, a_util::memory::shared_ptr<const DynamicLayout> layout)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_layouts.size() >= _capacity) {
+        // keep it simple, the sizes of real data hardly ever vary that much
+        _layouts.clear();
+    }
+    return _layouts.emplace(std::move(array_sizes), layout).first->second;
+}
+
+size_t DynamicLayoutCache::ArraySizesHash::operator()(const std::vector<size_t>& array_sizes) const
+{
+    size_t hash = array_sizes.size();
+    for (size_t array_size: array_sizes) {
+        hash ^= std::hash<size_t>()(array_size) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+} // namespace ddl
@@ -0,0 +1,242 @@
+/**
+ * @file
+ * Layout of the dynamic elements of a struct for one set of array sizes.
+ *
+ * Copyright @ 2021 VW Group. All rights reserved.
+ *
+ *     This Source Code Form is subject to the terms of the Mozilla
+ *     Public License, v. 2.0. If a copy of the MPL was not distributed
+ *     with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * If it is not possible or desirable to put the notice in a particular file, then
+ * You may include the notice in a location (such as a LICENSE file in a
+ * relevant directory) where a recipient would be likely to look for such a notice.
+ *
+ * You may add additional accurate notices of copyright ownership.
+ */
+
+#ifndef DDL_DYNAMIC_LAYOUT_CLASS_HEADER
+#define DDL_DYNAMIC_LAYOUT_CLASS_HEADER
+
+#include "a_util/memory.h"
+#include "a_util/result.h"
+#include "ddl/codec/struct_element.h"
+
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ddl {
+class StructLayout;
+
+/**
+ * @internal
+ * This class is for internal use only.
+ *
+ * The elements following the first dynamic array of a struct, calculated for one set of array
+ * sizes. The names of the elements are only built on first request.
+ */
+class DynamicLayout {
+public:
+    /**
+     * Calculates the dynamic elements by reading the array sizes by name from the data, checking
+     * every element against the data size.
+     */
+    DynamicLayout(const StructLayout& layout,
+                  const void* data,
+                  size_t data_size,
+                  DataRepresentation rep);
+
+    /**
+     * Calculates the dynamic elements for the given array sizes in the order they are found
+     * while walking the dynamic elements.
+     */
+    DynamicLayout(const StructLayout& layout, const std::vector<size_t>& array_sizes);
+
+    DynamicLayout(const DynamicLayout&) = delete;
+    DynamicLayout& operator=(const DynamicLayout&) = delete;
+
+    a_util::result::Result getCalculationResult() const
+    {
+        return _calculation_result;
+    }
+
+    /// The elements, the names are not necessarily set.
+    const std::vector<StructLayoutElement>& getElements() const
+    {
+        return _elements;
+    }
+
+    /// The elements with their names.
+    const std::vector<StructLayoutElement>& getNamedElements() const;
+
+    /// The name lookup of the elements, indices start after the static elements.
+    const StructElementIndex& getElementIndex() const;
+
+    /// The overall buffer sizes in bytes.
+    const Offsets& getBufferSizes() const
+    {
+        return _buffer_sizes;
+    }
+
+    /// A dynamic array instance of the layout.
+    struct Array {
+        size_t size_element;   ///< index of the array size element (static ones first) or -1
+        size_t scope;          ///< instance containing the array or -1 for the top level
+        size_t first_element;  ///< index of the first element of the array in getElements()
+        size_t first_instance; ///< index of the instance of the first array entry
+        size_t array_size;     ///< the number of entries
+        Offsets start;         ///< bit offsets of the first array entry
+        Offsets entry_size;    ///< bit sizes of an entry without nested dynamic elements
+        const DynamicStructLayoutElement* element;
+    };
+
+    /// The arrays in the order of their array sizes.
+    const std::vector<Array>& getArrays() const
+    {
+        return _arrays;
+    }
+
+    /// The array sizes in the order of DynamicLayout::collectArraySizes.
+    std::vector<size_t> getArraySizes() const;
+
+    /**
+     * Whether changing the size of an array without nested dynamic elements moves all following
+     * elements by the same offsets. This is the case if the size difference of the array keeps
+     * all alignments of the following elements.
+     */
+    static bool isUniformResize(const StructLayout& layout,
+                                const DynamicLayout& previous,
+                                size_t array,
+                                size_t array_size);
+
+    /**
+     * Calculates the layout after changing the size of an array. Only the offsets of the
+     * following elements are moved in case of a uniform resize, otherwise all elements are
+     * calculated again.
+     */
+    static a_util::memory::shared_ptr<const DynamicLayout> resize(const StructLayout& layout,
+                                                                  const DynamicLayout& previous,
+                                                                  size_t array,
+                                                                  size_t array_size);
+
+    /**
+     * Collects the array sizes of the data without creating any element. Fails if one of the
+     * array size elements can only be resolved by name or if the data is too small.
+     */
+    static bool collectArraySizes(const StructLayout& layout,
+                                  const void* data,
+                                  size_t data_size,
+                                  DataRepresentation rep,
+                                  std::vector<size_t>& array_sizes);
+
+    /// Reads the value of an array size element, positioned relative to the given start.
+    typedef std::function<bool(const StructLayoutElement& element,
+                               const Offsets& start,
+                               size_t& array_size)>
+        ArraySizeReader;
+
+    /**
+     * Same as above, but for data that is not contiguous, the array sizes are read through the
+     * given reader.
+     */
+    static bool collectArraySizes(const StructLayout& layout,
+                                  const ArraySizeReader& read_array_size,
+                                  size_t data_size,
+                                  DataRepresentation rep,
+                                  std::vector<size_t>& array_sizes);
+
+private:
+    struct Instance {
+        size_t parent;
+        const DynamicStructLayoutElement* element;
+        size_t array_index;
+        size_t first_element;
+    };
+
+    struct NameSource {
+        size_t instance;
+        const StructLayoutElement* element;
+    };
+
+    class Builder;
+
+    /// Moves the elements following the resized array of previous, see resize.
+    DynamicLayout(const DynamicLayout& previous, size_t array, size_t array_size);
+
+    void buildNames() const;
+
+private:
+    mutable std::vector<StructLayoutElement> _elements;
+    std::vector<Instance> _instances;
+    std::vector<NameSource> _name_sources;
+    std::vector<Array> _arrays;
+    Offsets _buffer_sizes;
+    Offsets _buffer_bit_sizes;
+    size_t _static_element_count;
+    a_util::result::Result _calculation_result;
+    mutable size_t _named_element_count;
+    mutable std::vector<std::string> _instance_names;
+    mutable StructElementIndex _element_index;
+    mutable std::once_flag _names_built;
+};
+
+/**
+ * @internal
+ * This class is for internal use only.
+ *
+ * Thread safe cache of the dynamic layouts of a struct layout, keyed by their array sizes.
+ */
+class DynamicLayoutCache {
+public:
+    /**
+     * @return A new cache for the layout or nullptr if the layout has no dynamic elements.
+     */
+    static a_util::memory::shared_ptr<DynamicLayoutCache> create(
+        const a_util::memory::shared_ptr<const StructLayout>& layout);
+
+    DynamicLayoutCache(const a_util::memory::shared_ptr<const StructLayout>& layout,
+                       size_t capacity);
+
+    /**
+     * @return The dynamic layout of the data, either a cached one or a newly calculated one.
+     */
+    a_util::memory::shared_ptr<const DynamicLayout> getLayout(const void* data,
+                                                              size_t data_size,
+                                                              DataRepresentation rep);
+
+    /**
+     * @return The dynamic layout for the given array sizes, in the order of
+     *         DynamicLayout::collectArraySizes, either a cached one or a newly calculated one.
+     */
+    a_util::memory::shared_ptr<const DynamicLayout> getLayout(std::vector<size_t> array_sizes);
+
+    /**
+     * @return The dynamic layout after changing the size of an array of previous, either a cached
+     *         one or one calculated by DynamicLayout::resize.
+     */
+    a_util::memory::shared_ptr<const DynamicLayout> getResizedLayout(
+        const DynamicLayout& previous, size_t array, size_t array_size);
+
+private:
+    struct ArraySizesHash {
+        size_t operator()(const std::vector<size_t>& array_sizes) const;
+    };
+
+    a_util::memory::shared_ptr<const DynamicLayout> find(const std::vector<size_t>& array_sizes);
+    a_util::memory::shared_ptr<const DynamicLayout> insert(
+        std::vector<size_t> array_sizes, a_util::memory::shared_ptr<const DynamicLayout> layout);
+
+    a_util::memory::shared_ptr<const StructLayout> _layout;
+    size_t _capacity;
+    std::mutex _mutex;
+    std::unordered_map<std::vector<size_t>,
+                       a_util::memory::shared_ptr<const DynamicLayout>,
+                       ArraySizesHash>
+        _layouts;
+};
+
+} // namespace ddl
+
+#endif
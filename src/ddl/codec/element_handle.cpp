@@ -0,0 +1,60 @@
+/**
+ * @file
+ * Implementation of the typed element handles.
+ *
+ * Copyright @ 2021 VW Group. All rights reserved.
+ *
+ *     This Source Code Form is subject to the terms of the Mozilla
+ *     Public License, v. 2.0. If a copy of the MPL was not distributed
+ *     with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * If it is not possible or desirable to put the notice in a particular file, then
+ * You may include the notice in a location (such as a LICENSE file in a
+ * relevant directory) where a recipient would be likely to look for such a notice.
+ *
+ * You may add additional accurate notices of copyright ownership.
+ */
+
+#include "ddl/codec/element_handle.h"
+
+#include "a_util/result/error_def.h"
+#include "ddl/legacy_error_macros.h"
+
+namespace ddl {
+namespace detail {
+// define all needed error types and values locally
+_MAKE_RESULT(-42, ERR_INVALID_TYPE);
+
+a_util::result::Result resolveElementHandle(const CodecFactory& factory,
+                                            size_t element_index,
+                                            DataRepresentation rep,
+                                            a_util::variant::VariantType type,
+                                            size_t type_size,
+                                            ElementHandleInfo& info)
+{
+    const StructElement* element = nullptr;
+    RETURN_IF_FAILED(factory.getStaticElement(element_index, element));
+    if (element->type != type) {
+        return ERR_INVALID_TYPE;
+    }
+
+    // the elements of a factory are always the layout elements of its struct layout
+    const StructLayoutElement& layout_element = *static_cast<const StructLayoutElement*>(element);
+    const Position& position =
+        rep == deserialized ? layout_element.deserialized : layout_element.serialized;
+
+    info.byte_offset = position.bit_offset / 8;
+    info.bit_offset = position.bit_offset;
+    info.bit_size = position.bit_size;
+    info.byte_aligned = position.bit_offset % 8 == 0 && position.bit_size == type_size * 8;
+    info.byte_order = rep == deserialized ?
+                          a_util::memory::get_platform_endianess() :
+                          static_cast<a_util::memory::Endianess>(layout_element.byte_order);
+    info.swap_bytes = a_util::memory::detail::needsByteSwap(info.byte_order);
+    info.representation = rep;
+
+    return a_util::result::SUCCESS;
+}
+
+} // namespace detail
+} // namespace ddl
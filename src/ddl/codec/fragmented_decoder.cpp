@@ -0,0 +1,410 @@
+/**
+ * @file
+ * Implementation of the fragmented decoder.
+ *
+ * Copyright @ 2021 VW Group. All rights reserved.
+ *
+ *     This Source Code Form is subject to the terms of the Mozilla
+ *     Public License, v. 2.0. If a copy of the MPL was not distributed
+ *     with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * If it is not possible or desirable to put the notice in a particular file, then
+ * You may include the notice in a location (such as a LICENSE file in a
+ * relevant directory) where a recipient would be likely to look for such a notice.
+ *
+ * You may add additional accurate notices of copyright ownership.
+ */
+
+#include "ddl/codec/fragmented_decoder.h"
+
+#include "a_util/result/error_def.h"
+#include "ddl/codec/bitserializer.h"
+#include "ddl/legacy_error_macros.h"
+#include "dynamic_layout.h"
+#include "element_accessor.h"
+#include "struct_layout.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ddl {
+// define all needed error types and values locally
+_MAKE_RESULT(-5, ERR_INVALID_ARG);
+_MAKE_RESULT(-10, ERR_INVALID_INDEX);
+_MAKE_RESULT(-19, ERR_NOT_SUPPORTED);
+_MAKE_RESULT(-20, ERR_NOT_FOUND);
+_MAKE_RESULT(-37, ERR_NOT_INITIALIZED);
+
+namespace {
+/// The largest number of bytes a single element can span, a 64 bit value at any bit position.
+constexpr size_t max_element_bytes = 9;
+
+template <typename T>
+a_util::variant::Variant toTypedVariant(const uint8_t* value)
+{
+    T typed_value;
+    std::memcpy(&typed_value, value, sizeof(T));
+    return a_util::variant::Variant(typed_value);
+}
+
+a_util::variant::Variant toVariant(a_util::variant::VariantType type, const uint8_t* value)
+{
+    switch (type) {
+    case a_util::variant::VT_Bool:
+        return toTypedVariant<bool>(value);
+    case a_util::variant::VT_Int8:
+        return toTypedVariant<int8_t>(value);
+    case a_util::variant::VT_UInt8:
+        return toTypedVariant<uint8_t>(value);
+    case a_util::variant::VT_Int16:
+        return toTypedVariant<int16_t>(value);
+    case a_util::variant::VT_UInt16:
+        return toTypedVariant<uint16_t>(value);
+    case a_util::variant::VT_Int32:
+        return toTypedVariant<int32_t>(value);
+    case a_util::variant::VT_UInt32:
+        return toTypedVariant<uint32_t>(value);
+    case a_util::variant::VT_Int64:
+        return toTypedVariant<int64_t>(value);
+    case a_util::variant::VT_UInt64:
+        return toTypedVariant<uint64_t>(value);
+    case a_util::variant::VT_Float:
+        return toTypedVariant<float>(value);
+    case a_util::variant::VT_Double:
+        return toTypedVariant<double>(value);
+    default:
+        return a_util::variant::Variant();
+    }
+}
+
+} // namespace
+
+FragmentedDecoder::FragmentedDecoder()
+    : _data_size(0), _representation(deserialized), _result(ERR_NOT_INITIALIZED)
+{
+}
+
+FragmentedDecoder::FragmentedDecoder(a_util::memory::shared_ptr<const StructLayout> layout,
+                                     a_util::memory::shared_ptr<DynamicLayoutCache> dynamic_layouts,
+                                     const std::vector<DataFragment>& fragments,
+                                     DataRepresentation rep)
+    : _layout(layout), _data_size(0), _representation(rep), _result(layout->isValid())
+{
+    _fragments.reserve(fragments.size());
+    _fragment_offsets.reserve(fragments.size());
+    for (const DataFragment& fragment: fragments) {
+        // empty fragments would make the lookup of the fragment of an offset ambiguous
+        if (fragment.data && fragment.size) {
+            _fragments.push_back(fragment);
+            _fragment_offsets.push_back(_data_size);
+            _data_size += fragment.size;
+        }
+    }
+
+    if (isFailed(_result) || !_layout->hasDynamicElements()) {
+        return;
+    }
+    if (_layout->hasProjectedDynamicElements()) {
+        _result = ERR_NOT_SUPPORTED;
+        return;
+    }
+
+    std::vector<size_t> array_sizes;
+    const bool array_sizes_collected = DynamicLayout::collectArraySizes(
+        *_layout,
+        [this](const StructLayoutElement& element, const Offsets& start, size_t& array_size) {
+            const size_t bit_offset =
+                _representation == deserialized ?
+                    element.deserialized.bit_offset + start.deserialized :
+                    element.serialized.bit_offset + start.serialized;
+            uint8_t value[sizeof(uint64_t)];
+            if (isFailed(readValue(element, bit_offset, value))) {
+                return false;
+            }
+            // use the same conversion as the lookup by name
+            array_size =
+                static_cast<size_t>(toVariant(element.type, value).asUInt64());
+            return true;
+        },
+        _data_size,
+        _representation,
+        array_sizes);
+
+    if (array_sizes_collected && dynamic_layouts) {
+        _dynamic_layout = dynamic_layouts->getLayout(std::move(array_sizes));
+    }
+    else {
+        // array sizes that can only be found by name, calculate it on a contiguous copy
+        std::vector<uint8_t> data;
+        data.reserve(_data_size);
+        for (const DataFragment& fragment: _fragments) {
+            const uint8_t* fragment_data = static_cast<const uint8_t*>(fragment.data);
+            data.insert(data.end(), fragment_data, fragment_data + fragment.size);
+        }
+        _dynamic_layout =
+            std::make_shared<const DynamicLayout>(*_layout, data.data(), data.size(), rep);
+    }
+    _result = _dynamic_layout->getCalculationResult();
+}
+
+a_util::result::Result FragmentedDecoder::isValid() const
+{
+    RETURN_IF_FAILED(_result);
+    if (_data_size < getBufferSize(_representation)) {
+        return ERR_INVALID_ARG;
+    }
+    return a_util::result::SUCCESS;
+}
+
+size_t FragmentedDecoder::findFragment(size_t byte_offset) const
+{
+    return std::upper_bound(_fragment_offsets.begin(), _fragment_offsets.end(), byte_offset) -
+           _fragment_offsets.begin() - 1;
+}
+
+a_util::result::Result FragmentedDecoder::readValue(const StructLayoutElement& element,
+                                                    size_t bit_offset,
+                                                    void* value) const
+{
+    const size_t bit_size = _representation == deserialized ? element.deserialized.bit_size :
+                                                              element.serialized.bit_size;
+    const size_t first_byte = bit_offset / 8;
+    const size_t byte_count = (bit_offset % 8 + bit_size + 7) / 8;
+    if (first_byte + byte_count > _data_size || byte_count == 0) {
+        return ERR_INVALID_ARG;
+    }
+
+    size_t fragment = findFragment(first_byte);
+    size_t fragment_offset = first_byte - _fragment_offsets[fragment];
+    const uint8_t* data = static_cast<const uint8_t*>(_fragments[fragment].data) + fragment_offset;
+    uint8_t assembled[max_element_bytes];
+    if (fragment_offset + byte_count > _fragments[fragment].size) {
+        // the only case in which the bytes are copied
+        if (byte_count > max_element_bytes) {
+            return ERR_NOT_SUPPORTED;
+        }
+        for (size_t assembled_count = 0; assembled_count < byte_count; ++fragment) {
+            const size_t count =
+                std::min(byte_count - assembled_count, _fragments[fragment].size - fragment_offset);
+            std::memcpy(assembled + assembled_count,
+                        static_cast<const uint8_t*>(_fragments[fragment].data) + fragment_offset,
+                        count);
+            assembled_count += count;
+            fragment_offset = 0;
+        }
+        data = assembled;
+    }
+
+    if (bit_offset % 8 == 0 && bit_size == element.deserialized.bit_size &&
+        byte_count <= sizeof(uint64_t)) {
+        // whole bytes, no need for the bit accessor
+        std::memcpy(value, data, byte_count);
+        if (_representation == serialized && byte_count > 1 &&
+            a_util::memory::detail::needsByteSwap(
+                static_cast<a_util::memory::Endianess>(element.byte_order))) {
+            std::reverse(static_cast<uint8_t*>(value), static_cast<uint8_t*>(value) + byte_count);
+        }
+        return a_util::result::SUCCESS;
+    }
+
+    // the element relative to the first byte
+    StructLayoutElement relative_element;
+    relative_element.type = element.type;
+    relative_element.p_enum = nullptr;
+    relative_element.p_enum_names = nullptr;
+    relative_element.byte_order = element.byte_order;
+    relative_element.constant = nullptr;
+    relative_element.deserialized = {bit_offset % 8, element.deserialized.bit_size};
+    relative_element.serialized = {bit_offset % 8, element.serialized.bit_size};
+    const ElementAccessor& accessor = _representation == deserialized ?
+                                          DeserializedAccessor::getInstance() :
+                                          SerializedAccessor::getInstance();
+    return accessor.getValue(relative_element, data, byte_count, value);
+}
+
+const StructLayoutElement* FragmentedDecoder::getLayoutElement(size_t index) const
+{
+    const std::vector<StructLayoutElement>& static_elements = _layout->getStaticElements();
+    if (index < static_elements.size()) {
+        return &static_elements[index];
+    }
+    index -= static_elements.size();
+    if (_dynamic_layout && index < _dynamic_layout->getElements().size()) {
+        return &_dynamic_layout->getElements()[index];
+    }
+    return nullptr;
+}
+
+size_t FragmentedDecoder::getElementCount() const
+{
+    if (!_layout) {
+        return 0;
+    }
+    return _layout->getStaticElements().size() +
+           (_dynamic_layout ? _dynamic_layout->getElements().size() : 0);
+}
+
+a_util::result::Result FragmentedDecoder::getElement(size_t index,
+                                                     const StructElement*& element) const
+{
+    const size_t static_element_count = _layout ? _layout->getStaticElements().size() : 0;
+    if (index < static_element_count) {
+        element = &_layout->getStaticElements()[index];
+        return a_util::result::SUCCESS;
+    }
+    if (_dynamic_layout && index - static_element_count < _dynamic_layout->getElements().size()) {
+        element = &_dynamic_layout->getNamedElements()[index - static_element_count];
+        return a_util::result::SUCCESS;
+    }
+    return ERR_INVALID_INDEX;
+}
+
+a_util::result::Result FragmentedDecoder::findElementIndex(const std::string& element_name,
+                                                           size_t& index) const
+{
+    if (_layout && _layout->getStaticElementIndex().find(element_name, index)) {
+        return a_util::result::SUCCESS;
+    }
+    if (_dynamic_layout && _dynamic_layout->getElementIndex().find(element_name, index)) {
+        return a_util::result::SUCCESS;
+    }
+    return ERR_NOT_FOUND;
+}
+
+a_util::result::Result FragmentedDecoder::findElementIndexByPrefix(const std::string& prefix,
+                                                                   size_t& index) const
+{
+    // static elements always precede the dynamic ones, so the static index wins
+    if (_layout && _layout->getStaticElementIndex().findPrefix(prefix, index)) {
+        return a_util::result::SUCCESS;
+    }
+    if (_dynamic_layout && _dynamic_layout->getElementIndex().findPrefix(prefix, index)) {
+        return a_util::result::SUCCESS;
+    }
+    return ERR_NOT_FOUND;
+}
+
+a_util::result::Result FragmentedDecoder::getElementValue(size_t index, void* value) const
+{
+    const StructLayoutElement* element = _layout ? getLayoutElement(index) : nullptr;
+    if (!element) {
+        return ERR_INVALID_INDEX;
+    }
+    return readValue(*element,
+                     _representation == deserialized ? element->deserialized.bit_offset :
+                                                       element->serialized.bit_offset,
+                     value);
+}
+
+a_util::result::Result FragmentedDecoder::getElementValue(size_t index,
+                                                          a_util::variant::Variant& value) const
+{
+    const StructLayoutElement* element = _layout ? getLayoutElement(index) : nullptr;
+    if (!element) {
+        return ERR_INVALID_INDEX;
+    }
+    uint8_t raw_value[sizeof(uint64_t)];
+    RETURN_IF_FAILED(getElementValue(index, raw_value));
+    value = toVariant(element->type, raw_value);
+    if (value.isEmpty()) {
+        return ERR_NOT_SUPPORTED;
+    }
+    return a_util::result::SUCCESS;
+}
+
+a_util::result::Result FragmentedDecoder::getElementValues(size_t first_index,
+                                                           size_t count,
+                                                           void* values) const
+{
+    uint8_t* destination = static_cast<uint8_t*>(values);
+    for (size_t index = first_index; index < first_index + count; ++index) {
+        const StructLayoutElement* element = _layout ? getLayoutElement(index) : nullptr;
+        if (!element) {
+            return ERR_INVALID_INDEX;
+        }
+        RETURN_IF_FAILED(getElementValue(index, destination));
+        destination += element->deserialized.bit_size / 8;
+    }
+    return a_util::result::SUCCESS;
+}
+
+const void* FragmentedDecoder::getElementAddress(size_t index) const
+{
+    const StructLayoutElement* element = _layout ? getLayoutElement(index) : nullptr;
+    if (!element) {
+        return nullptr;
+    }
+
+    const Position& position =
+        _representation == deserialized ? element->deserialized : element->serialized;
+    if (position.bit_offset % 8) {
+        return nullptr;
+    }
+    const size_t first_byte = position.bit_offset / 8;
+    const size_t byte_count = (position.bit_size + 7) / 8;
+    if (first_byte + byte_count > _data_size) {
+        return nullptr;
+    }
+    const size_t fragment = findFragment(first_byte);
+    const size_t fragment_offset = first_byte - _fragment_offsets[fragment];
+    if (fragment_offset + byte_count > _fragments[fragment].size) {
+        return nullptr;
+    }
+    return static_cast<const uint8_t*>(_fragments[fragment].data) + fragment_offset;
+}
+
+a_util::result::Result FragmentedDecoder::getElementRange(size_t first_index,
+                                                          size_t end_index,
+                                                          const void*& start_address,
+                                                          size_t& size) const
+{
+    const StructLayoutElement* element = _layout ? getLayoutElement(first_index) : nullptr;
+    if (!element || end_index <= first_index) {
+        return ERR_INVALID_INDEX;
+    }
+    const Position& position =
+        _representation == deserialized ? element->deserialized : element->serialized;
+    if (position.bit_offset % 8) {
+        return ERR_NOT_SUPPORTED;
+    }
+    const size_t first_byte = position.bit_offset / 8;
+    size_t end_byte = getBufferSize(_representation);
+    if (end_index < getElementCount()) {
+        const StructLayoutElement* end_element = getLayoutElement(end_index);
+        const Position& end_position =
+            _representation == deserialized ? end_element->deserialized : end_element->serialized;
+        end_byte = (end_position.bit_offset + 7) / 8;
+    }
+    if (end_byte <= first_byte || end_byte > _data_size) {
+        return ERR_INVALID_INDEX;
+    }
+    const size_t fragment = findFragment(first_byte);
+    const size_t fragment_offset = first_byte - _fragment_offsets[fragment];
+    if (fragment_offset + (end_byte - first_byte) > _fragments[fragment].size) {
+        return ERR_NOT_SUPPORTED;
+    }
+    start_address = static_cast<const uint8_t*>(_fragments[fragment].data) + fragment_offset;
+    size = end_byte - first_byte;
+    return a_util::result::SUCCESS;
+}
+
+size_t FragmentedDecoder::getStaticBufferSize(DataRepresentation rep) const
+{
+    return _layout ? _layout->getStaticBufferSize(rep) : 0;
+}
+
+size_t FragmentedDecoder::getBufferSize(DataRepresentation rep) const
+{
+    if (_dynamic_layout) {
+        return rep == deserialized ? _dynamic_layout->getBufferSizes().deserialized :
+                                     _dynamic_layout->getBufferSizes().serialized;
+    }
+    return getStaticBufferSize(rep);
+}
+
+DataRepresentation FragmentedDecoder::getRepresentation() const
+{
+    return _representation;
+}
+
+} // namespace ddl
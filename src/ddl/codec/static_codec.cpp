@@ -18,13 +18,18 @@
 #include "ddl/codec/static_codec.h"
 
 #include "a_util/result/error_def.h"
+#include "byte_swap.h"
+#include "ddl/codec/bitserializer.h"
 #include "ddl/legacy_error_macros.h"
 #include "element_accessor.h"
 
+#include <cstring>
+
 namespace ddl {
 // define all needed error types and values locally
 _MAKE_RESULT(-5, ERR_INVALID_ARG);
 _MAKE_RESULT(-10, ERR_INVALID_INDEX);
+_MAKE_RESULT(-20, ERR_NOT_FOUND);
 
 StaticDecoder::StaticDecoder(a_util::memory::shared_ptr<const StructLayout> pLayout,
                              const void* pData,
@@ -55,7 +60,7 @@ size_t StaticDecoder::getElementCount() const
 a_util::result::Result StaticDecoder::getElement(size_t nIndex,
                                                  const StructElement*& pElement) const
 {
-    pElement = getLayoutElement(nIndex);
+    pElement = getNamedLayoutElement(nIndex);
     if (!pElement) {
         return ERR_INVALID_INDEX;
     }
@@ -63,6 +68,24 @@ a_util::result::Result StaticDecoder::getElement(size_t nIndex,
     return a_util::result::SUCCESS;
 }
 
+a_util::result::Result StaticDecoder::findElementIndex(const std::string& element_name,
+                                                       size_t& index) const
+{
+    if (_layout->getStaticElementIndex().find(element_name, index)) {
+        return a_util::result::SUCCESS;
+    }
+    return ERR_NOT_FOUND;
+}
+
+a_util::result::Result StaticDecoder::findElementIndexByPrefix(const std::string& prefix,
+                                                               size_t& index) const
+{
+    if (_layout->getStaticElementIndex().findPrefix(prefix, index)) {
+        return a_util::result::SUCCESS;
+    }
+    return ERR_NOT_FOUND;
+}
+
 a_util::result::Result StaticDecoder::getElementValue(size_t nIndex, void* pValue) const
 {
     const StructLayoutElement* pElement = getLayoutElement(nIndex);
@@ -82,6 +105,75 @@ a_util::result::Result StaticDecoder::getElementValue(size_t nIndex,
     return _element_accessor->getValue(*pElement, _data, _data_size, oValue);
 }
 
+a_util::result::Result StaticDecoder::getElementValues(size_t nFirstIndex,
+                                                       size_t nCount,
+                                                       void* pValues) const
+{
+    const DataRepresentation eRep = getRepresentation();
+    Position StructLayoutElement::*pPosition = eRep == deserialized ?
+                                                   &StructLayoutElement::deserialized :
+                                                   &StructLayoutElement::serialized;
+    const std::vector<StructLayoutElement>& oStaticElements = _layout->getStaticElements();
+    uint8_t* pDestination = static_cast<uint8_t*>(pValues);
+    const size_t nEndIndex = nFirstIndex + nCount;
+    size_t nIndex = nFirstIndex;
+    while (nIndex < nEndIndex) {
+        const StructLayoutElement* pElement = getLayoutElement(nIndex);
+        if (!pElement) {
+            return ERR_INVALID_INDEX;
+        }
+        const Position& sPosition = pElement->*pPosition;
+        const size_t nItemSize = pElement->deserialized.bit_size / 8;
+        if (sPosition.bit_offset % 8 != 0 || sPosition.bit_size != nItemSize * 8) {
+            // bit-packed elements are converted one by one
+            RETURN_IF_FAILED(
+                _element_accessor->getValue(*pElement, _data, _data_size, pDestination));
+            pDestination += nItemSize;
+            ++nIndex;
+            continue;
+        }
+
+        // collect the run of adjacent elements with the same size and byte order, static
+        // elements are accessed directly since arrays usually consist of thousands of them
+        size_t nItemCount = 1;
+        for (; nIndex + nItemCount < nEndIndex; ++nItemCount) {
+            const size_t nNextIndex = nIndex + nItemCount;
+            const StructLayoutElement* pNext = nNextIndex < oStaticElements.size() ?
+                                                   &oStaticElements[nNextIndex] :
+                                                   getLayoutElement(nNextIndex);
+            if (!pNext) {
+                break;
+            }
+            const Position& sNext = pNext->*pPosition;
+            if (pNext->deserialized.bit_size != sPosition.bit_size ||
+                sNext.bit_size != sPosition.bit_size ||
+                sNext.bit_offset != sPosition.bit_offset + nItemCount * sPosition.bit_size ||
+                pNext->byte_order != pElement->byte_order) {
+                break;
+            }
+        }
+
+        const size_t nByteOffset = sPosition.bit_offset / 8;
+        const size_t nByteCount = nItemCount * nItemSize;
+        if (nByteOffset + nByteCount > _data_size) {
+            return ERR_INVALID_ARG;
+        }
+        const uint8_t* pSource = static_cast<const uint8_t*>(_data) + nByteOffset;
+        if (eRep == serialized && nItemSize > 1 &&
+            a_util::memory::detail::needsByteSwap(
+                static_cast<a_util::memory::Endianess>(pElement->byte_order))) {
+            swapByteOrder(pSource, pDestination, nItemSize, nItemCount);
+        }
+        else {
+            std::memcpy(pDestination, pSource, nByteCount);
+        }
+        pDestination += nByteCount;
+        nIndex += nItemCount;
+    }
+
+    return a_util::result::SUCCESS;
+}
+
 const void* StaticDecoder::getElementAddress(size_t nIndex) const
 {
     const StructLayoutElement* pElement = getLayoutElement(nIndex);
@@ -118,6 +210,11 @@ const StructLayoutElement* StaticDecoder::getLayoutElement(size_t nIndex) const
     return pElement;
 }
 
+const StructLayoutElement* StaticDecoder::getNamedLayoutElement(size_t nIndex) const
+{
+    return getLayoutElement(nIndex);
+}
+
 size_t StaticDecoder::getStaticBufferSize(DataRepresentation eRep) const
 {
     return _layout->getStaticBufferSize(eRep);
@@ -163,14 +260,8 @@ void* StaticCodec::getElementAddress(size_t nIndex)
 a_util::result::Result StaticCodec::setConstants()
 {
     if (_layout->hasEnums()) {
-        size_t nElementCount = getElementCount();
-        for (size_t nElement = 0; nElement < nElementCount; ++nElement) {
-            const StructLayoutElement* pElement = getLayoutElement(nElement);
-            if (pElement->constant) {
-                RETURN_IF_FAILED(_element_accessor->setValue(
-                    *pElement, const_cast<void*>(_data), _data_size, *pElement->constant));
-            }
-        }
+        // copied from the precalculated default sample
+        return _layout->setConstants(const_cast<void*>(_data), _data_size, getRepresentation());
     }
 
     return a_util::result::SUCCESS;
@@ -0,0 +1,385 @@
+/**
+ * @file
+ * Implementation of the struct converter.
+ *
+ * Copyright @ 2021 VW Group. All rights reserved.
+ *
+ *     This Source Code Form is subject to the terms of the Mozilla
+ *     Public License, v. 2.0. If a copy of the MPL was not distributed
+ *     with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * If it is not possible or desirable to put the notice in a particular file, then
+ * You may include the notice in a location (such as a LICENSE file in a
+ * relevant directory) where a recipient would be likely to look for such a notice.
+ *
+ * You may add additional accurate notices of copyright ownership.
+ */
+
+#include "ddl/codec/struct_converter.h"
+
+#include "a_util/result/error_def.h"
+#include "ddl/codec/bitserializer.h"
+#include "ddl/codec/struct_layout_cache.h"
+#include "ddl/legacy_error_macros.h"
+#include "element_accessor.h"
+#include "struct_layout.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace ddl {
+// define all needed error types and values locally
+_MAKE_RESULT(-4, ERR_POINTER);
+_MAKE_RESULT(-5, ERR_INVALID_ARG);
+_MAKE_RESULT(-19, ERR_NOT_SUPPORTED);
+_MAKE_RESULT(-20, ERR_NOT_FOUND);
+_MAKE_RESULT(-37, ERR_NOT_INITIALIZED);
+
+namespace {
+template <typename Source, typename Destination>
+using IsFloatingToInteger =
+    std::integral_constant<bool,
+                           std::is_floating_point<Source>::value &&
+                               std::is_integral<Destination>::value &&
+                               !std::is_same<Destination, bool>::value>;
+
+template <typename Source, typename Destination>
+using IsFloatingNarrowing =
+    std::integral_constant<bool,
+                           std::is_floating_point<Source>::value &&
+                               std::is_floating_point<Destination>::value &&
+                               (sizeof(Destination) < sizeof(Source))>;
+
+/// The cast of a floating point value out of the range of an integral type is undefined,
+/// so the value is clamped to the range and NaN is converted to zero.
+template <typename Source, typename Destination>
+typename std::enable_if<IsFloatingToInteger<Source, Destination>::value, Destination>::type
+castValue(Source value)
+{
+    if (std::isnan(value)) {
+        return 0;
+    }
+    // the maximum is rounded up to the next power of two, which is out of range itself
+    if (value >= static_cast<Source>(std::numeric_limits<Destination>::max())) {
+        return std::numeric_limits<Destination>::max();
+    }
+    if (value <= static_cast<Source>(std::numeric_limits<Destination>::lowest())) {
+        return std::numeric_limits<Destination>::lowest();
+    }
+    return static_cast<Destination>(value);
+}
+
+/// Finite values out of the range of the narrower floating point type become infinite.
+template <typename Source, typename Destination>
+typename std::enable_if<IsFloatingNarrowing<Source, Destination>::value, Destination>::type
+castValue(Source value)
+{
+    if (value > static_cast<Source>(std::numeric_limits<Destination>::max())) {
+        return std::numeric_limits<Destination>::infinity();
+    }
+    if (value < static_cast<Source>(std::numeric_limits<Destination>::lowest())) {
+        return -std::numeric_limits<Destination>::infinity();
+    }
+    return static_cast<Destination>(value);
+}
+
+template <typename Source, typename Destination>
+typename std::enable_if<!IsFloatingToInteger<Source, Destination>::value &&
+                            !IsFloatingNarrowing<Source, Destination>::value,
+                        Destination>::type
+castValue(Source value)
+{
+    return static_cast<Destination>(value);
+}
+
+template <typename Source, typename Destination>
+void convertValue(const void* source_value, void* destination_value)
+{
+    Source value;
+    std::memcpy(&value, source_value, sizeof(Source));
+    const Destination converted = castValue<Source, Destination>(value);
+    std::memcpy(destination_value, &converted, sizeof(Destination));
+}
+
+template <typename Source>
+void (*getConvertFunction(a_util::variant::VariantType destination_type))(const void*, void*)
+{
+    switch (destination_type) {
+    case a_util::variant::VT_Bool:
+        return &convertValue<Source, bool>;
+    case a_util::variant::VT_Int8:
+        return &convertValue<Source, int8_t>;
+    case a_util::variant::VT_UInt8:
+        return &convertValue<Source, uint8_t>;
+    case a_util::variant::VT_Int16:
+        return &convertValue<Source, int16_t>;
+    case a_util::variant::VT_UInt16:
+        return &convertValue<Source, uint16_t>;
+    case a_util::variant::VT_Int32:
+        return &convertValue<Source, int32_t>;
+    case a_util::variant::VT_UInt32:
+        return &convertValue<Source, uint32_t>;
+    case a_util::variant::VT_Int64:
+        return &convertValue<Source, int64_t>;
+    case a_util::variant::VT_UInt64:
+        return &convertValue<Source, uint64_t>;
+    case a_util::variant::VT_Float:
+        return &convertValue<Source, float>;
+    case a_util::variant::VT_Double:
+        return &convertValue<Source, double>;
+    default:
+        return nullptr;
+    }
+}
+
+void (*getConvertFunction(a_util::variant::VariantType source_type,
+                          a_util::variant::VariantType destination_type))(const void*, void*)
+{
+    switch (source_type) {
+    case a_util::variant::VT_Bool:
+        return getConvertFunction<bool>(destination_type);
+    case a_util::variant::VT_Int8:
+        return getConvertFunction<int8_t>(destination_type);
+    case a_util::variant::VT_UInt8:
+        return getConvertFunction<uint8_t>(destination_type);
+    case a_util::variant::VT_Int16:
+        return getConvertFunction<int16_t>(destination_type);
+    case a_util::variant::VT_UInt16:
+        return getConvertFunction<uint16_t>(destination_type);
+    case a_util::variant::VT_Int32:
+        return getConvertFunction<int32_t>(destination_type);
+    case a_util::variant::VT_UInt32:
+        return getConvertFunction<uint32_t>(destination_type);
+    case a_util::variant::VT_Int64:
+        return getConvertFunction<int64_t>(destination_type);
+    case a_util::variant::VT_UInt64:
+        return getConvertFunction<uint64_t>(destination_type);
+    case a_util::variant::VT_Float:
+        return getConvertFunction<float>(destination_type);
+    case a_util::variant::VT_Double:
+        return getConvertFunction<double>(destination_type);
+    default:
+        return nullptr;
+    }
+}
+
+/// Whether the bytes of an element can be copied, and if so, whether they are swapped.
+struct ByteLayout {
+    size_t byte_offset;
+    bool byte_aligned;
+    bool swapped;
+};
+
+ByteLayout getByteLayout(const StructLayoutElement& element, DataRepresentation rep)
+{
+    const Position& position = rep == deserialized ? element.deserialized : element.serialized;
+    ByteLayout layout;
+    layout.byte_offset = position.bit_offset / 8;
+    layout.byte_aligned =
+        position.bit_offset % 8 == 0 && position.bit_size == element.deserialized.bit_size;
+    layout.swapped = rep == serialized && element.deserialized.bit_size > 8 &&
+                     a_util::memory::detail::needsByteSwap(
+                         static_cast<a_util::memory::Endianess>(element.byte_order));
+    return layout;
+}
+
+bool startsWithElementOf(const std::string& name, const std::string& parent)
+{
+    return name.size() > parent.size() && name.compare(0, parent.size(), parent) == 0 &&
+           (name[parent.size()] == '.' || name[parent.size()] == '[');
+}
+
+const ElementAccessor& getAccessor(DataRepresentation rep)
+{
+    return rep == deserialized ? DeserializedAccessor::getInstance() :
+                                 SerializedAccessor::getInstance();
+}
+
+} // namespace
+
+StructConverter::StructConverter()
+    : _source_representation(deserialized),
+      _destination_representation(deserialized),
+      _copied_element_count(0),
+      _defaulted_element_count(0),
+      _result(ERR_NOT_INITIALIZED)
+{
+}
+
+StructConverter::StructConverter(const dd::StructTypeAccess& source,
+                                 const dd::StructTypeAccess& destination,
+                                 const std::map<std::string, std::string>& renamed_elements,
+                                 DataRepresentation source_rep,
+                                 DataRepresentation destination_rep)
+    : _source_layout(StructLayoutCache::getInstance().getLayout(source)),
+      _destination_layout(StructLayoutCache::getInstance().getLayout(destination)),
+      _source_representation(source_rep),
+      _destination_representation(destination_rep),
+      _copied_element_count(0),
+      _defaulted_element_count(0)
+{
+    _result = compile(renamed_elements);
+    if (isFailed(_result)) {
+        _copy_runs.clear();
+        _conversions.clear();
+    }
+}
+
+a_util::result::Result StructConverter::compile(
+    const std::map<std::string, std::string>& renamed_elements)
+{
+    RETURN_IF_FAILED(_source_layout->isValid());
+    RETURN_IF_FAILED(_destination_layout->isValid());
+    if (_source_layout->hasDynamicElements() || _destination_layout->hasDynamicElements()) {
+        return ERR_NOT_SUPPORTED;
+    }
+
+    const StructElementIndex& source_index = _source_layout->getStaticElementIndex();
+    for (const auto& renamed_element: renamed_elements) {
+        size_t index = 0;
+        if (!source_index.find(renamed_element.second, index) &&
+            !source_index.findPrefix(renamed_element.second + ".", index) &&
+            !source_index.findPrefix(renamed_element.second + "[", index)) {
+            return ERR_NOT_FOUND;
+        }
+    }
+
+    for (const StructLayoutElement& destination: _destination_layout->getStaticElements()) {
+        const StructLayoutElement* source =
+            destination.constant ? nullptr : findSourceElement(destination.name, renamed_elements);
+        if (!source) {
+            // keeps the value of the default sample, which also holds the constants
+            ++_defaulted_element_count;
+            continue;
+        }
+
+        const ByteLayout source_layout = getByteLayout(*source, _source_representation);
+        const ByteLayout destination_layout =
+            getByteLayout(destination, _destination_representation);
+        if (source->type == destination.type && source_layout.byte_aligned &&
+            destination_layout.byte_aligned &&
+            source_layout.swapped == destination_layout.swapped) {
+            const size_t source_offset = source_layout.byte_offset;
+            const size_t destination_offset = destination_layout.byte_offset;
+            const size_t size = destination.deserialized.bit_size / 8;
+            if (!_copy_runs.empty() &&
+                _copy_runs.back().source_offset + _copy_runs.back().size == source_offset &&
+                _copy_runs.back().destination_offset + _copy_runs.back().size ==
+                    destination_offset) {
+                _copy_runs.back().size += size;
+            }
+            else {
+                _copy_runs.push_back({source_offset, destination_offset, size});
+            }
+            ++_copied_element_count;
+            continue;
+        }
+
+        const ConvertFunction convert = getConvertFunction(source->type, destination.type);
+        if (!convert) {
+            return ERR_NOT_SUPPORTED;
+        }
+        _conversions.push_back({source, &destination, convert});
+    }
+
+    return a_util::result::SUCCESS;
+}
+
+const StructLayoutElement* StructConverter::findSourceElement(
+    const std::string& destination_name,
+    const std::map<std::string, std::string>& renamed_elements) const
+{
+    std::string source_name = destination_name;
+    for (const auto& renamed_element: renamed_elements) {
+        if (destination_name == renamed_element.first) {
+            source_name = renamed_element.second;
+            break;
+        }
+        if (startsWithElementOf(destination_name, renamed_element.first)) {
+            source_name =
+                renamed_element.second + destination_name.substr(renamed_element.first.size());
+            break;
+        }
+    }
+
+    size_t index = 0;
+    if (!_source_layout->getStaticElementIndex().find(source_name, index)) {
+        return nullptr;
+    }
+    return &_source_layout->getStaticElements()[index];
+}
+
+a_util::result::Result StructConverter::isValid() const
+{
+    return _result;
+}
+
+size_t StructConverter::getSourceSize() const
+{
+    return _source_layout ? _source_layout->getStaticBufferSize(_source_representation) : 0;
+}
+
+size_t StructConverter::getDestinationSize() const
+{
+    return _destination_layout ?
+               _destination_layout->getStaticBufferSize(_destination_representation) :
+               0;
+}
+
+size_t StructConverter::getCopiedElementCount() const
+{
+    return _copied_element_count;
+}
+
+size_t StructConverter::getConvertedElementCount() const
+{
+    return _conversions.size();
+}
+
+size_t StructConverter::getDefaultedElementCount() const
+{
+    return _defaulted_element_count;
+}
+
+a_util::result::Result StructConverter::convert(const void* source,
+                                                size_t source_size,
+                                                void* destination,
+                                                size_t destination_size) const
+{
+    RETURN_IF_FAILED(_result);
+    if (!source || !destination) {
+        return ERR_POINTER;
+    }
+    if (source_size < getSourceSize() || destination_size < getDestinationSize()) {
+        return ERR_INVALID_ARG;
+    }
+
+    // default values, constants and padding
+    const std::vector<uint8_t>& default_sample =
+        _destination_layout->getDefaultSample(_destination_representation);
+    std::memcpy(destination, default_sample.data(), default_sample.size());
+
+    const uint8_t* source_bytes = static_cast<const uint8_t*>(source);
+    uint8_t* destination_bytes = static_cast<uint8_t*>(destination);
+    for (const CopyRun& run: _copy_runs) {
+        std::memcpy(
+            destination_bytes + run.destination_offset, source_bytes + run.source_offset, run.size);
+    }
+
+    const ElementAccessor& source_accessor = getAccessor(_source_representation);
+    const ElementAccessor& destination_accessor = getAccessor(_destination_representation);
+    for (const Conversion& conversion: _conversions) {
+        uint64_t source_value = 0, destination_value = 0;
+        RETURN_IF_FAILED(
+            source_accessor.getValue(*conversion.source, source, source_size, &source_value));
+        conversion.convert(&source_value, &destination_value);
+        RETURN_IF_FAILED(destination_accessor.setValue(
+            *conversion.destination, destination, destination_size, &destination_value));
+    }
+
+    return a_util::result::SUCCESS;
+}
+
+} // namespace ddl
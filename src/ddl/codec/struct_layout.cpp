@@ -18,8 +18,12 @@
 #include "struct_layout.h"
 
 #include "a_util/result/error_def.h"
+#include "a_util/strings.h"
 #include "ddl/dd/ddenum.h"
 #include "ddl/legacy_error_macros.h"
+#include "element_accessor.h"
+
+#include <cstring>
 
 #include <algorithm>
 
@@ -42,6 +46,95 @@ StructLayout::StructLayout() : _calculations_result(ERR_NOT_INITIALIZED)
     _static_buffer_sizes.serialized = 0;
 }
 
+StructLayout::StructLayout(const a_util::memory::shared_ptr<const StructLayout>& source,
+                           const std::vector<size_t>& static_indices,
+                           const std::vector<std::string>& dynamic_names)
+    : _static_buffer_sizes(source->_static_buffer_sizes),
+      _calculations_result(source->_calculations_result),
+      // a projection of a projection refers to the full layout as well
+      _source(source->_source ? source->_source : source),
+      _projected_dynamic_names(dynamic_names)
+{
+    _static_elements.reserve(static_indices.size());
+    for (const size_t source_index: static_indices) {
+        _static_element_index.add(source->_static_elements[source_index].name,
+                                  _static_elements.size());
+        _static_elements.push_back(source->_static_elements[source_index]);
+    }
+    for (size_t index = 0; index < _projected_dynamic_names.size(); ++index) {
+        _projected_dynamic_index.add(_projected_dynamic_names[index],
+                                     _static_elements.size() + index);
+    }
+    _serialize_plan = TransformPlan(_static_elements, deserialized);
+    _deserialize_plan = TransformPlan(_static_elements, serialized);
+    calculateConstantRanges();
+}
+
+namespace {
+/// Skips an array index like "[3]" starting at @p pos, returns false if there is none.
+bool skipArrayIndex(const std::string& name, size_t& pos)
+{
+    if (pos >= name.size() || name[pos] != '[') {
+        return false;
+    }
+    const size_t digits_end = name.find_first_not_of("0123456789", pos + 1);
+    if (digits_end == pos + 1 || digits_end == std::string::npos || name[digits_end] != ']') {
+        return false;
+    }
+    pos = digits_end + 1;
+    return true;
+}
+
+/// Checks whether the name (starting at @p pos) may be one of the elements of the dynamic section.
+bool isDynamicElementName(const std::vector<DynamicStructLayoutElement>& dynamic_elements,
+                          const std::string& name,
+                          size_t pos)
+{
+    for (const auto& dynamic_element: dynamic_elements) {
+        if (dynamic_element.isAlignmentElement() ||
+            name.compare(pos, dynamic_element.name.size(), dynamic_element.name) != 0) {
+            continue;
+        }
+        // the array index is only known to be within the array size per sample
+        size_t instance_end = pos + dynamic_element.name.size();
+        if (dynamic_element.isDynamicArray() && !skipArrayIndex(name, instance_end)) {
+            continue;
+        }
+        if (instance_end == name.size()) {
+            for (const auto& static_element: dynamic_element.static_elements) {
+                if (static_element.name.empty()) {
+                    return true;
+                }
+            }
+            continue;
+        }
+        if (name[instance_end] != '.') {
+            continue;
+        }
+        const std::string element_name = name.substr(instance_end + 1);
+        for (const auto& static_element: dynamic_element.static_elements) {
+            if (static_element.name == element_name) {
+                return true;
+            }
+        }
+        if (isDynamicElementName(dynamic_element.dynamic_elements, name, instance_end + 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+bool StructLayout::isDynamicElementName(const std::string& name) const
+{
+    size_t index = 0;
+    if (_source) {
+        return _projected_dynamic_index.find(name, index);
+    }
+    return ddl::isDynamicElementName(_dynamic_elements, name, 0);
+}
+
 class SupportedTypes {
 private:
     SupportedTypes()
@@ -122,11 +215,15 @@ class cConverter {
 public:
     cConverter(std::vector<StructLayoutElement>& static_elements,
                std::vector<DynamicStructLayoutElement>& dynamic_elements,
-               std::map<std::string, AccessEnumType>& oEnums)
+               std::map<std::string, AccessEnumType>& oEnums,
+               std::map<const AccessEnumType*, EnumValueNames>& oEnumNames,
+               std::vector<std::pair<size_t, std::string>>* pDefaultValues = NULL)
         : m_bDynamicSectionStarted(false),
           _static_elements(static_elements),
           _dynamic_elements(dynamic_elements),
-          _enums(oEnums)
+          _enums(oEnums),
+          _enum_names(oEnumNames),
+          _default_values(pDefaultValues)
     {
         m_sOffsets.deserialized = 0;
         m_sOffsets.serialized = 0;
@@ -187,6 +284,8 @@ private:
                                    a_util::variant::Variant(ref_value.second->getValue().c_str())));
             }
             itEnum = _enums.insert(std::make_pair(enum_type.getName(), oCodecEnum)).first;
+            _enum_names.insert(
+                std::make_pair(&itEnum->second, EnumValueNames(itEnum->second)));
         }
         return &itEnum->second;
     }
@@ -229,7 +328,12 @@ private:
         }
         sElement.byte_order = elem.getElement().getByteOrder();
         sElement.p_enum = p_enum;
+        sElement.p_enum_names = p_enum ? &_enum_names[p_enum] : NULL;
         sElement.constant = findConstant(strConstant);
+        if (_default_values && !is_for_dynamic && !elem.getElement().getDefault().empty()) {
+            _default_values->push_back(
+                std::make_pair(_static_elements.size(), elem.getElement().getDefault()));
+        }
         _static_elements.push_back(std::move(sElement));
 
         return {};
@@ -307,8 +411,10 @@ private:
                                              const std::string& strStructPrefix)
     {
         DynamicStructLayoutElement sDynamicElement;
-        cConverter oChildConverter(
-            sDynamicElement.static_elements, sDynamicElement.dynamic_elements, _enums);
+        cConverter oChildConverter(sDynamicElement.static_elements,
+                                   sDynamicElement.dynamic_elements,
+                                   _enums,
+                                   _enum_names);
 
         const auto& elem_ref = element_access.getElement();
         RETURN_IF_FAILED(oChildConverter.add(element_access, "", elem_ref.getValue(), 0, true));
@@ -336,17 +442,92 @@ protected:
     std::vector<StructLayoutElement>& _static_elements;
     std::vector<DynamicStructLayoutElement>& _dynamic_elements;
     std::map<std::string, AccessEnumType>& _enums;
+    std::map<const AccessEnumType*, EnumValueNames>& _enum_names;
+    std::vector<std::pair<size_t, std::string>>* _default_values;
 };
 
 a_util::result::Result StructLayout::calculate(const dd::StructTypeAccess& ddl_struct_access)
 {
-    cConverter oConverter(_static_elements, _dynamic_elements, _enums);
+    cConverter oConverter(
+        _static_elements, _dynamic_elements, _enums, _enum_names, &_default_values);
     RETURN_IF_FAILED(oConverter.Convert(ddl_struct_access));
     _static_buffer_sizes = oConverter.getStaticBufferBitSizes();
 
+    for (size_t element_index = 0; element_index < _static_elements.size(); ++element_index) {
+        _static_element_index.add(_static_elements[element_index].name, element_index);
+    }
+    _serialize_plan = TransformPlan(_static_elements, deserialized);
+    _deserialize_plan = TransformPlan(_static_elements, serialized);
+    resolveArraySizeReferences(_dynamic_elements, nullptr);
+    calculateConstantRanges();
+
     return {};
 }
 
+void StructLayout::resolveArraySizeReferences(
+    std::vector<DynamicStructLayoutElement>& dynamic_elements,
+    const std::vector<StructLayoutElement>* scope_elements)
+{
+    for (size_t index = 0; index < dynamic_elements.size(); ++index) {
+        DynamicStructLayoutElement& dynamic_element = dynamic_elements[index];
+        ArraySizeReference& reference = dynamic_element.size_reference;
+        const std::string& size_name = dynamic_element.size_element_name;
+        if (dynamic_element.isDynamicArray()) {
+            // the static elements of the scope come first, the elements of any preceding
+            // dynamic element afterwards, just like the lookup by name does
+            if (!scope_elements) {
+                if (_static_element_index.find(size_name, reference.element_index)) {
+                    reference.kind = ArraySizeReference::scope_static;
+                }
+            }
+            else {
+                for (size_t element = 0; element < scope_elements->size(); ++element) {
+                    if ((*scope_elements)[element].name == size_name) {
+                        reference = {ArraySizeReference::scope_static, 0, element};
+                        break;
+                    }
+                }
+            }
+
+            for (size_t sibling = 0;
+                 sibling < index && reference.kind == ArraySizeReference::unresolved;
+                 ++sibling) {
+                const DynamicStructLayoutElement& sibling_element = dynamic_elements[sibling];
+                if (sibling_element.isAlignmentElement()) {
+                    continue;
+                }
+                // names depending on array sizes can only be resolved by name
+                if (sibling_element.isDynamicArray()) {
+                    if (size_name.compare(0, sibling_element.name.size() + 1,
+                                          sibling_element.name + "[") == 0) {
+                        break;
+                    }
+                    continue;
+                }
+                for (size_t element = 0; element < sibling_element.static_elements.size();
+                     ++element) {
+                    const std::string& element_name = sibling_element.static_elements[element].name;
+                    if (element_name.empty() ? sibling_element.name == size_name :
+                                               sibling_element.name + "." + element_name ==
+                                                   size_name) {
+                        reference = {ArraySizeReference::sibling, sibling, element};
+                        break;
+                    }
+                }
+                if (reference.kind == ArraySizeReference::unresolved &&
+                    !sibling_element.dynamic_elements.empty() &&
+                    size_name.compare(0, sibling_element.name.size() + 1,
+                                      sibling_element.name + ".") == 0) {
+                    break;
+                }
+            }
+        }
+
+        resolveArraySizeReferences(dynamic_element.dynamic_elements,
+                                   &dynamic_element.static_elements);
+    }
+}
+
 size_t StructLayout::getStaticBufferSize(DataRepresentation eRep) const
 {
     size_t nResult =
@@ -357,4 +538,155 @@ size_t StructLayout::getStaticBufferSize(DataRepresentation eRep) const
     return nResult / 8;
 }
 
+static a_util::variant::Variant parseDefaultValue(a_util::variant::VariantType type,
+                                                  const std::string& default_value)
+{
+    a_util::variant::Variant value;
+    switch (type) {
+    case a_util::variant::VT_Bool:
+        value.reset(a_util::strings::toBool(default_value));
+        break;
+    case a_util::variant::VT_Int8:
+        value.reset(a_util::strings::toInt8(default_value));
+        break;
+    case a_util::variant::VT_UInt8:
+        value.reset(a_util::strings::toUInt8(default_value));
+        break;
+    case a_util::variant::VT_Int16:
+        value.reset(a_util::strings::toInt16(default_value));
+        break;
+    case a_util::variant::VT_UInt16:
+        value.reset(a_util::strings::toUInt16(default_value));
+        break;
+    case a_util::variant::VT_Int32:
+        value.reset(a_util::strings::toInt32(default_value));
+        break;
+    case a_util::variant::VT_UInt32:
+        value.reset(a_util::strings::toUInt32(default_value));
+        break;
+    case a_util::variant::VT_Int64:
+        value.reset(a_util::strings::toInt64(default_value));
+        break;
+    case a_util::variant::VT_UInt64:
+        value.reset(a_util::strings::toUInt64(default_value));
+        break;
+    case a_util::variant::VT_Float:
+        value.reset(a_util::strings::toFloat(default_value));
+        break;
+    case a_util::variant::VT_Double:
+        value.reset(a_util::strings::toDouble(default_value));
+        break;
+    default:
+        break;
+    }
+    return value;
+}
+
+void StructLayout::calculateConstantRanges()
+{
+    for (const DataRepresentation rep: {serialized, deserialized}) {
+        std::vector<ConstantRange>& ranges = _constant_ranges[rep];
+        for (const StructLayoutElement& element: _static_elements) {
+            if (!element.constant) {
+                continue;
+            }
+            const Position& position =
+                rep == deserialized ? element.deserialized : element.serialized;
+            if (position.bit_offset % 8 != 0 || position.bit_size % 8 != 0) {
+                ranges.push_back({0, 0, &element});
+            }
+            else if (!ranges.empty() && !ranges.back().element &&
+                     ranges.back().byte_offset + ranges.back().byte_size ==
+                         position.bit_offset / 8) {
+                // adjacent constants are copied at once
+                ranges.back().byte_size += position.bit_size / 8;
+            }
+            else {
+                ranges.push_back({position.bit_offset / 8, position.bit_size / 8, nullptr});
+            }
+        }
+    }
+}
+
+void StructLayout::renderDefaultSamples() const
+{
+    std::vector<uint8_t>& deserialized_sample = _default_samples[deserialized];
+    std::vector<uint8_t>& serialized_sample = _default_samples[serialized];
+    deserialized_sample.assign(getStaticBufferSize(deserialized), 0);
+    serialized_sample.assign(getStaticBufferSize(serialized), 0);
+    if (isFailed(_calculations_result)) {
+        _default_samples_result = _calculations_result;
+        return;
+    }
+
+    const ElementAccessor& accessor = DeserializedAccessor::getInstance();
+    for (const auto& default_value: _default_values) {
+        const StructLayoutElement& element = _static_elements[default_value.first];
+        const a_util::variant::Variant value =
+            parseDefaultValue(element.type, default_value.second);
+        if (!value.isEmpty()) {
+            accessor.setValue(
+                element, deserialized_sample.data(), deserialized_sample.size(), value);
+        }
+    }
+    // constants win over default values
+    for (const StructLayoutElement& element: _static_elements) {
+        if (element.constant && isOk(_default_samples_result)) {
+            _default_samples_result = accessor.setValue(
+                element, deserialized_sample.data(), deserialized_sample.size(), *element.constant);
+        }
+    }
+
+    if (isOk(_default_samples_result)) {
+        _default_samples_result = getTransformPlan(deserialized)
+                                      .execute(_static_elements,
+                                               deserialized_sample.data(),
+                                               deserialized_sample.size(),
+                                               serialized_sample.data(),
+                                               serialized_sample.size());
+    }
+}
+
+const std::vector<uint8_t>& StructLayout::getDefaultSample(DataRepresentation rep) const
+{
+    if (_source) {
+        return _source->getDefaultSample(rep);
+    }
+    std::call_once(_default_samples_rendered, [this]() { renderDefaultSamples(); });
+    return _default_samples[rep];
+}
+
+a_util::result::Result StructLayout::setConstants(void* data,
+                                                  size_t data_size,
+                                                  DataRepresentation rep) const
+{
+    const std::vector<ConstantRange>& ranges = _constant_ranges[rep];
+    if (ranges.empty()) {
+        return a_util::result::SUCCESS;
+    }
+
+    const std::vector<uint8_t>& sample = getDefaultSample(rep);
+    RETURN_IF_FAILED(_source ? _source->_default_samples_result : _default_samples_result);
+    const ElementAccessor& accessor = rep == deserialized ?
+                                          DeserializedAccessor::getInstance() :
+                                          SerializedAccessor::getInstance();
+    uint8_t* bytes = static_cast<uint8_t*>(data);
+    for (const ConstantRange& range: ranges) {
+        if (range.element) {
+            uint64_t value = 0;
+            RETURN_IF_FAILED(
+                accessor.getValue(*range.element, sample.data(), sample.size(), &value));
+            RETURN_IF_FAILED(accessor.setValue(*range.element, data, data_size, &value));
+        }
+        else if (range.byte_offset + range.byte_size > data_size) {
+            return ERR_INVALID_ARG;
+        }
+        else {
+            std::memcpy(
+                bytes + range.byte_offset, sample.data() + range.byte_offset, range.byte_size);
+        }
+    }
+    return a_util::result::SUCCESS;
+}
+
 } // namespace ddl
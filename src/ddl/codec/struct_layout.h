@@ -18,8 +18,12 @@
 #ifndef DDL_STRUCT_LAYOUT_CLASS_HEADER
 #define DDL_STRUCT_LAYOUT_CLASS_HEADER
 
+#include "a_util/memory.h"
 #include "ddl/codec/struct_element.h"
 #include "ddl/dd/dd_struct_access.h"
+#include "transform_plan.h"
+
+#include <mutex>
 
 namespace ddl {
 class DDLComplex;
@@ -33,6 +37,17 @@ public:
     StructLayout();
     StructLayout(const dd::StructTypeAccess& ddl_struct_access);
 
+    /**
+     * Creates a projection of another layout that only contains the selected leaves.
+     * @param[in] source The layout to project, kept alive since the elements refer to its enums.
+     * @param[in] static_indices The indices of the selected static elements of @p source.
+     * @param[in] dynamic_names The full names of the selected elements of the dynamic section,
+     *                          located within the dynamic layouts of @p source.
+     */
+    StructLayout(const a_util::memory::shared_ptr<const StructLayout>& source,
+                 const std::vector<size_t>& static_indices,
+                 const std::vector<std::string>& dynamic_names);
+
     a_util::result::Result isValid() const
     {
         return _calculations_result;
@@ -43,6 +58,16 @@ public:
         return _static_elements;
     }
 
+    const StructElementIndex& getStaticElementIndex() const
+    {
+        return _static_element_index;
+    }
+
+    const TransformPlan& getTransformPlan(DataRepresentation source_rep) const
+    {
+        return source_rep == deserialized ? _serialize_plan : _deserialize_plan;
+    }
+
     const std::vector<DynamicStructLayoutElement>& getDynamicElements() const
     {
         return _dynamic_elements;
@@ -50,12 +75,41 @@ public:
 
     bool hasDynamicElements() const
     {
-        return !_dynamic_elements.empty();
+        return !_dynamic_elements.empty() || hasProjectedDynamicElements();
     }
 
     bool hasEnums() const
     {
-        return !_enums.empty();
+        return !_enums.empty() || (_source && _source->hasEnums());
+    }
+
+    /**
+     * Checks whether the name may be the one of an element of the dynamic section, whose array
+     * indices are only checked per sample. For a projection only the selected names are known.
+     */
+    bool isDynamicElementName(const std::string& name) const;
+
+    /// The full layout of a projection or nullptr if this is no projection.
+    const StructLayout* getSource() const
+    {
+        return _source.get();
+    }
+
+    /// The names of the selected elements of the dynamic section of a projection.
+    const std::vector<std::string>& getProjectedDynamicNames() const
+    {
+        return _projected_dynamic_names;
+    }
+
+    /// The name lookup of the selected dynamic elements, indices start after the static elements.
+    const StructElementIndex& getProjectedDynamicIndex() const
+    {
+        return _projected_dynamic_index;
+    }
+
+    bool hasProjectedDynamicElements() const
+    {
+        return !_projected_dynamic_names.empty();
     }
 
     const Offsets& getStaticBufferBitSizes() const
@@ -65,15 +119,48 @@ public:
 
     size_t getStaticBufferSize(DataRepresentation rep) const;
 
+    /**
+     * The static part of a sample with all elements set to their default values from the
+     * DataDefinition, to their constants or to zero otherwise. Rendered on first request.
+     */
+    const std::vector<uint8_t>& getDefaultSample(DataRepresentation rep) const;
+
+    /// Copies the values of all static elements with constants from the default sample.
+    a_util::result::Result setConstants(void* data, size_t data_size, DataRepresentation rep) const;
+
 private:
+    /// A range of the default sample to copy for setting constants.
+    struct ConstantRange {
+        size_t byte_offset;
+        size_t byte_size;
+        /// Set for bit-packed elements, which are copied by value.
+        const StructLayoutElement* element;
+    };
+
     a_util::result::Result calculate(const dd::StructTypeAccess& ddl_struct_access);
+    void calculateConstantRanges();
+    void renderDefaultSamples() const;
+    void resolveArraySizeReferences(std::vector<DynamicStructLayoutElement>& dynamic_elements,
+                                    const std::vector<StructLayoutElement>* scope_elements);
 
 private:
     std::vector<StructLayoutElement> _static_elements;
+    StructElementIndex _static_element_index;
+    TransformPlan _serialize_plan;
+    TransformPlan _deserialize_plan;
     std::vector<DynamicStructLayoutElement> _dynamic_elements;
     std::map<std::string, AccessEnumType> _enums;
+    std::map<const AccessEnumType*, EnumValueNames> _enum_names;
     Offsets _static_buffer_sizes;
     a_util::result::Result _calculations_result;
+    a_util::memory::shared_ptr<const StructLayout> _source;
+    std::vector<std::string> _projected_dynamic_names;
+    StructElementIndex _projected_dynamic_index;
+    std::vector<std::pair<size_t, std::string>> _default_values;
+    std::vector<ConstantRange> _constant_ranges[2];
+    mutable std::once_flag _default_samples_rendered;
+    mutable std::vector<uint8_t> _default_samples[2];
+    mutable a_util::result::Result _default_samples_result;
 };
 
 } // namespace ddl
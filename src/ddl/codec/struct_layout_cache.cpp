@@ -0,0 +1,459 @@
+/**
+ * @file
+ * Implementation of the process-wide struct layout cache.
+ *
+ * Copyright @ 2021 VW Group. All rights reserved.
+ *
+ *     This Source Code Form is subject to the terms of the Mozilla
+ *     Public License, v. 2.0. If a copy of the MPL was not distributed
+ *     with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * If it is not possible or desirable to put the notice in a particular file, then
+ * You may include the notice in a location (such as a LICENSE file in a
+ * relevant directory) where a recipient would be likely to look for such a notice.
+ *
+ * You may add additional accurate notices of copyright ownership.
+ */
+
+#include "ddl/codec/struct_layout_cache.h"
+
+#include "a_util/strings.h"
+#include "ddl/dd/ddstring.h"
+#include "struct_layout.h"
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace ddl {
+// define all needed error types and values locally
+_MAKE_RESULT(-20, ERR_NOT_FOUND);
+_MAKE_RESULT(-38, ERR_INVALID_DDL);
+
+constexpr size_t StructLayoutCache::default_capacity;
+
+namespace {
+/**
+ * 64 bit FNV-1a hash, fed incrementally. Collisions of this hash are easy to find, so the hashed
+ * content is kept as well to compare it on a matching hash.
+ */
+class ContentHash {
+public:
+    /// @param keep_content Whether the content is kept, not needed if the caller already has it.
+    explicit ContentHash(bool keep_content) : _content(keep_content ? new std::string() : nullptr)
+    {
+    }
+
+    void add(const void* data, size_t size)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t index = 0; index < size; ++index) {
+            _hash = (_hash ^ bytes[index]) * 0x100000001b3ULL;
+        }
+        if (_content) {
+            _content->append(static_cast<const char*>(data), size);
+        }
+    }
+
+    void add(const std::string& value)
+    {
+        // the length separates adjacent strings
+        add(static_cast<uint64_t>(value.size()));
+        add(value.data(), value.size());
+    }
+
+    void add(uint64_t value)
+    {
+        add(&value, sizeof(value));
+    }
+
+    void add(const dd::OptionalSize& value)
+    {
+        add(static_cast<uint64_t>(value ? *value + 1 : 0));
+    }
+
+    uint64_t getHash() const
+    {
+        return _hash;
+    }
+
+    /// The content added, if it is kept.
+    const std::shared_ptr<std::string>& getContent() const
+    {
+        return _content;
+    }
+
+private:
+    uint64_t _hash = 0xcbf29ce484222325ULL;
+    std::shared_ptr<std::string> _content;
+};
+
+/**
+ * Hashes everything the layout of a struct type access is calculated from: the definitions of
+ * the struct and all types it depends on, and the positions and sizes derived from them.
+ */
+class StructTypeHash {
+public:
+    explicit StructTypeHash(const dd::StructTypeAccess& struct_type_access) : _hash(true)
+    {
+        bool dynamic = false;
+        addStruct(struct_type_access, dynamic);
+    }
+
+    const ContentHash& getContentHash() const
+    {
+        return _hash;
+    }
+
+private:
+    void addStruct(const dd::StructTypeAccess& struct_type_access, bool& dynamic)
+    {
+        const auto& struct_type = struct_type_access.getStructType();
+        _hash.add(struct_type.getName());
+        if (!_visited_structs.insert(struct_type.getName()).second) {
+            return;
+        }
+        _hash.add(struct_type.getAlignment());
+        _hash.add(static_cast<uint64_t>(struct_type.getLanguageVersion().getMajor()));
+        _hash.add(static_cast<uint64_t>(struct_type.getLanguageVersion().getMinor()));
+        _hash.add(static_cast<uint64_t>(struct_type_access.getStaticStructSize()));
+        _hash.add(static_cast<uint64_t>(struct_type_access.getStaticSerializedBitSize()));
+        for (const auto& element_access: struct_type_access) {
+            addElement(element_access, dynamic);
+        }
+    }
+
+    void addElement(const dd::StructElementAccess& element_access, bool& dynamic)
+    {
+        const auto& element = element_access.getElement();
+        dynamic = dynamic || element_access.isDynamic();
+        _hash.add(element.getName());
+        _hash.add(element.getTypeName());
+        _hash.add(element.getValue());
+        // the default sample of the layout is made of the defaults
+        _hash.add(element.getDefault());
+        _hash.add(static_cast<uint64_t>(element.getByteOrder()));
+        _hash.add(static_cast<uint64_t>(element.getAlignment()));
+        _hash.add(element.getBytePos());
+        _hash.add(element.getBitPos());
+        _hash.add(element.getNumBits());
+        _hash.add(static_cast<uint64_t>(element.getArraySize().getArraySizeValue()));
+        _hash.add(element.getArraySize().getArraySizeElementName());
+        _hash.add(static_cast<uint64_t>(element_access.getSerializedBitSize()));
+        _hash.add(static_cast<uint64_t>(element_access.getSerializedTypeBitSize()));
+        _hash.add(static_cast<uint64_t>(dynamic));
+        if (!dynamic) {
+            _hash.add(static_cast<uint64_t>(element_access.getDeserializedBytePos()));
+            _hash.add(static_cast<uint64_t>(element_access.getSerializedBitOffset()));
+        }
+
+        const auto data_type = element_access.getDataType();
+        const auto enum_type = element_access.getEnumType();
+        if (data_type) {
+            _hash.add(data_type->getName());
+            _hash.add(static_cast<uint64_t>(data_type->getBitSize()));
+            _hash.add(data_type->getArraySize());
+        }
+        else if (enum_type) {
+            _hash.add(enum_type->getName());
+            _hash.add(enum_type->getDataTypeName());
+            for (const auto& enum_element: enum_type->getElements()) {
+                _hash.add(enum_element.second->getName());
+                _hash.add(enum_element.second->getValue());
+            }
+        }
+        else {
+            const auto struct_access =
+                element_access.getStructTypeAccess(dynamic ? static_cast<size_t>(-1) : 0);
+            if (struct_access) {
+                addStruct(struct_access, dynamic);
+            }
+        }
+    }
+
+    ContentHash _hash;
+    std::unordered_set<std::string> _visited_structs;
+};
+
+/// The hash of a content together with the content, which is compared if the hashes match.
+struct ContentKey {
+    uint64_t hash;
+    /// Only references the content for lookups, owns it for entries (see makeEntryKey).
+    std::shared_ptr<const std::string> content;
+
+    bool operator==(const ContentKey& other) const
+    {
+        return hash == other.hash && (content == other.content || *content == *other.content);
+    }
+
+    /// The key for a lookup of the given content, which does not copy it.
+    static ContentKey makeLookupKey(uint64_t hash, const std::string& content)
+    {
+        return {hash, std::shared_ptr<const std::string>(std::shared_ptr<const std::string>(),
+                                                         &content)};
+    }
+
+    /// The key to store in an entry, which owns the content.
+    ContentKey makeEntryKey() const
+    {
+        if (content.use_count() > 0) {
+            return *this;
+        }
+        return {hash, std::make_shared<const std::string>(*content)};
+    }
+};
+
+struct ContentKeyHash {
+    size_t operator()(const ContentKey& key) const
+    {
+        return static_cast<size_t>(key.hash);
+    }
+};
+
+struct LayoutKey {
+    std::string struct_name;
+    ContentKey content;
+    /// Hashes of description strings and of struct type accesses are never mixed.
+    bool from_description_string;
+
+    bool operator==(const LayoutKey& other) const
+    {
+        return content == other.content &&
+               from_description_string == other.from_description_string &&
+               struct_name == other.struct_name;
+    }
+};
+
+struct LayoutKeyHash {
+    size_t operator()(const LayoutKey& key) const
+    {
+        return std::hash<std::string>()(key.struct_name) ^ static_cast<size_t>(key.content.hash) ^
+               static_cast<size_t>(key.from_description_string);
+    }
+};
+
+/// Bounded map evicting the least recently used entry first, not synchronized.
+template <typename Key, typename Value, typename KeyHash>
+class LruMap {
+public:
+    /// @param stored_key Set to the key of the entry found, if given.
+    bool find(const Key& key, Value& value, Key* stored_key = nullptr)
+    {
+        const auto entry = _entries.find(key);
+        if (entry == _entries.end()) {
+            return false;
+        }
+        _order.splice(_order.begin(), _order, entry->second);
+        value = entry->second->second;
+        if (stored_key) {
+            *stored_key = entry->second->first;
+        }
+        return true;
+    }
+
+    /// Keeps an existing entry and returns its value in @p value.
+    void insert(const Key& key, Value& value, size_t capacity)
+    {
+        if (capacity == 0) {
+            return;
+        }
+        const auto entry = _entries.find(key);
+        if (entry != _entries.end()) {
+            _order.splice(_order.begin(), _order, entry->second);
+            value = entry->second->second;
+            return;
+        }
+        _order.emplace_front(key, value);
+        _entries.emplace(key, _order.begin());
+        shrink(capacity);
+    }
+
+    void shrink(size_t capacity)
+    {
+        while (_order.size() > capacity) {
+            _entries.erase(_order.back().first);
+            _order.pop_back();
+        }
+    }
+
+    size_t size() const
+    {
+        return _order.size();
+    }
+
+private:
+    typedef std::list<std::pair<Key, Value>> Order;
+    Order _order;
+    std::unordered_map<Key, typename Order::iterator, KeyHash> _entries;
+};
+
+} // namespace
+
+class StructLayoutCache::Implementation {
+public:
+    typedef std::shared_ptr<const StructLayout> Layout;
+    typedef std::shared_ptr<const dd::DataDefinition> Definition;
+
+    bool findLayout(const LayoutKey& key, Layout& layout)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_layouts.find(key, layout)) {
+            ++_statistics.layout_hits;
+            return true;
+        }
+        ++_statistics.layout_misses;
+        return false;
+    }
+
+    void insertLayout(const LayoutKey& key, Layout& layout)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _layouts.insert(key, layout, _capacity);
+    }
+
+    /// Replaces @p key by the one of the entry found, which owns the content.
+    bool findDefinition(ContentKey& key, Definition& definition)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_definitions.find(key, definition, &key)) {
+            ++_statistics.definition_hits;
+            return true;
+        }
+        ++_statistics.definition_misses;
+        return false;
+    }
+
+    void insertDefinition(const ContentKey& key, Definition& definition)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _definitions.insert(key, definition, _capacity);
+    }
+
+    mutable std::mutex _mutex;
+    size_t _capacity = default_capacity;
+    Statistics _statistics = {};
+    LruMap<LayoutKey, Layout, LayoutKeyHash> _layouts;
+    LruMap<ContentKey, Definition, ContentKeyHash> _definitions;
+};
+
+StructLayoutCache& StructLayoutCache::getInstance()
+{
+    static StructLayoutCache instance;
+    return instance;
+}
+
+StructLayoutCache::StructLayoutCache() : _impl(new Implementation())
+{
+}
+
+StructLayoutCache::~StructLayoutCache()
+{
+}
+
+StructLayoutCache::Statistics StructLayoutCache::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(_impl->_mutex);
+    Statistics statistics = _impl->_statistics;
+    statistics.layout_count = _impl->_layouts.size();
+    statistics.definition_count = _impl->_definitions.size();
+    return statistics;
+}
+
+void StructLayoutCache::resetStatistics()
+{
+    std::lock_guard<std::mutex> lock(_impl->_mutex);
+    _impl->_statistics = {};
+}
+
+size_t StructLayoutCache::getCapacity() const
+{
+    std::lock_guard<std::mutex> lock(_impl->_mutex);
+    return _impl->_capacity;
+}
+
+void StructLayoutCache::setCapacity(size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(_impl->_mutex);
+    _impl->_capacity = capacity;
+    _impl->_layouts.shrink(capacity);
+    _impl->_definitions.shrink(capacity);
+}
+
+void StructLayoutCache::clear()
+{
+    std::lock_guard<std::mutex> lock(_impl->_mutex);
+    _impl->_layouts.shrink(0);
+    _impl->_definitions.shrink(0);
+}
+
+a_util::result::Result StructLayoutCache::getLayout(const std::string& struct_name,
+                                                    const std::string& description,
+                                                    std::shared_ptr<const StructLayout>& layout)
+{
+    ContentHash hash(false);
+    hash.add(description.data(), description.size());
+    LayoutKey layout_key = {
+        struct_name, ContentKey::makeLookupKey(hash.getHash(), description), true};
+    if (_impl->findLayout(layout_key, layout)) {
+        return layout->isValid();
+    }
+
+    // the layouts of all structs of a description share the parsed description
+    Implementation::Definition definition;
+    try {
+        // the entries for the layout and for the parsed description share the copied description
+        if (!_impl->findDefinition(layout_key.content, definition)) {
+            layout_key.content = layout_key.content.makeEntryKey();
+            definition = std::make_shared<const dd::DataDefinition>(
+                DDString::fromXMLString(description));
+            _impl->insertDefinition(layout_key.content, definition);
+        }
+        // same error as DDString::fromXMLString for a single struct
+        if (!definition->getStructTypes().get(struct_name)) {
+            throw dd::Error("DDString::DDString",
+                            {struct_name, "xml_string"},
+                            "The xml_string does not contain the struct_type '" + struct_name +
+                                "'!");
+        }
+    }
+    catch (const dd::Error& dd_err) {
+        std::string error_desc =
+            a_util::strings::join(dd::transformProblemList(dd_err.problems()), ";");
+        return a_util::result::Result(ERR_INVALID_DDL,
+                                      error_desc.c_str(),
+                                      __LINE__,
+                                      __FILE__,
+                                      "StructLayoutCache::getLayout");
+    }
+
+    const auto struct_access = definition->getStructTypeAccess(struct_name);
+    if (!struct_access) {
+        return ERR_NOT_FOUND;
+    }
+    layout = std::make_shared<const StructLayout>(struct_access);
+    _impl->insertLayout(layout_key, layout);
+    return layout->isValid();
+}
+
+std::shared_ptr<const StructLayout> StructLayoutCache::getLayout(
+    const dd::StructTypeAccess& struct_type_access)
+{
+    if (!struct_type_access) {
+        return std::make_shared<const StructLayout>(struct_type_access);
+    }
+
+    const StructTypeHash struct_type_hash(struct_type_access);
+    const ContentHash& hash = struct_type_hash.getContentHash();
+    const LayoutKey layout_key = {
+        struct_type_access.getStructType().getName(), {hash.getHash(), hash.getContent()}, false};
+    std::shared_ptr<const StructLayout> layout;
+    if (!_impl->findLayout(layout_key, layout)) {
+        layout = std::make_shared<const StructLayout>(struct_type_access);
+        _impl->insertLayout(layout_key, layout);
+    }
+    return layout;
+}
+
+} // namespace ddl
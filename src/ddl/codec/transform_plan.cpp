@@ -0,0 +1,333 @@
+/**
+ * @file
+ * Implementation of the precomputed transformation between data representations.
+ *
+ * Copyright @ 2021 VW Group. All rights reserved.
+ *
+ *     This Source Code Form is subject to the terms of the Mozilla
+ *     Public License, v. 2.0. If a copy of the MPL was not distributed
+ *     with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * If it is not possible or desirable to put the notice in a particular file, then
+ * You may include the notice in a location (such as a LICENSE file in a
+ * relevant directory) where a recipient would be likely to look for such a notice.
+ *
+ * You may add additional accurate notices of copyright ownership.
+ */
+
+#include "transform_plan.h"
+
+#include "a_util/result/error_def.h"
+#include "byte_swap.h"
+#include "ddl/codec/bitserializer.h"
+#include "ddl/codec/codec.h"
+#include "ddl/legacy_error_macros.h"
+#include "dynamic_layout.h"
+#include "element_accessor.h"
+#include "struct_layout.h"
+#include "worker_pool.h"
+
+#include <assert.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace ddl {
+// define all needed error types and values locally
+_MAKE_RESULT(-5, ERR_INVALID_ARG);
+
+namespace {
+/// Samples with less destination bytes per thread are not worth to be split up.
+constexpr size_t minimum_chunk_size = 64 * 1024;
+} // namespace
+
+TransformPlan::TransformPlan() : _source_rep(deserialized), _source_size(0), _destination_size(0)
+{
+}
+
+TransformPlan::TransformPlan(const std::vector<StructLayoutElement>& elements,
+                             DataRepresentation source_rep)
+    : _source_rep(source_rep), _source_size(0), _destination_size(0)
+{
+    for (size_t element_index = 0; element_index < elements.size(); ++element_index) {
+        addElement(elements[element_index], element_index);
+    }
+}
+
+void TransformPlan::addElement(const StructLayoutElement& element, size_t element_index)
+{
+    const Position& source =
+        _source_rep == deserialized ? element.deserialized : element.serialized;
+    const Position& destination =
+        _source_rep == deserialized ? element.serialized : element.deserialized;
+    _source_size = std::max(_source_size, (source.bit_offset + source.bit_size + 7) / 8);
+    _destination_size =
+        std::max(_destination_size, (destination.bit_offset + destination.bit_size + 7) / 8);
+
+    Step step = {copy_element, source.bit_offset / 8, destination.bit_offset / 8, 0, 1, 0};
+    const bool byte_aligned = source.bit_offset % 8 == 0 && destination.bit_offset % 8 == 0 &&
+                              source.bit_size % 8 == 0 && source.bit_size == destination.bit_size;
+    if (!byte_aligned) {
+        step.element_index = element_index;
+        _steps.push_back(step);
+        return;
+    }
+
+    step.item_size = source.bit_size / 8;
+    const bool swap = step.item_size > 1 &&
+                      a_util::memory::detail::needsByteSwap(
+                          static_cast<a_util::memory::Endianess>(element.byte_order));
+    if (swap && step.item_size != 2 && step.item_size != 4 && step.item_size != 8) {
+        step.element_index = element_index;
+        _steps.push_back(step);
+        return;
+    }
+
+    step.type = swap ? swap_bytes : copy_bytes;
+    if (!_steps.empty()) {
+        Step& last = _steps.back();
+        const size_t last_size = last.item_size * last.item_count;
+        if (last.type == step.type && last.source_offset + last_size == step.source_offset &&
+            last.destination_offset + last_size == step.destination_offset) {
+            if (step.type == copy_bytes) {
+                last.item_size += step.item_size;
+                return;
+            }
+            if (last.item_size == step.item_size) {
+                ++last.item_count;
+                return;
+            }
+        }
+    }
+    _steps.push_back(step);
+}
+
+a_util::result::Result TransformPlan::execute(const std::vector<StructLayoutElement>& elements,
+                                              const void* source,
+                                              size_t source_size,
+                                              void* destination,
+                                              size_t destination_size) const
+{
+    if (source_size < _source_size || destination_size < _destination_size) {
+        return ERR_INVALID_ARG;
+    }
+
+    for (const Step& step: _steps) {
+        RETURN_IF_FAILED(executeStep(
+            step, elements, _source_rep, source, source_size, destination, destination_size));
+    }
+
+    return a_util::result::SUCCESS;
+}
+
+void TransformPlan::addPieces(const std::vector<StructLayoutElement>& elements,
+                              size_t piece_size,
+                              std::vector<Piece>& pieces) const
+{
+    for (const Step& step: _steps) {
+        if (step.type == copy_element) {
+            const StructLayoutElement& element = elements[step.element_index];
+            const Position& destination =
+                _source_rep == deserialized ? element.serialized : element.deserialized;
+            pieces.push_back({&elements,
+                              step,
+                              destination.bit_offset / 8,
+                              (destination.bit_offset + destination.bit_size + 7) / 8});
+            continue;
+        }
+
+        // blocks only contain whole bytes, so they can be split between any of their items
+        const size_t item_size = step.type == copy_bytes ? 1 : step.item_size;
+        const size_t item_count = step.type == copy_bytes ? step.item_size : step.item_count;
+        const size_t items_per_piece = std::max<size_t>(piece_size / item_size, 1);
+        for (size_t first_item = 0; first_item < item_count; first_item += items_per_piece) {
+            const size_t count = std::min(items_per_piece, item_count - first_item);
+            Step piece = step;
+            piece.source_offset += first_item * item_size;
+            piece.destination_offset += first_item * item_size;
+            if (step.type == copy_bytes) {
+                piece.item_size = count;
+            }
+            else {
+                piece.item_count = count;
+            }
+            pieces.push_back({&elements,
+                              piece,
+                              piece.destination_offset,
+                              piece.destination_offset + count * item_size});
+        }
+    }
+}
+
+a_util::result::Result TransformPlan::executeStep(const Step& step,
+                                                  const std::vector<StructLayoutElement>& elements,
+                                                  DataRepresentation source_rep,
+                                                  const void* source,
+                                                  size_t source_size,
+                                                  void* destination,
+                                                  size_t destination_size)
+{
+    switch (step.type) {
+    case copy_bytes:
+        std::memcpy(static_cast<uint8_t*>(destination) + step.destination_offset,
+                    static_cast<const uint8_t*>(source) + step.source_offset,
+                    step.item_size);
+        break;
+    case swap_bytes:
+        swapByteOrder(static_cast<const uint8_t*>(source) + step.source_offset,
+                      static_cast<uint8_t*>(destination) + step.destination_offset,
+                      step.item_size,
+                      step.item_count);
+        break;
+    case copy_element: {
+        const ElementAccessor& source_accessor = source_rep == deserialized ?
+                                                     DeserializedAccessor::getInstance() :
+                                                     SerializedAccessor::getInstance();
+        const ElementAccessor& destination_accessor = source_rep == deserialized ?
+                                                          SerializedAccessor::getInstance() :
+                                                          DeserializedAccessor::getInstance();
+        const StructLayoutElement& element = elements[step.element_index];
+        uint64_t buffer = 0;
+        RETURN_IF_FAILED(source_accessor.getValue(element, source, source_size, &buffer));
+        RETURN_IF_FAILED(
+            destination_accessor.setValue(element, destination, destination_size, &buffer));
+        break;
+    }
+    }
+
+    return a_util::result::SUCCESS;
+}
+
+bool TransformPlan::canTransform(const StaticDecoder& decoder, const StaticDecoder& codec)
+{
+    return decoder._layout && decoder._layout == codec._layout &&
+           decoder.getRepresentation() != codec.getRepresentation();
+}
+
+bool TransformPlan::canTransform(const Decoder& decoder, const Codec& codec)
+{
+    // the dynamic elements only match if both were calculated for the same array sizes, the
+    // plans of projections do not cover their dynamic elements
+    return canTransform(static_cast<const StaticDecoder&>(decoder),
+                        static_cast<const StaticDecoder&>(codec)) &&
+           !decoder._layout->hasProjectedDynamicElements() &&
+           decoder.getDynamicLayout() == codec.getDynamicLayout();
+}
+
+a_util::result::Result TransformPlan::transform(const StaticDecoder& decoder, StaticCodec& codec)
+{
+    assert(canTransform(decoder, codec));
+    return decoder._layout->getTransformPlan(decoder.getRepresentation())
+        .execute(decoder._layout->getStaticElements(),
+                 decoder._data,
+                 decoder._data_size,
+                 const_cast<void*>(codec._data),
+                 codec._data_size);
+}
+
+a_util::result::Result TransformPlan::transform(const Decoder& decoder, Codec& codec)
+{
+    const DataRepresentation source_rep = decoder.getRepresentation();
+    assert(codec.getRepresentation() != source_rep);
+
+    RETURN_IF_FAILED(decoder._layout->getTransformPlan(source_rep).execute(
+        decoder._layout->getStaticElements(),
+        decoder._data,
+        decoder._data_size,
+        const_cast<void*>(codec._data),
+        codec._data_size));
+
+    const DynamicLayout* dynamic_layout = decoder.getDynamicLayout();
+    if (dynamic_layout && !dynamic_layout->getElements().empty()) {
+        // the dynamic part depends on the actual data, so its plan cannot be cached
+        const TransformPlan dynamic_plan(dynamic_layout->getElements(), source_rep);
+        RETURN_IF_FAILED(dynamic_plan.execute(dynamic_layout->getElements(),
+                                              decoder._data,
+                                              decoder._data_size,
+                                              const_cast<void*>(codec._data),
+                                              codec._data_size));
+    }
+
+    return a_util::result::SUCCESS;
+}
+
+a_util::result::Result TransformPlan::transform(const Decoder& decoder,
+                                                Codec& codec,
+                                                size_t parallelism)
+{
+    parallelism = WorkerPool::getUsableParallelism(parallelism);
+    if (parallelism <= 1 || codec._data_size < 2 * minimum_chunk_size) {
+        return transform(decoder, codec);
+    }
+
+    const DataRepresentation source_rep = decoder.getRepresentation();
+    assert(codec.getRepresentation() != source_rep);
+
+    const TransformPlan& static_plan = decoder._layout->getTransformPlan(source_rep);
+    const DynamicLayout* dynamic_layout = decoder.getDynamicLayout();
+    const TransformPlan dynamic_plan =
+        dynamic_layout ? TransformPlan(dynamic_layout->getElements(), source_rep) : TransformPlan();
+    if (decoder._data_size < std::max(static_plan._source_size, dynamic_plan._source_size) ||
+        codec._data_size <
+            std::max(static_plan._destination_size, dynamic_plan._destination_size)) {
+        return ERR_INVALID_ARG;
+    }
+
+    const size_t piece_size = std::max(
+        (std::max(static_plan._destination_size, dynamic_plan._destination_size) + parallelism -
+         1) / parallelism,
+        minimum_chunk_size);
+    std::vector<Piece> pieces;
+    static_plan.addPieces(decoder._layout->getStaticElements(), piece_size, pieces);
+    if (dynamic_layout) {
+        dynamic_plan.addPieces(dynamic_layout->getElements(), piece_size, pieces);
+    }
+
+    // a chunk may only end where all bytes written before precede all bytes written after it
+    std::vector<size_t> following_begin(pieces.size() + 1, std::numeric_limits<size_t>::max());
+    for (size_t piece_index = pieces.size(); piece_index > 0; --piece_index) {
+        following_begin[piece_index - 1] =
+            std::min(following_begin[piece_index], pieces[piece_index - 1].destination_begin);
+    }
+    std::vector<size_t> chunk_ends;
+    size_t preceding_end = 0, chunk_size = 0;
+    for (size_t piece_index = 0; piece_index + 1 < pieces.size(); ++piece_index) {
+        const Piece& piece = pieces[piece_index];
+        preceding_end = std::max(preceding_end, piece.destination_end);
+        chunk_size += piece.destination_end - piece.destination_begin;
+        if (chunk_size >= piece_size && preceding_end <= following_begin[piece_index + 1] &&
+            chunk_ends.size() + 1 < parallelism) {
+            chunk_ends.push_back(piece_index + 1);
+            chunk_size = 0;
+        }
+    }
+    chunk_ends.push_back(pieces.size());
+
+    const auto execute_chunk = [&](size_t chunk) -> a_util::result::Result {
+        for (size_t piece_index = chunk == 0 ? 0 : chunk_ends[chunk - 1];
+             piece_index < chunk_ends[chunk];
+             ++piece_index) {
+            const Piece& piece = pieces[piece_index];
+            RETURN_IF_FAILED(executeStep(piece.step,
+                                         *piece.elements,
+                                         source_rep,
+                                         decoder._data,
+                                         decoder._data_size,
+                                         const_cast<void*>(codec._data),
+                                         codec._data_size));
+        }
+        return a_util::result::SUCCESS;
+    };
+
+    std::vector<a_util::result::Result> results(chunk_ends.size());
+    WorkerPool::getInstance().run(chunk_ends.size(), parallelism, [&](size_t chunk) {
+        results[chunk] = execute_chunk(chunk);
+    });
+
+    for (const a_util::result::Result& result: results) {
+        RETURN_IF_FAILED(result);
+    }
+    return a_util::result::SUCCESS;
+}
+
+} // namespace ddl
@@ -0,0 +1,151 @@
+/**
+ * @file
+ * Precomputed transformation between the data representations of a struct layout.
+ *
+ * Copyright @ 2021 VW Group. All rights reserved.
+ *
+ *     This Source Code Form is subject to the terms of the Mozilla
+ *     Public License, v. 2.0. If a copy of the MPL was not distributed
+ *     with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * If it is not possible or desirable to put the notice in a particular file, then
+ * You may include the notice in a location (such as a LICENSE file in a
+ * relevant directory) where a recipient would be likely to look for such a notice.
+ *
+ * You may add additional accurate notices of copyright ownership.
+ */
+
+#ifndef DDL_TRANSFORM_PLAN_CLASS_HEADER
+#define DDL_TRANSFORM_PLAN_CLASS_HEADER
+
+#include "a_util/result.h"
+#include "ddl/codec/struct_element.h"
+
+#include <vector>
+
+namespace ddl {
+class StaticDecoder;
+class StaticCodec;
+class Decoder;
+class Codec;
+
+/**
+ * @internal
+ * This class is for internal use only.
+ *
+ * A list of copy steps that transforms the elements of a layout from one data representation
+ * into the other. Runs of byte aligned elements that are adjacent in both representations are
+ * merged into a single memcpy block, or into a single byte swap block if all of them have the
+ * same size and their byte order differs between the representations, which is converted in
+ * bulk. Only the remaining elements are copied one by one through the element accessors.
+ */
+class TransformPlan {
+public:
+    TransformPlan();
+    TransformPlan(const std::vector<StructLayoutElement>& elements, DataRepresentation source_rep);
+
+    /**
+     * Transforms the data of the elements the plan has been created for.
+     * @param[in] elements The elements the plan has been created for.
+     * @param[in] source The source data in the source representation of the plan.
+     * @param[in] source_size The size of the source data.
+     * @param[out] destination The destination data in the opposite representation.
+     * @param[in] destination_size The size of the destination data.
+     * @retval ERR_INVALID_ARG One of the buffers is too small, nothing has been written.
+     */
+    a_util::result::Result execute(const std::vector<StructLayoutElement>& elements,
+                                   const void* source,
+                                   size_t source_size,
+                                   void* destination,
+                                   size_t destination_size) const;
+
+    /**
+     * @return Whether the decoder and the codec share the same layout and differ in their
+     *         representation, so they can be transformed with a plan.
+     */
+    static bool canTransform(const StaticDecoder& decoder, const StaticDecoder& codec);
+
+    /**
+     * @copydoc canTransform(const StaticDecoder&, const StaticDecoder&)
+     * The dynamic elements of both have to be calculated for the same array sizes.
+     */
+    static bool canTransform(const Decoder& decoder, const Codec& codec);
+
+    /**
+     * Transforms all elements of a static decoder into a static codec of the same layout in the
+     * opposite representation, using the precomputed plan.
+     * @param[in] decoder The source decoder.
+     * @param[out] codec The destination codec, see canTransform().
+     * @return Standard result.
+     */
+    static a_util::result::Result transform(const StaticDecoder& decoder, StaticCodec& codec);
+
+    /**
+     * Transforms all elements of a decoder into a codec of the same layout in the opposite
+     * representation, using the precomputed plan of the static elements.
+     * @param[in] decoder The source decoder.
+     * @param[out] codec The destination codec created from @p decoder.
+     * @return Standard result.
+     */
+    static a_util::result::Result transform(const Decoder& decoder, Codec& codec);
+
+    /**
+     * Transforms all elements of a decoder into a codec like transform(const Decoder&, Codec&),
+     * but splits the steps of the plans into chunks that are executed on the threads of the
+     * process wide @ref WorkerPool.
+     * Large block copies and byte swaps are split up, the chunks are only cut where the bytes
+     * written before and after the cut are disjoint, so bit-packed elements sharing a byte are
+     * always written by the same thread.
+     * @param[in] decoder The source decoder.
+     * @param[out] codec The destination codec created from @p decoder.
+     * @param[in] parallelism The maximum number of threads to use, including the calling one.
+     * @return Standard result.
+     */
+    static a_util::result::Result transform(const Decoder& decoder,
+                                            Codec& codec,
+                                            size_t parallelism);
+
+private:
+    void addElement(const StructLayoutElement& element, size_t element_index);
+
+private:
+    enum StepType { copy_bytes, swap_bytes, copy_element };
+
+    struct Step {
+        StepType type;
+        size_t source_offset;
+        size_t destination_offset;
+        size_t item_size;
+        size_t item_count;
+        size_t element_index;
+    };
+
+    /// A step together with the elements of the plan it belongs to.
+    struct Piece {
+        const std::vector<StructLayoutElement>* elements;
+        Step step;
+        size_t destination_begin;
+        size_t destination_end;
+    };
+
+    void addPieces(const std::vector<StructLayoutElement>& elements,
+                   size_t piece_size,
+                   std::vector<Piece>& pieces) const;
+
+    static a_util::result::Result executeStep(const Step& step,
+                                              const std::vector<StructLayoutElement>& elements,
+                                              DataRepresentation source_rep,
+                                              const void* source,
+                                              size_t source_size,
+                                              void* destination,
+                                              size_t destination_size);
+
+    std::vector<Step> _steps;
+    DataRepresentation _source_rep;
+    size_t _source_size;
+    size_t _destination_size;
+};
+
+} // namespace ddl
+
+#endif
@@ -0,0 +1,296 @@
+/**
+ * @file
+ * Implementation of the validated decoder and codec views.
+ *
+ * Copyright @ 2021 VW Group. All rights reserved.
+ *
+ *     This Source Code Form is subject to the terms of the Mozilla
+ *     Public License, v. 2.0. If a copy of the MPL was not distributed
+ *     with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * If it is not possible or desirable to put the notice in a particular file, then
+ * You may include the notice in a location (such as a LICENSE file in a
+ * relevant directory) where a recipient would be likely to look for such a notice.
+ *
+ * You may add additional accurate notices of copyright ownership.
+ */
+
+#include "ddl/codec/validated_view.h"
+
+#include "a_util/result/error_def.h"
+#include "ddl/codec/bitserializer.h"
+#include "dynamic_layout.h"
+#include "struct_layout.h"
+
+#include <assert.h>
+#include <cstring>
+
+namespace ddl {
+// define all needed error types and values locally
+_MAKE_RESULT(-19, ERR_NOT_SUPPORTED);
+_MAKE_RESULT(-37, ERR_NOT_INITIALIZED);
+
+namespace {
+template <typename T>
+void readUnchecked(const StructLayoutElement& element,
+                   DataRepresentation rep,
+                   const void* data,
+                   size_t data_size,
+                   void* value)
+{
+    if (rep == deserialized) {
+        std::memcpy(value,
+                    static_cast<const uint8_t*>(data) + element.deserialized.bit_offset / 8,
+                    sizeof(T));
+        return;
+    }
+    a_util::memory::BitSerializer(const_cast<void*>(data), data_size)
+        .readUnchecked(element.serialized.bit_offset,
+                       element.serialized.bit_size,
+                       static_cast<T*>(value),
+                       static_cast<a_util::memory::Endianess>(element.byte_order));
+}
+
+template <typename T>
+void writeUnchecked(const StructLayoutElement& element,
+                    DataRepresentation rep,
+                    void* data,
+                    size_t data_size,
+                    const void* value)
+{
+    if (rep == deserialized) {
+        std::memcpy(static_cast<uint8_t*>(data) + element.deserialized.bit_offset / 8,
+                    value,
+                    sizeof(T));
+        return;
+    }
+    T typed_value;
+    std::memcpy(&typed_value, value, sizeof(T));
+    a_util::memory::BitSerializer(data, data_size)
+        .writeUnchecked(element.serialized.bit_offset,
+                        element.serialized.bit_size,
+                        typed_value,
+                        static_cast<a_util::memory::Endianess>(element.byte_order));
+}
+
+template <typename T>
+a_util::variant::Variant readVariant(const StructLayoutElement& element,
+                                     DataRepresentation rep,
+                                     const void* data,
+                                     size_t data_size)
+{
+    T value;
+    readUnchecked<T>(element, rep, data, data_size, &value);
+    return a_util::variant::Variant(value);
+}
+
+template <typename T>
+void writeVariant(const StructLayoutElement& element,
+                  DataRepresentation rep,
+                  void* data,
+                  size_t data_size,
+                  const a_util::variant::Variant& value)
+{
+    const T typed_value = value;
+    writeUnchecked<T>(element, rep, data, data_size, &typed_value);
+}
+
+} // namespace
+
+ValidatedDecoderView::ValidatedDecoderView()
+    : _decoder(nullptr),
+      _static_elements(nullptr),
+      _static_count(0),
+      _dynamic_elements(nullptr),
+      _dynamic_count(0),
+      _data(nullptr),
+      _data_size(0),
+      _representation(deserialized),
+      _result(ERR_NOT_INITIALIZED)
+{
+}
+
+ValidatedDecoderView::ValidatedDecoderView(const StaticDecoder& decoder)
+    : _decoder(&decoder),
+      _static_elements(decoder._layout->getStaticElements().data()),
+      _static_count(decoder._layout->getStaticElements().size()),
+      _dynamic_elements(nullptr),
+      _dynamic_count(0),
+      _data(decoder._data),
+      _data_size(decoder._data_size),
+      _representation(decoder.getRepresentation()),
+      _result(decoder.StaticDecoder::isValid())
+{
+}
+
+ValidatedDecoderView::ValidatedDecoderView(const Decoder& decoder)
+    : ValidatedDecoderView(static_cast<const StaticDecoder&>(decoder))
+{
+    // the static check passed, now the dynamic elements are located and checked as a whole
+    if (isOk(_result) && decoder._layout->hasDynamicElements()) {
+        _result = decoder.isValid();
+        if (isOk(_result)) {
+            initDynamicElements(decoder);
+        }
+    }
+}
+
+void ValidatedDecoderView::initDynamicElements(const Decoder& decoder)
+{
+    const DynamicLayout* dynamic_layout = decoder.getDynamicLayout();
+    _result = dynamic_layout->getCalculationResult();
+    if (isFailed(_result)) {
+        return;
+    }
+
+    _dynamic_count = decoder.getElementCount() - _static_count;
+    if (decoder._layout->hasProjectedDynamicElements()) {
+        _projected_elements.reserve(_dynamic_count);
+        for (size_t index = 0; index < _dynamic_count; ++index) {
+            const StructLayoutElement* element = decoder.getProjectedElement(index);
+            if (!element) {
+                _result = ERR_NOT_SUPPORTED;
+                return;
+            }
+            _projected_elements.push_back(element);
+        }
+    }
+    else {
+        _dynamic_elements = dynamic_layout->getElements().data();
+    }
+}
+
+a_util::result::Result ValidatedDecoderView::isValid() const
+{
+    return _result;
+}
+
+const StaticDecoder& ValidatedDecoderView::getDecoder() const
+{
+    assert(_decoder);
+    return *_decoder;
+}
+
+size_t ValidatedDecoderView::getElementCount() const
+{
+    return _static_count + _dynamic_count;
+}
+
+#define DDL_VALIDATED_READ_CASE(__variant_type, __data_type)                                       \
+    case a_util::variant::__variant_type:                                                          \
+        readUnchecked<__data_type>(element, _representation, _data, _data_size, value);            \
+        break;
+
+void ValidatedDecoderView::getElementValue(size_t index, void* value) const
+{
+    assert(isOk(_result) && index < getElementCount());
+    const StructLayoutElement& element = getLayoutElement(index);
+    switch (element.type) {
+        DDL_VALIDATED_READ_CASE(VT_Bool, bool)
+        DDL_VALIDATED_READ_CASE(VT_Int8, int8_t)
+        DDL_VALIDATED_READ_CASE(VT_UInt8, uint8_t)
+        DDL_VALIDATED_READ_CASE(VT_Int16, int16_t)
+        DDL_VALIDATED_READ_CASE(VT_UInt16, uint16_t)
+        DDL_VALIDATED_READ_CASE(VT_Int32, int32_t)
+        DDL_VALIDATED_READ_CASE(VT_UInt32, uint32_t)
+        DDL_VALIDATED_READ_CASE(VT_Int64, int64_t)
+        DDL_VALIDATED_READ_CASE(VT_UInt64, uint64_t)
+        DDL_VALIDATED_READ_CASE(VT_Float32, float)
+        DDL_VALIDATED_READ_CASE(VT_Float64, double)
+    default:
+        break;
+    }
+}
+
+#define DDL_VALIDATED_READ_VARIANT_CASE(__variant_type, __data_type)                               \
+    case a_util::variant::__variant_type:                                                          \
+        return readVariant<__data_type>(element, _representation, _data, _data_size);
+
+a_util::variant::Variant ValidatedDecoderView::getElementValue(size_t index) const
+{
+    assert(isOk(_result) && index < getElementCount());
+    const StructLayoutElement& element = getLayoutElement(index);
+    switch (element.type) {
+        DDL_VALIDATED_READ_VARIANT_CASE(VT_Bool, bool)
+        DDL_VALIDATED_READ_VARIANT_CASE(VT_Int8, int8_t)
+        DDL_VALIDATED_READ_VARIANT_CASE(VT_UInt8, uint8_t)
+        DDL_VALIDATED_READ_VARIANT_CASE(VT_Int16, int16_t)
+        DDL_VALIDATED_READ_VARIANT_CASE(VT_UInt16, uint16_t)
+        DDL_VALIDATED_READ_VARIANT_CASE(VT_Int32, int32_t)
+        DDL_VALIDATED_READ_VARIANT_CASE(VT_UInt32, uint32_t)
+        DDL_VALIDATED_READ_VARIANT_CASE(VT_Int64, int64_t)
+        DDL_VALIDATED_READ_VARIANT_CASE(VT_UInt64, uint64_t)
+        DDL_VALIDATED_READ_VARIANT_CASE(VT_Float32, float)
+        DDL_VALIDATED_READ_VARIANT_CASE(VT_Float64, double)
+    default:
+        return a_util::variant::Variant();
+    }
+}
+
+ValidatedCodecView::ValidatedCodecView() : ValidatedDecoderView()
+{
+}
+
+ValidatedCodecView::ValidatedCodecView(StaticCodec& codec) : ValidatedDecoderView(codec)
+{
+}
+
+ValidatedCodecView::ValidatedCodecView(Codec& codec) : ValidatedDecoderView(codec)
+{
+}
+
+#define DDL_VALIDATED_WRITE_CASE(__variant_type, __data_type)                                      \
+    case a_util::variant::__variant_type:                                                          \
+        writeUnchecked<__data_type>(                                                               \
+            element, _representation, const_cast<void*>(_data), _data_size, value);                \
+        break;
+
+void ValidatedCodecView::setElementValue(size_t index, const void* value)
+{
+    assert(isOk(_result) && index < getElementCount());
+    const StructLayoutElement& element = getLayoutElement(index);
+    switch (element.type) {
+        DDL_VALIDATED_WRITE_CASE(VT_Bool, bool)
+        DDL_VALIDATED_WRITE_CASE(VT_Int8, int8_t)
+        DDL_VALIDATED_WRITE_CASE(VT_UInt8, uint8_t)
+        DDL_VALIDATED_WRITE_CASE(VT_Int16, int16_t)
+        DDL_VALIDATED_WRITE_CASE(VT_UInt16, uint16_t)
+        DDL_VALIDATED_WRITE_CASE(VT_Int32, int32_t)
+        DDL_VALIDATED_WRITE_CASE(VT_UInt32, uint32_t)
+        DDL_VALIDATED_WRITE_CASE(VT_Int64, int64_t)
+        DDL_VALIDATED_WRITE_CASE(VT_UInt64, uint64_t)
+        DDL_VALIDATED_WRITE_CASE(VT_Float32, float)
+        DDL_VALIDATED_WRITE_CASE(VT_Float64, double)
+    default:
+        break;
+    }
+}
+
+#define DDL_VALIDATED_WRITE_VARIANT_CASE(__variant_type, __data_type)                              \
+    case a_util::variant::__variant_type:                                                          \
+        writeVariant<__data_type>(                                                                 \
+            element, _representation, const_cast<void*>(_data), _data_size, value);                \
+        break;
+
+void ValidatedCodecView::setElementValue(size_t index, const a_util::variant::Variant& value)
+{
+    assert(isOk(_result) && index < getElementCount());
+    const StructLayoutElement& element = getLayoutElement(index);
+    switch (element.type) {
+        DDL_VALIDATED_WRITE_VARIANT_CASE(VT_Bool, bool)
+        DDL_VALIDATED_WRITE_VARIANT_CASE(VT_Int8, int8_t)
+        DDL_VALIDATED_WRITE_VARIANT_CASE(VT_UInt8, uint8_t)
+        DDL_VALIDATED_WRITE_VARIANT_CASE(VT_Int16, int16_t)
+        DDL_VALIDATED_WRITE_VARIANT_CASE(VT_UInt16, uint16_t)
+        DDL_VALIDATED_WRITE_VARIANT_CASE(VT_Int32, int32_t)
+        DDL_VALIDATED_WRITE_VARIANT_CASE(VT_UInt32, uint32_t)
+        DDL_VALIDATED_WRITE_VARIANT_CASE(VT_Int64, int64_t)
+        DDL_VALIDATED_WRITE_VARIANT_CASE(VT_UInt64, uint64_t)
+        DDL_VALIDATED_WRITE_VARIANT_CASE(VT_Float32, float)
+        DDL_VALIDATED_WRITE_VARIANT_CASE(VT_Float64, double)
+    default:
+        break;
+    }
+}
+
+} // namespace ddl
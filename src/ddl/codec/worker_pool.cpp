@@ -0,0 +1,147 @@
+/**
+ * @file
+ * Implementation of the process wide pool of worker threads.
+ *
+ * Copyright @ 2021 VW Group. All rights reserved.
+ *
+ *     This Source Code Form is subject to the terms of the Mozilla
+ *     Public License, v. 2.0. If a copy of the MPL was not distributed
+ *     with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * If it is not possible or desirable to put the notice in a particular file, then
+ * You may include the notice in a location (such as a LICENSE file in a
+ * relevant directory) where a recipient would be likely to look for such a notice.
+ *
+ * You may add additional accurate notices of copyright ownership.
+ */
+
+#include "worker_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <system_error>
+
+namespace ddl {
+
+/// A call of @ref WorkerPool::run, shared by the calling thread and the workers helping it.
+struct WorkerPool::Job {
+    Job(size_t count, size_t helper_count, const std::function<void(size_t)>& task)
+        : _count(count), _helpers_left(helper_count), _task(task)
+    {
+    }
+
+    /// Calls the task for the indices no other thread has taken yet.
+    void execute()
+    {
+        for (size_t index = _next++; index < _count; index = _next++) {
+            _task(index);
+        }
+    }
+
+    const size_t _count;
+    std::atomic<size_t> _next{0};
+    /// workers that may still join, guarded by the mutex of the pool
+    size_t _helpers_left;
+    /// workers executing the job, guarded by @ref _mutex
+    size_t _helpers_running = 0;
+    const std::function<void(size_t)>& _task;
+    std::mutex _mutex;
+    std::condition_variable _helpers_done;
+};
+
+WorkerPool& WorkerPool::getInstance()
+{
+    static WorkerPool pool;
+    return pool;
+}
+
+size_t WorkerPool::getUsableParallelism(size_t parallelism)
+{
+    return std::min(parallelism, std::max<size_t>(std::thread::hardware_concurrency(), 1));
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopped = true;
+    }
+    _job_added.notify_all();
+    for (std::thread& worker: _workers) {
+        worker.join();
+    }
+}
+
+void WorkerPool::run(size_t count, size_t parallelism, const std::function<void(size_t)>& task)
+{
+    const size_t helper_count =
+        std::min(getUsableParallelism(parallelism), count) - (count == 0 ? 0 : 1);
+    if (helper_count == 0) {
+        for (size_t index = 0; index < count; ++index) {
+            task(index);
+        }
+        return;
+    }
+
+    const auto job = std::make_shared<Job>(count, helper_count, task);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        startWorkers(helper_count);
+        _jobs.push_back(job);
+    }
+    _job_added.notify_all();
+    job->execute();
+    {
+        // no worker may join the job after this
+        std::lock_guard<std::mutex> lock(_mutex);
+        const auto queued = std::find(_jobs.begin(), _jobs.end(), job);
+        if (queued != _jobs.end()) {
+            _jobs.erase(queued);
+        }
+    }
+    std::unique_lock<std::mutex> lock(job->_mutex);
+    job->_helpers_done.wait(lock, [&job]() { return job->_helpers_running == 0; });
+}
+
+void WorkerPool::startWorkers(size_t worker_count)
+{
+    while (_workers.size() < worker_count) {
+        try {
+            _workers.emplace_back(&WorkerPool::work, this);
+        }
+        catch (const std::system_error&) {
+            // no more threads available, the calling threads take over the work
+            break;
+        }
+    }
+}
+
+void WorkerPool::work()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _job_added.wait(lock, [this]() { return _stopped || !_jobs.empty(); });
+        if (_stopped) {
+            return;
+        }
+        const std::shared_ptr<Job> job = _jobs.front();
+        if (--job->_helpers_left == 0) {
+            _jobs.pop_front();
+        }
+        {
+            std::lock_guard<std::mutex> job_lock(job->_mutex);
+            ++job->_helpers_running;
+        }
+        lock.unlock();
+        job->execute();
+        {
+            std::lock_guard<std::mutex> job_lock(job->_mutex);
+            if (--job->_helpers_running == 0) {
+                job->_helpers_done.notify_all();
+            }
+        }
+        lock.lock();
+    }
+}
+
+} // namespace ddl
@@ -0,0 +1,82 @@
+/**
+ * @file
+ * Process wide pool of worker threads.
+ *
+ * Copyright @ 2021 VW Group. All rights reserved.
+ *
+ *     This Source Code Form is subject to the terms of the Mozilla
+ *     Public License, v. 2.0. If a copy of the MPL was not distributed
+ *     with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * If it is not possible or desirable to put the notice in a particular file, then
+ * You may include the notice in a location (such as a LICENSE file in a
+ * relevant directory) where a recipient would be likely to look for such a notice.
+ *
+ * You may add additional accurate notices of copyright ownership.
+ */
+
+#ifndef DDL_WORKER_POOL_HEADER
+#define DDL_WORKER_POOL_HEADER
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ddl {
+/**
+ * @internal
+ * Process wide pool of worker threads. The workers are started on first demand and kept for all
+ * later calls, so repeated parallel work does not pay for starting and joining threads.
+ * The number of workers is limited by the number of hardware threads.
+ */
+class WorkerPool {
+public:
+    /**
+     * Get the process wide pool.
+     * @return WorkerPool& the pool.
+     */
+    static WorkerPool& getInstance();
+
+    /**
+     * Limits a requested parallelism to the number of hardware threads. Callers can skip the
+     * preparation of parallel work if this is 1.
+     * @param[in] parallelism The requested maximum number of threads, including the calling one.
+     * @return size_t the number of threads @ref run will use at most.
+     */
+    static size_t getUsableParallelism(size_t parallelism);
+
+    /**
+     * Calls @p task for all indices below @p count on at most @p parallelism threads, including
+     * the calling one, and returns after all calls are done. The calling thread takes every index
+     * no worker is free for, so nested and concurrent calls never wait for each other.
+     * @param[in] count The number of indices.
+     * @param[in] parallelism The maximum number of threads to use, including the calling one.
+     * @param[in] task The task to call for each index, must not throw.
+     */
+    void run(size_t count, size_t parallelism, const std::function<void(size_t)>& task);
+
+    /// DTOR, stops and joins the workers.
+    ~WorkerPool();
+
+private:
+    struct Job;
+
+    WorkerPool() = default;
+    void startWorkers(size_t worker_count);
+    void work();
+
+    std::mutex _mutex;
+    std::condition_variable _job_added;
+    std::deque<std::shared_ptr<Job>> _jobs;
+    std::vector<std::thread> _workers;
+    bool _stopped = false;
+};
+
+} // namespace ddl
+
+#endif
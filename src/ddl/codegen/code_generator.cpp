@@ -0,0 +1,316 @@
+/**
+ * @file
+ * Implementation of the generator of compile-time codecs.
+ *
+ * Copyright @ 2021 VW Group. All rights reserved.
+ *
+ *     This Source Code Form is subject to the terms of the Mozilla
+ *     Public License, v. 2.0. If a copy of the MPL was not distributed
+ *     with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * If it is not possible or desirable to put the notice in a particular file, then
+ * You may include the notice in a location (such as a LICENSE file in a
+ * relevant directory) where a recipient would be likely to look for such a notice.
+ *
+ * You may add additional accurate notices of copyright ownership.
+ */
+
+#include "code_generator.h"
+
+#include "../codec/struct_layout.h"
+#include "a_util/strings.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace ddl {
+namespace codegen {
+namespace {
+struct PlainType {
+    const char* name;
+    size_t size;
+};
+
+const PlainType* findPlainType(const std::string& data_type_name)
+{
+    static const std::map<std::string, PlainType> plain_types = {
+        {"tBool", {"bool", sizeof(bool)}},        {"bool", {"bool", sizeof(bool)}},
+        {"tChar", {"int8_t", 1}},                 {"char", {"int8_t", 1}},
+        {"tInt8", {"int8_t", 1}},                 {"int8_t", {"int8_t", 1}},
+        {"tUInt8", {"uint8_t", 1}},               {"uint8_t", {"uint8_t", 1}},
+        {"tInt16", {"int16_t", 2}},               {"int16_t", {"int16_t", 2}},
+        {"tUInt16", {"uint16_t", 2}},             {"uint16_t", {"uint16_t", 2}},
+        {"tInt32", {"int32_t", 4}},               {"int32_t", {"int32_t", 4}},
+        {"tUInt32", {"uint32_t", 4}},             {"uint32_t", {"uint32_t", 4}},
+        {"tInt64", {"int64_t", 8}},               {"int64_t", {"int64_t", 8}},
+        {"tUInt64", {"uint64_t", 8}},             {"uint64_t", {"uint64_t", 8}},
+        {"tFloat32", {"float", sizeof(float)}},   {"float", {"float", sizeof(float)}},
+        {"tFloat64", {"double", sizeof(double)}}, {"double", {"double", sizeof(double)}}};
+    const auto found = plain_types.find(data_type_name);
+    return found != plain_types.end() ? &found->second : nullptr;
+}
+
+bool isIdentifier(const std::string& name)
+{
+    if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0]))) {
+        return false;
+    }
+    return std::all_of(name.begin(), name.end(), [](char character) {
+        return std::isalnum(static_cast<unsigned char>(character)) || character == '_';
+    });
+}
+
+std::string getByteOrderName(dd::ByteOrder byte_order)
+{
+    switch (byte_order) {
+    case dd::e_le:
+        return "ddl::dd::e_le";
+    case dd::e_be:
+        return "ddl::dd::e_be";
+    default:
+        return "ddl::dd::e_noe";
+    }
+}
+
+} // namespace
+
+CodeGenerator::CodeGenerator(const dd::DataDefinition& dd, const std::string& namespace_name)
+    : _dd(dd), _namespace(namespace_name)
+{
+}
+
+void CodeGenerator::addStruct(const std::string& struct_name)
+{
+    if (_struct_indices.find(struct_name) != _struct_indices.end()) {
+        return;
+    }
+
+    const dd::StructTypeAccess access = _dd.getStructTypeAccess(struct_name);
+    if (!access) {
+        throw dd::Error("CodeGenerator::addStruct", {struct_name}, "unknown struct type");
+    }
+
+    for (const auto& element_access: access) {
+        if (element_access.getTypeOfType() == dd::TypeOfType::struct_type) {
+            addStruct(element_access.getElement().getTypeName());
+        }
+    }
+
+    GeneratedStruct generated;
+    generated.name = getStructName(struct_name);
+    generateDeclaration(access, generated);
+    generateTraits(struct_name, generated);
+    _struct_indices[struct_name] = _structs.size();
+    _structs.push_back(std::move(generated));
+}
+
+void CodeGenerator::generateDeclaration(const dd::StructTypeAccess& access,
+                                        GeneratedStruct& generated) const
+{
+    const std::string& struct_name = access.getStructType().getName();
+    std::string members;
+    std::string offset_checks;
+    size_t offset = 0;
+    size_t padding_count = 0;
+    const auto addPadding = [&](size_t position) {
+        if (position > offset) {
+            members += "    uint8_t _padding_" + std::to_string(padding_count++) + "[" +
+                       std::to_string(position - offset) + "];\n";
+        }
+    };
+
+    for (const auto& element_access: access) {
+        const auto& element = element_access.getElement();
+        if (element_access.isDynamic() || element_access.isAfterDynamic()) {
+            throw dd::Error("CodeGenerator::addStruct",
+                            {struct_name, element.getName()},
+                            "dynamic arrays are not supported");
+        }
+        if (!isIdentifier(element.getName())) {
+            throw dd::Error("CodeGenerator::addStruct",
+                            {struct_name, element.getName()},
+                            "the element name is not a valid identifier");
+        }
+
+        std::string type_name;
+        size_t type_size = 0;
+        if (element_access.getTypeOfType() == dd::TypeOfType::struct_type) {
+            const GeneratedStruct& nested =
+                _structs[_struct_indices.at(element.getTypeName())];
+            type_name = nested.name;
+            type_size = nested.deserialized_size;
+        }
+        else {
+            const PlainType* plain_type = findPlainType(
+                element_access.getEnumType() ? element_access.getEnumType()->getDataTypeName() :
+                                               element.getTypeName());
+            if (!plain_type) {
+                throw dd::Error("CodeGenerator::addStruct",
+                                {struct_name, element.getName()},
+                                "the element type is not supported");
+            }
+            type_name = plain_type->name;
+            type_size = plain_type->size;
+        }
+
+        const size_t array_size = std::max(element.getArraySize().getArraySizeValue(), size_t(1));
+        const size_t position = element_access.getDeserializedBytePos(0);
+        for (size_t array_index = 0; array_index < array_size; ++array_index) {
+            if (position < offset ||
+                element_access.getDeserializedBytePos(array_index) !=
+                    position + array_index * type_size) {
+                throw dd::Error("CodeGenerator::addStruct",
+                                {struct_name, element.getName()},
+                                "the deserialized position cannot be expressed by a plain struct");
+            }
+        }
+
+        addPadding(position);
+        members += "    " + type_name + " " + element.getName();
+        if (array_size > 1) {
+            members += "[" + std::to_string(array_size) + "]";
+        }
+        members += ";\n";
+        offset_checks += "static_assert(offsetof(" + generated.name + ", " + element.getName() +
+                         ") == " + std::to_string(position) + ", \"invalid offset of " +
+                         struct_name + "." + element.getName() + "\");\n";
+        offset = position + array_size * type_size;
+    }
+
+    generated.deserialized_size = access.getStaticStructSize();
+    if (generated.deserialized_size < offset) {
+        throw dd::Error("CodeGenerator::addStruct",
+                        {struct_name},
+                        "the deserialized size cannot be expressed by a plain struct");
+    }
+    addPadding(generated.deserialized_size);
+
+    generated.declaration = "/// Deserialized representation of " + struct_name + "\n";
+    generated.declaration += "#pragma pack(push, 1)\n";
+    generated.declaration += "struct " + generated.name + " {\n" + members + "};\n";
+    generated.declaration += "#pragma pack(pop)\n";
+    generated.declaration += "static_assert(sizeof(" + generated.name +
+                             ") == " + std::to_string(generated.deserialized_size) +
+                             ", \"invalid size of " + struct_name + "\");\n";
+    generated.declaration += offset_checks;
+}
+
+void CodeGenerator::generateTraits(const std::string& struct_type_name,
+                                   GeneratedStruct& generated) const
+{
+    const StructLayout layout(_dd.getStructTypeAccess(struct_type_name));
+    if (a_util::result::isFailed(layout.isValid())) {
+        throw dd::Error("CodeGenerator::addStruct",
+                        {struct_type_name},
+                        "the struct layout is invalid: " +
+                            std::string(layout.isValid().getDescription()));
+    }
+    if (layout.hasDynamicElements()) {
+        throw dd::Error(
+            "CodeGenerator::addStruct", {struct_type_name}, "dynamic arrays are not supported");
+    }
+
+    const std::string qualified_name = getQualifiedName(generated.name);
+    const std::string serialized_size = std::to_string(layout.getStaticBufferSize(serialized));
+    std::string elements;
+    std::string serialize;
+    std::string deserialize;
+    for (const StructLayoutElement& element: layout.getStaticElements()) {
+        if ((element.type == a_util::variant::VT_Float ||
+             element.type == a_util::variant::VT_Double) &&
+            element.serialized.bit_size != element.deserialized.bit_size) {
+            throw dd::Error("CodeGenerator::addStruct",
+                            {struct_type_name, element.name},
+                            "floating point elements cannot be bit-packed");
+        }
+
+        const std::string position = std::to_string(element.serialized.bit_offset) + ", " +
+                                     std::to_string(element.serialized.bit_size) + ", " +
+                                     getByteOrderName(element.byte_order);
+        elements += "        {\"" + element.name + "\", " +
+                    std::to_string(element.deserialized.bit_offset / 8) + ", " +
+                    std::to_string(element.deserialized.bit_size / 8) + ", " + position + "},\n";
+        serialize += "        serializeElement<" + position + ">(value." + element.name +
+                     ", buffer, " + serialized_size + ");\n";
+        deserialize += "        deserializeElement<" + position + ">(buffer, " + serialized_size +
+                       ", value." + element.name + ");\n";
+    }
+
+    std::string& traits = generated.traits;
+    traits = "template <typename Dummy>\n";
+    traits += "struct ElementTable<" + qualified_name + ", Dummy> {\n";
+    traits += "    static constexpr ElementInfo elements[] = {\n" + elements + "    };\n";
+    traits += "};\n\n";
+    traits += "template <typename Dummy>\n";
+    traits += "constexpr ElementInfo ElementTable<" + qualified_name + ", Dummy>::elements[];\n\n";
+    traits += "template <>\n";
+    traits += "struct CodecTraits<" + qualified_name + "> {\n";
+    traits += "    static constexpr const char* getStructName()\n    {\n";
+    traits += "        return \"" + struct_type_name + "\";\n    }\n\n";
+    traits += "    static constexpr size_t getDeserializedSize()\n    {\n";
+    traits += "        return " + std::to_string(layout.getStaticBufferSize(deserialized)) +
+              ";\n    }\n\n";
+    traits += "    static constexpr size_t getSerializedSize()\n    {\n";
+    traits += "        return " + serialized_size + ";\n    }\n\n";
+    traits += "    static void serialize(const " + qualified_name +
+              "& value, uint8_t* buffer)\n    {\n" + serialize + "    }\n\n";
+    traits += "    static void deserialize(const uint8_t* buffer, " + qualified_name +
+              "& value)\n    {\n" + deserialize + "    }\n";
+    traits += "};\n";
+}
+
+std::string CodeGenerator::generateHeader(const std::string& source_file,
+                                          const std::string& include_guard) const
+{
+    std::string header = "/**\n * @file\n * Compile-time codecs for the struct types of " +
+                         source_file + ".\n *\n * Generated by ddlcodegen, do not edit.\n */\n\n";
+    header += "#ifndef " + include_guard + "\n#define " + include_guard + "\n\n";
+    header += "#include \"ddl/codec/generated_codec.h\"\n\n";
+    header += "#include <cstddef>\n#include <cstdint>\n\n";
+
+    const std::vector<std::string> namespaces = a_util::strings::split(_namespace, "::");
+    for (const auto& namespace_name: namespaces) {
+        header += "namespace " + namespace_name + " {\n";
+    }
+    for (const auto& generated: _structs) {
+        header += "\n" + generated.declaration;
+    }
+    header += "\n";
+    for (auto namespace_name = namespaces.rbegin(); namespace_name != namespaces.rend();
+         ++namespace_name) {
+        header += "} // namespace " + *namespace_name + "\n";
+    }
+
+    header += "\nnamespace ddl {\nnamespace codegen {\n";
+    for (const auto& generated: _structs) {
+        header += "\n" + generated.traits;
+    }
+    header += "\n} // namespace codegen\n} // namespace ddl\n\n#endif\n";
+    return header;
+}
+
+std::string CodeGenerator::getStructName(const std::string& struct_type_name)
+{
+    std::string name;
+    for (const char character: struct_type_name) {
+        if (std::isalnum(static_cast<unsigned char>(character)) || character == '_') {
+            name += character;
+        }
+        else if (name.empty() || name.back() != '_') {
+            // "pack::tStruct" becomes "pack_tStruct", avoiding reserved double underscores
+            name += '_';
+        }
+    }
+    if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0]))) {
+        name.insert(0, "t");
+    }
+    return name;
+}
+
+std::string CodeGenerator::getQualifiedName(const std::string& struct_name) const
+{
+    return _namespace.empty() ? "::" + struct_name : "::" + _namespace + "::" + struct_name;
+}
+
+} // namespace codegen
+} // namespace ddl
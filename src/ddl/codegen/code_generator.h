@@ -0,0 +1,90 @@
+/**
+ * @file
+ * Generator of compile-time codecs for the struct types of a data definition.
+ *
+ * Copyright @ 2021 VW Group. All rights reserved.
+ *
+ *     This Source Code Form is subject to the terms of the Mozilla
+ *     Public License, v. 2.0. If a copy of the MPL was not distributed
+ *     with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * If it is not possible or desirable to put the notice in a particular file, then
+ * You may include the notice in a location (such as a LICENSE file in a
+ * relevant directory) where a recipient would be likely to look for such a notice.
+ *
+ * You may add additional accurate notices of copyright ownership.
+ */
+
+#ifndef DDL_CODE_GENERATOR_CLASS_HEADER
+#define DDL_CODE_GENERATOR_CLASS_HEADER
+
+#include "ddl/dd/dd.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ddl {
+namespace codegen {
+/**
+ * Generates a header with a plain struct, an offset table and the serialization code for each
+ * added struct type and all struct types it depends on.
+ *
+ * The deserialized positions are taken from the @ref dd::StructTypeAccess of the types and the
+ * serialized positions from the same struct layout the @ref ddl::CodecFactory uses, so the
+ * generated code transforms exactly like a @ref ddl::Codec.
+ */
+class CodeGenerator {
+public:
+    /**
+     * CTOR
+     * @param[in] dd The data definition containing the struct types.
+     * @param[in] namespace_name The namespace of the generated structs, may contain "::".
+     */
+    CodeGenerator(const dd::DataDefinition& dd, const std::string& namespace_name);
+
+    /**
+     * Adds a struct type together with all struct types it depends on.
+     * @param[in] struct_name The name of the struct type.
+     * @throw dd::Error if the struct type is unknown, has dynamic arrays or its deserialized
+     *                  representation cannot be expressed by a plain struct.
+     */
+    void addStruct(const std::string& struct_name);
+
+    /**
+     * @param[in] source_file The description file, only mentioned in the header comment.
+     * @param[in] include_guard The name of the include guard macro.
+     * @return The header with all added struct types in dependency order.
+     */
+    std::string generateHeader(const std::string& source_file,
+                               const std::string& include_guard) const;
+
+    /**
+     * @return The name of the generated struct for a struct type, each sequence of characters
+     *         that are not allowed within an identifier is replaced by an underscore.
+     */
+    static std::string getStructName(const std::string& struct_type_name);
+
+private:
+    struct GeneratedStruct {
+        std::string name;
+        size_t deserialized_size;
+        std::string declaration;
+        std::string traits;
+    };
+
+    void generateDeclaration(const dd::StructTypeAccess& access, GeneratedStruct& generated) const;
+    void generateTraits(const std::string& struct_type_name, GeneratedStruct& generated) const;
+    std::string getQualifiedName(const std::string& struct_name) const;
+
+private:
+    const dd::DataDefinition& _dd;
+    std::string _namespace;
+    std::vector<GeneratedStruct> _structs;
+    std::map<std::string, size_t> _struct_indices;
+};
+
+} // namespace codegen
+} // namespace ddl
+
+#endif
@@ -0,0 +1,133 @@
+/**
+ * @file
+ * Command line tool generating compile-time codecs from a data definition file.
+ *
+ * Copyright @ 2021 VW Group. All rights reserved.
+ *
+ *     This Source Code Form is subject to the terms of the Mozilla
+ *     Public License, v. 2.0. If a copy of the MPL was not distributed
+ *     with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * If it is not possible or desirable to put the notice in a particular file, then
+ * You may include the notice in a location (such as a LICENSE file in a
+ * relevant directory) where a recipient would be likely to look for such a notice.
+ *
+ * You may add additional accurate notices of copyright ownership.
+ */
+
+#include "code_generator.h"
+
+#include "ddl/dd/ddfile.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+void printUsage(const char* program)
+{
+    fprintf(stdout,
+            "Usage: %s --description=<file> --output=<header> [--namespace=<namespace>]\n"
+            "       [--struct=<struct type>]...\n\n"
+            "Generates a header with a plain struct, a constexpr offset table and the\n"
+            "serialization code for each given struct type and the struct types it depends on.\n"
+            "Without --struct all struct types of the description file are generated.\n",
+            program);
+}
+
+bool getArgument(const std::string& argument, const std::string& name, std::string& value)
+{
+    const std::string prefix = "--" + name + "=";
+    if (argument.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    value = argument.substr(prefix.size());
+    return true;
+}
+
+std::string getIncludeGuard(const std::string& output_file)
+{
+    const size_t name_start = output_file.find_last_of("/\\");
+    const std::string file_name =
+        name_start == std::string::npos ? output_file : output_file.substr(name_start + 1);
+    std::string guard = "DDL_GENERATED_";
+    for (const char character: file_name) {
+        guard += std::isalnum(static_cast<unsigned char>(character)) ?
+                     static_cast<char>(std::toupper(static_cast<unsigned char>(character))) :
+                     '_';
+    }
+    return guard;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::string description_file;
+    std::string output_file;
+    std::string namespace_name = "ddl_generated";
+    std::vector<std::string> struct_names;
+    for (int argument_index = 1; argument_index < argc; ++argument_index) {
+        const std::string argument = argv[argument_index];
+        std::string value;
+        if (argument == "--help" || argument == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        else if (getArgument(argument, "description", value)) {
+            description_file = value;
+        }
+        else if (getArgument(argument, "output", value)) {
+            output_file = value;
+        }
+        else if (getArgument(argument, "namespace", value)) {
+            namespace_name = value;
+        }
+        else if (getArgument(argument, "struct", value)) {
+            struct_names.push_back(value);
+        }
+        else {
+            fprintf(stderr, "Invalid argument: %s\n", argument.c_str());
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (description_file.empty() || output_file.empty()) {
+        fprintf(stderr, "Invalid arguments: description and output file must be provided.\n");
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    try {
+        const ddl::dd::DataDefinition dd = ddl::DDFile::fromXMLFile(description_file);
+        if (struct_names.empty()) {
+            for (const auto& struct_type: dd.getStructTypes()) {
+                struct_names.push_back(struct_type.first);
+            }
+            // the types are stored unordered, sort them for a reproducible output
+            std::sort(struct_names.begin(), struct_names.end());
+        }
+
+        ddl::codegen::CodeGenerator generator(dd, namespace_name);
+        for (const auto& struct_name: struct_names) {
+            generator.addStruct(struct_name);
+        }
+
+        std::ofstream output(output_file, std::ios::out | std::ios::trunc);
+        output << generator.generateHeader(description_file, getIncludeGuard(output_file));
+        if (!output) {
+            fprintf(stderr, "Unable to write %s\n", output_file.c_str());
+            return 1;
+        }
+    }
+    catch (const std::exception& error) {
+        fprintf(stderr, "%s: %s\n", description_file.c_str(), error.what());
+        return 1;
+    }
+
+    return 0;
+}
@@ -19,12 +19,22 @@
 
 #include "a_util/xml.h"
 
+#include <atomic>
 #include <exception>
 #include <utility>
 
 namespace ddl {
 namespace dd {
 namespace datamodel {
+namespace {
+uint64_t createChangeId()
+{
+    // 0 is never used, so it can stand for "no change id"
+    static std::atomic<uint64_t> last_change_id(0);
+    return ++last_change_id;
+}
+} // namespace
+
 /*************************************************************************************************************/
 // DataDefinition
 /*************************************************************************************************************/
@@ -49,7 +59,8 @@ DataDefinition::DataDefinition(const dd::Version& ddl_version)
       _struct_types(this, "datamodel::DataDefinition::StructTypes"),
       _stream_meta_types(this, "datamodel::DataDefinition::StreamMetaTypes"),
       _streams(this, "datamodel::DataDefinition::Streams"),
-      _empty_model(true)
+      _empty_model(true),
+      _change_id(createChangeId())
 {
 }
 
@@ -88,6 +99,7 @@ DataDefinition::DataDefinition(const DataDefinition& other)
     _stream_meta_types._validator = this;
     _streams._validator = this;
     _empty_model = other._empty_model;
+    _change_id = createChangeId();
 }
 
 DataDefinition& DataDefinition::operator=(const DataDefinition& other)
@@ -110,9 +122,27 @@ DataDefinition& DataDefinition::operator=(const DataDefinition& other)
     _stream_meta_types._validator = this;
     _streams._validator = this;
     _empty_model = other._empty_model;
+    _change_id = createChangeId();
     return *this;
 }
 
+void DataDefinition::shareContentOf(const DataDefinition& other)
+{
+    _header = std::make_shared<Header>(*other._header.get());
+    _base_units.shareItemsOf(other._base_units, &copyWithInfos<BaseUnit>);
+    _unit_prefixes.shareItemsOf(other._unit_prefixes, &copyWithInfos<UnitPrefix>);
+    _units.shareItemsOf(other._units, &copyWithInfos<Unit>);
+    _data_types.shareItemsOf(other._data_types, &copyWithInfos<DataType>);
+    _enum_types.shareItemsOf(other._enum_types, &copyWithInfos<EnumType>);
+    _struct_types.shareItemsOf(other._struct_types, &copyWithInfos<StructType>);
+    _stream_meta_types.shareItemsOf(other._stream_meta_types, &copyWithInfos<StreamMetaType>);
+    _streams.shareItemsOf(other._streams, &copyWithInfos<Stream>);
+    InfoMap::operator=(other);
+    copyInfos();
+    _empty_model = other._empty_model;
+    _change_id = createChangeId();
+}
+
 DataDefinition& DataDefinition::operator=(DataDefinition&& other)
 {
     _header = other._header;
@@ -133,6 +163,7 @@ DataDefinition& DataDefinition::operator=(DataDefinition&& other)
     _stream_meta_types._validator = this;
     _streams._validator = this;
     _empty_model = other._empty_model;
+    _change_id = createChangeId();
     return *this;
 }
 
@@ -156,11 +187,13 @@ DataDefinition::DataDefinition(DataDefinition&& other)
     _stream_meta_types._validator = this;
     _streams._validator = this;
     _empty_model = other._empty_model;
+    _change_id = createChangeId();
 }
 
 void DataDefinition::setVersion(const dd::Version& ddl_version)
 {
     _empty_model = false;
+    _change_id = createChangeId();
     _header->setLanguageVersion(ddl_version);
 }
 
@@ -182,6 +215,7 @@ std::shared_ptr<Header> DataDefinition::getHeader()
 void DataDefinition::setHeader(const Header& header)
 {
     _empty_model = false;
+    _change_id = createChangeId();
     (*_header).operator=(header);
 }
 
@@ -390,6 +424,7 @@ void DataDefinition::notifyChangedMapContent(utility::TypeAccessMapEventCode cod
                                              const std::string& additional_info)
 {
     _empty_model = false;
+    _change_id = createChangeId();
     ModelSubject<DataType>::notifyChanged(
         getModelEventCodeFromMapCode(code), data_type, additional_info);
 }
@@ -399,6 +434,7 @@ void DataDefinition::notifyChangedMapContent(utility::TypeAccessMapEventCode cod
                                              const std::string& additional_info)
 {
     _empty_model = false;
+    _change_id = createChangeId();
     ModelSubject<BaseUnit>::notifyChanged(
         getModelEventCodeFromMapCode(code), base_unit, additional_info);
 }
@@ -408,6 +444,7 @@ void DataDefinition::notifyChangedMapContent(utility::TypeAccessMapEventCode cod
                                              const std::string& additional_info)
 {
     _empty_model = false;
+    _change_id = createChangeId();
     ModelSubject<UnitPrefix>::notifyChanged(
         getModelEventCodeFromMapCode(code), unit_prefix, additional_info);
 }
@@ -417,6 +454,7 @@ void DataDefinition::notifyChangedMapContent(utility::TypeAccessMapEventCode cod
                                              const std::string& additional_info)
 {
     _empty_model = false;
+    _change_id = createChangeId();
     ModelSubject<Unit>::notifyChanged(getModelEventCodeFromMapCode(code), unit, additional_info);
 }
 
@@ -425,6 +463,7 @@ void DataDefinition::notifyChangedMapContent(utility::TypeAccessMapEventCode cod
                                              const std::string& additional_info)
 {
     _empty_model = false;
+    _change_id = createChangeId();
     ModelSubject<EnumType>::notifyChanged(
         getModelEventCodeFromMapCode(code), enum_type, additional_info);
 }
@@ -434,6 +473,7 @@ void DataDefinition::notifyChangedMapContent(utility::TypeAccessMapEventCode cod
                                              const std::string& additional_info)
 {
     _empty_model = false;
+    _change_id = createChangeId();
     ModelSubject<StructType>::notifyChanged(
         getModelEventCodeFromMapCode(code), struct_type, additional_info);
 }
@@ -443,6 +483,7 @@ void DataDefinition::notifyChangedMapContent(utility::TypeAccessMapEventCode cod
                                              const std::string& additional_info)
 {
     _empty_model = false;
+    _change_id = createChangeId();
     ModelSubject<StreamMetaType>::notifyChanged(
         getModelEventCodeFromMapCode(code), stream_meta_type, additional_info);
 }
@@ -452,6 +493,7 @@ void DataDefinition::notifyChangedMapContent(utility::TypeAccessMapEventCode cod
                                              const std::string& additional_info)
 {
     _empty_model = false;
+    _change_id = createChangeId();
     ModelSubject<Stream>::notifyChanged(
         getModelEventCodeFromMapCode(code), stream, additional_info);
 }
@@ -461,6 +503,7 @@ void DataDefinition::modelChanged(datamodel::ModelEventCode event_code,
                                   const std::string& additional_info)
 {
     _empty_model = false;
+    _change_id = createChangeId();
     ModelSubject<Header>::notifyChanged(event_code, changed_subject, additional_info);
 }
 
@@ -469,6 +512,11 @@ bool DataDefinition::isEmpty() const
     return _empty_model;
 }
 
+uint64_t DataDefinition::getChangeId() const
+{
+    return _change_id;
+}
+
 } // namespace datamodel
 } // namespace dd
 } // namespace ddl
@@ -0,0 +1,158 @@
+/**
+ * @file
+ * OO DataDefinition Redesign
+ *
+ * Copyright @ 2021 VW Group. All rights reserved.
+ *
+ *     This Source Code Form is subject to the terms of the Mozilla
+ *     Public License, v. 2.0. If a copy of the MPL was not distributed
+ *     with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * If it is not possible or desirable to put the notice in a particular file, then
+ * You may include the notice in a location (such as a LICENSE file in a
+ * relevant directory) where a recipient would be likely to look for such a notice.
+ *
+ * You may add additional accurate notices of copyright ownership.
+ */
+
+#include "ddl/datamodel/datamodel_interned_string.h"
+
+#include <functional>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+
+namespace ddl {
+
+namespace dd {
+
+namespace datamodel {
+
+namespace {
+/// the values of the pool are spread over several shards, so interning rarely waits for a lock
+constexpr size_t pool_shard_count = 16;
+
+struct PoolShard {
+    std::mutex lock;
+    std::unordered_map<std::string, std::atomic<size_t>> values;
+};
+
+/**
+ * The pool is never destroyed, so entries released by static objects destroyed at exit are still
+ * valid.
+ */
+PoolShard* getPoolShards()
+{
+    static PoolShard* shards = new PoolShard[pool_shard_count];
+    return shards;
+}
+
+PoolShard& getPoolShard(const std::string& value)
+{
+    return getPoolShards()[std::hash<std::string>()(value) % pool_shard_count];
+}
+
+} // namespace
+
+InternedString::InternedString(const std::string& value) : _entry(intern(value))
+{
+}
+
+InternedString::InternedString(const InternedString& other) : _entry(other._entry)
+{
+    if (_entry) {
+        // the other string holds a reference, so the entry is not released meanwhile
+        ++_entry->second;
+    }
+}
+
+InternedString::InternedString(InternedString&& other) : _entry(other._entry)
+{
+    other._entry = nullptr;
+}
+
+InternedString& InternedString::operator=(const InternedString& other)
+{
+    if (_entry != other._entry) {
+        InternedString copy(other);
+        std::swap(_entry, copy._entry);
+    }
+    return *this;
+}
+
+InternedString& InternedString::operator=(InternedString&& other)
+{
+    std::swap(_entry, other._entry);
+    return *this;
+}
+
+InternedString& InternedString::operator=(const std::string& value)
+{
+    if (get() != value) {
+        InternedString interned(value);
+        std::swap(_entry, interned._entry);
+    }
+    return *this;
+}
+
+InternedString::~InternedString()
+{
+    if (_entry) {
+        release(_entry);
+    }
+}
+
+size_t InternedString::getPoolSize()
+{
+    size_t size = 0;
+    for (size_t shard_index = 0; shard_index < pool_shard_count; ++shard_index) {
+        PoolShard& shard = getPoolShards()[shard_index];
+        std::lock_guard<std::mutex> lock(shard.lock);
+        size += shard.values.size();
+    }
+    return size;
+}
+
+const std::string& InternedString::empty()
+{
+    static const std::string empty_string;
+    return empty_string;
+}
+
+InternedString::Entry* InternedString::intern(const std::string& value)
+{
+    if (value.empty()) {
+        return nullptr;
+    }
+    PoolShard& shard = getPoolShard(value);
+    std::lock_guard<std::mutex> lock(shard.lock);
+    // the nodes of the map are never moved, so the entries stay valid until they are erased
+    Entry& entry = *shard.values
+                        .emplace(std::piecewise_construct,
+                                 std::forward_as_tuple(value),
+                                 std::forward_as_tuple(0))
+                        .first;
+    ++entry.second;
+    return &entry;
+}
+
+void InternedString::release(Entry* entry)
+{
+    // other references are dropped without the lock, the last one is dropped while holding the
+    // lock, so it cannot race with interning the same value again
+    size_t references = entry->second.load();
+    while (references > 1) {
+        if (entry->second.compare_exchange_weak(references, references - 1)) {
+            return;
+        }
+    }
+    PoolShard& shard = getPoolShard(entry->first);
+    std::lock_guard<std::mutex> lock(shard.lock);
+    if (--entry->second == 0) {
+        shard.values.erase(shard.values.find(entry->first));
+    }
+}
+
+} // namespace datamodel
+} // namespace dd
+} // namespace ddl
@@ -580,7 +580,7 @@ void StructType::Element::setName(const std::string& name)
 
 const std::string& StructType::Element::getTypeName() const
 {
-    return _type_name;
+    return _type_name.get();
 }
 
 void StructType::Element::setTypeName(const std::string& type_name)
@@ -626,7 +626,7 @@ void StructType::Element::setArraySize(const ArraySize& array_size)
 
 const std::string& StructType::Element::getUnitName() const
 {
-    return _unit_name;
+    return _unit_name.get();
 }
 void StructType::Element::setUnitName(const std::string& unit_name)
 {
@@ -865,6 +865,14 @@ StructType::Elements& StructType::getElements()
     return _elements;
 }
 
+void StructType::copyInfos()
+{
+    InfoMap::copyInfos();
+    for (auto& element: _elements) {
+        element->copyInfos();
+    }
+}
+
 bool StructType::validateContains(const Elements::access_type& element) const
 {
     return _elements.contains(element.getName());
@@ -17,10 +17,17 @@
 
 #include "ddl/dd/dd.h"
 
+#include "../codec/worker_pool.h"
 #include "ddl/dd/dd_predefined_datatypes.h"
+#include "ddl/dd/dd_predefined_units.h"
 #include "ddl/dd/dd_typeinfomodel.h"
 
+#include <algorithm>
+#include <exception>
 #include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
 
 namespace ddl {
 
@@ -40,9 +47,23 @@ DataDefinition::DataDefinition(const std::shared_ptr<datamodel::DataDefinition>&
     setModel(datamodel);
 }
 
+/**
+ * The snapshot of the datamodel for the copies. Its types are not changed anymore, the copies share
+ * them (see datamodel::DataDefinition::shareContentOf).
+ */
+struct DataDefinition::Snapshot {
+    std::shared_ptr<datamodel::DataDefinition> datamodel;
+    /// the change id of the datamodel the snapshot was taken at
+    uint64_t change_id = 0;
+    /// the types changed since, including the types using them
+    std::unordered_set<std::string> changed_type_names;
+    /// whether the next snapshot copies all types
+    bool all_types_changed = true;
+};
+
 DataDefinition::DataDefinition(const DataDefinition& other)
 {
-    setModel(std::make_shared<datamodel::DataDefinition>(*other.getModel()));
+    copyModel(other);
     _validation_level = other._validation_level;
     _last_known_ddl_version = other._last_known_ddl_version;
 }
@@ -51,6 +72,8 @@ DataDefinition::DataDefinition(DataDefinition&& other)
 {
     detachFromModel();
     _datamodel = other._datamodel;
+    _snapshot = std::move(other._snapshot);
+    _shares_types = other._shares_types;
     _validation_level = other._validation_level;
     _last_known_ddl_version = other._last_known_ddl_version;
     attachToModel();
@@ -58,9 +81,11 @@ DataDefinition::DataDefinition(DataDefinition&& other)
 
 DataDefinition& DataDefinition::operator=(const DataDefinition& other)
 {
-    setModel(std::make_shared<datamodel::DataDefinition>(*other.getModel()));
-    _last_known_ddl_version = other._last_known_ddl_version;
-    _validation_level = other._validation_level;
+    if (this != &other) {
+        copyModel(other);
+        _last_known_ddl_version = other._last_known_ddl_version;
+        _validation_level = other._validation_level;
+    }
     return *this;
 }
 
@@ -68,6 +93,8 @@ DataDefinition& DataDefinition::operator=(DataDefinition&& other)
 {
     detachFromModel();
     _datamodel = other._datamodel;
+    _snapshot = std::move(other._snapshot);
+    _shares_types = other._shares_types;
     _validation_level = other._validation_level;
     _last_known_ddl_version = other._last_known_ddl_version;
     attachToModel();
@@ -79,10 +106,13 @@ DataDefinition::~DataDefinition()
     detachFromModel();
 }
 
-void DataDefinition::setModel(const std::shared_ptr<datamodel::DataDefinition>& datamodel)
+void DataDefinition::setModel(const std::shared_ptr<datamodel::DataDefinition>& datamodel,
+                              size_t parallelism)
 {
     detachFromModel();
     _datamodel = datamodel;
+    _snapshot.reset();
+    _shares_types = false;
     if (_datamodel) {
         auto info = _datamodel->getInfo<ValidationServiceInfo>();
         if (info == nullptr) {
@@ -91,8 +121,8 @@ void DataDefinition::setModel(const std::shared_ptr<datamodel::DataDefinition>&
             _datamodel->setInfo<ValidationServiceInfo>(std::make_shared<ValidationServiceInfo>());
         }
         _last_known_ddl_version = _datamodel->getVersion();
-        validate();
-        calculatePositions("", invalid_type, false);
+        validate(false, parallelism);
+        calculatePositions("", invalid_type, false, parallelism);
     }
 
     attachToModel();
@@ -150,6 +180,197 @@ void DataDefinition::detachFromModel()
     }
 }
 
+void DataDefinition::copyModel(const DataDefinition& other)
+{
+    auto snapshot = other.takeSnapshot();
+    detachFromModel();
+    _datamodel.reset();
+    _snapshot.reset();
+    _shares_types = false;
+    if (snapshot) {
+        // the snapshot keeps the infos, so the copy is neither validated nor calculated again
+        _datamodel = std::make_shared<datamodel::DataDefinition>();
+        _datamodel->shareContentOf(*snapshot);
+        _shares_types = true;
+    }
+    attachToModel();
+}
+
+namespace {
+
+/// guards the snapshots against copies taken in parallel
+std::mutex& snapshotMutex()
+{
+    static std::mutex snapshot_mutex;
+    return snapshot_mutex;
+}
+
+/**
+ * Replaces the types the datamodel does not share with another snapshot yet: the unchanged types
+ * are taken from the previous snapshot, the others are copied.
+ *
+ * @return the copied types
+ */
+template <typename TYPES>
+std::vector<std::shared_ptr<typename TYPES::access_type>> replaceOwnedTypes(
+    TYPES& snapshot_types,
+    const TYPES& types,
+    const TYPES* previous_types,
+    const std::unordered_set<std::string>& changed_type_names)
+{
+    using access_type = typename TYPES::access_type;
+    std::vector<std::shared_ptr<access_type>> copied_types;
+    for (const auto& type: types) {
+        if (types.isShared(type.first)) {
+            continue;
+        }
+        std::shared_ptr<const access_type> snapshot_type;
+        if (previous_types &&
+            changed_type_names.find(type.first) == changed_type_names.cend()) {
+            snapshot_type = previous_types->get(type.first);
+        }
+        if (!snapshot_type) {
+            auto copied_type = datamodel::copyWithInfos(*type.second);
+            copied_types.push_back(copied_type);
+            snapshot_type = copied_type;
+        }
+        snapshot_types.addShared(snapshot_type, &datamodel::copyWithInfos<access_type>);
+    }
+    return copied_types;
+}
+
+/// Replaces the types the datamodel does not share with another snapshot yet by copies.
+template <typename TYPES>
+void copyOwnedTypes(TYPES& snapshot_types, const TYPES& types)
+{
+    replaceOwnedTypes<TYPES>(snapshot_types, types, nullptr, {});
+}
+
+} // namespace
+
+std::shared_ptr<const datamodel::DataDefinition> DataDefinition::takeSnapshot() const
+{
+    if (!_datamodel) {
+        return {};
+    }
+    // only read the datamodel
+    const datamodel::DataDefinition& ddl_model = *_datamodel;
+    std::lock_guard<std::mutex> lock(snapshotMutex());
+    if (!_snapshot) {
+        _snapshot.reset(new Snapshot());
+    }
+    auto& snapshot = *_snapshot;
+    if (snapshot.datamodel && *snapshot.datamodel->getHeader() != *ddl_model.getHeader()) {
+        // the header may be changed without notification
+        snapshot.all_types_changed = true;
+    }
+    if (snapshot.datamodel && !snapshot.all_types_changed &&
+        snapshot.change_id == ddl_model.getChangeId()) {
+        return snapshot.datamodel;
+    }
+
+    const datamodel::DataDefinition* previous_model =
+        snapshot.all_types_changed ? nullptr : snapshot.datamodel.get();
+    const auto& changed_type_names = snapshot.changed_type_names;
+    // this shares the types already shared with another snapshot and copies the infos of the model
+    auto snapshot_model = std::make_shared<datamodel::DataDefinition>();
+    snapshot_model->shareContentOf(ddl_model);
+    // the units and streams are few, they are copied every time
+    copyOwnedTypes(snapshot_model->getBaseUnits(), ddl_model.getBaseUnits());
+    copyOwnedTypes(snapshot_model->getUnitPrefixes(), ddl_model.getUnitPrefixes());
+    copyOwnedTypes(snapshot_model->getUnits(), ddl_model.getUnits());
+    replaceOwnedTypes(snapshot_model->getDataTypes(),
+                      ddl_model.getDataTypes(),
+                      previous_model ? &previous_model->getDataTypes() : nullptr,
+                      changed_type_names);
+    replaceOwnedTypes(snapshot_model->getEnumTypes(),
+                      ddl_model.getEnumTypes(),
+                      previous_model ? &previous_model->getEnumTypes() : nullptr,
+                      changed_type_names);
+    const auto copied_struct_types =
+        replaceOwnedTypes(snapshot_model->getStructTypes(),
+                          ddl_model.getStructTypes(),
+                          previous_model ? &previous_model->getStructTypes() : nullptr,
+                          changed_type_names);
+    copyOwnedTypes(snapshot_model->getStreamMetaTypes(), ddl_model.getStreamMetaTypes());
+    copyOwnedTypes(snapshot_model->getStreams(), ddl_model.getStreams());
+    // the copied struct types refer to the types of the snapshot, the unchanged ones already do
+    for (const auto& struct_type: copied_struct_types) {
+        for (const auto& element: struct_type->getElements()) {
+            const auto element_info = element->getInfo<ElementTypeInfo>();
+            if (element_info != nullptr) {
+                element_info->resolveTypes(*snapshot_model);
+            }
+        }
+    }
+
+    snapshot.datamodel = snapshot_model;
+    snapshot.change_id = ddl_model.getChangeId();
+    snapshot.changed_type_names.clear();
+    snapshot.all_types_changed = false;
+    return snapshot_model;
+}
+
+void DataDefinition::invalidateSnapshot()
+{
+    if (_snapshot) {
+        _snapshot->all_types_changed = true;
+    }
+}
+
+ValidationServiceInfo::InvalidatedTypes DataDefinition::recordTypeChange(
+    datamodel::ModelEventCode event_code,
+    const datamodel::TypeBase& type,
+    const std::string& additional_info)
+{
+    const bool is_recorded = _snapshot && !_snapshot->all_types_changed;
+    const auto validation_service = _datamodel->getInfo<ValidationServiceInfo>();
+    if ((!is_recorded && !_shares_types) || validation_service == nullptr) {
+        return {};
+    }
+    // this is called before the change is handled, a removed or renamed type has no users after
+    const auto& type_name = event_code == datamodel::ModelEventCode::item_renamed
+                                ? additional_info
+                                : type.getName();
+    auto users = validation_service->getDependentTypes(type_name, type.getTypeOfType());
+    if (is_recorded) {
+        // the next snapshot copies the type and its users again
+        auto& changed_type_names = _snapshot->changed_type_names;
+        changed_type_names.insert(type.getName());
+        changed_type_names.insert(type_name);
+        changed_type_names.insert(users._enum_type_names.cbegin(), users._enum_type_names.cend());
+        changed_type_names.insert(users._struct_type_names.cbegin(),
+                                  users._struct_type_names.cend());
+    }
+    return users;
+}
+
+void DataDefinition::resolveSharedTypes(const datamodel::TypeBase& type,
+                                        const ValidationServiceInfo::InvalidatedTypes& users)
+{
+    if (!_shares_types) {
+        return;
+    }
+    // the shared struct types refer to the types of the snapshot, not to the changed ones
+    auto resolve_types = [this](const std::string& struct_type_name) {
+        auto struct_type = _datamodel->getStructTypes().access(struct_type_name);
+        if (struct_type) {
+            for (auto& element: struct_type->getElements()) {
+                auto element_info = element->getInfo<ElementTypeInfo>();
+                if (element_info != nullptr) {
+                    element_info->resolveTypes(*_datamodel);
+                }
+            }
+        }
+    };
+    if (type.getTypeOfType() == TypeOfType::struct_type) {
+        resolve_types(type.getName());
+    }
+    for (const auto& struct_type_name: users._struct_type_names) {
+        resolve_types(struct_type_name);
+    }
+}
+
 void DataDefinition::setVersion(const dd::Version& ddl_version)
 {
     auto old_version = getVersion();
@@ -329,11 +550,20 @@ DEF_SETINFO(ValidationInfo, StreamMetaType);
 DEF_GETINFO(ValidationInfo, Stream);
 DEF_SETINFO(ValidationInfo, Stream);
 
-template <typename T>
-DataDefinition::ValidationLevel getOrCreateValidationLevelFor(std::shared_ptr<T>& type_val,
-                                                              datamodel::DataDefinition& parent_ddl,
-                                                              bool force_update)
+template <typename T, typename TYPES>
+DataDefinition::ValidationLevel getOrCreateValidationLevelFor(
+    TYPES& types,
+    const std::pair<const std::string, std::shared_ptr<T>>& ref_type,
+    datamodel::DataDefinition& parent_ddl,
+    bool force_update)
 {
+    const auto known_info = getInfoFromConst(*ref_type.second);
+    if (known_info != nullptr && !force_update &&
+        known_info->getValidationLevel() >= ValidationInfo::ValidationLevel::valid) {
+        // nothing to update, so a type shared with a snapshot stays shared
+        return known_info->getValidationLevel();
+    }
+    auto type_val = types.access(ref_type.first);
     auto info = getInfoFrom(*type_val);
     if (info == nullptr) {
         // for recursion detection we need to create it first, then update!
@@ -346,10 +576,299 @@ DataDefinition::ValidationLevel getOrCreateValidationLevelFor(std::shared_ptr<T>
     }
     return info->getValidationLevel();
 }
+
+/**
+ * Clears the element path indices of all struct types, a struct type may reach the elements of
+ * other struct types by a path.
+ */
+void clearElementPathIndices(const datamodel::DataDefinition& parent_ddl)
+{
+    for (const auto& ref_types: parent_ddl.getStructTypes()) {
+        const auto type_info = ref_types.second->getInfo<TypeInfo>();
+        if (type_info != nullptr) {
+            type_info->getElementPathIndex().clear();
+        }
+    }
+}
+
+/// Waves with less struct types per thread are not worth to be split up.
+constexpr size_t min_struct_types_per_thread = 64;
+
+/**
+ * The struct types of a datamodel (in the order of the map) with the struct types they use.
+ */
+struct StructTypeGraph {
+    std::vector<std::shared_ptr<StructType>> _struct_types;
+    /// the indices of the struct types using the struct type
+    std::vector<std::vector<size_t>> _users;
+    /// the number of different struct types used by the struct type
+    std::vector<size_t> _used_count;
+};
+
+StructTypeGraph createStructTypeGraph(datamodel::DataDefinition& parent_ddl)
+{
+    StructTypeGraph graph;
+    auto& struct_types = parent_ddl.getStructTypes();
+    std::unordered_map<std::string, size_t> indices;
+    for (const auto& ref_types: struct_types) {
+        indices[ref_types.first] = graph._struct_types.size();
+        graph._struct_types.push_back(ref_types.second);
+    }
+    graph._users.resize(graph._struct_types.size());
+    graph._used_count.resize(graph._struct_types.size());
+    std::vector<size_t> used;
+    for (size_t index = 0; index < graph._struct_types.size(); ++index) {
+        used.clear();
+        for (const auto& element: graph._struct_types[index]->getElements()) {
+            const auto found = indices.find(element->getTypeName());
+            if (found != indices.end() &&
+                std::find(used.begin(), used.end(), found->second) == used.end()) {
+                used.push_back(found->second);
+                // a struct type using itself will never be ready
+                graph._users[found->second].push_back(index);
+            }
+        }
+        graph._used_count[index] = used.size();
+    }
+    return graph;
+}
+
+/**
+ * Calls \p update for all indices of the \p wave on at most \p parallelism threads of the
+ * process wide worker pool, including the calling one. \p update must not throw.
+ */
+template <typename UPDATE>
+void updateWave(const std::vector<size_t>& wave, size_t parallelism, const UPDATE& update)
+{
+    const size_t chunk_count =
+        std::min(parallelism, std::max<size_t>(wave.size() / min_struct_types_per_thread, 1));
+    const size_t chunk_size = (wave.size() + chunk_count - 1) / chunk_count;
+    WorkerPool::getInstance().run(
+        chunk_count, parallelism, [&wave, &update, chunk_size](size_t chunk) {
+            const size_t chunk_end = std::min((chunk + 1) * chunk_size, wave.size());
+            for (size_t position = chunk * chunk_size; position < chunk_end; ++position) {
+                update(position);
+            }
+        });
+}
+
+/**
+ * Updates the struct types of the \p graph in topological waves: a wave contains all struct
+ * types whose used struct types are done and updates them on several threads.
+ * Struct types of a recursion or using a struct type that is not done after its update are left
+ * over for the sequential update.
+ *
+ * @param graph the struct types.
+ * @param parallelism the maximum number of threads to use, including the calling one.
+ * @param done_before the struct types that are done without update.
+ * @param can_update whether the struct type can be updated without changing other types.
+ * @param update updates the struct type, called on any thread.
+ * @param after_wave called with the updated indices on the calling thread after each wave.
+ * @param is_done whether the struct type is done after its update.
+ * @throw the first exception (in the order of the map) thrown by \p update within a wave.
+ * @return std::vector<bool> the struct types updated.
+ */
+template <typename CAN_UPDATE, typename UPDATE, typename AFTER_WAVE, typename IS_DONE>
+std::vector<bool> updateStructTypesInWaves(const StructTypeGraph& graph,
+                                           size_t parallelism,
+                                           const std::vector<bool>& done_before,
+                                           const CAN_UPDATE& can_update,
+                                           const UPDATE& update,
+                                           const AFTER_WAVE& after_wave,
+                                           const IS_DONE& is_done)
+{
+    const size_t struct_type_count = graph._struct_types.size();
+    std::vector<bool> updated(struct_type_count, false);
+    auto pending_count = graph._used_count;
+    std::vector<size_t> wave;
+    for (size_t index = 0; index < struct_type_count; ++index) {
+        if (done_before[index]) {
+            for (const auto user: graph._users[index]) {
+                --pending_count[user];
+            }
+        }
+    }
+    for (size_t index = 0; index < struct_type_count; ++index) {
+        if (!done_before[index] && pending_count[index] == 0 && can_update(index)) {
+            wave.push_back(index);
+        }
+    }
+    std::vector<std::exception_ptr> errors;
+    std::vector<size_t> next_wave;
+    while (!wave.empty()) {
+        errors.assign(wave.size(), nullptr);
+        updateWave(wave, parallelism, [&](size_t position) {
+            try {
+                update(wave[position]);
+            }
+            catch (...) {
+                errors[position] = std::current_exception();
+            }
+        });
+        for (const auto& error: errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+        after_wave(wave);
+        next_wave.clear();
+        for (const auto index: wave) {
+            updated[index] = true;
+            if (is_done(index)) {
+                for (const auto user: graph._users[index]) {
+                    if (--pending_count[user] == 0 && !done_before[user] && can_update(user)) {
+                        next_wave.push_back(user);
+                    }
+                }
+            }
+        }
+        // keep the order of the map within the wave
+        std::sort(next_wave.begin(), next_wave.end());
+        std::swap(wave, next_wave);
+    }
+    return updated;
+}
+
+/**
+ * Validates the struct types in waves (see @ref updateStructTypesInWaves), the types used by them
+ * must be validated before.
+ * @return std::vector<bool> the struct types validated.
+ */
+std::vector<bool> validateStructTypesInWaves(const StructTypeGraph& graph,
+                                             datamodel::DataDefinition& parent_ddl,
+                                             bool force_revalidation,
+                                             size_t parallelism)
+{
+    const auto& struct_types = graph._struct_types;
+    std::vector<bool> done_before(struct_types.size(), false);
+    for (size_t index = 0; index < struct_types.size(); ++index) {
+        const auto info = struct_types[index]->getInfo<ValidationInfo>();
+        done_before[index] = !force_revalidation && info && info->isValid();
+        if (done_before[index]) {
+            continue;
+        }
+        // the validation adds the predefined base units used, which must not happen in a wave
+        for (const auto& element: struct_types[index]->getElements()) {
+            const std::string& unit_name = element->getUnitName();
+            if (!unit_name.empty() &&
+                parent_ddl.getTypeOfUnit(unit_name) == TypeOfUnit::invalid_unit) {
+                const auto predefined =
+                    PredefinedUnits::getInstance().getPredefinedBaseUnit(unit_name);
+                if (predefined) {
+                    parent_ddl.getBaseUnits().add(*predefined);
+                }
+            }
+        }
+    }
+    // only the validation of the struct type itself is changed, the validation of a used data
+    // type or enum type which is not valid would be repeated, an unknown type may be added as
+    // predefined data type (the predefined base units are added above)
+    const auto is_valid_type = [&parent_ddl](const std::string& type_name) {
+        const ValidationInfo* info = nullptr;
+        switch (parent_ddl.getTypeOfType(type_name)) {
+        case TypeOfType::data_type:
+            info = parent_ddl.getDataTypes().get(type_name)->getInfo<ValidationInfo>();
+            break;
+        case TypeOfType::enum_type:
+            info = parent_ddl.getEnumTypes().get(type_name)->getInfo<ValidationInfo>();
+            break;
+        case TypeOfType::struct_type:
+            // the graph takes care of these
+            return true;
+        default:
+            return false;
+        }
+        return info != nullptr && info->isValid();
+    };
+    const auto has_unit_info = [&parent_ddl](const std::string& unit_name) {
+        switch (parent_ddl.getTypeOfUnit(unit_name)) {
+        case TypeOfUnit::base_unit:
+            return true;
+        case TypeOfUnit::unit:
+            return parent_ddl.getUnits().get(unit_name)->getInfo<ValidationInfo>() != nullptr;
+        default:
+            return false;
+        }
+    };
+    const auto can_update = [&](size_t index) {
+        for (const auto& element: struct_types[index]->getElements()) {
+            if (!is_valid_type(element->getTypeName()) ||
+                (!element->getUnitName().empty() && !has_unit_info(element->getUnitName()))) {
+                return false;
+            }
+        }
+        return true;
+    };
+    std::vector<std::vector<ValidationServiceInfo::Dependency>> dependencies(struct_types.size());
+    const auto update = [&](size_t index) {
+        ValidationServiceInfo::DependencyCollector collector;
+        auto& struct_type = *struct_types[index];
+        auto info = struct_type.getInfo<ValidationInfo>();
+        if (info == nullptr) {
+            // for recursion detection we need to create it first, then update!
+            struct_type.setInfo<ValidationInfo>(std::make_shared<ValidationInfo>());
+            info = struct_type.getInfo<ValidationInfo>();
+        }
+        info->update(struct_type, parent_ddl);
+        dependencies[index] = std::move(collector._dependencies);
+    };
+    const auto after_wave = [&](const std::vector<size_t>& wave) {
+        auto dependency_service = parent_ddl.getInfo<ValidationServiceInfo>();
+        for (const auto index: wave) {
+            if (dependency_service) {
+                for (const auto& dependency: dependencies[index]) {
+                    dependency_service->addDependency(dependency);
+                }
+            }
+            dependencies[index].clear();
+        }
+    };
+    const auto is_done = [&struct_types](size_t index) {
+        return struct_types[index]->getInfo<ValidationInfo>()->isValid();
+    };
+    return updateStructTypesInWaves(
+        graph, parallelism, done_before, can_update, update, after_wave, is_done);
+}
+
+/**
+ * Calculates the positions of the struct types in waves (see @ref updateStructTypesInWaves), the
+ * data types and enum types must be calculated before.
+ * @return std::vector<bool> the struct types calculated.
+ */
+std::vector<bool> calculateStructTypesInWaves(const StructTypeGraph& graph,
+                                              datamodel::DataDefinition& parent_ddl,
+                                              bool force_recalculation,
+                                              size_t parallelism)
+{
+    const auto& struct_types = graph._struct_types;
+    const auto update = [&](size_t index) {
+        auto& struct_type = *struct_types[index];
+        auto type_info = struct_type.getInfo<TypeInfo>();
+        if (type_info == nullptr) {
+            // we need that order because of possible recursions!
+            struct_type.setInfo(std::make_shared<TypeInfo>());
+            type_info = struct_type.getInfo<TypeInfo>();
+            type_info->update(struct_type, parent_ddl);
+        }
+        else {
+            type_info->update(struct_type, parent_ddl, force_recalculation);
+        }
+    };
+    return updateStructTypesInWaves(
+        graph,
+        parallelism,
+        std::vector<bool>(struct_types.size(), false),
+        [](size_t) { return true; },
+        update,
+        [](const std::vector<size_t>&) {},
+        [](size_t) { return true; });
+}
 } // namespace
 
-void DataDefinition::validate(bool force_revalidation)
+void DataDefinition::validate(bool force_revalidation, size_t parallelism)
 {
+    // the types are accessed only if they need to be validated
+    const datamodel::DataDefinition& ddl_model = *_datamodel;
     auto discovered_level = ValidationLevel::valid;
     if (_datamodel->isEmpty()) {
         _validation_level = discovered_level;
@@ -357,50 +876,60 @@ void DataDefinition::validate(bool force_revalidation)
     }
 
     // validate data types
-    for (auto& ref_types: getUnits()) {
-        auto level =
-            getOrCreateValidationLevelFor<Unit>(ref_types.second, *_datamodel, force_revalidation);
+    for (const auto& ref_types: ddl_model.getUnits()) {
+        auto level = getOrCreateValidationLevelFor<Unit>(
+            _datamodel->getUnits(), ref_types, *_datamodel, force_revalidation);
         if (level < discovered_level) {
             discovered_level = level;
         }
     }
     // validate data types
-    for (auto& ref_types: getDataTypes()) {
+    for (const auto& ref_types: ddl_model.getDataTypes()) {
         auto level = getOrCreateValidationLevelFor<DataType>(
-            ref_types.second, *_datamodel, force_revalidation);
+            _datamodel->getDataTypes(), ref_types, *_datamodel, force_revalidation);
         if (level < discovered_level) {
             discovered_level = level;
         }
     }
     // validate enum types
-    for (auto& ref_types: getEnumTypes()) {
+    for (const auto& ref_types: ddl_model.getEnumTypes()) {
         auto level = getOrCreateValidationLevelFor<EnumType>(
-            ref_types.second, *_datamodel, force_revalidation);
+            _datamodel->getEnumTypes(), ref_types, *_datamodel, force_revalidation);
         if (level < discovered_level) {
             discovered_level = level;
         }
     }
     // validate struct types
-    for (auto& ref_types: getStructTypes()) {
+    std::vector<bool> validated_struct_types;
+    if (WorkerPool::getUsableParallelism(parallelism) > 1) {
+        validated_struct_types = validateStructTypesInWaves(
+            createStructTypeGraph(*_datamodel), *_datamodel, force_revalidation, parallelism);
+    }
+    size_t struct_type_index = 0;
+    for (const auto& ref_types: ddl_model.getStructTypes()) {
+        // the ones left over are validated like without parallelism
+        const bool validated = struct_type_index < validated_struct_types.size() &&
+                               validated_struct_types[struct_type_index];
+        ++struct_type_index;
         auto level = getOrCreateValidationLevelFor<StructType>(
-            ref_types.second, *_datamodel, force_revalidation);
+            _datamodel->getStructTypes(), ref_types, *_datamodel, force_revalidation && !validated);
         if (level < discovered_level) {
             discovered_level = level;
         }
     }
     // validate stream meta types
-    for (auto& ref_types: getStreamMetaTypes()) {
+    for (const auto& ref_types: ddl_model.getStreamMetaTypes()) {
         auto level = getOrCreateValidationLevelFor<StreamMetaType>(
-            ref_types.second, *_datamodel, force_revalidation);
+            _datamodel->getStreamMetaTypes(), ref_types, *_datamodel, force_revalidation);
         if (level < discovered_level) {
             discovered_level = level;
         }
     }
 
     // validate streams
-    for (auto& ref_types: getStreams()) {
+    for (const auto& ref_types: ddl_model.getStreams()) {
         auto level = getOrCreateValidationLevelFor<Stream>(
-            ref_types.second, *_datamodel, force_revalidation);
+            _datamodel->getStreams(), ref_types, *_datamodel, force_revalidation);
         if (level < discovered_level) {
             discovered_level = level;
         }
@@ -476,7 +1005,8 @@ std::vector<ValidationInfo::Problem> DataDefinition::getValidationProtocol() con
 
 void DataDefinition::calculatePositions(const std::string& type_name,
                                         TypeOfType type_of_type,
-                                        bool force_recalculation)
+                                        bool force_recalculation,
+                                        size_t parallelism)
 {
     if (_datamodel->isEmpty()) {
         return;
@@ -490,7 +1020,7 @@ void DataDefinition::calculatePositions(const std::string& type_name,
     if (type_name.empty()) {
         // all datatypes
         if (calc_dt) {
-            for (const auto& ref_types: getDataTypes()) {
+            for (const auto& ref_types: _datamodel->getDataTypes()) {
                 auto type_info = ref_types.second->getInfo<TypeInfo>();
                 if (type_info == nullptr) {
                     // we need that order because of possible recursions!
@@ -507,7 +1037,7 @@ void DataDefinition::calculatePositions(const std::string& type_name,
         }
         // all enum types
         if (calc_et) {
-            for (const auto& ref_types: getEnumTypes()) {
+            for (const auto& ref_types: _datamodel->getEnumTypes()) {
                 auto type_info = ref_types.second->getInfo<TypeInfo>();
                 if (type_info == nullptr) {
                     // we need that order because of possible recursions!
@@ -524,7 +1054,21 @@ void DataDefinition::calculatePositions(const std::string& type_name,
         }
         // calculate ALL structs
         if (calc_st) {
-            for (const auto& ref_types: getStructTypes()) {
+            std::vector<bool> calculated_struct_types;
+            if (WorkerPool::getUsableParallelism(parallelism) > 1) {
+                const auto graph = createStructTypeGraph(*_datamodel);
+                calculated_struct_types = calculateStructTypesInWaves(
+                    graph, *_datamodel, force_recalculation, parallelism);
+            }
+            size_t struct_type_index = 0;
+            for (const auto& ref_types: _datamodel->getStructTypes()) {
+                // the ones left over are calculated like without parallelism
+                const bool calculated = struct_type_index < calculated_struct_types.size() &&
+                                        calculated_struct_types[struct_type_index];
+                ++struct_type_index;
+                if (calculated) {
+                    continue;
+                }
                 auto type_info = ref_types.second->getInfo<TypeInfo>();
                 if (type_info == nullptr) {
                     // we need that order because of possible recursions!
@@ -539,8 +1083,8 @@ void DataDefinition::calculatePositions(const std::string& type_name,
         }
     }
     else {
-        const auto struct_type = getStructTypes().access(type_name);
-        const auto enum_type = getEnumTypes().access(type_name);
+        const auto struct_type = _datamodel->getStructTypes().access(type_name);
+        const auto enum_type = _datamodel->getEnumTypes().access(type_name);
         if (struct_type) {
             auto type_info = struct_type->getInfo<TypeInfo>();
             if (type_info == nullptr) {
@@ -577,6 +1121,7 @@ void DataDefinition::modelChanged(datamodel::ModelEventCode,
                                   datamodel::Header& changed_subject,
                                   const std::string&)
 {
+    invalidateSnapshot();
     // we need to check versioned changes here
     if (_last_known_ddl_version != changed_subject.getLanguageVersion()) {
         calculatePositions({}, TypeOfType::struct_type, true);
@@ -588,6 +1133,10 @@ void DataDefinition::modelChanged(datamodel::ModelEventCode event_code,
                                   datamodel::BaseUnit& changed_subject,
                                   const std::string& additional_info)
 {
+    // the units are used by the types, but only if they were known before
+    if (event_code != datamodel::ModelEventCode::item_added) {
+        invalidateSnapshot();
+    }
     if (event_code == datamodel::ModelEventCode::item_renamed) {
         _datamodel->getInfo<ValidationServiceInfo>()->renamed(
             changed_subject, additional_info, *_datamodel);
@@ -601,6 +1150,10 @@ void DataDefinition::modelChanged(datamodel::ModelEventCode event_code,
                                   datamodel::UnitPrefix& changed_subject,
                                   const std::string& additional_info)
 {
+    // the units are used by the types, but only if they were known before
+    if (event_code != datamodel::ModelEventCode::item_added) {
+        invalidateSnapshot();
+    }
     if (event_code == datamodel::ModelEventCode::item_renamed) {
         _datamodel->getInfo<ValidationServiceInfo>()->renamed(
             changed_subject, additional_info, *_datamodel);
@@ -614,6 +1167,9 @@ void DataDefinition::modelChanged(datamodel::ModelEventCode event_code,
                                   datamodel::Unit& changed_subject,
                                   const std::string& additional_info)
 {
+    if (event_code != datamodel::ModelEventCode::item_added) {
+        invalidateSnapshot();
+    }
     if (event_code == datamodel::ModelEventCode::item_added) {
         changed_subject.setInfo<ValidationInfo>(
             std::make_shared<ValidationInfo>(changed_subject, *_datamodel));
@@ -689,6 +1245,7 @@ void DataDefinition::modelChanged(datamodel::ModelEventCode event_code,
                                   datamodel::DataType& changed_subject,
                                   const std::string& additional_info)
 {
+    const auto users = recordTypeChange(event_code, changed_subject, additional_info);
     if (event_code == datamodel::ModelEventCode::item_added) {
         changed_subject.setInfo<TypeInfo>(std::make_shared<TypeInfo>(changed_subject, *_datamodel));
         changed_subject.setInfo<ValidationInfo>(
@@ -720,8 +1277,9 @@ void DataDefinition::modelChanged(datamodel::ModelEventCode event_code,
                             changed_subject.getName(),
                             changed_subject.getTypeOfType(),
                             *_datamodel);
-                        updateInfoAllStructs(dependencies._struct_type_names, true, *_datamodel);
+                        // the struct types may use the enum types
                         updateInfoAllEnums(dependencies._enum_type_names, *_datamodel);
+                        updateInfoAllStructs(dependencies._struct_type_names, true, *_datamodel);
                     }
                 }
             }
@@ -738,12 +1296,14 @@ void DataDefinition::modelChanged(datamodel::ModelEventCode event_code,
     else if (event_code == datamodel::ModelEventCode::item_removed) {
         _datamodel->getInfo<ValidationServiceInfo>()->removed(changed_subject, *_datamodel);
     }
+    resolveSharedTypes(changed_subject, users);
 }
 
 void DataDefinition::modelChanged(datamodel::ModelEventCode event_code,
                                   datamodel::EnumType& changed_subject,
                                   const std::string& additional_info)
 {
+    const auto users = recordTypeChange(event_code, changed_subject, additional_info);
     if (event_code == datamodel::ModelEventCode::item_added) {
         changed_subject.setInfo<TypeInfo>(std::make_shared<TypeInfo>(changed_subject, *_datamodel));
         changed_subject.setInfo<ValidationInfo>(
@@ -784,12 +1344,14 @@ void DataDefinition::modelChanged(datamodel::ModelEventCode event_code,
         _datamodel->getInfo<ValidationServiceInfo>()->removed(changed_subject, *_datamodel);
     }
     // we do not react on subitem changes for type info
+    resolveSharedTypes(changed_subject, users);
 }
 
 void DataDefinition::modelChanged(datamodel::ModelEventCode event_code,
                                   datamodel::StructType& changed_subject,
                                   const std::string& additional_info)
 {
+    const auto users = recordTypeChange(event_code, changed_subject, additional_info);
     switch (event_code) {
     case datamodel::ModelEventCode::item_added:
         // struct may have recursion, thats why we have no CTOR on that, first we set it, then we
@@ -802,6 +1364,7 @@ void DataDefinition::modelChanged(datamodel::ModelEventCode event_code,
         changed_subject.getInfo<TypeInfo>()->update(changed_subject, *_datamodel);
         break;
     case datamodel::ModelEventCode::item_removed:
+        clearElementPathIndices(*_datamodel);
         _datamodel->getInfo<ValidationServiceInfo>()->removed(changed_subject, *_datamodel);
         break;
     case datamodel::ModelEventCode::subitem_changed: {
@@ -857,6 +1420,7 @@ void DataDefinition::modelChanged(datamodel::ModelEventCode event_code,
         }
     } break;
     case datamodel::ModelEventCode::subitem_removed:
+        clearElementPathIndices(*_datamodel);
         changed_subject.getInfo<TypeInfo>()->update(changed_subject, *_datamodel, true);
         changed_subject.getInfo<ValidationInfo>()->update(changed_subject, *_datamodel);
         break;
@@ -866,11 +1430,14 @@ void DataDefinition::modelChanged(datamodel::ModelEventCode event_code,
         break;
     case datamodel::ModelEventCode::subitem_added:
         // this is the case if one element is added
+        clearElementPathIndices(*_datamodel);
         changed_subject.getInfo<TypeInfo>()->update(changed_subject, *_datamodel, false);
         break;
     case datamodel::ModelEventCode::subitem_renamed:
+        clearElementPathIndices(*_datamodel);
         break;
     }
+    resolveSharedTypes(changed_subject, users);
 }
 
 void DataDefinition::modelChanged(datamodel::ModelEventCode event_code,
@@ -74,6 +74,20 @@ size_t calculateSerializedBitSize(size_t array_size, size_t type_bit_size, Optio
 
 namespace {
 
+/**
+ * The element types refer to the used types for reading only, so a type shared with other
+ * datamodels is accessed for changes only to create its type info.
+ */
+template <typename TYPES>
+std::shared_ptr<typename TYPES::access_type> getUsedType(TYPES& types, const std::string& type_name)
+{
+    auto used_type = std::const_pointer_cast<typename TYPES::access_type>(types.get(type_name));
+    if (used_type && used_type->template getInfo<TypeInfo>() == nullptr) {
+        used_type = types.access(type_name);
+    }
+    return used_type;
+}
+
 const TypeInfo* getOrCreateTypeInfo(const datamodel::StructType::Element& current,
                                     datamodel::DataDefinition& ddl,
                                     datamodel::ElementType& elem_type_return)
@@ -87,7 +101,7 @@ const TypeInfo* getOrCreateTypeInfo(const datamodel::StructType::Element& curren
 
     elem_type_return._type_of_type = ddl.getTypeOfType(type_name);
     if (elem_type_return._type_of_type == TypeOfType::data_type) {
-        elem_type_return._data_type = ddl.getDataTypes().access(type_name);
+        elem_type_return._data_type = getUsedType(ddl.getDataTypes(), type_name);
         auto info = elem_type_return._data_type->getInfo<TypeInfo>();
         if (info == nullptr) {
             elem_type_return._data_type->setInfo<TypeInfo>(
@@ -97,7 +111,7 @@ const TypeInfo* getOrCreateTypeInfo(const datamodel::StructType::Element& curren
         return info;
     }
     else if (elem_type_return._type_of_type == TypeOfType::enum_type) {
-        elem_type_return._enum_type = ddl.getEnumTypes().access(type_name);
+        elem_type_return._enum_type = getUsedType(ddl.getEnumTypes(), type_name);
         auto info = elem_type_return._enum_type->getInfo<TypeInfo>();
         if (info == nullptr) {
             elem_type_return._enum_type->setInfo<TypeInfo>(
@@ -106,11 +120,11 @@ const TypeInfo* getOrCreateTypeInfo(const datamodel::StructType::Element& curren
         }
         // we set also the data type here!
         elem_type_return._data_type =
-            ddl.getDataTypes().access(elem_type_return._enum_type->getDataTypeName());
+            getUsedType(ddl.getDataTypes(), elem_type_return._enum_type->getDataTypeName());
         return info;
     }
     else if (elem_type_return._type_of_type == TypeOfType::struct_type) {
-        elem_type_return._struct_type = ddl.getStructTypes().access(type_name);
+        elem_type_return._struct_type = getUsedType(ddl.getStructTypes(), type_name);
         auto info = elem_type_return._struct_type->getInfo<TypeInfo>();
         if (info == nullptr) {
             // we need that order because of possible recursions
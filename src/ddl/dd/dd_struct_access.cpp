@@ -304,32 +304,44 @@ const std::shared_ptr<const datamodel::StructType::Element> findElement(
 }
 } // namespace
 
-StructElementAccess StructTypeAccess::getElementByPath(const std::string name_path) const
-{
-    auto splitted_list_of_elements = a_util::strings::split(name_path, ".");
-    if (splitted_list_of_elements.size() == 0 &&
-        name_path.find_first_of("/") != std::string::npos) {
-        splitted_list_of_elements = a_util::strings::split(name_path, "/");
+StructElementAccess StructTypeAccess::getElementByPath(const std::string& name_path) const
+{
+    // the offsets within this struct type are resolved once and kept in the index of its TypeInfo
+    const ElementPathIndex* index = _type_info != nullptr ? &_type_info->getElementPathIndex()
+                                                     : nullptr;
+    ElementPathIndex::ResolvedElement resolved_element = {};
+    if (index == nullptr || !index->find(name_path, resolved_element)) {
+        auto splitted_list_of_elements = a_util::strings::split(name_path, ".");
+        if (splitted_list_of_elements.size() == 0 &&
+            name_path.find_first_of("/") != std::string::npos) {
+            splitted_list_of_elements = a_util::strings::split(name_path, "/");
+        }
+
+        OptionalSize serialized_struct_offset = 0;
+        OptionalSize deserialized_struct_offset = 0;
+        resolved_element._element = findElement(*_struct_type,
+                                                splitted_list_of_elements,
+                                                serialized_struct_offset,
+                                                deserialized_struct_offset,
+                                                resolved_element._array_pos);
+        if (!resolved_element._element) {
+            return nullptr;
+        }
+        resolved_element._serialized_struct_bit_offset = *serialized_struct_offset;
+        resolved_element._deserialized_struct_byte_offset = *deserialized_struct_offset;
+        if (index != nullptr) {
+            index->add(name_path, resolved_element);
+        }
     }
 
     OptionalSize current_serialized_struct_offset = _serialized_struct_as_element_offset;
     OptionalSize current_deserialized_struct_offset = _deserialized_struct_as_element_offset;
-    OptionalSize array_pos = {};
-
-    auto found_elem = findElement(*_struct_type,
-                                  splitted_list_of_elements,
-                                  current_serialized_struct_offset,
-                                  current_deserialized_struct_offset,
-                                  array_pos);
-    if (found_elem) {
-        return {found_elem,
-                current_serialized_struct_offset,
-                current_deserialized_struct_offset,
-                array_pos};
-    }
-    else {
-        return nullptr;
-    }
+    *current_serialized_struct_offset += resolved_element._serialized_struct_bit_offset;
+    *current_deserialized_struct_offset += resolved_element._deserialized_struct_byte_offset;
+    return {resolved_element._element,
+            current_serialized_struct_offset,
+            current_deserialized_struct_offset,
+            resolved_element._array_pos};
 }
 
 size_t StructTypeAccess::getStaticStructSize() const
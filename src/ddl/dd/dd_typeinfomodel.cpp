@@ -19,6 +19,9 @@
 
 #include "dd_offset_calculation.h"
 #include "ddl/dd/dd_predefined_datatypes.h"
+#include "ddl/dd/dd_validationinfomodel.h"
+
+#include <algorithm>
 
 namespace ddl {
 namespace dd {
@@ -26,6 +29,40 @@ namespace dd {
 constexpr const uint8_t TypeInfo::INFO_TYPE_ID;
 constexpr const uint8_t ElementTypeInfo::INFO_TYPE_ID;
 
+ElementPathIndex::ElementPathIndex(const ElementPathIndex&)
+{
+}
+
+ElementPathIndex& ElementPathIndex::operator=(const ElementPathIndex&)
+{
+    clear();
+    return *this;
+}
+
+bool ElementPathIndex::find(const std::string& name_path, ResolvedElement& resolved_element) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto found = _resolved_elements.find(name_path);
+    if (found == _resolved_elements.end()) {
+        return false;
+    }
+    resolved_element = found->second;
+    return true;
+}
+
+void ElementPathIndex::add(const std::string& name_path,
+                           const ResolvedElement& resolved_element) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _resolved_elements[name_path] = resolved_element;
+}
+
+void ElementPathIndex::clear() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _resolved_elements.clear();
+}
+
 TypeInfo::TypeInfo(const datamodel::DataType& data_type, datamodel::DataDefinition& parent_ddl)
 {
     update(data_type, parent_ddl);
@@ -36,6 +73,11 @@ TypeInfo::TypeInfo(const datamodel::EnumType& enum_type, datamodel::DataDefiniti
     update(enum_type, parent_ddl);
 }
 
+std::shared_ptr<datamodel::IInfo> TypeInfo::clone() const
+{
+    return std::make_shared<TypeInfo>(*this);
+}
+
 size_t TypeInfo::getTypeBitSize() const
 {
     return _type_bit_size;
@@ -66,6 +108,11 @@ bool TypeInfo::isDynamic() const
     return _is_dynamic;
 }
 
+const ElementPathIndex& TypeInfo::getElementPathIndex() const
+{
+    return _element_path_index;
+}
+
 bool TypeInfo::isValid() const
 {
     return _is_valid;
@@ -132,6 +179,8 @@ void TypeInfo::update(datamodel::StructType& struct_type,
                       datamodel::DataDefinition& parent_dd,
                       bool recalculate_all)
 {
+    // the positions of the elements may change
+    _element_path_index.clear();
     if (_already_discovering) {
         _is_valid = false;
         throw Error("TypeInfo::update", {struct_type.getName()}, "Recursive use of this type!");
@@ -216,10 +265,367 @@ void TypeInfo::update(datamodel::StructType& struct_type,
     _already_discovering = false;
 }
 
+bool TypeFingerprint::operator==(const TypeFingerprint& other) const
+{
+    return _high == other._high && _low == other._low;
+}
+
+bool TypeFingerprint::operator!=(const TypeFingerprint& other) const
+{
+    return !operator==(other);
+}
+
+TypeFingerprintCache::TypeFingerprintCache(const TypeFingerprintCache&)
+{
+}
+
+TypeFingerprintCache& TypeFingerprintCache::operator=(const TypeFingerprintCache&)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _change_ids[layout] = 0;
+    _change_ids[full] = 0;
+    return *this;
+}
+
+bool TypeFingerprintCache::find(Kind kind,
+                                uint64_t change_id,
+                                OptionalTypeFingerprint& fingerprint) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_change_ids[kind] != change_id) {
+        return false;
+    }
+    fingerprint = _fingerprints[kind];
+    return true;
+}
+
+void TypeFingerprintCache::add(Kind kind,
+                               uint64_t change_id,
+                               const OptionalTypeFingerprint& fingerprint) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _change_ids[kind] = change_id;
+    _fingerprints[kind] = fingerprint;
+}
+
+namespace {
+
+/**
+ * Calculates a 128 bit hash in two FNV-1a like lanes of 64 bit with different primes. All values
+ * are added byte by byte in little endian order to be independent of the platform.
+ */
+class FingerprintHasher {
+public:
+    void add(uint64_t value)
+    {
+        for (size_t byte = 0; byte < sizeof(value); ++byte) {
+            addByte(static_cast<uint8_t>(value >> (byte * 8)));
+        }
+    }
+    void add(const std::string& value)
+    {
+        add(static_cast<uint64_t>(value.size()));
+        for (const auto character: value) {
+            addByte(static_cast<uint8_t>(character));
+        }
+    }
+    void add(const OptionalSize& value)
+    {
+        add(static_cast<uint64_t>(value ? 1 : 0));
+        if (value) {
+            add(static_cast<uint64_t>(*value));
+        }
+    }
+    void add(const TypeFingerprint& value)
+    {
+        add(value._high);
+        add(value._low);
+    }
+    TypeFingerprint get() const
+    {
+        TypeFingerprint fingerprint;
+        fingerprint._high = mix(_high ^ ((_low >> 32) | (_low << 32)));
+        fingerprint._low = mix(_low);
+        return fingerprint;
+    }
+
+private:
+    void addByte(uint8_t value)
+    {
+        _low = (_low ^ value) * 0x100000001B3ULL;
+        _high = (_high ^ value) * 0x9E3779B97F4A7C15ULL;
+    }
+    static uint64_t mix(uint64_t value)
+    {
+        // the finalizer of splitmix64
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+        return value ^ (value >> 31);
+    }
+
+    uint64_t _low = 0xCBF29CE484222325ULL;
+    uint64_t _high = 0x6C62272E07BB0142ULL;
+};
+
+std::string getCanonicalDataTypeName(const std::string& data_type_name)
+{
+    // aliases like tUInt32 and uint32_t describe the same layout
+    auto canonical_name = data_type_name;
+    for (const auto& alias: PredefinedDataTypes::getInstance().getAliasTypes(data_type_name)) {
+        canonical_name = std::min(canonical_name, alias);
+    }
+    return canonical_name;
+}
+
+OptionalTypeFingerprint calculateLayoutFingerprint(const datamodel::StructType& struct_type,
+                                                   const TypeInfo& type_info,
+                                                   const datamodel::DataDefinition& parent_dd)
+{
+    FingerprintHasher hasher;
+    hasher.add(type_info.getTypeByteSize());
+    hasher.add(type_info.getTypeBitSize());
+    hasher.add(type_info.getTypeAlignment());
+    hasher.add(type_info.isDynamic());
+    const auto& elements = struct_type.getElements();
+    hasher.add(elements.getSize());
+    for (const auto& element: elements) {
+        const auto element_info = element->getInfo<ElementTypeInfo>();
+        if (element_info == nullptr) {
+            return {};
+        }
+        hasher.add(element->getAlignment());
+        hasher.add(static_cast<uint64_t>(element->getByteOrder()));
+        const auto& array_size = element->getArraySize();
+        hasher.add(array_size.isDynamicArraySize());
+        if (array_size.isDynamicArraySize()) {
+            hasher.add(elements.getPosOf(array_size.getArraySizeElementName()));
+        }
+        else {
+            hasher.add(array_size.getArraySizeValue());
+        }
+        hasher.add(element_info->getDeserializedBytePos());
+        hasher.add(element_info->getDeserializedByteSize());
+        hasher.add(element_info->getDeserializedTypeByteSize());
+        hasher.add(element_info->getSerializedBitOffset());
+        hasher.add(element_info->getSerializedBitSize());
+        hasher.add(element_info->getSerializedTypeBitSize());
+        hasher.add(element_info->isDynamic());
+        hasher.add(element_info->isAfterDynamic());
+        hasher.add(static_cast<uint64_t>(element_info->getTypeOfType()));
+        std::string data_type_name;
+        switch (element_info->getTypeOfType()) {
+        case TypeOfType::data_type:
+            data_type_name = element_info->getDataType()->getName();
+            break;
+        case TypeOfType::enum_type:
+            data_type_name = element_info->getEnumType()->getDataTypeName();
+            break;
+        case TypeOfType::struct_type: {
+            const auto used_struct_type = element_info->getStructType();
+            const auto used_type_info = used_struct_type->getInfo<TypeInfo>();
+            if (used_type_info == nullptr) {
+                return {};
+            }
+            const auto fingerprint =
+                used_type_info->getLayoutFingerprint(*used_struct_type, parent_dd);
+            if (!fingerprint) {
+                return {};
+            }
+            hasher.add(*fingerprint);
+            continue;
+        }
+        default:
+            return {};
+        }
+        // only predefined data types have a known binary layout
+        if (!PredefinedDataTypes::getInstance().getPredefinedType(data_type_name)) {
+            return {};
+        }
+        hasher.add(getCanonicalDataTypeName(data_type_name));
+    }
+    return hasher.get();
+}
+
+void addBaseUnit(FingerprintHasher& hasher, const datamodel::BaseUnit& base_unit)
+{
+    hasher.add(base_unit.getName());
+    hasher.add(base_unit.getSymbol());
+    hasher.add(base_unit.getDescription());
+}
+
+bool addUnit(FingerprintHasher& hasher,
+             const std::string& unit_name,
+             const datamodel::DataDefinition& parent_dd)
+{
+    const auto type_of_unit = parent_dd.getTypeOfUnit(unit_name);
+    hasher.add(unit_name);
+    hasher.add(static_cast<uint64_t>(type_of_unit));
+    if (type_of_unit == TypeOfUnit::base_unit) {
+        addBaseUnit(hasher, *parent_dd.getBaseUnits().get(unit_name));
+    }
+    else if (type_of_unit == TypeOfUnit::unit) {
+        const auto unit = parent_dd.getUnits().get(unit_name);
+        hasher.add(unit->getNumerator());
+        hasher.add(unit->getDenominator());
+        hasher.add(unit->getOffset());
+        hasher.add(unit->getRefUnits().size());
+        for (const auto& ref_unit: unit->getRefUnits()) {
+            hasher.add(static_cast<uint64_t>(static_cast<int64_t>(ref_unit.getPower())));
+            const auto base_unit = parent_dd.getBaseUnits().get(ref_unit.getUnitName());
+            const auto prefix = parent_dd.getUnitPrefixes().get(ref_unit.getPrefixName());
+            if (!base_unit || !prefix) {
+                return false;
+            }
+            addBaseUnit(hasher, *base_unit);
+            hasher.add(prefix->getName());
+            hasher.add(prefix->getSymbol());
+            hasher.add(static_cast<uint64_t>(static_cast<int64_t>(prefix->getPower())));
+        }
+    }
+    return true;
+}
+
+void addDataType(FingerprintHasher& hasher, const datamodel::DataType& data_type)
+{
+    hasher.add(data_type.getName());
+    hasher.add(data_type.getBitSize());
+    hasher.add(data_type.getArraySize());
+    hasher.add(data_type.getUnitName());
+    hasher.add(data_type.getMin());
+    hasher.add(data_type.getMax());
+    hasher.add(data_type.getDescription());
+    hasher.add(data_type.getDefaultAlignment());
+}
+
+bool addEnumType(FingerprintHasher& hasher,
+                 const datamodel::EnumType& enum_type,
+                 const datamodel::DataDefinition& parent_dd)
+{
+    const auto data_type = parent_dd.getDataTypes().get(enum_type.getDataTypeName());
+    if (!data_type) {
+        return false;
+    }
+    hasher.add(enum_type.getName());
+    addDataType(hasher, *data_type);
+    // the order of the elements is not defined
+    std::vector<std::pair<std::string, std::string>> elements;
+    for (const auto& element: enum_type.getElements()) {
+        elements.emplace_back(element.second->getName(), element.second->getValue());
+    }
+    std::sort(elements.begin(), elements.end());
+    hasher.add(elements.size());
+    for (const auto& element: elements) {
+        hasher.add(element.first);
+        hasher.add(element.second);
+    }
+    return true;
+}
+
+OptionalTypeFingerprint calculateFullFingerprint(const datamodel::StructType& struct_type,
+                                                 const datamodel::DataDefinition& parent_dd)
+{
+    FingerprintHasher hasher;
+    hasher.add(struct_type.getName());
+    hasher.add(struct_type.getVersion());
+    hasher.add(struct_type.getComment());
+    hasher.add(struct_type.getAlignment());
+    hasher.add(struct_type.getLanguageVersion().getMajor());
+    hasher.add(struct_type.getLanguageVersion().getMinor());
+    hasher.add(struct_type.getElements().getSize());
+    for (const auto& element: struct_type.getElements()) {
+        hasher.add(element->getName());
+        hasher.add(element->getDescription());
+        hasher.add(element->getComment());
+        hasher.add(element->getArraySize().isDynamicArraySize());
+        hasher.add(element->getArraySize().getArraySizeValue());
+        hasher.add(element->getArraySize().getArraySizeElementName());
+        hasher.add(element->getValue());
+        hasher.add(element->getMin());
+        hasher.add(element->getMax());
+        hasher.add(element->getDefault());
+        hasher.add(element->getScale());
+        hasher.add(element->getOffset());
+        hasher.add(element->getAlignment());
+        hasher.add(element->getBytePos());
+        hasher.add(element->getBitPos());
+        hasher.add(element->getNumBits());
+        hasher.add(static_cast<uint64_t>(element->getByteOrder()));
+        if (!addUnit(hasher, element->getUnitName(), parent_dd)) {
+            return {};
+        }
+        const auto& type_name = element->getTypeName();
+        const auto type_of_type = parent_dd.getTypeOfType(type_name);
+        hasher.add(type_name);
+        hasher.add(static_cast<uint64_t>(type_of_type));
+        if (type_of_type == TypeOfType::data_type) {
+            addDataType(hasher, *parent_dd.getDataTypes().get(type_name));
+        }
+        else if (type_of_type == TypeOfType::enum_type) {
+            if (!addEnumType(hasher, *parent_dd.getEnumTypes().get(type_name), parent_dd)) {
+                return {};
+            }
+        }
+        else if (type_of_type == TypeOfType::struct_type) {
+            const auto used_struct_type = parent_dd.getStructTypes().get(type_name);
+            const auto used_type_info = used_struct_type->getInfo<TypeInfo>();
+            if (used_type_info == nullptr) {
+                return {};
+            }
+            const auto fingerprint =
+                used_type_info->getFullFingerprint(*used_struct_type, parent_dd);
+            if (!fingerprint) {
+                return {};
+            }
+            hasher.add(*fingerprint);
+        }
+        else {
+            return {};
+        }
+    }
+    return hasher.get();
+}
+
+} // namespace
+
+OptionalTypeFingerprint TypeInfo::getLayoutFingerprint(
+    const datamodel::StructType& struct_type, const datamodel::DataDefinition& parent_dd) const
+{
+    const auto change_id = parent_dd.getChangeId();
+    OptionalTypeFingerprint fingerprint;
+    if (!_fingerprints.find(TypeFingerprintCache::layout, change_id, fingerprint)) {
+        const auto validation_info = struct_type.getInfo<ValidationInfo>();
+        if (_is_valid && validation_info != nullptr && validation_info->isValid()) {
+            fingerprint = calculateLayoutFingerprint(struct_type, *this, parent_dd);
+        }
+        _fingerprints.add(TypeFingerprintCache::layout, change_id, fingerprint);
+    }
+    return fingerprint;
+}
+
+OptionalTypeFingerprint TypeInfo::getFullFingerprint(
+    const datamodel::StructType& struct_type, const datamodel::DataDefinition& parent_dd) const
+{
+    const auto change_id = parent_dd.getChangeId();
+    OptionalTypeFingerprint fingerprint;
+    if (!_fingerprints.find(TypeFingerprintCache::full, change_id, fingerprint)) {
+        const auto validation_info = struct_type.getInfo<ValidationInfo>();
+        if (_is_valid && validation_info != nullptr && validation_info->isValid()) {
+            fingerprint = calculateFullFingerprint(struct_type, parent_dd);
+        }
+        _fingerprints.add(TypeFingerprintCache::full, change_id, fingerprint);
+    }
+    return fingerprint;
+}
+
 /**
  * Element Size Info is inportant to get the TypeInfo for Structs
  */
 
+std::shared_ptr<datamodel::IInfo> ElementTypeInfo::clone() const
+{
+    return std::make_shared<ElementTypeInfo>(*this);
+}
+
 OptionalSize ElementTypeInfo::getDeserializedBytePos(size_t array_pos) const
 {
     if (_deserialized_byte_pos && array_pos > 0) {
@@ -323,6 +729,28 @@ void ElementTypeInfo::update(
     _is_valid = deserialized_pos._valid && serialized_pos._valid;
 }
 
+namespace {
+template <typename TYPES>
+void resolveType(std::shared_ptr<typename TYPES::access_type>& type, const TYPES& types)
+{
+    if (type) {
+        const auto resolved_type = types.get(type->getName());
+        // a removed type stays referenced, like in the DD the reference was resolved in
+        if (resolved_type) {
+            // the references are handed out for reading only
+            type = std::const_pointer_cast<typename TYPES::access_type>(resolved_type);
+        }
+    }
+}
+} // namespace
+
+void ElementTypeInfo::resolveTypes(const datamodel::DataDefinition& parent_dd)
+{
+    resolveType(_element_type._data_type, parent_dd.getDataTypes());
+    resolveType(_element_type._enum_type, parent_dd.getEnumTypes());
+    resolveType(_element_type._struct_type, parent_dd.getStructTypes());
+}
+
 std::shared_ptr<const datamodel::StructType> ElementTypeInfo::getStructType() const
 {
     return _element_type._struct_type;
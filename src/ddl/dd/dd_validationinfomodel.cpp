@@ -21,6 +21,8 @@
 #include "ddl/dd/dd_predefined_units.h"
 #include "ddl/utilities/std_to_string.h"
 
+#include <algorithm>
+
 namespace ddl {
 
 namespace dd {
@@ -42,61 +44,39 @@ ValidationServiceInfo::Dependency::Dependency(DependencyType type_of_dependency,
 namespace {
 void addDependencyToMap(const std::string& from,
                         const std::string& to,
-                        ValidationServiceInfo::ToFromMap& the_map)
+                        ValidationServiceInfo::ToFromMap& the_map,
+                        ValidationServiceInfo::ToFromMap& the_from_map)
 {
     // the map will save wich one is by which items
     // the "to" -> many "used from"
-    // but only if it does not exist already
-    for (auto& current_from: the_map[to]) {
-        if (current_from == from) {
-            // is already in there
-            return;
-        }
-    }
-    the_map[to].push_back(from);
-}
-
-void removeInMapFrom(const std::string& from, ValidationServiceInfo::ToFromMap& the_map)
-{
-    for (auto current_to = the_map.begin(); current_to != the_map.end(); ++current_to) {
-        for (auto it = current_to->second.begin(); it != current_to->second.end(); ++it) {
-            if (*it == from) {
-                current_to->second.erase(it);
-                break;
-            }
-        }
-    }
+    // the set will keep it only once if it does exist already
+    the_map[to].insert(from);
+    the_from_map[from].insert(to);
 }
 
-std::vector<std::string> removeInMapTo(const std::string& to,
-                                       ValidationServiceInfo::ToFromMap& the_map)
+void eraseInMap(const std::string& key,
+                const std::string& value,
+                ValidationServiceInfo::ToFromMap& the_map)
 {
-    std::vector<std::string> result = {};
-    auto it = the_map.find(to);
+    auto it = the_map.find(key);
     if (it != the_map.end()) {
-        std::swap(it->second, result);
-        the_map.erase(it);
-    }
-    return result;
-}
-
-void renameInMapFrom(const std::string& from_old,
-                     const std::string& from_new,
-                     ValidationServiceInfo::ToFromMap& the_map)
-{
-    for (auto& current_to: the_map) {
-        for (auto it = current_to.second.begin(); it != current_to.second.end(); ++it) {
-            if (*it == from_old) {
-                *it = from_new;
-                break;
-            }
+        it->second.erase(value);
+        if (it->second.empty()) {
+            the_map.erase(it);
         }
     }
 }
 
+/// The collector of the dependencies found on the current thread, if any.
+thread_local ValidationServiceInfo::DependencyCollector* current_dependency_collector = nullptr;
+
 void addDependency(const ValidationServiceInfo::Dependency& dependency,
                    datamodel::DataDefinition& parent_ddl)
 {
+    if (current_dependency_collector) {
+        current_dependency_collector->_dependencies.push_back(dependency);
+        return;
+    }
     auto dependency_service = parent_ddl.getInfo<ValidationServiceInfo>();
     if (dependency_service) {
         dependency_service->addDependency(dependency);
@@ -105,14 +85,97 @@ void addDependency(const ValidationServiceInfo::Dependency& dependency,
 
 } // namespace
 
+std::shared_ptr<datamodel::IInfo> ValidationServiceInfo::clone() const
+{
+    return std::make_shared<ValidationServiceInfo>(*this);
+}
+
 /**
  * DependencyServiceInfo is only part of the toplevel DataDefinition.
  * The validation model uses these
  */
 void ValidationServiceInfo::addDependency(const Dependency& dependency)
 {
-    auto& ToFromMap = _dependencies[dependency._type_of_dependency];
-    addDependencyToMap(dependency._from, dependency._to, ToFromMap);
+    changeDependencies();
+    addDependencyToMap(dependency._from,
+                       dependency._to,
+                       (*_dependencies)[dependency._type_of_dependency],
+                       (*_dependencies_from)[dependency._type_of_dependency]);
+}
+
+ValidationServiceInfo::DependencyCollector::DependencyCollector()
+    : _previous_collector(current_dependency_collector)
+{
+    current_dependency_collector = this;
+}
+
+ValidationServiceInfo::DependencyCollector::~DependencyCollector()
+{
+    current_dependency_collector = _previous_collector;
+}
+
+void ValidationServiceInfo::removeInMapFrom(const std::string& from, DependencyType type)
+{
+    // only the "to" items used by "from" are touched
+    changeDependencies();
+    auto& from_to_map = (*_dependencies_from)[type];
+    auto from_it = from_to_map.find(from);
+    if (from_it != from_to_map.end()) {
+        auto& to_from_map = (*_dependencies)[type];
+        for (const auto& current_to: from_it->second) {
+            eraseInMap(current_to, from, to_from_map);
+        }
+        from_to_map.erase(from_it);
+    }
+}
+
+std::vector<std::string> ValidationServiceInfo::removeInMapTo(const std::string& to,
+                                                              DependencyType type)
+{
+    std::vector<std::string> result = {};
+    changeDependencies();
+    auto& to_from_map = (*_dependencies)[type];
+    auto it = to_from_map.find(to);
+    if (it != to_from_map.end()) {
+        result.assign(it->second.begin(), it->second.end());
+        to_from_map.erase(it);
+        auto& from_to_map = (*_dependencies_from)[type];
+        for (const auto& current_from: result) {
+            eraseInMap(current_from, to, from_to_map);
+        }
+    }
+    return result;
+}
+
+void ValidationServiceInfo::renameInMapFrom(const std::string& from_old,
+                                            const std::string& from_new,
+                                            DependencyType type)
+{
+    changeDependencies();
+    auto& from_to_map = (*_dependencies_from)[type];
+    auto from_it = from_to_map.find(from_old);
+    if (from_it != from_to_map.end()) {
+        auto used_to = std::move(from_it->second);
+        from_to_map.erase(from_it);
+        auto& to_from_map = (*_dependencies)[type];
+        for (const auto& current_to: used_to) {
+            auto& current_from = to_from_map[current_to];
+            current_from.erase(from_old);
+            current_from.insert(from_new);
+        }
+        from_to_map[from_new].insert(used_to.begin(), used_to.end());
+    }
+}
+
+void ValidationServiceInfo::changeDependencies()
+{
+    if (_dependencies.use_count() > 1) {
+        _dependencies = std::make_shared<std::unordered_map<uint8_t, ToFromMap>>(*_dependencies);
+    }
+    if (_dependencies_from.use_count() > 1) {
+        _dependencies_from =
+            std::make_shared<std::unordered_map<uint8_t, ToFromMap>>(*_dependencies_from);
+    }
 }
 
 namespace {
@@ -139,14 +202,14 @@ void updateValidationInfo(const std::shared_ptr<T>& type_ref, datamodel::DataDef
 void ValidationServiceInfo::removed(const datamodel::DataType& data_type,
                                     datamodel::DataDefinition& parent_ddl)
 {
-    removeInMapFrom(data_type.getName(), _dependencies[data_type_to_unit]);
-    auto dependencies = removeInMapTo(data_type.getName(), _dependencies[enum_type_to_data_type]);
+    removeInMapFrom(data_type.getName(), data_type_to_unit);
+    auto dependencies = removeInMapTo(data_type.getName(), enum_type_to_data_type);
     // this should invalidate the enum_type if there are values
     for (const auto& current_enum_name: dependencies) {
         const auto enum_type = parent_ddl.getEnumTypes().access(current_enum_name);
         updateValidationInfo<datamodel::EnumType>(enum_type, parent_ddl);
     }
-    dependencies = removeInMapTo(data_type.getName(), _dependencies[struct_type_to_data_type]);
+    dependencies = removeInMapTo(data_type.getName(), struct_type_to_data_type);
     // this should invalidate the struct_types
     for (const auto& current_struct_name: dependencies) {
         const auto struct_type = parent_ddl.getStructTypes().access(current_struct_name);
@@ -157,8 +220,8 @@ void ValidationServiceInfo::removed(const datamodel::DataType& data_type,
 void ValidationServiceInfo::removed(const datamodel::EnumType& enum_type,
                                     datamodel::DataDefinition& parent_ddl)
 {
-    removeInMapFrom(enum_type.getName(), _dependencies[enum_type_to_data_type]);
-    auto dependencies = removeInMapTo(enum_type.getName(), _dependencies[struct_type_to_enum_type]);
+    removeInMapFrom(enum_type.getName(), enum_type_to_data_type);
+    auto dependencies = removeInMapTo(enum_type.getName(), struct_type_to_enum_type);
     // this should invalidate the struct_types using it
     for (const auto& current_struct_name: dependencies) {
         const auto struct_type = parent_ddl.getStructTypes().access(current_struct_name);
@@ -169,17 +232,17 @@ void ValidationServiceInfo::removed(const datamodel::EnumType& enum_type,
 void ValidationServiceInfo::removed(const datamodel::StructType& struct_type,
                                     datamodel::DataDefinition& parent_ddl)
 {
-    removeInMapFrom(struct_type.getName(), _dependencies[struct_type_to_data_type]);
-    removeInMapFrom(struct_type.getName(), _dependencies[struct_type_to_enum_type]);
-    removeInMapFrom(struct_type.getName(), _dependencies[struct_type_to_struct_type]);
+    removeInMapFrom(struct_type.getName(), struct_type_to_data_type);
+    removeInMapFrom(struct_type.getName(), struct_type_to_enum_type);
+    removeInMapFrom(struct_type.getName(), struct_type_to_struct_type);
     auto dependencies =
-        removeInMapTo(struct_type.getName(), _dependencies[struct_type_to_struct_type]);
+        removeInMapTo(struct_type.getName(), struct_type_to_struct_type);
     // this should invalidate the struct_types using it
     for (const auto& current_struct_name: dependencies) {
         const auto struct_type_to_access = parent_ddl.getStructTypes().access(current_struct_name);
         updateValidationInfo<datamodel::StructType>(struct_type_to_access, parent_ddl);
     }
-    dependencies = removeInMapTo(struct_type.getName(), _dependencies[stream_to_struct_type]);
+    dependencies = removeInMapTo(struct_type.getName(), stream_to_struct_type);
     // this should invalidate the streams
     for (const auto& current_stream: dependencies) {
         const auto stream = parent_ddl.getStreams().access(current_stream);
@@ -191,10 +254,10 @@ void ValidationServiceInfo::removed(const datamodel::StreamMetaType& stream_meta
                                     datamodel::DataDefinition& parent_dd)
 {
     removeInMapFrom(stream_meta_type.getName(),
-                    _dependencies[stream_meta_type_to_stream_meta_type]);
+                    stream_meta_type_to_stream_meta_type);
 
     auto dependencies = removeInMapTo(stream_meta_type.getName(),
-                                      _dependencies[stream_meta_type_to_stream_meta_type]);
+                                      stream_meta_type_to_stream_meta_type);
     // this should invalidate the struct_types using it
     for (const auto& current_stream_meta_name: dependencies) {
         const auto current_meta_type =
@@ -202,7 +265,7 @@ void ValidationServiceInfo::removed(const datamodel::StreamMetaType& stream_meta
         updateValidationInfo<datamodel::StreamMetaType>(current_meta_type, parent_dd);
     }
     dependencies =
-        removeInMapTo(stream_meta_type.getName(), _dependencies[stream_to_stream_meta_type]);
+        removeInMapTo(stream_meta_type.getName(), stream_to_stream_meta_type);
     // this should invalidate the struct_types using it
     for (const auto& current_stream: dependencies) {
         const auto stream = parent_dd.getStreams().access(current_stream);
@@ -212,27 +275,27 @@ void ValidationServiceInfo::removed(const datamodel::StreamMetaType& stream_meta
 
 void ValidationServiceInfo::removed(const datamodel::Stream& stream, datamodel::DataDefinition&)
 {
-    removeInMapFrom(stream.getName(), _dependencies[stream_to_stream_meta_type]);
-    removeInMapFrom(stream.getName(), _dependencies[stream_to_struct_type]);
+    removeInMapFrom(stream.getName(), stream_to_stream_meta_type);
+    removeInMapFrom(stream.getName(), stream_to_struct_type);
 }
 
 void ValidationServiceInfo::removed(const datamodel::BaseUnit& base_unit,
                                     datamodel::DataDefinition& parent_dd)
 {
     // update all units
-    auto dependencies = removeInMapTo(base_unit.getName(), _dependencies[unit_to_base_unit]);
+    auto dependencies = removeInMapTo(base_unit.getName(), unit_to_base_unit);
     for (const auto& current_unit_name: dependencies) {
         const auto unit = parent_dd.getUnits().access(current_unit_name);
         updateValidationInfo<datamodel::Unit>(unit, parent_dd);
     }
     // update all data types
-    dependencies = removeInMapTo(base_unit.getName(), _dependencies[data_type_to_base_unit]);
+    dependencies = removeInMapTo(base_unit.getName(), data_type_to_base_unit);
     for (const auto& current_data_type_name: dependencies) {
         const auto data_type = parent_dd.getDataTypes().access(current_data_type_name);
         updateValidationInfo<datamodel::DataType>(data_type, parent_dd);
     }
     // update all struct types
-    dependencies = removeInMapTo(base_unit.getName(), _dependencies[struct_type_to_base_unit]);
+    dependencies = removeInMapTo(base_unit.getName(), struct_type_to_base_unit);
     for (const auto& current_struct_type_name: dependencies) {
         const auto struct_type = parent_dd.getStructTypes().access(current_struct_type_name);
         updateValidationInfo<datamodel::StructType>(struct_type, parent_dd);
@@ -243,7 +306,7 @@ void ValidationServiceInfo::removed(const datamodel::UnitPrefix& unit_prefix,
                                     datamodel::DataDefinition& parent_dd)
 {
     // update all units
-    auto dependencies = removeInMapTo(unit_prefix.getName(), _dependencies[unit_to_unit_prefix]);
+    auto dependencies = removeInMapTo(unit_prefix.getName(), unit_to_unit_prefix);
     for (const auto& current_unit_name: dependencies) {
         auto unit = parent_dd.getUnits().access(current_unit_name);
         updateValidationInfo<datamodel::Unit>(unit, parent_dd);
@@ -253,17 +316,17 @@ void ValidationServiceInfo::removed(const datamodel::UnitPrefix& unit_prefix,
 void ValidationServiceInfo::removed(const datamodel::Unit& unit,
                                     datamodel::DataDefinition& parent_dd)
 {
-    removeInMapFrom(unit.getName(), _dependencies[unit_to_base_unit]);
-    removeInMapFrom(unit.getName(), _dependencies[unit_to_unit_prefix]);
+    removeInMapFrom(unit.getName(), unit_to_base_unit);
+    removeInMapFrom(unit.getName(), unit_to_unit_prefix);
 
     // update all data types
-    auto dependencies = removeInMapTo(unit.getName(), _dependencies[data_type_to_unit]);
+    auto dependencies = removeInMapTo(unit.getName(), data_type_to_unit);
     for (const auto& current_data_type_name: dependencies) {
         auto data_type = parent_dd.getDataTypes().access(current_data_type_name);
         updateValidationInfo<datamodel::DataType>(data_type, parent_dd);
     }
     // update all struct types
-    dependencies = removeInMapTo(unit.getName(), _dependencies[struct_type_to_unit]);
+    dependencies = removeInMapTo(unit.getName(), struct_type_to_unit);
     for (const auto& current_struct_type_name: dependencies) {
         auto struct_type = parent_dd.getStructTypes().access(current_struct_type_name);
         updateValidationInfo<datamodel::StructType>(struct_type, parent_dd);
@@ -274,10 +337,10 @@ void ValidationServiceInfo::renamed(const datamodel::DataType& data_type,
                                     const std::string& old_name,
                                     datamodel::DataDefinition& parent_dd)
 {
-    renameInMapFrom(old_name, data_type.getName(), _dependencies[data_type_to_unit]);
+    renameInMapFrom(old_name, data_type.getName(), data_type_to_unit);
 
     // this should invalidate the enum_type if there are values
-    auto dependencies = removeInMapTo(old_name, _dependencies[enum_type_to_data_type]);
+    auto dependencies = removeInMapTo(old_name, enum_type_to_data_type);
     for (const auto& current_enum_name: dependencies) {
         auto enum_type = parent_dd.getEnumTypes().access(current_enum_name);
         if (enum_type) {
@@ -290,7 +353,7 @@ void ValidationServiceInfo::renamed(const datamodel::DataType& data_type,
 
     // this should invalidate the struct_type if there are values
     // go through the structs using this
-    dependencies = removeInMapTo(old_name, _dependencies[struct_type_to_data_type]);
+    dependencies = removeInMapTo(old_name, struct_type_to_data_type);
     // this should invalidate the struct_types
     for (const auto& current_struct_name: dependencies) {
         auto struct_type = parent_dd.getStructTypes().access(current_struct_name);
@@ -313,9 +376,9 @@ void ValidationServiceInfo::renamed(const datamodel::EnumType& enum_type,
                                     const std::string& old_name,
                                     datamodel::DataDefinition& parent_dd)
 {
-    renameInMapFrom(old_name, enum_type.getName(), _dependencies[enum_type_to_data_type]);
+    renameInMapFrom(old_name, enum_type.getName(), enum_type_to_data_type);
 
-    auto dependencies = removeInMapTo(old_name, _dependencies[struct_type_to_enum_type]);
+    auto dependencies = removeInMapTo(old_name, struct_type_to_enum_type);
     // this should invalidate the struct_types using it
     for (const auto& current_struct_name: dependencies) {
         auto struct_type = parent_dd.getStructTypes().access(current_struct_name);
@@ -338,11 +401,11 @@ void ValidationServiceInfo::renamed(const datamodel::StructType& struct_type,
                                     const std::string& old_name,
                                     datamodel::DataDefinition& parent_dd)
 {
-    renameInMapFrom(old_name, struct_type.getName(), _dependencies[struct_type_to_data_type]);
-    renameInMapFrom(old_name, struct_type.getName(), _dependencies[struct_type_to_enum_type]);
-    renameInMapFrom(old_name, struct_type.getName(), _dependencies[struct_type_to_struct_type]);
+    renameInMapFrom(old_name, struct_type.getName(), struct_type_to_data_type);
+    renameInMapFrom(old_name, struct_type.getName(), struct_type_to_enum_type);
+    renameInMapFrom(old_name, struct_type.getName(), struct_type_to_struct_type);
 
-    auto dependencies = removeInMapTo(old_name, _dependencies[struct_type_to_struct_type]);
+    auto dependencies = removeInMapTo(old_name, struct_type_to_struct_type);
     // this should invalidate the struct_types using it
     for (const auto& current_struct_name: dependencies) {
         auto struct_type_current = parent_dd.getStructTypes().access(current_struct_name);
@@ -360,7 +423,7 @@ void ValidationServiceInfo::renamed(const datamodel::StructType& struct_type,
         _validation_needed = true;
     }
 
-    dependencies = removeInMapTo(old_name, _dependencies[stream_to_struct_type]);
+    dependencies = removeInMapTo(old_name, stream_to_struct_type);
     // this should invalidate the streams
     for (const auto& current_stream_name: dependencies) {
         auto current_stream = parent_dd.getStreams().access(current_stream_name);
@@ -387,10 +450,10 @@ void ValidationServiceInfo::renamed(const datamodel::StreamMetaType& stream_meta
                                     datamodel::DataDefinition& parent_dd)
 {
     renameInMapFrom(
-        old_name, stream_meta_type.getName(), _dependencies[stream_meta_type_to_stream_meta_type]);
+        old_name, stream_meta_type.getName(), stream_meta_type_to_stream_meta_type);
 
     auto dependencies =
-        removeInMapTo(old_name, _dependencies[stream_meta_type_to_stream_meta_type]);
+        removeInMapTo(old_name, stream_meta_type_to_stream_meta_type);
     // this should invalidate the struct_types using it
     for (const auto& current_stream_meta_type_name: dependencies) {
         auto current_stream_meta_type =
@@ -407,7 +470,7 @@ void ValidationServiceInfo::renamed(const datamodel::StreamMetaType& stream_meta
         _validation_needed = true;
     }
 
-    dependencies = removeInMapTo(old_name, _dependencies[stream_to_stream_meta_type]);
+    dependencies = removeInMapTo(old_name, stream_to_stream_meta_type);
     // this should invalidate the streams using it
     for (const auto& current_stream_name: dependencies) {
         auto current_stream = parent_dd.getStreams().access(current_stream_name);
@@ -428,8 +491,8 @@ void ValidationServiceInfo::renamed(const datamodel::Stream& stream,
                                     const std::string& old_name,
                                     datamodel::DataDefinition&)
 {
-    renameInMapFrom(old_name, stream.getName(), _dependencies[stream_to_stream_meta_type]);
-    renameInMapFrom(old_name, stream.getName(), _dependencies[stream_to_struct_type]);
+    renameInMapFrom(old_name, stream.getName(), stream_to_stream_meta_type);
+    renameInMapFrom(old_name, stream.getName(), stream_to_struct_type);
 }
 
 void ValidationServiceInfo::renamed(const datamodel::BaseUnit& base_unit,
@@ -437,7 +500,7 @@ void ValidationServiceInfo::renamed(const datamodel::BaseUnit& base_unit,
                                     datamodel::DataDefinition& parent_dd)
 {
     // rename in structs
-    auto dependencies = removeInMapTo(old_name, _dependencies[struct_type_to_base_unit]);
+    auto dependencies = removeInMapTo(old_name, struct_type_to_base_unit);
     // this should invalidate the struct_types using it
     for (const auto& current_struct_name: dependencies) {
         auto current_struct_type = parent_dd.getStructTypes().access(current_struct_name);
@@ -456,7 +519,7 @@ void ValidationServiceInfo::renamed(const datamodel::BaseUnit& base_unit,
     }
 
     // rename in data_types
-    dependencies = removeInMapTo(old_name, _dependencies[data_type_to_base_unit]);
+    dependencies = removeInMapTo(old_name, data_type_to_base_unit);
     // this should invalidate the struct_types using it
     for (const auto& current_data_type_name: dependencies) {
         auto current_data_type = parent_dd.getDataTypes().access(current_data_type_name);
@@ -473,7 +536,7 @@ void ValidationServiceInfo::renamed(const datamodel::BaseUnit& base_unit,
     }
 
     // rename in refUnits
-    dependencies = removeInMapTo(old_name, _dependencies[unit_to_base_unit]);
+    dependencies = removeInMapTo(old_name, unit_to_base_unit);
     // this should invalidate the struct_types using it
     for (const auto& current_unit_name: dependencies) {
         auto current_unit = parent_dd.getUnits().access(current_unit_name);
@@ -507,7 +570,7 @@ void ValidationServiceInfo::renamed(const datamodel::UnitPrefix& unit_prefix,
                                     datamodel::DataDefinition& parent_dd)
 {
     // rename in refUnits
-    auto dependencies = removeInMapTo(old_name, _dependencies[unit_to_unit_prefix]);
+    auto dependencies = removeInMapTo(old_name, unit_to_unit_prefix);
     // this should invalidate the struct_types using it
     for (const auto& current_unit_name: dependencies) {
         auto current_unit = parent_dd.getUnits().access(current_unit_name);
@@ -540,11 +603,11 @@ void ValidationServiceInfo::renamed(const datamodel::Unit& unit,
                                     const std::string& old_name,
                                     datamodel::DataDefinition& parent_ddl)
 {
-    renameInMapFrom(old_name, unit.getName(), _dependencies[unit_to_base_unit]);
-    renameInMapFrom(old_name, unit.getName(), _dependencies[unit_to_unit_prefix]);
+    renameInMapFrom(old_name, unit.getName(), unit_to_base_unit);
+    renameInMapFrom(old_name, unit.getName(), unit_to_unit_prefix);
 
     // rename in structs
-    auto dependencies = removeInMapTo(old_name, _dependencies[struct_type_to_unit]);
+    auto dependencies = removeInMapTo(old_name, struct_type_to_unit);
     // this should invalidate the struct_types using it
     for (const auto& current_struct_name: dependencies) {
         auto current_struct_type = parent_ddl.getStructTypes().access(current_struct_name);
@@ -563,7 +626,7 @@ void ValidationServiceInfo::renamed(const datamodel::Unit& unit,
     }
 
     // rename in data_types
-    dependencies = removeInMapTo(old_name, _dependencies[data_type_to_unit]);
+    dependencies = removeInMapTo(old_name, data_type_to_unit);
     // this should invalidate the struct_types using it
     for (const auto& current_data_type_name: dependencies) {
         auto current_data_type = parent_ddl.getDataTypes().access(current_data_type_name);
@@ -614,6 +677,11 @@ ValidationInfo::~ValidationInfo()
     // removeAllDependencies();
 }
 
+std::shared_ptr<datamodel::IInfo> ValidationInfo::clone() const
+{
+    return std::make_shared<ValidationInfo>(*this);
+}
+
 bool ValidationInfo::isValid(ValidationLevel level) const
 {
     if (_valid == invalid) {
@@ -655,30 +723,30 @@ ValidationInfo::Problem generateProblemMessage(const std::string& typeofmodel,
     return {name, typeofmodel + " ('" + name + "'): " + problem_message};
 }
 
-std::shared_ptr<datamodel::BaseUnit> getOrCreatePredefinedBaseUnit(
+std::shared_ptr<const datamodel::BaseUnit> getOrCreatePredefinedBaseUnit(
     const std::string& name, datamodel::DataDefinition& parent_dd)
 {
-    auto base_unit_found = parent_dd.getBaseUnits().access(name);
+    auto base_unit_found = parent_dd.getBaseUnits().get(name);
     if (!base_unit_found) {
         // if not found mayby it is predefined
         auto predefined = ddl::PredefinedUnits::getInstance().getPredefinedBaseUnit(name);
         if (predefined) {
             parent_dd.getBaseUnits().add(*predefined);
-            base_unit_found = parent_dd.getBaseUnits().access(name);
+            base_unit_found = parent_dd.getBaseUnits().get(name);
         }
     }
     return base_unit_found;
 }
-std::shared_ptr<datamodel::UnitPrefix> getOrCreatePredefinedUnitPrefix(
+std::shared_ptr<const datamodel::UnitPrefix> getOrCreatePredefinedUnitPrefix(
     const std::string& name, datamodel::DataDefinition& parent_dd)
 {
-    auto unit_prefix_found = parent_dd.getUnitPrefixes().access(name);
+    auto unit_prefix_found = parent_dd.getUnitPrefixes().get(name);
     if (!unit_prefix_found) {
         // if not found mayby it is predefined
         auto predefined = ddl::PredefinedUnits::getInstance().getPredefinedUnitPrefix(name);
         if (predefined) {
             parent_dd.getUnitPrefixes().add(*predefined);
-            unit_prefix_found = parent_dd.getUnitPrefixes().access(name);
+            unit_prefix_found = parent_dd.getUnitPrefixes().get(name);
         }
     }
     return unit_prefix_found;
@@ -800,16 +868,16 @@ void ValidationInfo::update(datamodel::DataType& data_type, datamodel::DataDefin
 }
 
 namespace {
-std::shared_ptr<datamodel::DataType> getOrCreatePredefinedDataType(
+std::shared_ptr<const datamodel::DataType> getOrCreatePredefinedDataType(
     const std::string& name, datamodel::DataDefinition& parent_dd)
 {
-    auto data_type_found = parent_dd.getDataTypes().access(name);
+    auto data_type_found = parent_dd.getDataTypes().get(name);
     if (!data_type_found) {
         // if not found mayby it is predefined
         auto predefined = ddl::PredefinedDataTypes::getInstance().getPredefinedType(name);
         if (predefined) {
             parent_dd.getDataTypes().add(*predefined);
-            data_type_found = parent_dd.getDataTypes().access(name);
+            data_type_found = parent_dd.getDataTypes().get(name);
         }
     }
     return data_type_found;
@@ -864,6 +932,23 @@ void ValidationInfo::forceRevalidation()
 
 namespace {
 
+/**
+ * Finds the validation info of a type if it is valid already. The type is not accessed for
+ * changes, so a type shared with other datamodels is not copied to be read only.
+ */
+template <typename TYPES>
+const ValidationInfo* findValidInfo(const TYPES& types, const std::string& type_name)
+{
+    const auto type = types.get(type_name);
+    if (type) {
+        const auto info = type->template getInfo<ValidationInfo>();
+        if (info != nullptr && info->isValid()) {
+            return info;
+        }
+    }
+    return nullptr;
+}
+
 const ValidationInfo* getOrCreateValidationInfo(const std::string type_name,
                                                 TypeOfType& type_of_type,
                                                 datamodel::DataDefinition& ddl,
@@ -878,8 +963,7 @@ const ValidationInfo* getOrCreateValidationInfo(const std::string type_name,
     // we check for invalid here to have a look at the predefined types
     if (!with_stream_meta_type) {
         if (type_of_type == TypeOfType::data_type || type_of_type == TypeOfType::invalid_type) {
-            auto dt = getOrCreatePredefinedDataType(type_name, ddl);
-            if (dt) {
+            if (getOrCreatePredefinedDataType(type_name, ddl)) {
                 // if we maybe found a predefined type we mus set this to data_type
                 type_of_type = TypeOfType::data_type;
             }
@@ -887,6 +971,11 @@ const ValidationInfo* getOrCreateValidationInfo(const std::string type_name,
                 // it is really invalid, so we return nullptr
                 return {};
             }
+            const auto valid_info = findValidInfo(ddl.getDataTypes(), type_name);
+            if (valid_info != nullptr) {
+                return valid_info;
+            }
+            auto dt = ddl.getDataTypes().access(type_name);
             auto info = dt->getInfo<ValidationInfo>();
             if (info == nullptr) {
                 dt->setInfo<ValidationInfo>(std::make_shared<ValidationInfo>(*dt, ddl));
@@ -900,6 +989,10 @@ const ValidationInfo* getOrCreateValidationInfo(const std::string type_name,
             return info;
         }
         else if (type_of_type == TypeOfType::enum_type) {
+            const auto valid_info = findValidInfo(ddl.getEnumTypes(), type_name);
+            if (valid_info != nullptr) {
+                return valid_info;
+            }
             auto et = ddl.getEnumTypes().access(type_name);
             auto info = et->getInfo<ValidationInfo>();
             if (info == nullptr) {
@@ -915,6 +1008,10 @@ const ValidationInfo* getOrCreateValidationInfo(const std::string type_name,
         }
     }
     if (type_of_type == TypeOfType::struct_type) {
+        const auto valid_info = findValidInfo(ddl.getStructTypes(), type_name);
+        if (valid_info != nullptr) {
+            return valid_info;
+        }
         auto st = ddl.getStructTypes().access(type_name);
         auto info = st->getInfo<ValidationInfo>();
         if (info == nullptr) {
@@ -930,6 +1027,10 @@ const ValidationInfo* getOrCreateValidationInfo(const std::string type_name,
         return info;
     }
     else if (with_stream_meta_type && type_of_type == TypeOfType::stream_meta_type) {
+        const auto valid_info = findValidInfo(ddl.getStreamMetaTypes(), type_name);
+        if (valid_info != nullptr) {
+            return valid_info;
+        }
         auto smt = ddl.getStreamMetaTypes().access(type_name);
         auto info = smt->getInfo<ValidationInfo>();
         if (info == nullptr) {
@@ -1305,14 +1406,19 @@ void ValidationInfo::update(datamodel::Stream& stream, datamodel::DataDefinition
 }
 
 namespace {
-std::vector<std::string> findInMapTo(const std::string& find_to_type,
-                                     const ValidationServiceInfo::ToFromMap& the_map)
+const std::unordered_set<std::string>* findInMapTo(
+    const std::string& find_to_type,
+    const std::unordered_map<uint8_t, ValidationServiceInfo::ToFromMap>& dependencies,
+    ValidationServiceInfo::DependencyType type)
 {
-    const auto& found_type_map = the_map.find(find_to_type);
-    if (found_type_map != the_map.end()) {
-        return found_type_map->second;
+    const auto& to_type_map = dependencies.find(type);
+    if (to_type_map != dependencies.end()) {
+        const auto& found_type_map = to_type_map->second.find(find_to_type);
+        if (found_type_map != to_type_map->second.end()) {
+            return &found_type_map->second;
+        }
     }
-    return {};
+    return nullptr;
 }
 } // namespace
 
@@ -1322,82 +1428,118 @@ ValidationServiceInfo::InvalidatedTypes ValidationServiceInfo::forceRevalidation
     datamodel::DataDefinition& parent_dd) const
 {
     ValidationServiceInfo::InvalidatedTypes invalidated_types_to_return;
+    // the struct types to start with, their users are found while walking the dependencies
     std::vector<std::string> invalidated_structs;
-    std::vector<std::string> invalidated_enums;
-    if (type == struct_type) {
-        const auto& to_struct_type_map = _dependencies.find(struct_type_to_struct_type);
-        if (to_struct_type_map != _dependencies.end()) {
-            invalidated_structs = findInMapTo(type_name, to_struct_type_map->second);
-            invalidated_types_to_return._struct_type_names = invalidated_structs;
+    auto add_structs = [&invalidated_structs](const std::unordered_set<std::string>* users) {
+        if (users) {
+            invalidated_structs.insert(invalidated_structs.end(), users->begin(), users->end());
         }
+    };
+    if (type == struct_type) {
+        add_structs(findInMapTo(type_name, *_dependencies, struct_type_to_struct_type));
     }
     else if (type == enum_type) {
-        const auto& to_struct_type_map = _dependencies.find(struct_type_to_enum_type);
-        if (to_struct_type_map != _dependencies.end()) {
-            invalidated_structs = findInMapTo(type_name, to_struct_type_map->second);
-            invalidated_types_to_return._struct_type_names = invalidated_structs;
-        }
+        add_structs(findInMapTo(type_name, *_dependencies, struct_type_to_enum_type));
     }
     else if (type == data_type) {
-        const auto& to_struct_type_map = _dependencies.find(struct_type_to_data_type);
-        if (to_struct_type_map != _dependencies.end()) {
-            invalidated_structs = findInMapTo(type_name, to_struct_type_map->second);
-            invalidated_types_to_return._struct_type_names = invalidated_structs;
-        }
-        const auto& to_enum_type_map = _dependencies.find(enum_type_to_data_type);
-        if (to_enum_type_map != _dependencies.end()) {
-            invalidated_enums = findInMapTo(type_name, to_enum_type_map->second);
-            invalidated_types_to_return._enum_type_names = invalidated_enums;
+        add_structs(findInMapTo(type_name, *_dependencies, struct_type_to_data_type));
+        // enum types only use data types, so they do not depend on each other
+        const auto enum_users = findInMapTo(type_name, *_dependencies, enum_type_to_data_type);
+        if (enum_users) {
+            for (const auto& current: *enum_users) {
+                auto enum_type = parent_dd.getEnumTypes().access(current);
+                if (enum_type) {
+                    auto info = enum_type->getInfo<ValidationInfo>();
+                    if (info) {
+                        info->forceRevalidation();
+                    }
+                    invalidated_types_to_return._enum_type_names.push_back(current);
+                    add_structs(findInMapTo(current, *_dependencies, struct_type_to_enum_type));
+                }
+            }
         }
     }
 
-    // set force invalid to the structs
-    for (const auto& current: invalidated_structs) {
-        auto struct_type = parent_dd.getStructTypes().access(current);
-        if (struct_type) {
-            auto info = struct_type->getInfo<ValidationInfo>();
-            if (info) {
-                if (info->isValid()) {
-                    info->forceRevalidation();
-                    auto invalidated_types = forceRevalidationOfTypeDependencies(
-                        struct_type->getName(), struct_type->getTypeOfType(), parent_dd);
-                    invalidated_types_to_return._enum_type_names.insert(
-                        invalidated_types_to_return._enum_type_names.end(),
-                        invalidated_types._enum_type_names.begin(),
-                        invalidated_types._enum_type_names.end());
-                    invalidated_types_to_return._struct_type_names.insert(
-                        invalidated_types_to_return._struct_type_names.end(),
-                        invalidated_types._struct_type_names.begin(),
-                        invalidated_types._struct_type_names.end());
+    // set force invalid to the structs and all structs using them (each only once), the depth
+    // first search returns the users of a struct before the struct itself, so the reversed order
+    // lists every struct after the structs it uses
+    std::unordered_set<std::string> visited_structs;
+    std::vector<std::pair<std::string, bool>> structs_to_visit;
+    for (auto current = invalidated_structs.rbegin(); current != invalidated_structs.rend();
+         ++current) {
+        structs_to_visit.emplace_back(*current, false);
+    }
+    auto& struct_type_names = invalidated_types_to_return._struct_type_names;
+    while (!structs_to_visit.empty()) {
+        auto current = std::move(structs_to_visit.back());
+        structs_to_visit.pop_back();
+        if (current.second) {
+            // all users are already listed
+            struct_type_names.push_back(std::move(current.first));
+            continue;
+        }
+        if (!visited_structs.insert(current.first).second) {
+            continue;
+        }
+        auto struct_type = parent_dd.getStructTypes().access(current.first);
+        if (!struct_type) {
+            continue;
+        }
+        auto info = struct_type->getInfo<ValidationInfo>();
+        if (info) {
+            info->forceRevalidation();
+        }
+        const auto users = findInMapTo(current.first, *_dependencies, struct_type_to_struct_type);
+        structs_to_visit.emplace_back(std::move(current.first), true);
+        if (users) {
+            for (const auto& user: *users) {
+                if (visited_structs.find(user) == visited_structs.end()) {
+                    structs_to_visit.emplace_back(user, false);
                 }
             }
         }
     }
+    std::reverse(struct_type_names.begin(), struct_type_names.end());
+    return invalidated_types_to_return;
+}
 
-    // set force invalid to the enums
-    for (const auto& current: invalidated_enums) {
-        auto enum_type = parent_dd.getEnumTypes().access(current);
-        if (enum_type) {
-            auto info = enum_type->getInfo<ValidationInfo>();
-            if (info) {
-                info->forceRevalidation();
-                if (info->isValid()) {
-                    info->forceRevalidation();
-                    auto invalidated_types = forceRevalidationOfTypeDependencies(
-                        enum_type->getName(), enum_type->getTypeOfType(), parent_dd);
-                    invalidated_types_to_return._enum_type_names.insert(
-                        invalidated_types_to_return._enum_type_names.end(),
-                        invalidated_types._enum_type_names.begin(),
-                        invalidated_types._enum_type_names.end());
-                    invalidated_types_to_return._struct_type_names.insert(
-                        invalidated_types_to_return._struct_type_names.end(),
-                        invalidated_types._struct_type_names.begin(),
-                        invalidated_types._struct_type_names.end());
-                }
+ValidationServiceInfo::InvalidatedTypes ValidationServiceInfo::getDependentTypes(
+    const std::string& type_name, ddl::dd::TypeOfType type) const
+{
+    ValidationServiceInfo::InvalidatedTypes dependent_types;
+    std::vector<std::string> structs_to_visit;
+    auto add_structs = [&structs_to_visit](const std::unordered_set<std::string>* users) {
+        if (users) {
+            structs_to_visit.insert(structs_to_visit.end(), users->begin(), users->end());
+        }
+    };
+    if (type == struct_type) {
+        add_structs(findInMapTo(type_name, *_dependencies, struct_type_to_struct_type));
+    }
+    else if (type == enum_type) {
+        add_structs(findInMapTo(type_name, *_dependencies, struct_type_to_enum_type));
+    }
+    else if (type == data_type) {
+        add_structs(findInMapTo(type_name, *_dependencies, struct_type_to_data_type));
+        const auto enum_users = findInMapTo(type_name, *_dependencies, enum_type_to_data_type);
+        if (enum_users) {
+            for (const auto& current: *enum_users) {
+                dependent_types._enum_type_names.push_back(current);
+                add_structs(findInMapTo(current, *_dependencies, struct_type_to_enum_type));
             }
         }
     }
-    return invalidated_types_to_return;
+
+    std::unordered_set<std::string> visited_structs;
+    while (!structs_to_visit.empty()) {
+        auto current = std::move(structs_to_visit.back());
+        structs_to_visit.pop_back();
+        if (visited_structs.insert(current).second) {
+            add_structs(findInMapTo(current, *_dependencies, struct_type_to_struct_type));
+            dependent_types._struct_type_names.push_back(std::move(current));
+        }
+    }
+    return dependent_types;
 }
 
 } // namespace dd
@@ -0,0 +1,831 @@
+/**
+ * @file
+ * OO DataDefinition binary cache
+ *
+ * Copyright @ 2021 VW Group. All rights reserved.
+ *
+ *     This Source Code Form is subject to the terms of the Mozilla
+ *     Public License, v. 2.0. If a copy of the MPL was not distributed
+ *     with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * If it is not possible or desirable to put the notice in a particular file, then
+ * You may include the notice in a location (such as a LICENSE file in a
+ * relevant directory) where a recipient would be likely to look for such a notice.
+ *
+ * You may add additional accurate notices of copyright ownership.
+ */
+
+#include "ddl/dd/ddbinary.h"
+
+#include "ddl/dd/dd_typeinfomodel.h"
+#include "ddl/dd/dd_validationinfomodel.h"
+#include "ddl/dd/ddstring.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+namespace ddl {
+
+namespace detail {
+
+/**
+ * Appends values in the byte order of the platform.
+ */
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::vector<uint8_t>& data) : _data(data)
+    {
+    }
+
+    template <typename T>
+    void write(T value)
+    {
+        const size_t pos = _data.size();
+        _data.resize(pos + sizeof(T));
+        std::memcpy(&_data[pos], &value, sizeof(T));
+    }
+
+    /// sizes are written as variable length quantity, 7 bits per byte
+    void writeSize(size_t value)
+    {
+        while (value >= 0x80) {
+            _data.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        _data.push_back(static_cast<uint8_t>(value));
+    }
+
+    void writeBool(bool value)
+    {
+        write<uint8_t>(value ? 1 : 0);
+    }
+
+    void writeString(const std::string& value)
+    {
+        writeSize(value.size());
+        _data.insert(_data.end(), value.begin(), value.end());
+    }
+
+    void writeOptional(const dd::OptionalSize& value)
+    {
+        writeBool(value);
+        if (value) {
+            writeSize(*value);
+        }
+    }
+
+    void writeVersion(const dd::Version& value)
+    {
+        write<uint32_t>(value.getMajor());
+        write<uint32_t>(value.getMinor());
+    }
+
+private:
+    std::vector<uint8_t>& _data;
+};
+
+/**
+ * Reads the values written by the BinaryWriter, throws if the data ends unexpectedly.
+ */
+class BinaryReader {
+public:
+    BinaryReader(const void* data, size_t data_size)
+        : _data(static_cast<const uint8_t*>(data)), _data_size(data_size), _pos(0)
+    {
+    }
+
+    template <typename T>
+    T read()
+    {
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    size_t readSize()
+    {
+        size_t value = 0;
+        for (size_t shift = 0; shift < std::numeric_limits<size_t>::digits; shift += 7) {
+            const uint8_t byte = *take(1);
+            value |= static_cast<size_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw dd::Error("DDBinary::fromBinary", "The binary data contains an invalid size");
+    }
+
+    /// reads the amount of following items, each of them needs at least one byte
+    size_t readCount()
+    {
+        const size_t count = readSize();
+        if (count > _data_size - _pos) {
+            throw dd::Error("DDBinary::fromBinary", "The binary data contains an invalid count");
+        }
+        return count;
+    }
+
+    bool readBool()
+    {
+        return read<uint8_t>() != 0;
+    }
+
+    std::string readString()
+    {
+        const size_t size = readSize();
+        return std::string(reinterpret_cast<const char*>(take(size)), size);
+    }
+
+    dd::OptionalSize readOptional()
+    {
+        if (readBool()) {
+            return readSize();
+        }
+        return {};
+    }
+
+    dd::Version readVersion()
+    {
+        const uint32_t major = read<uint32_t>();
+        const uint32_t minor = read<uint32_t>();
+        return dd::Version(major, minor);
+    }
+
+    const uint8_t* take(size_t size)
+    {
+        if (size > _data_size - _pos) {
+            throw dd::Error("DDBinary::fromBinary", "The binary data is truncated");
+        }
+        const uint8_t* current = _data + _pos;
+        _pos += size;
+        return current;
+    }
+
+    bool atEnd() const
+    {
+        return _pos == _data_size;
+    }
+
+private:
+    const uint8_t* _data;
+    size_t _data_size;
+    size_t _pos;
+};
+
+} // namespace detail
+
+namespace {
+
+using detail::BinaryReader;
+using detail::BinaryWriter;
+using namespace dd;
+
+/// "DDLB" in the byte order of the platform, data of the other byte order is rejected
+constexpr uint32_t binary_magic = 0x424c4444;
+constexpr uint64_t fnv_offset_basis = 0xcbf29ce484222325ULL;
+constexpr uint64_t fnv_prime = 0x100000001b3ULL;
+/// magic, format version, source hash, payload size and payload hash
+constexpr size_t binary_header_size = 4 + 4 + 8 + 8 + 8;
+
+uint64_t hashFNV1a(const void* data, size_t data_size, uint64_t hash)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t index = 0; index < data_size; ++index) {
+        hash = (hash ^ bytes[index]) * fnv_prime;
+    }
+    return hash;
+}
+
+void writeModel(BinaryWriter& writer, const datamodel::DataDefinition& ddl_model)
+{
+    writer.writeBool(ddl_model.isEmpty());
+    const auto& header = *ddl_model.getHeader();
+    writer.writeVersion(header.getLanguageVersion());
+    writer.writeString(header.getAuthor());
+    writer.writeString(header.getDateCreation());
+    writer.writeString(header.getDateChange());
+    writer.writeString(header.getDescription());
+    writer.writeSize(header.getExtDeclarations().getSize());
+    for (const auto& ext: header.getExtDeclarations()) {
+        writer.writeString(ext.second->getKey());
+        writer.writeString(ext.second->getValue());
+    }
+
+    writer.writeSize(ddl_model.getBaseUnits().getSize());
+    for (const auto& base_unit: ddl_model.getBaseUnits()) {
+        writer.writeString(base_unit.second->getName());
+        writer.writeString(base_unit.second->getSymbol());
+        writer.writeString(base_unit.second->getDescription());
+    }
+    writer.writeSize(ddl_model.getUnitPrefixes().getSize());
+    for (const auto& unit_prefix: ddl_model.getUnitPrefixes()) {
+        writer.writeString(unit_prefix.second->getName());
+        writer.writeString(unit_prefix.second->getSymbol());
+        writer.write<int32_t>(unit_prefix.second->getPower());
+    }
+    writer.writeSize(ddl_model.getUnits().getSize());
+    for (const auto& unit: ddl_model.getUnits()) {
+        writer.writeString(unit.second->getName());
+        writer.writeString(unit.second->getNumerator());
+        writer.writeString(unit.second->getDenominator());
+        writer.writeString(unit.second->getOffset());
+        writer.writeSize(unit.second->getRefUnits().size());
+        for (const auto& ref_unit: unit.second->getRefUnits()) {
+            writer.writeString(ref_unit.getUnitName());
+            writer.write<int32_t>(ref_unit.getPower());
+            writer.writeString(ref_unit.getPrefixName());
+        }
+    }
+
+    writer.writeSize(ddl_model.getDataTypes().getSize());
+    for (const auto& data_type: ddl_model.getDataTypes()) {
+        writer.writeString(data_type.second->getName());
+        writer.writeSize(data_type.second->getBitSize());
+        writer.writeString(data_type.second->getDescription());
+        writer.writeOptional(data_type.second->getArraySize());
+        writer.writeString(data_type.second->getUnitName());
+        writer.writeString(data_type.second->getMin());
+        writer.writeString(data_type.second->getMax());
+        writer.writeOptional(data_type.second->getDefaultAlignment());
+    }
+    writer.writeSize(ddl_model.getEnumTypes().getSize());
+    for (const auto& enum_type: ddl_model.getEnumTypes()) {
+        writer.writeString(enum_type.second->getName());
+        writer.writeString(enum_type.second->getDataTypeName());
+        writer.writeSize(enum_type.second->getElements().getSize());
+        for (const auto& enum_element: enum_type.second->getElements()) {
+            writer.writeString(enum_element.second->getName());
+            writer.writeString(enum_element.second->getValue());
+        }
+    }
+    writer.writeSize(ddl_model.getStructTypes().getSize());
+    for (const auto& struct_type: ddl_model.getStructTypes()) {
+        writer.writeString(struct_type.second->getName());
+        writer.writeString(struct_type.second->getVersion());
+        writer.writeOptional(struct_type.second->getAlignment());
+        writer.writeString(struct_type.second->getComment());
+        writer.writeVersion(struct_type.second->getLanguageVersion());
+        writer.writeSize(struct_type.second->getElements().getSize());
+        for (const auto& element: struct_type.second->getElements()) {
+            writer.writeString(element->getName());
+            writer.writeString(element->getTypeName());
+            writer.writeSize(element->getAlignment());
+            writer.writeOptional(element->getBytePos());
+            writer.write<int32_t>(element->getByteOrder());
+            writer.writeOptional(element->getBitPos());
+            writer.writeOptional(element->getNumBits());
+            const auto& array_size = element->getArraySize();
+            writer.writeBool(array_size.isDynamicArraySize());
+            if (array_size.isDynamicArraySize()) {
+                writer.writeString(array_size.getArraySizeElementName());
+            }
+            else {
+                writer.writeSize(array_size.getArraySizeValue());
+            }
+            writer.writeString(element->getDescription());
+            writer.writeString(element->getComment());
+            writer.writeString(element->getUnitName());
+            writer.writeString(element->getValue());
+            writer.writeString(element->getMin());
+            writer.writeString(element->getMax());
+            writer.writeString(element->getDefault());
+            writer.writeString(element->getScale());
+            writer.writeString(element->getOffset());
+        }
+    }
+
+    writer.writeSize(ddl_model.getStreamMetaTypes().getSize());
+    for (const auto& stream_meta_type: ddl_model.getStreamMetaTypes()) {
+        writer.writeString(stream_meta_type.second->getName());
+        writer.writeString(stream_meta_type.second->getVersion());
+        writer.writeString(stream_meta_type.second->getParent());
+        writer.writeSize(stream_meta_type.second->getProperties().getSize());
+        for (const auto& property: stream_meta_type.second->getProperties()) {
+            writer.writeString(property.second->getName());
+            writer.writeString(property.second->getType());
+        }
+    }
+    writer.writeSize(ddl_model.getStreams().getSize());
+    for (const auto& stream: ddl_model.getStreams()) {
+        writer.writeString(stream.second->getName());
+        writer.writeString(stream.second->getStreamTypeName());
+        writer.writeString(stream.second->getDescription());
+        writer.writeSize(stream.second->getStructs().getSize());
+        for (const auto& stream_struct: stream.second->getStructs()) {
+            writer.writeString(stream_struct->getName());
+            writer.writeString(stream_struct->getTypeName());
+            writer.writeOptional(stream_struct->getBytePos());
+        }
+    }
+}
+
+std::shared_ptr<datamodel::DataDefinition> readModel(BinaryReader& reader)
+{
+    const bool is_empty = reader.readBool();
+    const Version language_version = reader.readVersion();
+    const std::string author = reader.readString();
+    const std::string date_creation = reader.readString();
+    const std::string date_change = reader.readString();
+    const std::string description = reader.readString();
+    std::vector<datamodel::Header::ExtDeclaration> exts;
+    for (size_t count = reader.readCount(); count > 0; --count) {
+        const std::string key = reader.readString();
+        exts.emplace_back(key, reader.readString());
+    }
+    auto ddl_model = std::make_shared<datamodel::DataDefinition>(language_version);
+    if (!is_empty) {
+        ddl_model->setHeader(datamodel::Header(
+            language_version, author, date_creation, date_change, description, exts));
+    }
+
+    for (size_t count = reader.readCount(); count > 0; --count) {
+        const std::string name = reader.readString();
+        const std::string symbol = reader.readString();
+        ddl_model->getBaseUnits().emplace(datamodel::BaseUnit(name, symbol, reader.readString()));
+    }
+    for (size_t count = reader.readCount(); count > 0; --count) {
+        const std::string name = reader.readString();
+        const std::string symbol = reader.readString();
+        ddl_model->getUnitPrefixes().emplace(
+            datamodel::UnitPrefix(name, symbol, reader.read<int32_t>()));
+    }
+    for (size_t count = reader.readCount(); count > 0; --count) {
+        const std::string name = reader.readString();
+        const std::string numerator = reader.readString();
+        const std::string denominator = reader.readString();
+        const std::string offset = reader.readString();
+        std::vector<datamodel::Unit::RefUnit> ref_units;
+        for (size_t ref_count = reader.readCount(); ref_count > 0; --ref_count) {
+            const std::string unit_name = reader.readString();
+            const int32_t power = reader.read<int32_t>();
+            ref_units.emplace_back(unit_name, power, reader.readString());
+        }
+        ddl_model->getUnits().emplace(
+            datamodel::Unit(name, numerator, denominator, offset, ref_units));
+    }
+
+    for (size_t count = reader.readCount(); count > 0; --count) {
+        const std::string name = reader.readString();
+        const size_t bit_size = reader.readSize();
+        const std::string type_description = reader.readString();
+        const OptionalSize array_size = reader.readOptional();
+        const std::string unit_name = reader.readString();
+        const std::string minimum_value = reader.readString();
+        const std::string maximum_value = reader.readString();
+        ddl_model->getDataTypes().emplace(datamodel::DataType(name,
+                                                             bit_size,
+                                                             type_description,
+                                                             array_size,
+                                                             unit_name,
+                                                             minimum_value,
+                                                             maximum_value,
+                                                             reader.readOptional()));
+    }
+    for (size_t count = reader.readCount(); count > 0; --count) {
+        const std::string name = reader.readString();
+        datamodel::EnumType enum_type(name, reader.readString());
+        for (size_t element_count = reader.readCount(); element_count > 0; --element_count) {
+            const std::string element_name = reader.readString();
+            enum_type.getElements().emplace(
+                datamodel::EnumType::Element(element_name, reader.readString()));
+        }
+        ddl_model->getEnumTypes().emplace(std::move(enum_type));
+    }
+    for (size_t count = reader.readCount(); count > 0; --count) {
+        const std::string name = reader.readString();
+        const std::string struct_version = reader.readString();
+        const OptionalSize alignment = reader.readOptional();
+        const std::string comment = reader.readString();
+        datamodel::StructType struct_type(
+            name, struct_version, alignment, comment, reader.readVersion());
+        for (size_t element_count = reader.readCount(); element_count > 0; --element_count) {
+            const std::string element_name = reader.readString();
+            const std::string type_name = reader.readString();
+            const size_t element_alignment = reader.readSize();
+            const OptionalSize byte_pos = reader.readOptional();
+            const auto byte_order = static_cast<ByteOrder>(reader.read<int32_t>());
+            const OptionalSize bit_pos = reader.readOptional();
+            const OptionalSize num_bits = reader.readOptional();
+            ArraySize array_size;
+            if (reader.readBool()) {
+                array_size = reader.readString();
+            }
+            else {
+                array_size = reader.readSize();
+            }
+            const std::string element_description = reader.readString();
+            const std::string element_comment = reader.readString();
+            const std::string unit_name = reader.readString();
+            const std::string value = reader.readString();
+            const std::string minimum_value = reader.readString();
+            const std::string maximum_value = reader.readString();
+            const std::string default_value = reader.readString();
+            const std::string scale = reader.readString();
+            struct_type.getElements().emplace(datamodel::StructType::Element(
+                element_name,
+                type_name,
+                datamodel::StructType::DeserializedInfo(element_alignment),
+                datamodel::StructType::SerializedInfo(byte_pos, byte_order, bit_pos, num_bits),
+                array_size,
+                element_description,
+                element_comment,
+                unit_name,
+                value,
+                minimum_value,
+                maximum_value,
+                default_value,
+                scale,
+                reader.readString()));
+        }
+        ddl_model->getStructTypes().emplace(std::move(struct_type));
+    }
+
+    for (size_t count = reader.readCount(); count > 0; --count) {
+        const std::string name = reader.readString();
+        const std::string meta_type_version = reader.readString();
+        datamodel::StreamMetaType stream_meta_type(name, meta_type_version, reader.readString());
+        for (size_t property_count = reader.readCount(); property_count > 0; --property_count) {
+            const std::string property_name = reader.readString();
+            stream_meta_type.getProperties().emplace(
+                datamodel::StreamMetaType::Property(property_name, reader.readString()));
+        }
+        ddl_model->getStreamMetaTypes().emplace(std::move(stream_meta_type));
+    }
+    for (size_t count = reader.readCount(); count > 0; --count) {
+        const std::string name = reader.readString();
+        const std::string stream_type_name = reader.readString();
+        datamodel::Stream stream(name, stream_type_name, reader.readString());
+        for (size_t struct_count = reader.readCount(); struct_count > 0; --struct_count) {
+            const std::string struct_name = reader.readString();
+            const std::string struct_type_name = reader.readString();
+            stream.getStructs().emplace(
+                datamodel::Stream::Struct(struct_name, struct_type_name, reader.readOptional()));
+        }
+        ddl_model->getStreams().emplace(std::move(stream));
+    }
+    return ddl_model;
+}
+
+template <typename CONTAINER>
+auto accessItem(CONTAINER& container, const std::string& name) -> decltype(container.access(name))
+{
+    auto item = container.access(name);
+    if (!item) {
+        throw dd::Error(
+            "DDBinary::fromBinary", {name}, "The binary data refers to an unknown item");
+    }
+    return item;
+}
+
+/// resolves the type of an element like the offset calculation does
+datamodel::ElementType resolveElementType(const std::string& type_name,
+                                          datamodel::DataDefinition& ddl_model)
+{
+    datamodel::ElementType element_type;
+    if (type_name.empty()) {
+        return element_type;
+    }
+    element_type._type_of_type = ddl_model.getTypeOfType(type_name);
+    if (element_type._type_of_type == TypeOfType::data_type) {
+        element_type._data_type = ddl_model.getDataTypes().access(type_name);
+    }
+    else if (element_type._type_of_type == TypeOfType::enum_type) {
+        element_type._enum_type = ddl_model.getEnumTypes().access(type_name);
+        element_type._data_type =
+            ddl_model.getDataTypes().access(element_type._enum_type->getDataTypeName());
+    }
+    else if (element_type._type_of_type == TypeOfType::struct_type) {
+        element_type._struct_type = ddl_model.getStructTypes().access(type_name);
+    }
+    return element_type;
+}
+
+} // namespace
+
+void DDBinary::writeInfos(BinaryWriter& writer, const datamodel::DataDefinition& ddl_model)
+{
+    const auto write_validation_info = [&writer](const datamodel::InfoMap& item) {
+        const auto info = item.getInfo<ValidationInfo>();
+        writer.writeBool(info != nullptr);
+        if (info) {
+            writer.write<uint8_t>(info->_valid);
+            writer.writeSize(info->_validation_problems.size());
+            for (const auto& problem: info->_validation_problems) {
+                writer.writeString(problem.item_name);
+                writer.writeString(problem.problem_message);
+            }
+        }
+    };
+    const auto write_type_info = [&writer](const datamodel::InfoMap& item) {
+        const auto info = item.getInfo<TypeInfo>();
+        writer.writeBool(info != nullptr);
+        if (info) {
+            writer.writeSize(info->_type_bit_size);
+            writer.writeSize(info->_type_alignment);
+            writer.writeSize(info->_type_byte_size);
+            writer.writeSize(info->_type_aligned_byte_size);
+            writer.writeSize(info->_type_unaligned_byte_size);
+            writer.writeBool(info->_is_dynamic);
+            writer.writeBool(info->_is_valid);
+        }
+    };
+    const auto write_element_type_info = [&writer](const datamodel::InfoMap& item) {
+        const auto info = item.getInfo<ElementTypeInfo>();
+        writer.writeBool(info != nullptr);
+        if (info) {
+            writer.writeOptional(info->_deserialized_byte_pos);
+            writer.writeOptional(info->_deserialized_byte_size);
+            writer.writeSize(info->_deserialized_type_byte_size);
+            writer.writeSize(info->_deserialized_type_aligned_byte_size);
+            writer.writeOptional(info->_serialized_byte_pos);
+            writer.writeOptional(info->_serialized_absolute_bit_offset);
+            writer.writeOptional(info->_serialized_bit_size);
+            writer.writeSize(info->_serialized_type_bit_size);
+            writer.writeBool(info->_is_dynamic);
+            writer.writeBool(info->_is_after_dynamic);
+            writer.writeBool(info->_is_valid);
+        }
+    };
+
+    writer.writeSize(ddl_model.getUnits().getSize());
+    for (const auto& unit: ddl_model.getUnits()) {
+        writer.writeString(unit.first);
+        write_validation_info(*unit.second);
+    }
+    writer.writeSize(ddl_model.getDataTypes().getSize());
+    for (const auto& data_type: ddl_model.getDataTypes()) {
+        writer.writeString(data_type.first);
+        write_validation_info(*data_type.second);
+        write_type_info(*data_type.second);
+    }
+    writer.writeSize(ddl_model.getEnumTypes().getSize());
+    for (const auto& enum_type: ddl_model.getEnumTypes()) {
+        writer.writeString(enum_type.first);
+        write_validation_info(*enum_type.second);
+        write_type_info(*enum_type.second);
+    }
+    writer.writeSize(ddl_model.getStructTypes().getSize());
+    for (const auto& struct_type: ddl_model.getStructTypes()) {
+        writer.writeString(struct_type.first);
+        write_validation_info(*struct_type.second);
+        write_type_info(*struct_type.second);
+        for (const auto& element: struct_type.second->getElements()) {
+            write_element_type_info(*element);
+        }
+    }
+    writer.writeSize(ddl_model.getStreamMetaTypes().getSize());
+    for (const auto& stream_meta_type: ddl_model.getStreamMetaTypes()) {
+        writer.writeString(stream_meta_type.first);
+        write_validation_info(*stream_meta_type.second);
+    }
+    writer.writeSize(ddl_model.getStreams().getSize());
+    for (const auto& stream: ddl_model.getStreams()) {
+        writer.writeString(stream.first);
+        write_validation_info(*stream.second);
+    }
+
+    // the dependencies are needed to revalidate the dependent types on later changes
+    const auto service_info = ddl_model.getInfo<ValidationServiceInfo>();
+    writer.writeBool(service_info != nullptr);
+    if (service_info) {
+        writer.writeBool(service_info->_validation_needed);
+        writer.writeSize(service_info->_dependencies->size());
+        for (const auto& dependencies: *service_info->_dependencies) {
+            writer.write<uint8_t>(dependencies.first);
+            writer.writeSize(dependencies.second.size());
+            for (const auto& to_from: dependencies.second) {
+                writer.writeString(to_from.first);
+                writer.writeSize(to_from.second.size());
+                for (const auto& from: to_from.second) {
+                    writer.writeString(from);
+                }
+            }
+        }
+    }
+}
+
+void DDBinary::readInfos(BinaryReader& reader, datamodel::DataDefinition& ddl_model)
+{
+    const auto read_validation_info = [&reader](datamodel::InfoMap& item) {
+        if (!reader.readBool()) {
+            return;
+        }
+        auto info = std::make_shared<ValidationInfo>();
+        const uint8_t level = reader.read<uint8_t>();
+        if (level > ValidationInfo::ValidationLevel::valid) {
+            throw dd::Error("DDBinary::fromBinary", "The binary data is corrupt");
+        }
+        info->_valid = static_cast<ValidationInfo::ValidationLevel>(level);
+        for (size_t count = reader.readCount(); count > 0; --count) {
+            ValidationInfo::Problem problem;
+            problem.item_name = reader.readString();
+            problem.problem_message = reader.readString();
+            info->_validation_problems.push_back(std::move(problem));
+        }
+        item.setInfo(info);
+    };
+    const auto read_type_info = [&reader](datamodel::InfoMap& item) {
+        if (!reader.readBool()) {
+            return;
+        }
+        auto info = std::make_shared<TypeInfo>();
+        info->_type_bit_size = reader.readSize();
+        info->_type_alignment = reader.readSize();
+        info->_type_byte_size = reader.readSize();
+        info->_type_aligned_byte_size = reader.readSize();
+        info->_type_unaligned_byte_size = reader.readSize();
+        info->_is_dynamic = reader.readBool();
+        info->_is_valid = reader.readBool();
+        item.setInfo(info);
+    };
+    const auto read_element_type_info = [&reader, &ddl_model](
+                                            datamodel::StructType::Element& element) {
+        if (!reader.readBool()) {
+            return;
+        }
+        auto info = std::make_shared<ElementTypeInfo>();
+        info->_deserialized_byte_pos = reader.readOptional();
+        info->_deserialized_byte_size = reader.readOptional();
+        info->_deserialized_type_byte_size = reader.readSize();
+        info->_deserialized_type_aligned_byte_size = reader.readSize();
+        info->_serialized_byte_pos = reader.readOptional();
+        info->_serialized_absolute_bit_offset = reader.readOptional();
+        info->_serialized_bit_size = reader.readOptional();
+        info->_serialized_type_bit_size = reader.readSize();
+        info->_is_dynamic = reader.readBool();
+        info->_is_after_dynamic = reader.readBool();
+        info->_is_valid = reader.readBool();
+        info->_element_type = resolveElementType(element.getTypeName(), ddl_model);
+        element.setInfo(info);
+    };
+
+    for (size_t count = reader.readCount(); count > 0; --count) {
+        read_validation_info(*accessItem(ddl_model.getUnits(), reader.readString()));
+    }
+    for (size_t count = reader.readCount(); count > 0; --count) {
+        auto data_type = accessItem(ddl_model.getDataTypes(), reader.readString());
+        read_validation_info(*data_type);
+        read_type_info(*data_type);
+    }
+    for (size_t count = reader.readCount(); count > 0; --count) {
+        auto enum_type = accessItem(ddl_model.getEnumTypes(), reader.readString());
+        read_validation_info(*enum_type);
+        read_type_info(*enum_type);
+    }
+    for (size_t count = reader.readCount(); count > 0; --count) {
+        auto struct_type = accessItem(ddl_model.getStructTypes(), reader.readString());
+        read_validation_info(*struct_type);
+        read_type_info(*struct_type);
+        for (auto& element: struct_type->getElements()) {
+            read_element_type_info(*element);
+        }
+    }
+    for (size_t count = reader.readCount(); count > 0; --count) {
+        read_validation_info(*accessItem(ddl_model.getStreamMetaTypes(), reader.readString()));
+    }
+    for (size_t count = reader.readCount(); count > 0; --count) {
+        read_validation_info(*accessItem(ddl_model.getStreams(), reader.readString()));
+    }
+
+    if (reader.readBool()) {
+        auto service_info = std::make_shared<ValidationServiceInfo>();
+        service_info->_validation_needed = reader.readBool();
+        for (size_t count = reader.readCount(); count > 0; --count) {
+            const auto type =
+                static_cast<ValidationServiceInfo::DependencyType>(reader.read<uint8_t>());
+            for (size_t to_count = reader.readCount(); to_count > 0; --to_count) {
+                const auto to = reader.readString();
+                for (size_t from_count = reader.readCount(); from_count > 0; --from_count) {
+                    service_info->addDependency({type, reader.readString(), to});
+                }
+            }
+        }
+        ddl_model.setInfo(service_info);
+    }
+}
+
+uint64_t DDBinary::hashSource(const void* data, size_t data_size)
+{
+    return hashFNV1a(data, data_size, fnv_offset_basis);
+}
+
+std::vector<uint8_t> DDBinary::toBinary(const dd::DataDefinition& ddl_to_write,
+                                        uint64_t source_hash)
+{
+    std::vector<uint8_t> data(binary_header_size);
+    BinaryWriter writer(data);
+    writeModel(writer, *ddl_to_write.getModel());
+    writeInfos(writer, *ddl_to_write.getModel());
+
+    // the header is written last, it contains the size and the hash of the payload
+    std::vector<uint8_t> header;
+    BinaryWriter header_writer(header);
+    header_writer.write<uint32_t>(binary_magic);
+    header_writer.write<uint32_t>(format_version);
+    header_writer.write<uint64_t>(source_hash);
+    header_writer.write<uint64_t>(data.size() - binary_header_size);
+    header_writer.write<uint64_t>(hashSource(data.data() + binary_header_size,
+                                             data.size() - binary_header_size));
+    std::memcpy(data.data(), header.data(), binary_header_size);
+    return data;
+}
+
+dd::DataDefinition DDBinary::fromBinary(const void* data, size_t data_size, uint64_t source_hash)
+{
+    BinaryReader reader(data, data_size);
+    if (data_size < binary_header_size || reader.read<uint32_t>() != binary_magic ||
+        reader.read<uint32_t>() != format_version || reader.read<uint64_t>() != source_hash) {
+        throw dd::Error("DDBinary::fromBinary", "The binary data is stale");
+    }
+    const uint64_t payload_size = reader.read<uint64_t>();
+    const uint64_t payload_hash = reader.read<uint64_t>();
+    if (payload_size != data_size - binary_header_size ||
+        payload_hash != hashSource(static_cast<const uint8_t*>(data) + binary_header_size,
+                                   data_size - binary_header_size)) {
+        throw dd::Error("DDBinary::fromBinary", "The binary data is corrupt");
+    }
+
+    auto created_datamodel = readModel(reader);
+    // the infos are restored before the model is set, so it is neither validated nor are the
+    // positions calculated again
+    readInfos(reader, *created_datamodel);
+    if (!reader.atEnd()) {
+        throw dd::Error("DDBinary::fromBinary", "The binary data is corrupt");
+    }
+
+    dd::DataDefinition created_dd;
+    created_dd.setModel(created_datamodel);
+    return created_dd;
+}
+
+void DDBinary::toBinaryFile(const dd::DataDefinition& ddl_to_write,
+                            uint64_t source_hash,
+                            const std::string& binary_filepath)
+{
+    const std::vector<uint8_t> data = toBinary(ddl_to_write, source_hash);
+    std::ofstream binary_file(binary_filepath, std::ios::binary | std::ios::trunc);
+    binary_file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    if (!binary_file) {
+        throw dd::Error("DDBinary::toBinaryFile", {binary_filepath}, "could not be written");
+    }
+}
+
+dd::DataDefinition DDBinary::fromBinaryFile(const std::string& binary_filepath,
+                                            uint64_t source_hash)
+{
+    std::ifstream binary_file(binary_filepath, std::ios::binary);
+    if (!binary_file) {
+        throw dd::Error("DDBinary::fromBinaryFile", {binary_filepath}, "could not be read");
+    }
+    const std::vector<char> data((std::istreambuf_iterator<char>(binary_file)),
+                                 std::istreambuf_iterator<char>());
+    if (binary_file.bad()) {
+        throw dd::Error("DDBinary::fromBinaryFile", {binary_filepath}, "could not be read");
+    }
+    return fromBinary(data.data(), data.size(), source_hash);
+}
+
+dd::DataDefinition DDBinary::fromXMLFileCached(const std::string& xml_filepath,
+                                               const std::string& cache_filepath,
+                                               bool strict)
+{
+    std::ifstream xml_file(xml_filepath, std::ios::binary);
+    if (!xml_file) {
+        throw dd::Error("DDBinary::fromXMLFileCached", {xml_filepath}, "could not be read");
+    }
+    const std::string xml_content((std::istreambuf_iterator<char>(xml_file)),
+                                  std::istreambuf_iterator<char>());
+    // the strict mode changes the loaded model, so it is part of the hash
+    const uint8_t strict_flag = strict ? 1 : 0;
+    const uint64_t source_hash =
+        hashFNV1a(&strict_flag, 1, hashSource(xml_content.data(), xml_content.size()));
+
+    try {
+        return fromBinaryFile(cache_filepath, source_hash);
+    }
+    catch (const dd::Error&) {
+        // missing, stale or corrupt, the xml file is loaded
+    }
+
+    // the content is parsed as read, so the cache is written for exactly the hashed content
+    // even if the file changes meanwhile
+    dd::DataDefinition loaded_dd;
+    try {
+        loaded_dd = DDString::fromXMLString(xml_content, dd::Version::ddl_version_notset, strict);
+    }
+    catch (const dd::Error& error) {
+        throw dd::Error(
+            "DDBinary::fromXMLFileCached", {xml_filepath}, error.what(), error.problems());
+    }
+    try {
+        toBinaryFile(loaded_dd, source_hash, cache_filepath);
+    }
+    catch (const dd::Error&) {
+        // the cache is optional, it is written again on the next load
+    }
+    return loaded_dd;
+}
+
+} // namespace ddl
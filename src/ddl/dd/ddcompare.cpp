@@ -67,6 +67,39 @@ _MAKE_RESULT(-38, ERR_FAILED);
 
 #define CHECK_OPTIONAL(__name, __attr) COMPARE(__name, get##__attr)
 
+namespace {
+/**
+ * Checks whether the fingerprints of both struct types are available and equal. Then the detailed
+ * comparison would not find any difference and is only needed to describe differences.
+ */
+bool haveEqualFingerprints(const dd::StructType& struct_type1,
+                           const dd::DataDefinition& source_ddl_of_type1,
+                           const dd::StructType& struct_type2,
+                           const dd::DataDefinition& source_ddl_of_type2,
+                           dd::TypeFingerprintCache::Kind kind)
+{
+    const auto get_fingerprint = [kind](const dd::StructType& struct_type,
+                                        const dd::DataDefinition& source_ddl) {
+        const auto type_info = struct_type.getInfo<dd::TypeInfo>();
+        // the fingerprint is calculated within the description the struct type belongs to
+        if (type_info == nullptr ||
+            source_ddl.getStructTypes().get(struct_type.getName()).get() != &struct_type) {
+            return dd::OptionalTypeFingerprint();
+        }
+        const auto& model = *source_ddl.getModel();
+        return kind == dd::TypeFingerprintCache::layout ?
+                   type_info->getLayoutFingerprint(struct_type, model) :
+                   type_info->getFullFingerprint(struct_type, model);
+    };
+    const auto fingerprint1 = get_fingerprint(struct_type1, source_ddl_of_type1);
+    if (!fingerprint1) {
+        return false;
+    }
+    const auto fingerprint2 = get_fingerprint(struct_type2, source_ddl_of_type2);
+    return fingerprint2 && *fingerprint1 == *fingerprint2;
+}
+} // namespace
+
 template <typename T>
 static a_util::result::Result CompareSizes(
     const T& vec1, const T& vec2, uint32_t flags, const std::string& name, uint32_t subset_flags)
@@ -208,6 +241,14 @@ a_util::result::Result DDCompare::isBinaryEqual(const std::string& type1,
                                  ("Unable to find definitions for struct " + type2).c_str());
     }
 
+    if (haveEqualFingerprints(struct1_access.getStructType(),
+                              desc1,
+                              struct2_access.getStructType(),
+                              desc2,
+                              dd::TypeFingerprintCache::layout)) {
+        return a_util::result::SUCCESS;
+    }
+
     StructLayout layout1(struct1_access);
     StructLayout layout2(struct2_access);
 
@@ -436,6 +477,14 @@ a_util::result::Result DDCompare::isEqual(const dd::StructType& ddl_struct1,
                                           const dd::DataDefinition& source_ddl_of_type2,
                                           uint32_t flags)
 {
+    if (haveEqualFingerprints(ddl_struct1,
+                              source_ddl_of_type1,
+                              ddl_struct2,
+                              source_ddl_of_type2,
+                              dd::TypeFingerprintCache::full)) {
+        return a_util::result::SUCCESS;
+    }
+
     CHECK_NAMES(ddl_struct, "struct")
 
     if ((flags & DDCompare::icf_versions) && ddl_struct1.getVersion() != ddl_struct2.getVersion()) {
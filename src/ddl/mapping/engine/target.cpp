@@ -21,6 +21,7 @@
 #include "ddl/legacy_error_macros.h"
 #include "ddl/mapping/configuration/map_configuration.h"
 
+#include <algorithm>
 #include <memory> //std::unique_ptr<>
 
 namespace ddl {
@@ -61,8 +62,9 @@ a_util::result::Result Target::create(const MapConfiguration& oMapConfig,
     ddl::CodecFactory oFactory(_type_name.c_str(), strTargetDescription.c_str());
     RETURN_IF_FAILED(oFactory.isValid());
 
-    // Alloc and zero memory
-    _buffer.resize(oFactory.getStaticBufferSize(), 0);
+    // Alloc memory and set the default values and constants from the DataDefinition
+    const MemoryBuffer& oDefaultSample = oFactory.getDefaultSample();
+    _buffer.assign(oDefaultSample.begin(), oDefaultSample.end());
 
     // Begin here, end when target is destroyed or after reset
     _codec.reset(new ddl::StaticCodec(oFactory.makeStaticCodecFor(&_buffer[0], _buffer.size())));
@@ -163,110 +165,27 @@ a_util::result::Result Target::create(const MapConfiguration& oMapConfig,
         _target_elements.push_back(pElement.release());
     }
 
-    // initialize memory
-    RETURN_IF_FAILED(reset(oMapConfig));
+    // Set constant elements and keep the result as the image for resetting the buffer
+    for (Constants::iterator it = _constant_elements.begin(); it != _constant_elements.end();
+         it++) {
+        RETURN_IF_FAILED(it->second->setDefaultValue(it->first));
+    }
+    _reset_buffer = _buffer;
 
     return a_util::result::SUCCESS;
 }
 
-a_util::result::Result Target::reset(const MapConfiguration& oMapConfig)
+a_util::result::Result Target::reset(const MapConfiguration&)
 {
-    a_util::result::Result nResult = a_util::result::SUCCESS;
     // Reset Counter
     _counter = 0;
 
-    auto struct_type_access =
-        dd::StructTypeAccess(oMapConfig.getDD()->getStructTypes().get(_type_name));
-    if (!struct_type_access) {
-        return ERR_POINTER;
+    // Restore the default values and constants rendered on creation
+    if (_buffer.size() != _reset_buffer.size()) {
+        return ERR_UNEXPECTED;
     }
-
-    // Set default values from DataDefinition in a newly created data sample
-    for (size_t nIdx = 0; nIdx < _codec->getElementCount(); ++nIdx) {
-        const ddl::StructElement* pElement = NULL;
-        if (isFailed(_codec->getElement(nIdx, pElement))) {
-            continue;
-        }
-
-        auto elem_access = struct_type_access.getElementByPath(pElement->name);
-
-        std::string strDefaultValue;
-        if (elem_access) {
-            // Element Description was found ... check for a default value
-            if (!elem_access.getElement().getDefault().empty()) {
-                strDefaultValue = elem_access.getElement().getDefault();
-            }
-        }
-        else {
-            // Set error if no error happend so far
-            if (isOk(nResult)) {
-                nResult = ERR_UNEXPECTED;
-            }
-        }
-
-        if (strDefaultValue.empty()) {
-            // No default detected, just reset this entry
-            ddl::access_element::reset(*_codec, pElement->name);
-        }
-        else {
-            a_util::variant::Variant var;
-            switch (pElement->type) {
-            case a_util::variant::VT_Bool:
-                var.reset(a_util::strings::toBool(strDefaultValue));
-                break;
-            case a_util::variant::VT_Int8:
-                var.reset(a_util::strings::toInt8(strDefaultValue));
-                break;
-            case a_util::variant::VT_UInt8:
-                var.reset(a_util::strings::toUInt8(strDefaultValue));
-                break;
-            case a_util::variant::VT_Int16:
-                var.reset(a_util::strings::toInt16(strDefaultValue));
-                break;
-            case a_util::variant::VT_UInt16:
-                var.reset(a_util::strings::toUInt16(strDefaultValue));
-                break;
-            case a_util::variant::VT_Int32:
-                var.reset(a_util::strings::toInt32(strDefaultValue));
-                break;
-            case a_util::variant::VT_UInt32:
-                var.reset(a_util::strings::toUInt32(strDefaultValue));
-                break;
-            case a_util::variant::VT_Int64:
-                var.reset(a_util::strings::toInt64(strDefaultValue));
-                break;
-            case a_util::variant::VT_UInt64:
-                var.reset(a_util::strings::toUInt64(strDefaultValue));
-                break;
-            case a_util::variant::VT_Float:
-                var.reset(a_util::strings::toFloat(strDefaultValue));
-                break;
-            case a_util::variant::VT_Double:
-                var.reset(a_util::strings::toDouble(strDefaultValue));
-                break;
-            default:
-                ddl::access_element::reset(*_codec, pElement->name);
-                break;
-            }
-
-            if (!var.isEmpty()) {
-                auto nCurrentResult = _codec->setElementValue(nIdx, var);
-                // Set error if no error happend so far
-                if (isOk(nResult)) {
-                    nResult = nCurrentResult;
-                }
-            }
-        }
-    }
-
-    // Set constant elements
-    if (isOk(nResult)) {
-        for (Constants::iterator it = _constant_elements.begin(); it != _constant_elements.end();
-             it++) {
-            nResult = it->second->setDefaultValue(it->first);
-        }
-    }
-    return nResult;
+    std::copy(_reset_buffer.begin(), _reset_buffer.end(), _buffer.begin());
+    return a_util::result::SUCCESS;
 }
 
 const std::string& Target::getName() const
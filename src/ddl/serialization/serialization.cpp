@@ -16,6 +16,7 @@
 
 #include "ddl/serialization/serialization.h"
 
+#include "../codec/transform_plan.h"
 #include "a_util/result/error_def.h"
 
 namespace ddl {
@@ -23,9 +24,26 @@ namespace serialization {
 // define all needed error types and values locally
 _MAKE_RESULT(-12, ERR_MEMORY);
 
+a_util::result::Result transform(const StaticDecoder& decoder, StaticCodec& encoder)
+{
+    if (TransformPlan::canTransform(decoder, encoder)) {
+        return TransformPlan::transform(decoder, encoder);
+    }
+    return transform<StaticDecoder, StaticCodec>(decoder, encoder);
+}
+
+a_util::result::Result transform(const Decoder& decoder, Codec& encoder)
+{
+    if (TransformPlan::canTransform(decoder, encoder)) {
+        return TransformPlan::transform(decoder, encoder);
+    }
+    return transform<Decoder, Codec>(decoder, encoder);
+}
+
 a_util::result::Result transformToBuffer(const Decoder& decoder,
                                          a_util::memory::MemoryBuffer& buffer,
-                                         bool zero)
+                                         bool zero,
+                                         size_t parallelism)
 {
     DataRepresentation target_rep =
         decoder.getRepresentation() == deserialized ? serialized : deserialized;
@@ -40,7 +58,10 @@ a_util::result::Result transformToBuffer(const Decoder& decoder,
         a_util::memory::set(buffer.getPtr(), buffer.getSize(), 0, buffer.getSize());
     }
     Codec codec = decoder.makeCodecFor(buffer.getPtr(), buffer.getSize(), target_rep);
-    return transform(decoder, codec);
+    if (TransformPlan::canTransform(decoder, codec)) {
+        return TransformPlan::transform(decoder, codec, parallelism);
+    }
+    return transform<Decoder, Codec>(decoder, codec);
 }
 
 } // namespace serialization
@@ -16,9 +16,11 @@
  */
 
 #include "../../_common/adtf_compat.h"
+#include "a_util/system.h"
 #include "ddl/codec/bitserializer.h"
 
 #include <gtest/gtest.h>
+#include <vector>
 
 using namespace a_util::memory;
 
@@ -406,3 +408,172 @@ TEST(CodecTest, BitSerializerTestWriteValue)
 
     ASSERT_EQ(sValue2, sResult2);
 }
+
+/// Reads a signal bit by bit, independent of the word based implementation.
+static uint64_t readReferenceSignal(const uint8_t* pBuffer,
+                                    size_t nStartBit,
+                                    size_t nBitLength,
+                                    Endianess eEndianess)
+{
+    uint64_t nBits = 0;
+    for (size_t nBit = 0; nBit < nBitLength; ++nBit) {
+        const size_t nBufferBit = nStartBit + nBit;
+        nBits |= static_cast<uint64_t>((pBuffer[nBufferBit / 8] >> (nBufferBit % 8)) & 1) << nBit;
+    }
+    if (eEndianess == bit_little_endian) {
+        return nBits;
+    }
+
+    // the first bit_length % 8 bits form the most significant byte of a BE signal
+    uint64_t nValue = 0;
+    size_t nChunkBits = nBitLength % 8 == 0 ? 8 : nBitLength % 8;
+    for (size_t nBit = 0; nBit < nBitLength; nBit += nChunkBits, nChunkBits = 8) {
+        nValue = (nValue << 8) | ((nBits >> nBit) & ((1ULL << nChunkBits) - 1));
+    }
+    return nValue;
+}
+
+/**
+ * @detail  Compare the word based access of the bit serializer with a bit by bit reference for
+ *          all bit offsets and lengths, including signals spread over nine bytes.
+ * @req_id
+ */
+TEST(CodecTest, BitSerializerTestWordAccess)
+{
+    uint8_t aui8Buffer[12];
+    for (size_t nByte = 0; nByte < sizeof(aui8Buffer); ++nByte) {
+        aui8Buffer[nByte] = static_cast<uint8_t>(0x9D * (nByte + 1));
+    }
+    BitSerializer oBits(aui8Buffer, sizeof(aui8Buffer));
+
+    for (auto eEndianess: {bit_little_endian, bit_big_endian}) {
+        for (size_t nStartBit = 0; nStartBit < 24; ++nStartBit) {
+            for (size_t nBitLength = 1; nBitLength <= 64; ++nBitLength) {
+                const uint64_t nExpected =
+                    readReferenceSignal(aui8Buffer, nStartBit, nBitLength, eEndianess);
+                uint64_t nValue = 0;
+                ASSERT_EQ(a_util::result::SUCCESS,
+                          oBits.read(nStartBit, nBitLength, &nValue, eEndianess));
+                ASSERT_EQ(nExpected, nValue) << nStartBit << " " << nBitLength;
+                nValue = 0;
+                oBits.readUnchecked(nStartBit, nBitLength, &nValue, eEndianess);
+                ASSERT_EQ(nExpected, nValue) << nStartBit << " " << nBitLength;
+
+                // write the inverted value and check that no other bits changed
+                uint8_t aui8Before[sizeof(aui8Buffer)];
+                memcpy(aui8Before, aui8Buffer, sizeof(aui8Buffer));
+                oBits.writeUnchecked(nStartBit, nBitLength, ~nExpected, eEndianess);
+                ASSERT_EQ(a_util::result::SUCCESS,
+                          oBits.read(nStartBit, nBitLength, &nValue, eEndianess));
+                const uint64_t nMask = nBitLength == 64 ? ~0ULL : (1ULL << nBitLength) - 1;
+                ASSERT_EQ(~nExpected & nMask, nValue) << nStartBit << " " << nBitLength;
+                for (size_t nBit = 0; nBit < sizeof(aui8Buffer) * 8; ++nBit) {
+                    if (nBit < nStartBit || nBit >= nStartBit + nBitLength) {
+                        ASSERT_EQ((aui8Before[nBit / 8] >> (nBit % 8)) & 1,
+                                  (aui8Buffer[nBit / 8] >> (nBit % 8)) & 1)
+                            << nStartBit << " " << nBitLength;
+                    }
+                }
+                ASSERT_EQ(a_util::result::SUCCESS,
+                          oBits.write(nStartBit, nBitLength, nExpected, eEndianess));
+                ASSERT_EQ(0, memcmp(aui8Before, aui8Buffer, sizeof(aui8Buffer)))
+                    << nStartBit << " " << nBitLength << " " << eEndianess;
+            }
+        }
+    }
+
+    // aligned values of full size, signed and floating point
+    int16_t nSigned = 0;
+    ASSERT_EQ(a_util::result::SUCCESS, oBits.write(8, 16, int16_t(-1234), bit_big_endian));
+    ASSERT_EQ(a_util::result::SUCCESS, oBits.read(8, 16, &nSigned, bit_big_endian));
+    ASSERT_EQ(-1234, nSigned);
+    ASSERT_EQ(a_util::result::SUCCESS, oBits.write(3, 11, int16_t(-1000), bit_big_endian));
+    ASSERT_EQ(a_util::result::SUCCESS, oBits.read(3, 11, &nSigned, bit_big_endian));
+    ASSERT_EQ(-1000, nSigned);
+    double fValue = 0.0;
+    ASSERT_EQ(a_util::result::SUCCESS, oBits.write(16, 64, 3.25, bit_big_endian));
+    ASSERT_EQ(a_util::result::SUCCESS, oBits.read(16, 64, &fValue, bit_big_endian));
+    ASSERT_EQ(3.25, fValue);
+    ASSERT_EQ(a_util::result::SUCCESS, oBits.write(5, 64, -0.5, bit_little_endian));
+    ASSERT_EQ(a_util::result::SUCCESS, oBits.read(5, 64, &fValue, bit_little_endian));
+    ASSERT_EQ(-0.5, fValue);
+}
+
+namespace can {
+/// Signal of a CAN frame as found in a DBC file.
+struct tSignal {
+    size_t nStartBit;
+    size_t nBitLength;
+    Endianess eEndianess;
+};
+
+const tSignal aSignals[] = {{0, 12, bit_little_endian},
+                            {12, 4, bit_little_endian},
+                            {16, 16, bit_little_endian},
+                            {32, 1, bit_little_endian},
+                            {33, 7, bit_big_endian},
+                            {40, 10, bit_big_endian},
+                            {50, 14, bit_big_endian}};
+const size_t nSignalCount = sizeof(aSignals) / sizeof(aSignals[0]);
+} // namespace can
+
+/**
+ * @detail  Measure packing and unpacking of CAN frames with the bit serializer.
+ * @req_id
+ */
+TEST(CodecTest, BitSerializerTestCanFramePerf)
+{
+    const size_t nFrameCount = 100000;
+    std::vector<uint8_t> oFrames(nFrameCount * 8);
+    uint64_t nSumWritten = 0;
+
+    timestamp_t now = a_util::system::getCurrentMicroseconds();
+    for (size_t nFrame = 0; nFrame < nFrameCount; ++nFrame) {
+        BitSerializer oBits(&oFrames[nFrame * 8], 8);
+        for (size_t nSignal = 0; nSignal < can::nSignalCount; ++nSignal) {
+            const can::tSignal& sSignal = can::aSignals[nSignal];
+            const uint32_t nValue = static_cast<uint32_t>((nFrame * 31 + nSignal * 7) &
+                                                          ((1ULL << sSignal.nBitLength) - 1));
+            nSumWritten += nValue;
+            oBits.write(sSignal.nStartBit, sSignal.nBitLength, nValue, sSignal.eEndianess);
+        }
+    }
+    timestamp_t nTimePack = a_util::system::getCurrentMicroseconds() - now;
+
+    uint64_t nSumChecked = 0;
+    now = a_util::system::getCurrentMicroseconds();
+    for (size_t nFrame = 0; nFrame < nFrameCount; ++nFrame) {
+        BitSerializer oBits(&oFrames[nFrame * 8], 8);
+        for (size_t nSignal = 0; nSignal < can::nSignalCount; ++nSignal) {
+            const can::tSignal& sSignal = can::aSignals[nSignal];
+            uint32_t nValue = 0;
+            oBits.read(sSignal.nStartBit, sSignal.nBitLength, &nValue, sSignal.eEndianess);
+            nSumChecked += nValue;
+        }
+    }
+    timestamp_t nTimeUnpack = a_util::system::getCurrentMicroseconds() - now;
+
+    // the frame size is validated once, the signals of the DBC are known to fit
+    uint64_t nSumUnchecked = 0;
+    now = a_util::system::getCurrentMicroseconds();
+    for (size_t nFrame = 0; nFrame < nFrameCount; ++nFrame) {
+        const BitSerializer oBits(&oFrames[nFrame * 8], 8);
+        for (size_t nSignal = 0; nSignal < can::nSignalCount; ++nSignal) {
+            const can::tSignal& sSignal = can::aSignals[nSignal];
+            uint32_t nValue = 0;
+            oBits.readUnchecked(
+                sSignal.nStartBit, sSignal.nBitLength, &nValue, sSignal.eEndianess);
+            nSumUnchecked += nValue;
+        }
+    }
+    timestamp_t nTimeUnpackUnchecked = a_util::system::getCurrentMicroseconds() - now;
+
+    ASSERT_EQ(nSumWritten, nSumChecked);
+    ASSERT_EQ(nSumWritten, nSumUnchecked);
+    std::cout << a_util::strings::format(
+                     "CAN frames: pack %lld us, unpack %lld us, unpack unchecked %lld us\n",
+                     nTimePack,
+                     nTimeUnpack,
+                     nTimeUnpackUnchecked)
+                     .c_str();
+}
@@ -18,11 +18,20 @@
 #include "../../_common/adtf_compat.h"
 #include "a_util/system.h"
 #include "ddl/codec/access_element.h"
+#include "ddl/codec/batch_decoder.h"
+#include "ddl/codec/delta_codec.h"
+#include "ddl/codec/element_handle.h"
 #include "ddl/codec/static_codec.h"
+#include "ddl/codec/struct_converter.h"
+#include "ddl/codec/struct_layout_cache.h"
+#include "ddl/codec/validated_view.h"
+#include "ddl/dd/ddstring.h"
 #include "ddl/serialization/serialization.h"
 
 #include <gtest/gtest.h>
+#include <limits>
 #include <list>
+#include <thread>
 
 using namespace ddl;
 
@@ -974,3 +983,2597 @@ TEST(CodecTest, TestArrayAccessWithStruct)
     ASSERT_EQ(value3.asUInt8(), 6);
     ASSERT_EQ(parentvalue.asUInt8(), 7);
 }
+
+/**
+ * Linear lookup of an element index by name, as performed before the hashed name index existed.
+ */
+template <typename T>
+a_util::result::Result findIndexByScan(const T& oDecoder,
+                                       const std::string& strName,
+                                       size_t& nIndex)
+{
+    for (size_t nElement = 0; nElement < oDecoder.getElementCount(); ++nElement) {
+        const StructElement* pElement;
+        if (isOk(oDecoder.getElement(nElement, pElement)) && pElement->name == strName) {
+            nIndex = nElement;
+            return a_util::result::SUCCESS;
+        }
+    }
+    return access_element::ERR_NOT_FOUND;
+}
+
+/**
+ * @detail Check that the hashed name index resolves the same indices as a linear scan,
+ *         for static and dynamic elements as well as for struct and array prefixes
+ */
+TEST(CodecTest, TestElementIndexLookup)
+{
+    CodecFactory oFactory("main", complex::strTestDesc);
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+    Decoder oDecoder =
+        oFactory.makeDecoderFor(&complex::sTestData, sizeof(complex::sTestData), deserialized);
+    ASSERT_EQ(a_util::result::SUCCESS, oDecoder.isValid());
+
+    for (size_t nElement = 0; nElement < oDecoder.getElementCount(); ++nElement) {
+        const StructElement* pElement;
+        ASSERT_EQ(a_util::result::SUCCESS, oDecoder.getElement(nElement, pElement));
+        size_t nIndex = 0;
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  access_element::findIndex(oDecoder, pElement->name, nIndex));
+        size_t nScanIndex = 0;
+        ASSERT_EQ(a_util::result::SUCCESS, findIndexByScan(oDecoder, pElement->name, nScanIndex));
+        ASSERT_EQ(nIndex, nScanIndex);
+    }
+
+    size_t nIndex = 0;
+    ASSERT_EQ(a_util::result::SUCCESS,
+              access_element::findStructIndex(oDecoder, "test.array[1]", nIndex));
+    ASSERT_EQ(nIndex, 12);
+    ASSERT_EQ(a_util::result::SUCCESS,
+              access_element::findArrayIndex(oDecoder, "test.array[0].child_array2", nIndex));
+    ASSERT_EQ(nIndex, 7);
+    ASSERT_EQ(a_util::result::SUCCESS,
+              access_element::findArrayIndex(oDecoder, "test.array", nIndex));
+    ASSERT_EQ(nIndex, 2);
+    ASSERT_EQ(access_element::ERR_NOT_FOUND,
+              access_element::findIndex(oDecoder, "test.array[2].child_size", nIndex));
+    ASSERT_EQ(access_element::ERR_NOT_FOUND,
+              access_element::findStructIndex(oDecoder, "test.arr", nIndex));
+
+    // the factory only knows the static elements
+    ASSERT_EQ(a_util::result::SUCCESS,
+              access_element::findIndex(oFactory, "test.array_size", nIndex));
+    ASSERT_EQ(nIndex, 1);
+    ASSERT_EQ(access_element::ERR_NOT_FOUND,
+              access_element::findIndex(oFactory, "test.array[0].child_size", nIndex));
+}
+
+/**
+ * @detail Compare the hashed element name lookup with a linear scan on a large structure
+ */
+TEST(CodecTest, TestFindIndexPerf)
+{
+    const size_t nLeafCount = 500;
+    const std::string strDescription = a_util::strings::format(
+        "<?xml version=\"1.0\" encoding=\"iso-8859-1\" standalone=\"no\"?>"
+        "<structs>"
+        "<struct alignment=\"1\" name=\"leaf\" version=\"1\">"
+        "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" bytepos=\"0\" "
+        "name=\"a\" type=\"tUInt8\"/>"
+        "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" bytepos=\"1\" "
+        "name=\"b\" type=\"tUInt16\"/>"
+        "<element alignment=\"1\" arraysize=\"3\" byteorder=\"LE\" bytepos=\"3\" "
+        "name=\"c\" type=\"tUInt32\"/>"
+        "</struct>"
+        "<struct alignment=\"1\" name=\"main\" version=\"1\">"
+        "<element alignment=\"1\" arraysize=\"%d\" byteorder=\"LE\" bytepos=\"0\" "
+        "name=\"leafs\" type=\"leaf\"/>"
+        "</struct>"
+        "</structs>",
+        nLeafCount);
+
+    CodecFactory oFactory("main", strDescription);
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+    std::vector<uint8_t> oData(oFactory.getStaticBufferSize(), 0);
+    Decoder oDecoder = oFactory.makeDecoderFor(oData.data(), oData.size());
+    ASSERT_EQ(oDecoder.getElementCount(), nLeafCount * 5);
+
+    std::vector<std::string> oNames;
+    for (size_t nLeaf = 0; nLeaf < nLeafCount; nLeaf += 7) {
+        oNames.push_back(a_util::strings::format("leafs[%d].c[2]", nLeaf));
+    }
+
+    const size_t nRepeats = 100;
+    size_t nChecksumScan = 0;
+    timestamp_t now = a_util::system::getCurrentMicroseconds();
+    for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+        for (const auto& strName: oNames) {
+            size_t nIndex = 0;
+            findIndexByScan(oDecoder, strName, nIndex);
+            nChecksumScan += nIndex;
+        }
+    }
+    timestamp_t nTimeScan = a_util::system::getCurrentMicroseconds() - now;
+
+    size_t nChecksumIndex = 0;
+    now = a_util::system::getCurrentMicroseconds();
+    for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+        for (const auto& strName: oNames) {
+            size_t nIndex = 0;
+            access_element::findIndex(oDecoder, strName, nIndex);
+            nChecksumIndex += nIndex;
+        }
+    }
+    timestamp_t nTimeIndex = a_util::system::getCurrentMicroseconds() - now;
+
+    ASSERT_EQ(nChecksumScan, nChecksumIndex);
+    std::cout << a_util::strings::format(
+                     "findIndex on %d elements: linear scan %lld us, hashed index %lld us\n",
+                     oDecoder.getElementCount(),
+                     nTimeScan,
+                     nTimeIndex)
+                     .c_str();
+}
+
+namespace handles {
+const char* strTestDesc = "<?xml version=\"1.0\" encoding=\"iso-8859-1\" standalone=\"no\"?>"
+                          "<struct alignment=\"1\" name=\"main\" version=\"2\">"
+                          "<element alignment=\"1\" arraysize=\"1\" byteorder=\"BE\" "
+                          "bytepos=\"0\" name=\"u16\" type=\"tUInt16\"/>"
+                          "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" "
+                          "bytepos=\"2\" name=\"i32\" type=\"tInt32\"/>"
+                          "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" "
+                          "bytepos=\"6\" bitpos=\"3\" numbits=\"5\" name=\"bits\" "
+                          "type=\"tUInt8\"/>"
+                          "<element alignment=\"1\" arraysize=\"1\" byteorder=\"BE\" "
+                          "bytepos=\"7\" name=\"f64\" type=\"tFloat64\"/>"
+                          "<element alignment=\"1\" arraysize=\"1\" byteorder=\"BE\" "
+                          "bytepos=\"15\" bitpos=\"2\" numbits=\"11\" name=\"sbits\" "
+                          "type=\"tInt16\"/>"
+                          "</struct>";
+} // namespace handles
+
+void TestElementHandles(const CodecFactory& oFactory, DataRepresentation eRep)
+{
+    ElementHandle<uint16_t> oU16(oFactory, "u16", eRep);
+    ElementHandle<int32_t> oI32(oFactory, "i32", eRep);
+    ElementHandle<uint8_t> oBits(oFactory, "bits", eRep);
+    ElementHandle<double> oF64(oFactory, "f64", eRep);
+    ElementHandle<int16_t> oSBits(oFactory, 4, eRep);
+    ASSERT_EQ(a_util::result::SUCCESS, oU16.isValid());
+    ASSERT_EQ(a_util::result::SUCCESS, oI32.isValid());
+    ASSERT_EQ(a_util::result::SUCCESS, oBits.isValid());
+    ASSERT_EQ(a_util::result::SUCCESS, oF64.isValid());
+    ASSERT_EQ(a_util::result::SUCCESS, oSBits.isValid());
+    ASSERT_EQ(oU16.getRepresentation(), eRep);
+
+    std::vector<uint8_t> oData(oFactory.getStaticBufferSize(eRep), 0);
+    StaticCodec oCodec = oFactory.makeStaticCodecFor(oData.data(), oData.size(), eRep);
+    ASSERT_EQ(a_util::result::SUCCESS, oCodec.isValid());
+
+    // values written by the codec are read by the handles
+    ASSERT_EQ(a_util::result::SUCCESS, access_element::setValue(oCodec, "u16", (uint16_t)0x1234));
+    ASSERT_EQ(a_util::result::SUCCESS, access_element::setValue(oCodec, "i32", (int32_t)-5));
+    ASSERT_EQ(a_util::result::SUCCESS, access_element::setValue(oCodec, "bits", (uint8_t)21));
+    ASSERT_EQ(a_util::result::SUCCESS, access_element::setValue(oCodec, "f64", 3.5));
+    ASSERT_EQ(a_util::result::SUCCESS, access_element::setValue(oCodec, "sbits", (int16_t)-300));
+    ASSERT_EQ(oU16.getValue(oCodec), 0x1234);
+    ASSERT_EQ(oI32.getValue(oCodec), -5);
+    ASSERT_EQ(oBits.getValue(oCodec), 21);
+    ASSERT_EQ(oF64.getValue(oCodec), 3.5);
+    ASSERT_EQ(oSBits.getValue(oCodec), -300);
+
+    // values written by the handles are read by the codec
+    oU16.setValue(oCodec, 0xABCD);
+    oI32.setValue(oCodec, 123456);
+    oBits.setValue(oCodec, 7);
+    oF64.setValue(oCodec, -0.25);
+    oSBits.setValue(oCodec, 511);
+    ASSERT_EQ(access_element::getValue(oCodec, "u16").getUInt16(), 0xABCD);
+    ASSERT_EQ(access_element::getValue(oCodec, "i32").getInt32(), 123456);
+    ASSERT_EQ(access_element::getValue(oCodec, "bits").getUInt8(), 7);
+    ASSERT_EQ(access_element::getValue(oCodec, "f64").getFloat64(), -0.25);
+    ASSERT_EQ(access_element::getValue(oCodec, "sbits").getInt16(), 511);
+
+    // the handles work on raw buffers and decoders as well
+    StaticDecoder oDecoder = oFactory.makeStaticDecoderFor(oData.data(), oData.size(), eRep);
+    ASSERT_EQ(oU16.getValue(oData.data()), 0xABCD);
+    ASSERT_EQ(oSBits.getValue(oDecoder), 511);
+}
+
+/**
+ * @detail Check reading and writing through typed element handles in both representations
+ */
+TEST(CodecTest, TestElementHandle)
+{
+    CodecFactory oFactory("main", handles::strTestDesc);
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+
+    TestElementHandles(oFactory, deserialized);
+    TestElementHandles(oFactory, serialized);
+
+    ElementHandle<uint16_t> oInvalid;
+    ASSERT_NE(a_util::result::SUCCESS, oInvalid.isValid());
+    ElementHandle<uint32_t> oWrongType(oFactory, "u16");
+    ASSERT_NE(a_util::result::SUCCESS, oWrongType.isValid());
+    ElementHandle<uint16_t> oUnknown(oFactory, "unknown");
+    ASSERT_EQ(access_element::ERR_NOT_FOUND, oUnknown.isValid());
+    ElementHandle<uint16_t> oWrongIndex(oFactory, 5);
+    ASSERT_NE(a_util::result::SUCCESS, oWrongIndex.isValid());
+}
+
+/**
+ * @detail Compare reading elements through typed handles with reading them by index
+ */
+TEST(CodecTest, TestElementHandlePerf)
+{
+    CodecFactory oFactory("test", static_struct::strTestDesc);
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+
+    for (auto eRep: {deserialized, serialized}) {
+        std::vector<uint8_t> oData(oFactory.getStaticBufferSize(eRep), 1);
+        StaticDecoder oDecoder = oFactory.makeStaticDecoderFor(oData.data(), oData.size(), eRep);
+        ASSERT_EQ(a_util::result::SUCCESS, oDecoder.isValid());
+
+        std::vector<size_t> oIndices;
+        std::vector<ElementHandle<int32_t>> oHandles;
+        for (size_t nChild = 0; nChild < 2; ++nChild) {
+            for (size_t nValue = 0; nValue < 3; ++nValue) {
+                const std::string strName =
+                    a_util::strings::format("child[%d].value[%d]", nChild, nValue);
+                size_t nIndex = 0;
+                ASSERT_EQ(a_util::result::SUCCESS,
+                          access_element::findIndex(oFactory, strName, nIndex));
+                oIndices.push_back(nIndex);
+                oHandles.emplace_back(oFactory, strName, eRep);
+                ASSERT_EQ(a_util::result::SUCCESS, oHandles.back().isValid());
+            }
+        }
+
+        const size_t nRepeats = 100000;
+        int64_t nSumIndex = 0;
+        timestamp_t now = a_util::system::getCurrentMicroseconds();
+        for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+            for (size_t nIndex: oIndices) {
+                int32_t nValue = 0;
+                oDecoder.getElementValue(nIndex, &nValue);
+                nSumIndex += nValue;
+            }
+        }
+        timestamp_t nTimeIndex = a_util::system::getCurrentMicroseconds() - now;
+
+        int64_t nSumHandle = 0;
+        now = a_util::system::getCurrentMicroseconds();
+        for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+            for (const auto& oHandle: oHandles) {
+                nSumHandle += oHandle.getValue(oDecoder);
+            }
+        }
+        timestamp_t nTimeHandle = a_util::system::getCurrentMicroseconds() - now;
+
+        ASSERT_EQ(nSumIndex, nSumHandle);
+        std::cout << a_util::strings::format(
+                         "%s: getElementValue %lld us, ElementHandle %lld us\n",
+                         eRep == deserialized ? "deserialized" : "serialized",
+                         nTimeIndex,
+                         nTimeHandle)
+                         .c_str();
+    }
+}
+
+void CheckTransformPlan(const CodecFactory& oFactory,
+                        const void* pData,
+                        size_t nDataSize,
+                        DataRepresentation eRep)
+{
+    Decoder oDecoder = oFactory.makeDecoderFor(pData, nDataSize, eRep);
+    ASSERT_EQ(a_util::result::SUCCESS, oDecoder.isValid());
+    const DataRepresentation eTargetRep = eRep == deserialized ? serialized : deserialized;
+
+    a_util::memory::MemoryBuffer oPlanBuffer;
+    ASSERT_EQ(a_util::result::SUCCESS,
+              serialization::transformToBuffer(oDecoder, oPlanBuffer, true));
+
+    // element wise reference transformation
+    a_util::memory::MemoryBuffer oReferenceBuffer(oDecoder.getBufferSize(eTargetRep));
+    a_util::memory::set(
+        oReferenceBuffer.getPtr(), oReferenceBuffer.getSize(), 0, oReferenceBuffer.getSize());
+    Codec oReferenceCodec =
+        oDecoder.makeCodecFor(oReferenceBuffer.getPtr(), oReferenceBuffer.getSize(), eTargetRep);
+    ASSERT_EQ(a_util::result::SUCCESS,
+              (serialization::transform<Decoder, Codec>(oDecoder, oReferenceCodec)));
+
+    ASSERT_EQ(oPlanBuffer.getSize(), oReferenceBuffer.getSize());
+    ASSERT_EQ(0, memcmp(oPlanBuffer.getPtr(), oReferenceBuffer.getPtr(), oPlanBuffer.getSize()));
+
+    // and back again
+    Decoder oTargetDecoder =
+        oFactory.makeDecoderFor(oPlanBuffer.getPtr(), oPlanBuffer.getSize(), eTargetRep);
+    a_util::memory::MemoryBuffer oRoundTripBuffer;
+    ASSERT_EQ(a_util::result::SUCCESS,
+              serialization::transformToBuffer(oTargetDecoder, oRoundTripBuffer, true));
+    ASSERT_EQ(oDecoder.getBufferSize(eRep), oRoundTripBuffer.getSize());
+    for (size_t nElement = 0; nElement < oDecoder.getElementCount(); ++nElement) {
+        a_util::variant::Variant oExpected, oValue;
+        ASSERT_EQ(a_util::result::SUCCESS, oDecoder.getElementValue(nElement, oExpected));
+        ASSERT_EQ(a_util::result::SUCCESS, oTargetDecoder.getElementValue(nElement, oValue));
+        ASSERT_EQ(oExpected.asString(), oValue.asString());
+    }
+}
+
+/**
+ * @detail Check that the precomputed transformation plan matches the element wise transformation
+ */
+TEST(CodecTest, TestTransformPlan)
+{
+    {
+        CodecFactory oFactory("test", static_struct::strTestDesc);
+        static_struct::tTest sTest = static_struct::sTestData;
+        CheckTransformPlan(oFactory, &sTest, sizeof(sTest), deserialized);
+        static_struct::serialized::tTest sSerTest = static_struct::serialized::sTestData;
+        CheckTransformPlan(oFactory, &sSerTest, sizeof(sSerTest), serialized);
+    }
+    {
+        CodecFactory oFactory("main", complex::strTestDesc);
+        complex::tMain sTest = complex::sTestData;
+        CheckTransformPlan(oFactory, &sTest, sizeof(sTest), deserialized);
+        complex::serialized::tMain sSerTest = complex::serialized::sTestData;
+        CheckTransformPlan(oFactory, &sSerTest, sizeof(sSerTest), serialized);
+    }
+    {
+        CodecFactory oFactory("main", handles::strTestDesc);
+        std::vector<uint8_t> oData(oFactory.getStaticBufferSize(deserialized));
+        StaticCodec oCodec = oFactory.makeStaticCodecFor(oData.data(), oData.size());
+        access_element::setValue(oCodec, "u16", (uint16_t)0x1234);
+        access_element::setValue(oCodec, "i32", (int32_t)-5);
+        access_element::setValue(oCodec, "bits", (uint8_t)21);
+        access_element::setValue(oCodec, "f64", 3.5);
+        access_element::setValue(oCodec, "sbits", (int16_t)-300);
+        CheckTransformPlan(oFactory, oData.data(), oData.size(), deserialized);
+    }
+
+    // a too small destination buffer is rejected
+    CodecFactory oFactory("test", static_struct::strTestDesc);
+    static_struct::tTest sTest = static_struct::sTestData;
+    Decoder oDecoder = oFactory.makeDecoderFor(&sTest, sizeof(sTest) / 2);
+    a_util::memory::MemoryBuffer oBuffer;
+    ASSERT_NE(a_util::result::SUCCESS, serialization::transformToBuffer(oDecoder, oBuffer));
+}
+
+/**
+ * @detail Compare the transformation plan with the element wise transformation for large arrays
+ */
+TEST(CodecTest, TestTransformPlanPerf)
+{
+    const std::string strDesc = a_util::strings::format(
+        "<?xml version=\"1.0\" encoding=\"iso-8859-1\" standalone=\"no\"?>"
+        "<struct alignment=\"8\" name=\"metadata\" version=\"2\">"
+        "<element alignment=\"8\" arraysize=\"8192\" byteorder=\"LE\" bytepos=\"0\" "
+        "name=\"timestamps\" type=\"tUInt64\"/>"
+        "<element alignment=\"4\" arraysize=\"16384\" byteorder=\"BE\" bytepos=\"65536\" "
+        "name=\"values\" type=\"tFloat32\"/>"
+        "<element alignment=\"2\" arraysize=\"32768\" byteorder=\"LE\" bytepos=\"131072\" "
+        "name=\"pixels\" type=\"tUInt16\"/>"
+        "</struct>");
+    CodecFactory oFactory("metadata", strDesc.c_str());
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+
+    std::vector<uint8_t> oData(oFactory.getStaticBufferSize(deserialized));
+    for (size_t nByte = 0; nByte < oData.size(); ++nByte) {
+        oData[nByte] = static_cast<uint8_t>(nByte * 7);
+    }
+    Decoder oDecoder = oFactory.makeDecoderFor(oData.data(), oData.size());
+    ASSERT_EQ(a_util::result::SUCCESS, oDecoder.isValid());
+
+    const size_t nRepeats = 20;
+    a_util::memory::MemoryBuffer oReferenceBuffer(oDecoder.getBufferSize(serialized));
+    Codec oReferenceCodec = oDecoder.makeCodecFor(
+        oReferenceBuffer.getPtr(), oReferenceBuffer.getSize(), serialized);
+    timestamp_t now = a_util::system::getCurrentMicroseconds();
+    for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  (serialization::transform<Decoder, Codec>(oDecoder, oReferenceCodec)));
+    }
+    timestamp_t nTimeElements = a_util::system::getCurrentMicroseconds() - now;
+
+    a_util::memory::MemoryBuffer oPlanBuffer;
+    now = a_util::system::getCurrentMicroseconds();
+    for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+        ASSERT_EQ(a_util::result::SUCCESS, serialization::transformToBuffer(oDecoder, oPlanBuffer));
+    }
+    timestamp_t nTimePlan = a_util::system::getCurrentMicroseconds() - now;
+
+    ASSERT_EQ(0, memcmp(oPlanBuffer.getPtr(), oReferenceBuffer.getPtr(), oPlanBuffer.getSize()));
+    std::cout << a_util::strings::format("element wise transform %lld us, transform plan %lld us\n",
+                                         nTimeElements,
+                                         nTimePlan)
+                     .c_str();
+}
+
+namespace grid {
+const char* strTestDesc =
+    "<?xml version=\"1.0\" encoding=\"iso-8859-1\" standalone=\"no\"?>"
+    "<adtf:ddl>"
+    "<structs>"
+    "<struct alignment=\"2\" name=\"cell\" version=\"1\">"
+    "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" bytepos=\"0\" bitpos=\"0\" "
+    "numbits=\"3\" name=\"state\" type=\"tUInt8\"/>"
+    "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" bytepos=\"0\" bitpos=\"3\" "
+    "numbits=\"5\" name=\"class\" type=\"tUInt8\"/>"
+    "<element alignment=\"2\" arraysize=\"1\" byteorder=\"BE\" bytepos=\"1\" bitpos=\"2\" "
+    "numbits=\"11\" name=\"height\" type=\"tInt16\"/>"
+    "</struct>"
+    "<struct alignment=\"8\" name=\"main\" version=\"1\">"
+    "<element alignment=\"8\" arraysize=\"8192\" byteorder=\"LE\" bytepos=\"0\" "
+    "name=\"timestamps\" type=\"tUInt64\"/>"
+    "<element alignment=\"4\" arraysize=\"1\" byteorder=\"LE\" bytepos=\"65536\" "
+    "name=\"count\" type=\"tUInt32\"/>"
+    "<element alignment=\"2\" arraysize=\"count\" byteorder=\"LE\" bytepos=\"65540\" "
+    "name=\"cells\" type=\"cell\"/>"
+    "<element alignment=\"4\" arraysize=\"16384\" byteorder=\"BE\" bytepos=\"-1\" "
+    "name=\"values\" type=\"tFloat32\"/>"
+    "</struct>"
+    "</structs>"
+    "</adtf:ddl>";
+} // namespace grid
+
+/**
+ * @detail Check that the parallel transformation writes the same data as the sequential one,
+ *         including bit-packed elements sharing bytes and dynamic elements
+ */
+TEST(CodecTest, TestParallelTransform)
+{
+    CodecFactory oFactory("main", grid::strTestDesc);
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+
+    const uint32_t nCells = 100000;
+    std::vector<uint8_t> oData(1024 * 1024);
+    for (size_t nByte = 0; nByte < oData.size(); ++nByte) {
+        oData[nByte] = static_cast<uint8_t>(nByte * 7);
+    }
+    a_util::memory::copy(oData.data() + 65536, sizeof(nCells), &nCells, sizeof(nCells));
+    Decoder oDecoder = oFactory.makeDecoderFor(oData.data(), oData.size());
+    ASSERT_EQ(a_util::result::SUCCESS, oDecoder.isValid());
+    oData.resize(oDecoder.getBufferSize(deserialized));
+    oDecoder = oFactory.makeDecoderFor(oData.data(), oData.size());
+    ASSERT_EQ(a_util::result::SUCCESS, oDecoder.isValid());
+
+    a_util::memory::MemoryBuffer oSequentialBuffer;
+    ASSERT_EQ(a_util::result::SUCCESS,
+              serialization::transformToBuffer(oDecoder, oSequentialBuffer, true));
+    for (size_t nParallelism: {2, 3, 8}) {
+        a_util::memory::MemoryBuffer oParallelBuffer;
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  serialization::transformToBuffer(oDecoder, oParallelBuffer, true, nParallelism));
+        ASSERT_EQ(oSequentialBuffer.getSize(), oParallelBuffer.getSize());
+        ASSERT_EQ(0,
+                  memcmp(oSequentialBuffer.getPtr(),
+                         oParallelBuffer.getPtr(),
+                         oSequentialBuffer.getSize()));
+    }
+
+    // and back again, the bit-packed elements are read by several threads then
+    Decoder oSerializedDecoder = oFactory.makeDecoderFor(
+        oSequentialBuffer.getPtr(), oSequentialBuffer.getSize(), serialized);
+    ASSERT_EQ(a_util::result::SUCCESS, oSerializedDecoder.isValid());
+    a_util::memory::MemoryBuffer oSequentialRoundTrip, oParallelRoundTrip;
+    ASSERT_EQ(a_util::result::SUCCESS,
+              serialization::transformToBuffer(oSerializedDecoder, oSequentialRoundTrip, true));
+    ASSERT_EQ(a_util::result::SUCCESS,
+              serialization::transformToBuffer(oSerializedDecoder, oParallelRoundTrip, true, 4));
+    ASSERT_EQ(oSequentialRoundTrip.getSize(), oParallelRoundTrip.getSize());
+    ASSERT_EQ(0,
+              memcmp(oSequentialRoundTrip.getPtr(),
+                     oParallelRoundTrip.getPtr(),
+                     oSequentialRoundTrip.getSize()));
+}
+
+/**
+ * @detail Measure the scaling of the parallel transformation of a large sample with the number
+ *         of threads
+ */
+TEST(CodecTest, TestParallelTransformPerf)
+{
+    const std::string strDesc = a_util::strings::format(
+        "<?xml version=\"1.0\" encoding=\"iso-8859-1\" standalone=\"no\"?>"
+        "<struct alignment=\"8\" name=\"metadata\" version=\"2\">"
+        "<element alignment=\"8\" arraysize=\"65536\" byteorder=\"LE\" bytepos=\"0\" "
+        "name=\"timestamps\" type=\"tUInt64\"/>"
+        "<element alignment=\"4\" arraysize=\"131072\" byteorder=\"BE\" bytepos=\"524288\" "
+        "name=\"values\" type=\"tFloat32\"/>"
+        "<element alignment=\"2\" arraysize=\"262144\" byteorder=\"BE\" bytepos=\"1048576\" "
+        "name=\"pixels\" type=\"tUInt16\"/>"
+        "</struct>");
+    CodecFactory oFactory("metadata", strDesc.c_str());
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+
+    std::vector<uint8_t> oData(oFactory.getStaticBufferSize(deserialized));
+    for (size_t nByte = 0; nByte < oData.size(); ++nByte) {
+        oData[nByte] = static_cast<uint8_t>(nByte * 7);
+    }
+    Decoder oDecoder = oFactory.makeDecoderFor(oData.data(), oData.size());
+    ASSERT_EQ(a_util::result::SUCCESS, oDecoder.isValid());
+
+    const size_t nRepeats = 50;
+    a_util::memory::MemoryBuffer oReferenceBuffer;
+    ASSERT_EQ(a_util::result::SUCCESS,
+              serialization::transformToBuffer(oDecoder, oReferenceBuffer));
+    const size_t nMaxParallelism = std::max<size_t>(std::thread::hardware_concurrency(), 4);
+    for (size_t nParallelism = 1; nParallelism <= nMaxParallelism; nParallelism *= 2) {
+        a_util::memory::MemoryBuffer oBuffer;
+        timestamp_t now = a_util::system::getCurrentMicroseconds();
+        for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+            ASSERT_EQ(a_util::result::SUCCESS,
+                      serialization::transformToBuffer(oDecoder, oBuffer, false, nParallelism));
+        }
+        timestamp_t nTime = a_util::system::getCurrentMicroseconds() - now;
+        ASSERT_EQ(0, memcmp(oBuffer.getPtr(), oReferenceBuffer.getPtr(), oBuffer.getSize()));
+        std::cout << a_util::strings::format("transform with %d threads: %lld us\n",
+                                             static_cast<int>(nParallelism),
+                                             nTime)
+                         .c_str();
+    }
+}
+
+namespace byte_swap {
+// odd array sizes to cover the scalar tails of the vectorized byte swap
+const char* strTestDesc =
+    "<?xml version=\"1.0\" encoding=\"iso-8859-1\" standalone=\"no\"?>"
+    "<struct alignment=\"1\" name=\"signals\" version=\"2\">"
+    "<element alignment=\"1\" arraysize=\"17\" byteorder=\"BE\" bytepos=\"0\" "
+    "name=\"counters\" type=\"tUInt64\"/>"
+    "<element alignment=\"1\" arraysize=\"1027\" byteorder=\"BE\" bytepos=\"136\" "
+    "name=\"values\" type=\"tFloat32\"/>"
+    "<element alignment=\"1\" arraysize=\"33\" byteorder=\"BE\" bytepos=\"4244\" "
+    "name=\"offsets\" type=\"tInt16\"/>"
+    "<element alignment=\"1\" arraysize=\"5\" byteorder=\"LE\" bytepos=\"4310\" "
+    "name=\"flags\" type=\"tUInt32\"/>"
+    "</struct>";
+
+#pragma pack(push, 1)
+struct tSignals {
+    uint64_t counters[17];
+    float values[1027];
+    int16_t offsets[33];
+    uint32_t flags[5];
+};
+#pragma pack(pop)
+} // namespace byte_swap
+
+/**
+ * @detail Check the bulk byte order conversion of big endian arrays in all transformations
+ */
+TEST(CodecTest, TestBulkByteSwap)
+{
+    CodecFactory oFactory("signals", byte_swap::strTestDesc);
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+    ASSERT_EQ(oFactory.getStaticBufferSize(deserialized), sizeof(byte_swap::tSignals));
+
+    byte_swap::tSignals sSignals;
+    for (size_t nItem = 0; nItem < 17; ++nItem) {
+        sSignals.counters[nItem] = 0x0102030405060708ULL * (nItem + 1);
+    }
+    for (size_t nItem = 0; nItem < 1027; ++nItem) {
+        sSignals.values[nItem] = 0.25f * nItem - 100.0f;
+    }
+    for (size_t nItem = 0; nItem < 33; ++nItem) {
+        sSignals.offsets[nItem] = static_cast<int16_t>(-0x0102 * static_cast<int>(nItem));
+    }
+    for (size_t nItem = 0; nItem < 5; ++nItem) {
+        sSignals.flags[nItem] = 0x01020304 + static_cast<uint32_t>(nItem);
+    }
+
+    CheckTransformPlan(oFactory, &sSignals, sizeof(sSignals), deserialized);
+
+    // static decoders and codecs of the same factory
+    const size_t nSerializedSize = oFactory.getStaticBufferSize(serialized);
+    std::vector<uint8_t> oSerialized(nSerializedSize, 0);
+    std::vector<uint8_t> oReference(nSerializedSize, 0);
+    StaticDecoder oDecoder = oFactory.makeStaticDecoderFor(&sSignals, sizeof(sSignals));
+    StaticCodec oCodec =
+        oFactory.makeStaticCodecFor(oSerialized.data(), nSerializedSize, serialized);
+    StaticCodec oReferenceCodec =
+        oFactory.makeStaticCodecFor(oReference.data(), nSerializedSize, serialized);
+    ASSERT_EQ(a_util::result::SUCCESS, serialization::transform(oDecoder, oCodec));
+    ASSERT_EQ(a_util::result::SUCCESS,
+              (serialization::transform<StaticDecoder, StaticCodec>(oDecoder, oReferenceCodec)));
+    ASSERT_EQ(oSerialized, oReference);
+    CheckTransformPlan(oFactory, oSerialized.data(), oSerialized.size(), serialized);
+
+    // the converted serialized arrays are in the platform byte order
+    Decoder oSerializedDecoder =
+        oFactory.makeDecoderFor(oSerialized.data(), nSerializedSize, serialized);
+    byte_swap::tSignals sArrays;
+    std::memset(&sArrays, 0, sizeof(sArrays));
+    ASSERT_EQ(
+        a_util::result::SUCCESS,
+        access_element::getConvertedArrayValue(oSerializedDecoder, "counters", sArrays.counters));
+    ASSERT_EQ(
+        a_util::result::SUCCESS,
+        access_element::getConvertedArrayValue(oSerializedDecoder, "values", sArrays.values));
+    ASSERT_EQ(
+        a_util::result::SUCCESS,
+        access_element::getConvertedArrayValue(oSerializedDecoder, "offsets", sArrays.offsets));
+    ASSERT_EQ(
+        a_util::result::SUCCESS,
+        access_element::getConvertedArrayValue(oSerializedDecoder, "flags", sArrays.flags));
+    ASSERT_EQ(0, std::memcmp(&sArrays, &sSignals, sizeof(sSignals)));
+    ASSERT_EQ(
+        access_element::ERR_NOT_FOUND,
+        access_element::getConvertedArrayValue(oSerializedDecoder, "unknown", sArrays.flags));
+
+    // getArrayValue still copies the serialized array as it is
+    ASSERT_EQ(a_util::result::SUCCESS,
+              access_element::getArrayValue(oSerializedDecoder, "offsets", sArrays.offsets));
+    ASSERT_EQ(0, std::memcmp(sArrays.offsets, oSerialized.data() + 4244, sizeof(sArrays.offsets)));
+
+    float fValue = 0.0f;
+    ASSERT_EQ(a_util::result::SUCCESS, oSerializedDecoder.getElementValues(18, 1, &fValue));
+    ASSERT_EQ(sSignals.values[1], fValue);
+    ASSERT_NE(
+        a_util::result::SUCCESS,
+        oSerializedDecoder.getElementValues(oSerializedDecoder.getElementCount(), 1, &fValue));
+}
+
+/**
+ * @detail Check the buffer sizes needed for the converted and the raw copies of a bit-packed
+ * array, whose items are followed by another element within the size of their type
+ */
+TEST(CodecTest, TestConvertedArrayValue)
+{
+    const char* strDesc =
+        "<?xml version=\"1.0\" encoding=\"iso-8859-1\" standalone=\"no\"?>"
+        "<struct alignment=\"1\" name=\"packed\" version=\"2\">"
+        "<element alignment=\"1\" arraysize=\"4\" byteorder=\"LE\" bytepos=\"0\" "
+        "bitpos=\"0\" numbits=\"4\" name=\"nibbles\" type=\"tUInt8\"/>"
+        "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" bytepos=\"3\" "
+        "name=\"after\" type=\"tUInt8\"/>"
+        "</struct>";
+    CodecFactory oFactory("packed", strDesc);
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+    ASSERT_EQ(oFactory.getStaticBufferSize(serialized), 4);
+
+    std::vector<uint8_t> oSerialized(4, 0);
+    StaticCodec oCodec =
+        oFactory.makeStaticCodecFor(oSerialized.data(), oSerialized.size(), serialized);
+    ASSERT_EQ(a_util::result::SUCCESS, access_element::setValue(oCodec, "after", 0xF0));
+    for (uint8_t nItem = 0; nItem < 4; ++nItem) {
+        const uint8_t nValue = nItem + 1;
+        ASSERT_EQ(a_util::result::SUCCESS, oCodec.setElementValue(nItem, &nValue));
+    }
+    Decoder oDecoder = oFactory.makeDecoderFor(oSerialized.data(), oSerialized.size(), serialized);
+
+    // the raw copy takes the serialized bytes up to the following element
+    std::vector<uint8_t> oRaw(16, 0xEE);
+    ASSERT_EQ(a_util::result::SUCCESS,
+              access_element::getArrayValue(oDecoder, "nibbles", oRaw.data()));
+    ASSERT_EQ(std::vector<uint8_t>(oRaw.begin(), oRaw.begin() + 4),
+              std::vector<uint8_t>({1, 2, 3, 0xEE}));
+
+    // the converted copy takes the four items with the size of their type
+    std::vector<uint8_t> oConverted(16, 0xEE);
+    ASSERT_EQ(a_util::result::SUCCESS,
+              access_element::getConvertedArrayValue(oDecoder, "nibbles", oConverted.data()));
+    ASSERT_EQ(std::vector<uint8_t>(oConverted.begin(), oConverted.begin() + 5),
+              std::vector<uint8_t>({1, 2, 3, 4, 0xEE}));
+}
+
+/**
+ * @detail Compare reading a big endian array element by element with the bulk conversion
+ */
+TEST(CodecTest, TestBulkByteSwapPerf)
+{
+    const char* strDesc =
+        "<?xml version=\"1.0\" encoding=\"iso-8859-1\" standalone=\"no\"?>"
+        "<struct alignment=\"4\" name=\"samples\" version=\"2\">"
+        "<element alignment=\"4\" arraysize=\"65536\" byteorder=\"BE\" bytepos=\"0\" "
+        "name=\"values\" type=\"tFloat32\"/>"
+        "</struct>";
+    CodecFactory oFactory("samples", strDesc);
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+
+    const size_t nItemCount = 65536;
+    std::vector<uint8_t> oData(oFactory.getStaticBufferSize(serialized));
+    for (size_t nByte = 0; nByte < oData.size(); ++nByte) {
+        oData[nByte] = static_cast<uint8_t>(nByte * 13);
+    }
+    Decoder oDecoder = oFactory.makeDecoderFor(oData.data(), oData.size(), serialized);
+    ASSERT_EQ(a_util::result::SUCCESS, oDecoder.isValid());
+
+    const size_t nRepeats = 20;
+    std::vector<float> oElementValues(nItemCount);
+    timestamp_t now = a_util::system::getCurrentMicroseconds();
+    for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+        for (size_t nItem = 0; nItem < nItemCount; ++nItem) {
+            oDecoder.getElementValue(nItem, &oElementValues[nItem]);
+        }
+    }
+    timestamp_t nTimeElements = a_util::system::getCurrentMicroseconds() - now;
+
+    std::vector<float> oBulkValues(nItemCount);
+    now = a_util::system::getCurrentMicroseconds();
+    for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+        ASSERT_EQ(
+            a_util::result::SUCCESS,
+            access_element::getConvertedArrayValue(oDecoder, "values", oBulkValues.data()));
+    }
+    timestamp_t nTimeBulk = a_util::system::getCurrentMicroseconds() - now;
+
+    ASSERT_EQ(0, memcmp(oElementValues.data(), oBulkValues.data(), nItemCount * sizeof(float)));
+    std::cout << a_util::strings::format(
+                     "element wise byte swap %lld us, bulk byte swap %lld us\n",
+                     nTimeElements,
+                     nTimeBulk)
+                     .c_str();
+}
+
+/**
+ * @detail Check decoding of multiple samples into columns in both representations
+ */
+TEST(CodecTest, TestBatchDecoder)
+{
+    CodecFactory oFactory("main", handles::strTestDesc);
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+    const std::vector<std::string> oNames = {"f64", "bits", "u16", "sbits", "i32"};
+
+    for (auto eRep: {deserialized, serialized}) {
+        const size_t nSampleCount = 10;
+        const size_t nSampleSize = oFactory.getStaticBufferSize(eRep);
+        std::vector<uint8_t> oSamples(nSampleCount * nSampleSize);
+        for (size_t nSample = 0; nSample < nSampleCount; ++nSample) {
+            StaticCodec oCodec = oFactory.makeStaticCodecFor(
+                oSamples.data() + nSample * nSampleSize, nSampleSize, eRep);
+            const int nValue = static_cast<int>(nSample);
+            access_element::setValue(oCodec, "u16", (uint16_t)(0x100 * nValue + 1));
+            access_element::setValue(oCodec, "i32", (int32_t)(-1000 * nValue));
+            access_element::setValue(oCodec, "bits", (uint8_t)(nValue + 3));
+            access_element::setValue(oCodec, "f64", 0.5 * nValue);
+            access_element::setValue(oCodec, "sbits", (int16_t)(-50 * nValue));
+        }
+
+        BatchDecoder oBatch(oFactory, oNames, eRep);
+        ASSERT_EQ(a_util::result::SUCCESS, oBatch.isValid());
+        ASSERT_EQ(oBatch.getColumnCount(), oNames.size());
+        ASSERT_EQ(oBatch.getColumnType(0), a_util::variant::VT_Double);
+        ASSERT_EQ(oBatch.getColumnTypeSize(3), sizeof(int16_t));
+
+        std::vector<double> oF64(nSampleCount);
+        std::vector<uint8_t> oBits(nSampleCount);
+        std::vector<uint16_t> oU16(nSampleCount);
+        std::vector<int16_t> oSBits(nSampleCount);
+        std::vector<int32_t> oI32(nSampleCount);
+        const std::vector<void*> oColumns = {
+            oF64.data(), oBits.data(), oU16.data(), oSBits.data(), oI32.data()};
+
+        // contiguous samples
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  oBatch.decode(oSamples.data(), nSampleCount, nSampleSize, oColumns));
+        for (size_t nSample = 0; nSample < nSampleCount; ++nSample) {
+            StaticDecoder oDecoder = oFactory.makeStaticDecoderFor(
+                oSamples.data() + nSample * nSampleSize, nSampleSize, eRep);
+            ASSERT_EQ(oF64[nSample], access_element::getValue(oDecoder, "f64").getFloat64());
+            ASSERT_EQ(oBits[nSample], access_element::getValue(oDecoder, "bits").getUInt8());
+            ASSERT_EQ(oU16[nSample], access_element::getValue(oDecoder, "u16").getUInt16());
+            ASSERT_EQ(oSBits[nSample], access_element::getValue(oDecoder, "sbits").getInt16());
+            ASSERT_EQ(oI32[nSample], access_element::getValue(oDecoder, "i32").getInt32());
+        }
+
+        // separate sample buffers in reverse order
+        std::vector<const void*> oSamplePointers;
+        for (size_t nSample = nSampleCount; nSample > 0; --nSample) {
+            oSamplePointers.push_back(oSamples.data() + (nSample - 1) * nSampleSize);
+        }
+        std::vector<int32_t> oReversedI32(nSampleCount);
+        std::vector<void*> oReversedColumns = oColumns;
+        oReversedColumns.back() = oReversedI32.data();
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  oBatch.decode(oSamplePointers, nSampleSize, oReversedColumns));
+        for (size_t nSample = 0; nSample < nSampleCount; ++nSample) {
+            ASSERT_EQ(oReversedI32[nSample], oI32[nSampleCount - 1 - nSample]);
+        }
+
+        // errors
+        ASSERT_NE(a_util::result::SUCCESS,
+                  oBatch.decode(oSamples.data(), nSampleCount, nSampleSize - 1, oColumns));
+        ASSERT_NE(a_util::result::SUCCESS,
+                  oBatch.decode(oSamples.data(),
+                                nSampleCount,
+                                nSampleSize,
+                                std::vector<void*>(oColumns.begin(), oColumns.end() - 1)));
+    }
+
+    BatchDecoder oInvalid(oFactory, {"u16", "unknown"});
+    ASSERT_NE(a_util::result::SUCCESS, oInvalid.isValid());
+    ASSERT_NE(a_util::result::SUCCESS, BatchDecoder().isValid());
+}
+
+/**
+ * @detail Compare the batch decoder with decoding every sample through access_element::getValue
+ */
+TEST(CodecTest, TestBatchDecoderPerf)
+{
+    CodecFactory oFactory("test", static_struct::strTestDesc);
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+    const std::vector<std::string> oNames = {"child[0].value[0]",
+                                             "child[0].value[2]",
+                                             "child[1].value[1]",
+                                             "child[1].value[2]"};
+
+    for (auto eRep: {deserialized, serialized}) {
+        const size_t nSampleCount = 20000;
+        const size_t nSampleSize = oFactory.getStaticBufferSize(eRep);
+        std::vector<uint8_t> oSamples(nSampleCount * nSampleSize);
+        for (size_t nByte = 0; nByte < oSamples.size(); ++nByte) {
+            oSamples[nByte] = static_cast<uint8_t>(nByte);
+        }
+
+        std::vector<std::vector<int32_t>> oReference(oNames.size(),
+                                                     std::vector<int32_t>(nSampleCount));
+        timestamp_t now = a_util::system::getCurrentMicroseconds();
+        for (size_t nSample = 0; nSample < nSampleCount; ++nSample) {
+            Decoder oDecoder = oFactory.makeDecoderFor(
+                oSamples.data() + nSample * nSampleSize, nSampleSize, eRep);
+            for (size_t nColumn = 0; nColumn < oNames.size(); ++nColumn) {
+                oReference[nColumn][nSample] =
+                    access_element::getValue(oDecoder, oNames[nColumn]).getInt32();
+            }
+        }
+        timestamp_t nTimeAccess = a_util::system::getCurrentMicroseconds() - now;
+
+        std::vector<std::vector<int32_t>> oResult(oNames.size(),
+                                                  std::vector<int32_t>(nSampleCount));
+        std::vector<void*> oColumns;
+        for (auto& oColumn: oResult) {
+            oColumns.push_back(oColumn.data());
+        }
+        now = a_util::system::getCurrentMicroseconds();
+        BatchDecoder oBatch(oFactory, oNames, eRep);
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  oBatch.decode(oSamples.data(), nSampleCount, nSampleSize, oColumns));
+        timestamp_t nTimeBatch = a_util::system::getCurrentMicroseconds() - now;
+
+        ASSERT_EQ(oReference, oResult);
+        std::cout << a_util::strings::format(
+                         "%s: access_element::getValue %lld us, BatchDecoder %lld us\n",
+                         eRep == deserialized ? "deserialized" : "serialized",
+                         nTimeAccess,
+                         nTimeBatch)
+                         .c_str();
+    }
+}
+
+/**
+ * @detail Check that decoders of the same factory share the dynamic layout for equal array sizes
+ */
+TEST(CodecTest, TestDynamicLayoutCache)
+{
+    CodecFactory oFactory("main", complex::strTestDesc);
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+
+    complex::tMain sFirst = complex::sTestData;
+    complex::tMain sSecond = complex::sTestData;
+    Decoder oFirst = oFactory.makeDecoderFor(&sFirst, sizeof(sFirst));
+    Decoder oSecond = oFactory.makeDecoderFor(&sSecond, sizeof(sSecond));
+    ASSERT_EQ(oFirst.getElementCount(), 23);
+    ASSERT_EQ(oSecond.getElementCount(), 23);
+    const StructElement* pFirstElement = nullptr;
+    const StructElement* pSecondElement = nullptr;
+    ASSERT_EQ(a_util::result::SUCCESS, oFirst.getElement(20, pFirstElement));
+    ASSERT_EQ(a_util::result::SUCCESS, oSecond.getElement(20, pSecondElement));
+    ASSERT_EQ(pFirstElement, pSecondElement);
+    ASSERT_EQ(pFirstElement->name, "test.array[1].fixed_array[1]");
+
+    // other array sizes result in another layout
+    complex::tMain sThird = complex::sTestData;
+    sThird.sTest.nArraySize = 1;
+    Decoder oThird = oFactory.makeDecoderFor(&sThird, sizeof(sThird));
+    ASSERT_EQ(oThird.getElementCount(), 13);
+    ASSERT_EQ(access_element::getValue(oThird, "test.array[0].child_array2[1]").getInt32(), 20);
+    size_t nIndex = 0;
+    ASSERT_NE(a_util::result::SUCCESS,
+              access_element::findIndex(oThird, "test.array[1].child_size", nIndex));
+
+    // the layout of a codec is determined at construction time
+    complex::tMain sFourth = complex::sTestData;
+    Codec oCodec = oFactory.makeCodecFor(&sFourth, sizeof(sFourth));
+    ASSERT_EQ(a_util::result::SUCCESS, access_element::setValue(oCodec, "test.array_size", 1));
+    ASSERT_EQ(oCodec.getElementCount(), 23);
+}
+
+/**
+ * @detail Check that threads reading the same decoder calculate its dynamic layout once
+ */
+TEST(CodecTest, TestDynamicLayoutThreads)
+{
+    CodecFactory oFactory("main", complex::strTestDesc);
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+    complex::tMain sTest = complex::sTestData;
+
+    for (size_t nRound = 0; nRound < 50; ++nRound) {
+        Decoder oDecoder = oFactory.makeDecoderFor(&sTest, sizeof(sTest));
+        const Decoder& oShared = oDecoder;
+        std::vector<std::thread> oThreads;
+        std::vector<const StructElement*> oElements(4, nullptr);
+        for (size_t nThread = 0; nThread < oElements.size(); ++nThread) {
+            oThreads.emplace_back(
+                [&, nThread]() { oShared.getElement(20, oElements[nThread]); });
+        }
+        for (auto& oThread: oThreads) {
+            oThread.join();
+        }
+        ASSERT_NE(oElements[0], nullptr);
+        ASSERT_EQ(oElements, std::vector<const StructElement*>(oElements.size(), oElements[0]));
+        ASSERT_EQ(oElements[0]->name, "test.array[1].fixed_array[1]");
+
+        // the layout moves with the decoder
+        const StructElement* pMovedElement = nullptr;
+        Decoder oMoved = std::move(oDecoder);
+        ASSERT_EQ(a_util::result::SUCCESS, oMoved.getElement(20, pMovedElement));
+        ASSERT_EQ(pMovedElement, oElements[0]);
+    }
+}
+
+/**
+ * @detail Measure the creation of decoders for dynamic data with cached dynamic layouts
+ */
+TEST(CodecTest, TestDynamicLayoutCachePerf)
+{
+    CodecFactory oFactory("main", complex::strTestDesc);
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+    complex::tMain sTest = complex::sTestData;
+
+    size_t nIndex = 0;
+    {
+        Decoder oDecoder = oFactory.makeDecoderFor(&sTest, sizeof(sTest));
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  access_element::findIndex(oDecoder, "test.array[1].child_array2[1]", nIndex));
+    }
+
+    const size_t nRepeats = 100000;
+    int64_t nSum = 0;
+    timestamp_t now = a_util::system::getCurrentMicroseconds();
+    for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+        Decoder oDecoder = oFactory.makeDecoderFor(&sTest, sizeof(sTest));
+        int32_t nValue = 0;
+        oDecoder.getElementValue(nIndex, &nValue);
+        nSum += nValue;
+    }
+    timestamp_t nTime = a_util::system::getCurrentMicroseconds() - now;
+
+    ASSERT_EQ(nSum, 220 * static_cast<int64_t>(nRepeats));
+    std::cout << a_util::strings::format(
+                     "%d dynamic decoders: %lld us\n", static_cast<int>(nRepeats), nTime)
+                     .c_str();
+}
+
+/**
+ * @detail Returns the address of the first element of a factory, equal for shared layouts
+ */
+static const StructElement* getFirstElement(const CodecFactory& oFactory)
+{
+    const StructElement* pElement = nullptr;
+    EXPECT_EQ(a_util::result::SUCCESS, oFactory.getStaticElement(0, pElement));
+    return pElement;
+}
+
+/**
+ * @detail Check that factories for equal content share their layout and parsed description
+ */
+TEST(CodecTest, TestStructLayoutCache)
+{
+    StructLayoutCache& oCache = StructLayoutCache::getInstance();
+    oCache.clear();
+    oCache.resetStatistics();
+
+    // factories from description strings
+    CodecFactory oFirst("test", static_struct::strTestDesc);
+    ASSERT_EQ(a_util::result::SUCCESS, oFirst.isValid());
+    CodecFactory oSecond("test", static_struct::strTestDesc);
+    ASSERT_EQ(a_util::result::SUCCESS, oSecond.isValid());
+    ASSERT_EQ(getFirstElement(oFirst), getFirstElement(oSecond));
+    CodecFactory oChild("child_struct", static_struct::strTestDesc);
+    ASSERT_EQ(a_util::result::SUCCESS, oChild.isValid());
+    ASSERT_EQ(oChild.getStaticElementCount(), 5);
+
+    StructLayoutCache::Statistics sStatistics = oCache.getStatistics();
+    ASSERT_EQ(sStatistics.layout_hits, 1);
+    ASSERT_EQ(sStatistics.layout_misses, 2);
+    ASSERT_EQ(sStatistics.layout_count, 2);
+    ASSERT_EQ(sStatistics.definition_hits, 1);
+    ASSERT_EQ(sStatistics.definition_misses, 1);
+    ASSERT_EQ(sStatistics.definition_count, 1);
+
+    // the errors stay the same
+    CodecFactory oMissing("missing", static_struct::strTestDesc);
+    ASSERT_EQ(oMissing.isValid().getErrorCode(), -38);
+    ASSERT_EQ(oMissing.getStaticElementCount(), 0);
+    CodecFactory oInvalid("test", "<structs><struct></structs>");
+    ASSERT_EQ(oInvalid.isValid().getErrorCode(), -38);
+    ASSERT_EQ(oCache.getStatistics().layout_count, 2);
+
+    // factories from data definitions are keyed by the content of the struct
+    const dd::DataDefinition oDD = DDString::fromXMLString(static_struct::strTestDesc);
+    const dd::DataDefinition oOtherDD = DDString::fromXMLString(static_struct::strTestDesc);
+    oCache.resetStatistics();
+    CodecFactory oFromDD(oDD.getStructTypeAccess("test"));
+    ASSERT_EQ(a_util::result::SUCCESS, oFromDD.isValid());
+    CodecFactory oFromOtherDD(*oOtherDD.getStructTypes().get("test"), oOtherDD);
+    ASSERT_EQ(a_util::result::SUCCESS, oFromOtherDD.isValid());
+    ASSERT_EQ(getFirstElement(oFromDD), getFirstElement(oFromOtherDD));
+    ASSERT_NE(getFirstElement(oFromDD), getFirstElement(oFirst));
+    sStatistics = oCache.getStatistics();
+    ASSERT_EQ(sStatistics.layout_hits, 1);
+    ASSERT_EQ(sStatistics.layout_misses, 1);
+
+    // any change of the content results in another layout
+    std::string strChanged = static_struct::strTestDesc;
+    strChanged.replace(strChanged.find("name=\"after\""), 12, "name=\"later\"");
+    const dd::DataDefinition oChangedDD = DDString::fromXMLString(strChanged);
+    CodecFactory oChanged(oChangedDD.getStructTypeAccess("test"));
+    ASSERT_EQ(a_util::result::SUCCESS, oChanged.isValid());
+    ASSERT_NE(getFirstElement(oChanged), getFirstElement(oFromDD));
+    size_t nIndex = 0;
+    ASSERT_EQ(a_util::result::SUCCESS, oChanged.findElementIndex("child[1].later", nIndex));
+    ASSERT_NE(a_util::result::SUCCESS, oFromDD.findElementIndex("child[1].later", nIndex));
+    ASSERT_EQ(oCache.getStatistics().layout_misses, 2);
+
+    // the least recently used entries are evicted first
+    oCache.setCapacity(2);
+    ASSERT_EQ(oCache.getStatistics().layout_count, 2);
+    CodecFactory oThird("test", static_struct::strTestDesc);
+    ASSERT_EQ(oCache.getStatistics().layout_misses, 3);
+    CodecFactory oChangedAgain(oChangedDD.getStructTypeAccess("test"));
+    ASSERT_EQ(getFirstElement(oChangedAgain), getFirstElement(oChanged));
+    CodecFactory oFromDDAgain(oDD.getStructTypeAccess("test"));
+    ASSERT_NE(getFirstElement(oFromDDAgain), getFirstElement(oFromDD));
+    sStatistics = oCache.getStatistics();
+    ASSERT_EQ(sStatistics.layout_hits, 2);
+    ASSERT_EQ(sStatistics.layout_misses, 4);
+    ASSERT_EQ(sStatistics.layout_count, 2);
+
+    // without capacity nothing is cached, existing factories keep working
+    oCache.setCapacity(0);
+    CodecFactory oUncached("test", static_struct::strTestDesc);
+    ASSERT_EQ(a_util::result::SUCCESS, oUncached.isValid());
+    ASSERT_EQ(oCache.getStatistics().layout_count, 0);
+    static_struct::tTest sValue = static_struct::sTestData;
+    StaticDecoder oDecoder = oFirst.makeStaticDecoderFor(&sValue, sizeof(sValue));
+    ASSERT_EQ(access_element::getValue(oDecoder, "child[1].after").asInt32(), 0x0A);
+    oCache.setCapacity(StructLayoutCache::default_capacity);
+}
+
+/**
+ * @detail Check that structs differing only in the default values do not share their layout
+ */
+TEST(CodecTest, TestStructLayoutCacheDefaults)
+{
+    std::string strDefault7 = static_struct::strTestDesc;
+    strDefault7.replace(strDefault7.find("name=\"after\""), 12, "default=\"7\" name=\"after\"");
+    std::string strDefault99 = static_struct::strTestDesc;
+    strDefault99.replace(
+        strDefault99.find("name=\"after\""), 12, "default=\"99\" name=\"after\"");
+    const dd::DataDefinition oDD7 = DDString::fromXMLString(strDefault7);
+    const dd::DataDefinition oDD99 = DDString::fromXMLString(strDefault99);
+
+    CodecFactory oFactory7(oDD7.getStructTypeAccess("test"));
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory7.isValid());
+    CodecFactory oFactory99(oDD99.getStructTypeAccess("test"));
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory99.isValid());
+    ASSERT_NE(getFirstElement(oFactory7), getFirstElement(oFactory99));
+
+    std::vector<uint8_t> oSample7 = oFactory7.getDefaultSample(deserialized);
+    std::vector<uint8_t> oSample99 = oFactory99.getDefaultSample(deserialized);
+    StaticDecoder oDecoder7 = oFactory7.makeStaticDecoderFor(oSample7.data(), oSample7.size());
+    StaticDecoder oDecoder99 = oFactory99.makeStaticDecoderFor(oSample99.data(), oSample99.size());
+    ASSERT_EQ(access_element::getValue(oDecoder7, "child[1].after").asInt32(), 7);
+    ASSERT_EQ(access_element::getValue(oDecoder99, "child[1].after").asInt32(), 99);
+}
+
+/**
+ * @detail Check that the cache can be used by many threads concurrently
+ */
+TEST(CodecTest, TestStructLayoutCacheThreads)
+{
+    StructLayoutCache& oCache = StructLayoutCache::getInstance();
+    oCache.clear();
+    oCache.setCapacity(3);
+    const dd::DataDefinition oDD = DDString::fromXMLString(complex::strTestDesc);
+    const char* aStructNames[] = {"main", "test", "child_struct", "test"};
+
+    std::vector<std::thread> oThreads;
+    std::vector<size_t> oFailures(8, 0);
+    for (size_t nThread = 0; nThread < oFailures.size(); ++nThread) {
+        oThreads.emplace_back([&, nThread]() {
+            for (size_t nRound = 0; nRound < 200; ++nRound) {
+                const char* strStruct = aStructNames[(nThread + nRound) % 4];
+                CodecFactory oFromString(strStruct, complex::strTestDesc);
+                CodecFactory oFromDD(oDD.getStructTypeAccess(strStruct));
+                if (isFailed(oFromString.isValid()) || isFailed(oFromDD.isValid()) ||
+                    oFromString.getStaticElementCount() != oFromDD.getStaticElementCount()) {
+                    ++oFailures[nThread];
+                }
+            }
+        });
+    }
+    for (auto& oThread: oThreads) {
+        oThread.join();
+    }
+
+    ASSERT_EQ(oFailures, std::vector<size_t>(oFailures.size(), 0));
+    ASSERT_LE(oCache.getStatistics().layout_count, 3);
+    oCache.setCapacity(StructLayoutCache::default_capacity);
+}
+
+/**
+ * @detail Measure the repeated construction of factories with and without the layout cache
+ */
+TEST(CodecTest, TestStructLayoutCachePerf)
+{
+    StructLayoutCache& oCache = StructLayoutCache::getInstance();
+    const dd::DataDefinition oDD = DDString::fromXMLString(byte_swap::strTestDesc);
+    const size_t nRepeats = 200;
+    timestamp_t aTimes[2][2];
+    for (size_t nCached = 0; nCached < 2; ++nCached) {
+        oCache.clear();
+        oCache.setCapacity(nCached ? StructLayoutCache::default_capacity : 0);
+        timestamp_t now = a_util::system::getCurrentMicroseconds();
+        for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+            CodecFactory oFactory("signals", byte_swap::strTestDesc);
+            ASSERT_EQ(oFactory.getStaticElementCount(), 1082);
+        }
+        aTimes[nCached][0] = a_util::system::getCurrentMicroseconds() - now;
+
+        now = a_util::system::getCurrentMicroseconds();
+        for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+            CodecFactory oFactory(oDD.getStructTypeAccess("signals"));
+            ASSERT_EQ(oFactory.getStaticElementCount(), 1082);
+        }
+        aTimes[nCached][1] = a_util::system::getCurrentMicroseconds() - now;
+    }
+    oCache.setCapacity(StructLayoutCache::default_capacity);
+
+    std::cout << a_util::strings::format("%d factories from strings: uncached %lld us, cached "
+                                         "%lld us\n%d factories from DataDefinitions: uncached "
+                                         "%lld us, cached %lld us\n",
+                                         static_cast<int>(nRepeats),
+                                         aTimes[0][0],
+                                         aTimes[1][0],
+                                         static_cast<int>(nRepeats),
+                                         aTimes[0][1],
+                                         aTimes[1][1])
+                     .c_str();
+}
+
+/**
+ * @detail Check projections onto selected elements of static and dynamic structs
+ */
+TEST(CodecTest, TestProjection)
+{
+    CodecFactory oFactory("test", static_struct::strTestDesc);
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+    CodecFactory oProjection = oFactory.makeProjection({"child[1].value[*]", "child[0].after"});
+    ASSERT_EQ(a_util::result::SUCCESS, oProjection.isValid());
+    ASSERT_EQ(oProjection.getStaticElementCount(), 4);
+    ASSERT_EQ(oProjection.getStaticBufferSize(), oFactory.getStaticBufferSize());
+    ASSERT_EQ(oProjection.getStaticBufferSize(serialized),
+              oFactory.getStaticBufferSize(serialized));
+
+    static_struct::tTest sValue = static_struct::sTestData;
+    const char* aNames[] = {"child[1].value[0]", "child[1].value[1]", "child[1].value[2]",
+                            "child[0].after"};
+    Decoder oFullDecoder = oFactory.makeDecoderFor(&sValue, sizeof(sValue));
+    Decoder oDecoder = oProjection.makeDecoderFor(&sValue, sizeof(sValue));
+    ASSERT_EQ(a_util::result::SUCCESS, oDecoder.isValid());
+    ASSERT_EQ(oDecoder.getElementCount(), 4);
+    for (size_t nIndex = 0; nIndex < 4; ++nIndex) {
+        const StructElement* pElement = nullptr;
+        ASSERT_EQ(a_util::result::SUCCESS, oDecoder.getElement(nIndex, pElement));
+        ASSERT_EQ(pElement->name, aNames[nIndex]);
+        size_t nFoundIndex = 0;
+        ASSERT_EQ(a_util::result::SUCCESS, oDecoder.findElementIndex(aNames[nIndex], nFoundIndex));
+        ASSERT_EQ(nFoundIndex, nIndex);
+        ASSERT_EQ(access_element::getValue(oDecoder, nIndex),
+                  access_element::getValue(oFullDecoder, aNames[nIndex]));
+    }
+    size_t nIndex = 0;
+    ASSERT_EQ(a_util::result::SUCCESS, oDecoder.findElementIndexByPrefix("child[1].", nIndex));
+    ASSERT_EQ(nIndex, 0);
+    ASSERT_NE(a_util::result::SUCCESS, oDecoder.findElementIndex("child[0].value[0]", nIndex));
+
+    // codecs write through to the data
+    StaticCodec oCodec = oProjection.makeStaticCodecFor(&sValue, sizeof(sValue));
+    ASSERT_EQ(a_util::result::SUCCESS, oCodec.setElementValue(3, int8_t(42)));
+    ASSERT_EQ(sValue.sChild[0].nAfter, 42);
+
+    // duplicates are removed, unknown names and patterns without any match are rejected
+    ASSERT_EQ(oFactory.makeProjection({"child[0].after", "child[?].after"}).getStaticElementCount(),
+              2);
+    ASSERT_EQ(oFactory.makeProjection({"child[0].missing"}).isValid().getErrorCode(), -20);
+    ASSERT_EQ(oFactory.makeProjection({"*.missing*"}).isValid().getErrorCode(), -20);
+    ASSERT_EQ(oFactory.makeProjection({"*"}).getStaticElementCount(),
+              oFactory.getStaticElementCount());
+}
+
+/**
+ * @detail Check projections onto elements before and after the first dynamic array
+ */
+TEST(CodecTest, TestProjectionDynamic)
+{
+    CodecFactory oFactory("main", complex::strTestDesc);
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+
+    // static elements only, the dynamic section is never calculated
+    CodecFactory oStaticProjection = oFactory.makeProjection({"test.array_size", "before"});
+    ASSERT_EQ(a_util::result::SUCCESS, oStaticProjection.isValid());
+    complex::tMain sValue = complex::sTestData;
+    const size_t nStaticSize = oFactory.getStaticBufferSize();
+    ASSERT_EQ(oFactory.makeDecoderFor(&sValue, nStaticSize).isValid().getErrorCode(), -5);
+    Decoder oStaticDecoder = oStaticProjection.makeDecoderFor(&sValue, nStaticSize);
+    ASSERT_EQ(a_util::result::SUCCESS, oStaticDecoder.isValid());
+    ASSERT_EQ(oStaticDecoder.getElementCount(), 2);
+    ASSERT_EQ(access_element::getValue(oStaticDecoder, 0).asInt32(), 2);
+    ASSERT_EQ(access_element::getValue(oStaticDecoder, 1).asInt32(), 4);
+
+    // elements of the dynamic section are located per sample
+    CodecFactory oProjection =
+        oFactory.makeProjection({"test.array[1].child_array2[1]", "before", "after"});
+    ASSERT_EQ(a_util::result::SUCCESS, oProjection.isValid());
+    ASSERT_EQ(oProjection.getStaticElementCount(), 1);
+    Decoder oDecoder = oProjection.makeDecoderFor(&sValue, sizeof(sValue));
+    ASSERT_EQ(a_util::result::SUCCESS, oDecoder.isValid());
+    ASSERT_EQ(oDecoder.getElementCount(), 3);
+    ASSERT_EQ(access_element::getValue(oDecoder, 0).asInt32(), 4);
+    ASSERT_EQ(access_element::getValue(oDecoder, 1).asInt32(), 220);
+    ASSERT_EQ(access_element::getValue(oDecoder, 2).asInt32(), 8);
+    size_t nIndex = 0;
+    ASSERT_EQ(a_util::result::SUCCESS, oDecoder.findElementIndex("after", nIndex));
+    ASSERT_EQ(nIndex, 2);
+    const StructElement* pElement = nullptr;
+    ASSERT_EQ(a_util::result::SUCCESS, oDecoder.getElement(1, pElement));
+    ASSERT_EQ(pElement->name, "test.array[1].child_array2[1]");
+
+    // the serialized representation
+    a_util::memory::MemoryBuffer oBuffer;
+    ASSERT_EQ(a_util::result::SUCCESS,
+              serialization::transformToBuffer(
+                  oFactory.makeDecoderFor(&sValue, sizeof(sValue)), oBuffer, true));
+    Decoder oSerializedDecoder =
+        oProjection.makeDecoderFor(oBuffer.getPtr(), oBuffer.getSize(), serialized);
+    ASSERT_EQ(a_util::result::SUCCESS, oSerializedDecoder.isValid());
+    ASSERT_EQ(access_element::getValue(oSerializedDecoder, 1).asInt32(), 220);
+    ASSERT_EQ(access_element::getValue(oSerializedDecoder, 2).asInt32(), 8);
+
+    // only the selected elements of a projection are transformed, element by element
+    a_util::memory::MemoryBuffer oProjectedBuffer;
+    ASSERT_EQ(a_util::result::SUCCESS,
+              serialization::transformToBuffer(oDecoder, oProjectedBuffer, true));
+    ASSERT_EQ(oProjectedBuffer.getSize(), oBuffer.getSize());
+    const uint8_t* pProjected = static_cast<const uint8_t*>(oProjectedBuffer.getPtr());
+    const uint8_t* pFull = static_cast<const uint8_t*>(oBuffer.getPtr());
+    size_t nWrittenBytes = 0;
+    for (size_t nByte = 0; nByte < oBuffer.getSize(); ++nByte) {
+        ASSERT_TRUE(pProjected[nByte] == 0 || pProjected[nByte] == pFull[nByte]);
+        nWrittenBytes += pProjected[nByte] != 0;
+    }
+    ASSERT_LE(nWrittenBytes, 3 * sizeof(int32_t));
+    const size_t nDynamicOffset =
+        static_cast<const uint8_t*>(oSerializedDecoder.getElementAddress(1)) - pFull;
+    ASSERT_EQ(std::memcmp(pProjected + nDynamicOffset, pFull + nDynamicOffset, sizeof(int32_t)),
+              0);
+
+    // samples without the element
+    complex::tMain sShort = complex::sTestData;
+    sShort.sTest.nArraySize = 1;
+    oDecoder = oProjection.makeDecoderFor(&sShort, sizeof(sShort));
+    ASSERT_EQ(a_util::result::SUCCESS, oDecoder.isValid());
+    int32_t nValue = 0;
+    ASSERT_EQ(oDecoder.getElementValue(1, &nValue).getErrorCode(), -10);
+    ASSERT_EQ(access_element::getValue(oDecoder, 0).asInt32(), 4);
+
+    // glob patterns are only matched against the static elements
+    ASSERT_EQ(oFactory.makeProjection({"test.array[*]*"}).isValid().getErrorCode(), -20);
+
+    // names of the dynamic section have to be element paths of the struct
+    ASSERT_EQ(oFactory.makeProjection({"test.aray[1].child_array2[1]"}).isValid().getErrorCode(),
+              -20);
+    ASSERT_EQ(oFactory.makeProjection({"test.array[1].child_array3[1]"}).isValid().getErrorCode(),
+              -20);
+    ASSERT_EQ(oFactory.makeProjection({"test.array.child_array2[1]"}).isValid().getErrorCode(),
+              -20);
+    ASSERT_EQ(oFactory.makeProjection({"aftr"}).isValid().getErrorCode(), -20);
+
+    // a projection of a projection locates the elements within the full layout
+    CodecFactory oNested = oProjection.makeProjection({"after", "test.array[1].child_array2[1]"});
+    ASSERT_EQ(a_util::result::SUCCESS, oNested.isValid());
+    ASSERT_EQ(oNested.getStaticElementCount(), 0);
+    ASSERT_EQ(oProjection.makeProjection({"before", "test.array[0].child_array2[1]"})
+                  .isValid()
+                  .getErrorCode(),
+              -20);
+    Decoder oNestedDecoder = oNested.makeDecoderFor(&sValue, sizeof(sValue));
+    ASSERT_EQ(a_util::result::SUCCESS, oNestedDecoder.isValid());
+    ASSERT_EQ(oNestedDecoder.getElementCount(), 2);
+    ASSERT_EQ(access_element::getValue(oNestedDecoder, 0).asInt32(), 8);
+    ASSERT_EQ(access_element::getValue(oNestedDecoder, 1).asInt32(), 220);
+}
+
+namespace projection {
+/// A large struct with a dynamic array of which only a few elements are needed.
+std::string createDescription()
+{
+    return "<?xml version=\"1.0\" encoding=\"iso-8859-1\" standalone=\"no\"?>"
+           "<struct alignment=\"1\" name=\"frame\" version=\"2\">"
+           "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" bytepos=\"0\" "
+           "name=\"counter\" type=\"tUInt32\"/>"
+           "<element alignment=\"1\" arraysize=\"3000\" byteorder=\"LE\" bytepos=\"4\" "
+           "name=\"signals\" type=\"tFloat32\"/>"
+           "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" bytepos=\"12004\" "
+           "name=\"sample_count\" type=\"tUInt32\"/>"
+           "<element alignment=\"1\" arraysize=\"sample_count\" byteorder=\"LE\" "
+           "bytepos=\"12008\" name=\"samples\" type=\"tInt16\"/>"
+           "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" bytepos=\"-1\" "
+           "name=\"checksum\" type=\"tUInt32\"/>"
+           "</struct>";
+}
+} // namespace projection
+
+/**
+ * @detail Compare reading a few elements per sample with and without a projection
+ */
+TEST(CodecTest, TestProjectionPerf)
+{
+    CodecFactory oFactory("frame", projection::createDescription());
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+    const std::vector<std::string> oNames = {
+        "counter", "signals[10]", "signals[1500]", "signals[2999]", "sample_count"};
+    CodecFactory oProjection = oFactory.makeProjection(oNames);
+    ASSERT_EQ(a_util::result::SUCCESS, oProjection.isValid());
+
+    std::vector<uint8_t> oSample(12008 + 500 * 2 + 4, 0);
+    const uint32_t nSampleCount = 500;
+    std::memcpy(oSample.data() + 12004, &nSampleCount, sizeof(nSampleCount));
+    std::vector<size_t> oFullIndices(oNames.size());
+    for (size_t nName = 0; nName < oNames.size(); ++nName) {
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  oFactory.findElementIndex(oNames[nName], oFullIndices[nName]));
+    }
+
+    const size_t nRepeats = 20000;
+    double fSum = 0;
+    timestamp_t now = a_util::system::getCurrentMicroseconds();
+    for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+        Decoder oDecoder = oFactory.makeDecoderFor(oSample.data(), oSample.size());
+        if (isOk(oDecoder.isValid())) {
+            for (const size_t nIndex: oFullIndices) {
+                fSum += access_element::getValue(oDecoder, nIndex).asDouble();
+            }
+        }
+    }
+    timestamp_t nTimeFull = a_util::system::getCurrentMicroseconds() - now;
+
+    now = a_util::system::getCurrentMicroseconds();
+    for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+        Decoder oDecoder = oProjection.makeDecoderFor(oSample.data(), oSample.size());
+        if (isOk(oDecoder.isValid())) {
+            for (size_t nIndex = 0; nIndex < oNames.size(); ++nIndex) {
+                fSum -= access_element::getValue(oDecoder, nIndex).asDouble();
+            }
+        }
+    }
+    timestamp_t nTimeProjection = a_util::system::getCurrentMicroseconds() - now;
+
+    ASSERT_EQ(fSum, 0.0);
+    std::cout << a_util::strings::format("%d samples, %d of %d elements: full decoder %lld us, "
+                                         "projection %lld us\n",
+                                         static_cast<int>(nRepeats),
+                                         static_cast<int>(oNames.size()),
+                                         static_cast<int>(oFactory.makeDecoderFor(
+                                             oSample.data(), oSample.size()).getElementCount()),
+                                         nTimeFull,
+                                         nTimeProjection)
+                     .c_str();
+}
+
+namespace default_sample {
+/// A struct with default values, constants and a bit-packed constant.
+const char* strTestDesc = "<?xml version=\"1.0\" encoding=\"iso-8859-1\" standalone=\"no\"?>"
+                          "<adtf:ddl>"
+                          "<enums>"
+                          "<enum name=\"tMode\" type=\"tUInt32\">"
+                          "<element name=\"OFF\" value=\"0\"/>"
+                          "<element name=\"FORTYTWO\" value=\"42\"/>"
+                          "</enum>"
+                          "<enum name=\"tBits\" type=\"tUInt8\">"
+                          "<element name=\"FIVE\" value=\"5\"/>"
+                          "</enum>"
+                          "</enums>"
+                          "<structs>"
+                          "<struct alignment=\"1\" name=\"main\" version=\"1\">"
+                          "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" bytepos=\"0\" "
+                          "name=\"counter\" type=\"tUInt32\" default=\"7\"/>"
+                          "<element alignment=\"1\" arraysize=\"1\" byteorder=\"BE\" bytepos=\"4\" "
+                          "name=\"mode\" type=\"tMode\" value=\"FORTYTWO\"/>"
+                          "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" bytepos=\"8\" "
+                          "bitpos=\"2\" numbits=\"3\" name=\"bits\" type=\"tBits\" value=\"FIVE\"/>"
+                          "<element alignment=\"1\" arraysize=\"1\" byteorder=\"BE\" bytepos=\"9\" "
+                          "name=\"scale\" type=\"tFloat64\" default=\"1.5\"/>"
+                          "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" "
+                          "bytepos=\"17\" name=\"zero\" type=\"tInt16\"/>"
+                          "</struct>"
+                          "</structs>"
+                          "</adtf:ddl>";
+
+void checkValues(const StaticDecoder& oDecoder, int64_t nCounter)
+{
+    ASSERT_EQ(access_element::getValue(oDecoder, "counter").asInt64(), nCounter);
+    ASSERT_EQ(access_element::getValue(oDecoder, "mode").asInt64(), 42);
+    ASSERT_EQ(access_element::getValue(oDecoder, "bits").asInt64(), 5);
+}
+} // namespace default_sample
+
+/**
+ * @detail Check the default sample of a factory and setting constants from it.
+ */
+TEST(CodecTest, TestDefaultSample)
+{
+    CodecFactory oFactory("main", default_sample::strTestDesc);
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+
+    for (const DataRepresentation eRep: {deserialized, serialized}) {
+        const std::vector<uint8_t>& oSample = oFactory.getDefaultSample(eRep);
+        ASSERT_EQ(oSample.size(), oFactory.getStaticBufferSize(eRep));
+        ASSERT_EQ(&oSample, &oFactory.getDefaultSample(eRep));
+        StaticDecoder oDecoder =
+            oFactory.makeStaticDecoderFor(oSample.data(), oSample.size(), eRep);
+        ASSERT_EQ(a_util::result::SUCCESS, oDecoder.isValid());
+        default_sample::checkValues(oDecoder, 7);
+        ASSERT_EQ(access_element::getValue(oDecoder, "scale").asDouble(), 1.5);
+        ASSERT_EQ(access_element::getValue(oDecoder, "zero").asInt64(), 0);
+
+        // only the constants are set, all other values are kept
+        std::vector<uint8_t> oBuffer(oSample.size(), 0xFF);
+        StaticCodec oCodec = oFactory.makeStaticCodecFor(oBuffer.data(), oBuffer.size(), eRep);
+        ASSERT_EQ(a_util::result::SUCCESS, oCodec.setConstants());
+        default_sample::checkValues(oCodec, 0xFFFFFFFF);
+        ASSERT_EQ(access_element::getValue(oCodec, "zero").asInt64(), -1);
+
+        std::fill(oBuffer.begin(), oBuffer.end(), 0xFF);
+        Codec oDynamicCodec = oFactory.makeCodecFor(oBuffer.data(), oBuffer.size(), eRep);
+        ASSERT_EQ(a_util::result::SUCCESS, oDynamicCodec.setConstants());
+        default_sample::checkValues(oDynamicCodec, 0xFFFFFFFF);
+    }
+
+    // projections share the sample of their source
+    CodecFactory oProjection = oFactory.makeProjection({"mode"});
+    ASSERT_EQ(a_util::result::SUCCESS, oProjection.isValid());
+    ASSERT_EQ(&oFactory.getDefaultSample(), &oProjection.getDefaultSample());
+    std::vector<uint8_t> oBuffer(oFactory.getStaticBufferSize(), 0);
+    StaticCodec oCodec = oProjection.makeStaticCodecFor(oBuffer.data(), oBuffer.size());
+    ASSERT_EQ(a_util::result::SUCCESS, oCodec.setConstants());
+    ASSERT_EQ(access_element::getValue(oCodec, 0).asInt64(), 42);
+}
+
+/**
+ * @detail Compare resetting a sample element by element to copying the default sample.
+ */
+TEST(CodecTest, TestDefaultSamplePerf)
+{
+    CodecFactory oFactory("frame", projection::createDescription());
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+    std::vector<uint8_t> oBuffer(oFactory.getStaticBufferSize(), 0xFF);
+    StaticCodec oCodec = oFactory.makeStaticCodecFor(oBuffer.data(), oBuffer.size());
+    const size_t nElementCount = oCodec.getElementCount();
+
+    const size_t nRepeats = 1000;
+    timestamp_t now = a_util::system::getCurrentMicroseconds();
+    for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+        for (size_t nElement = 0; nElement < nElementCount; ++nElement) {
+            const StructElement* pElement = nullptr;
+            if (isOk(oCodec.getElement(nElement, pElement))) {
+                access_element::reset(oCodec, pElement->name);
+            }
+        }
+        ASSERT_EQ(a_util::result::SUCCESS, oCodec.setConstants());
+    }
+    timestamp_t nTimeElements = a_util::system::getCurrentMicroseconds() - now;
+    ASSERT_EQ(oBuffer, oFactory.getDefaultSample());
+
+    std::fill(oBuffer.begin(), oBuffer.end(), 0xFF);
+    now = a_util::system::getCurrentMicroseconds();
+    for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+        const std::vector<uint8_t>& oSample = oFactory.getDefaultSample();
+        std::copy(oSample.begin(), oSample.end(), oBuffer.begin());
+    }
+    timestamp_t nTimeSample = a_util::system::getCurrentMicroseconds() - now;
+    ASSERT_EQ(oBuffer, oFactory.getDefaultSample());
+
+    std::cout << a_util::strings::format("%d resets of %d elements: element by element %lld us, "
+                                         "default sample %lld us\n",
+                                         static_cast<int>(nRepeats),
+                                         static_cast<int>(nElementCount),
+                                         nTimeElements,
+                                         nTimeSample)
+                     .c_str();
+}
+
+/**
+ * @detail Check encoding and applying the changed elements of static samples.
+ */
+TEST(CodecTest, TestDeltaCodec)
+{
+    CodecFactory oFactory("main", default_sample::strTestDesc);
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+    ASSERT_NE(a_util::result::SUCCESS, DeltaCodec().isValid());
+    ASSERT_EQ(-19, DeltaCodec(oFactory.makeProjection({"mode"})).isValid().getErrorCode());
+
+    for (const DataRepresentation eRep: {deserialized, serialized}) {
+        DeltaCodec oDeltaCodec(oFactory, eRep);
+        ASSERT_EQ(a_util::result::SUCCESS, oDeltaCodec.isValid());
+        const std::vector<uint8_t>& oBase = oFactory.getDefaultSample(eRep);
+        std::vector<uint8_t> oSample = oBase;
+
+        // no changes, only the header
+        std::vector<uint8_t> oDelta;
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  oDeltaCodec.encode(
+                      oBase.data(), oBase.size(), oSample.data(), oSample.size(), oDelta));
+        ASSERT_EQ(oDelta.size(), 3);
+
+        StaticCodec oCodec = oFactory.makeStaticCodecFor(oSample.data(), oSample.size(), eRep);
+        ASSERT_EQ(a_util::result::SUCCESS, access_element::setValue(oCodec, "counter", 8));
+        ASSERT_EQ(a_util::result::SUCCESS, access_element::setValue(oCodec, "bits", 3));
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  oDeltaCodec.encode(
+                      oBase.data(), oBase.size(), oSample.data(), oSample.size(), oDelta));
+        ASSERT_EQ(oDelta.size(), 3 + 1 + 4 + 1 + 1);
+
+        std::vector<uint8_t> oResult = oBase;
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  oDeltaCodec.apply(oDelta.data(), oDelta.size(), oResult));
+        ASSERT_EQ(oResult, oSample);
+
+        // without a base, all non-zero elements are encoded
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  oDeltaCodec.encode(nullptr, 0, oSample.data(), oSample.size(), oDelta));
+        oResult.clear();
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  oDeltaCodec.apply(oDelta.data(), oDelta.size(), oResult));
+        ASSERT_EQ(oResult, oSample);
+
+        // corrupt deltas leave the sample unchanged, even if their first entries are valid
+        oResult = oBase;
+        ASSERT_EQ(-5, oDeltaCodec.apply(oDelta.data(), 2, oResult).getErrorCode());
+        oDelta.push_back(100);
+        ASSERT_EQ(-5, oDeltaCodec.apply(oDelta.data(), oDelta.size(), oResult).getErrorCode());
+        ASSERT_EQ(oResult, oBase);
+    }
+}
+
+/**
+ * @detail Check encoding and applying the changed elements of samples with dynamic arrays.
+ */
+TEST(CodecTest, TestDeltaCodecDynamic)
+{
+    CodecFactory oFactory("frame", projection::createDescription());
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+    DeltaCodec oDeltaCodec(oFactory);
+    ASSERT_EQ(a_util::result::SUCCESS, oDeltaCodec.isValid());
+
+    auto createSample = [&](uint32_t nSampleCount, int16_t nOffset) {
+        std::vector<uint8_t> oSample(12008 + nSampleCount * 2 + 4, 0);
+        std::memcpy(oSample.data() + 12004, &nSampleCount, sizeof(nSampleCount));
+        Codec oCodec = oFactory.makeCodecFor(oSample.data(), oSample.size());
+        for (uint32_t nIndex = 0; nIndex < nSampleCount; ++nIndex) {
+            access_element::setValue(oCodec,
+                                     a_util::strings::format("samples[%u]", nIndex),
+                                     static_cast<int16_t>(nIndex + nOffset));
+        }
+        access_element::setValue(oCodec, "checksum", nSampleCount + nOffset);
+        return oSample;
+    };
+
+    const std::vector<uint8_t> oBase = createSample(100, 0);
+    for (const uint32_t nSampleCount: {100, 150, 20}) {
+        const std::vector<uint8_t> oSample = createSample(nSampleCount, 1);
+        std::vector<uint8_t> oDelta;
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  oDeltaCodec.encode(
+                      oBase.data(), oBase.size(), oSample.data(), oSample.size(), oDelta));
+        ASSERT_LT(oDelta.size(), oSample.size() / 10);
+
+        std::vector<uint8_t> oResult = oBase;
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  oDeltaCodec.apply(oDelta.data(), oDelta.size(), oResult));
+        ASSERT_EQ(oResult, oSample);
+    }
+
+    // samples growing by more than their changed elements are sent as a whole
+    std::vector<uint8_t> oZeros(12008 + 2000 * 2 + 4, 0);
+    const uint32_t nZeroCount = 2000;
+    std::memcpy(oZeros.data() + 12004, &nZeroCount, sizeof(nZeroCount));
+    std::vector<uint8_t> oDelta;
+    ASSERT_EQ(
+        a_util::result::SUCCESS,
+        oDeltaCodec.encode(oBase.data(), oBase.size(), oZeros.data(), oZeros.size(), oDelta));
+    ASSERT_EQ(oDelta.size(), oZeros.size() + 3);
+    std::vector<uint8_t> oResult = oBase;
+    ASSERT_EQ(a_util::result::SUCCESS, oDeltaCodec.apply(oDelta.data(), oDelta.size(), oResult));
+    ASSERT_EQ(oResult, oZeros);
+
+    // the sizes within a corrupt delta do not fit to its length
+    oResult = oBase;
+    const std::vector<uint8_t> oHugeSample = {0, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 1, 100, 0, 1, 2};
+    ASSERT_EQ(-5,
+              oDeltaCodec.apply(oHugeSample.data(), oHugeSample.size(), oResult).getErrorCode());
+    const std::vector<uint8_t> oHugeArray = {0, 0xB4, 0x5F, 1, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F};
+    ASSERT_EQ(-5,
+              oDeltaCodec.apply(oHugeArray.data(), oHugeArray.size(), oResult).getErrorCode());
+    ASSERT_EQ(oResult, oBase);
+
+    // a delta growing the sample, which is corrupt after its valid entries
+    const std::vector<uint8_t> oGrown = createSample(150, 1);
+    ASSERT_EQ(
+        a_util::result::SUCCESS,
+        oDeltaCodec.encode(oBase.data(), oBase.size(), oGrown.data(), oGrown.size(), oDelta));
+    oDelta.push_back(100);
+    ASSERT_EQ(-5, oDeltaCodec.apply(oDelta.data(), oDelta.size(), oResult).getErrorCode());
+    ASSERT_EQ(oResult, oBase);
+}
+
+/**
+ * @detail Measure the compression ratio and the throughput of the delta codec for a stream
+ * in which only a few elements change from sample to sample.
+ */
+TEST(CodecTest, TestDeltaCodecPerf)
+{
+    CodecFactory oFactory("frame", projection::createDescription());
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+    DeltaCodec oDeltaCodec(oFactory);
+
+    const uint32_t nSampleCount = 500;
+    std::vector<uint8_t> oPrevious(12008 + nSampleCount * 2 + 4, 0);
+    std::memcpy(oPrevious.data() + 12004, &nSampleCount, sizeof(nSampleCount));
+    std::vector<uint8_t> oSample = oPrevious;
+    std::vector<uint8_t> oReceived = oPrevious;
+    Codec oCodec = oFactory.makeCodecFor(oSample.data(), oSample.size());
+    std::vector<size_t> oChangedIndices;
+    for (const char* strName:
+         {"counter", "signals[3]", "signals[700]", "signals[2500]", "checksum"}) {
+        size_t nIndex = 0;
+        ASSERT_EQ(a_util::result::SUCCESS, oCodec.findElementIndex(strName, nIndex));
+        oChangedIndices.push_back(nIndex);
+    }
+
+    const size_t nRepeats = 2000;
+    size_t nDeltaBytes = 0;
+    timestamp_t nTimeEncode = 0, nTimeApply = 0;
+    std::vector<uint8_t> oDelta;
+    for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+        for (const size_t nIndex: oChangedIndices) {
+            oCodec.setElementValue(
+                nIndex, a_util::variant::Variant(static_cast<uint32_t>(nRound + nIndex)));
+        }
+
+        timestamp_t now = a_util::system::getCurrentMicroseconds();
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  oDeltaCodec.encode(
+                      oPrevious.data(), oPrevious.size(), oSample.data(), oSample.size(), oDelta));
+        nTimeEncode += a_util::system::getCurrentMicroseconds() - now;
+        nDeltaBytes += oDelta.size();
+
+        now = a_util::system::getCurrentMicroseconds();
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  oDeltaCodec.apply(oDelta.data(), oDelta.size(), oReceived));
+        nTimeApply += a_util::system::getCurrentMicroseconds() - now;
+        oPrevious = oSample;
+    }
+    ASSERT_EQ(oReceived, oSample);
+
+    const double fSampleBytes = static_cast<double>(nRepeats * oSample.size());
+    std::cout << a_util::strings::format("%d samples of %d bytes: compression ratio %.1f, "
+                                         "encode %.0f MB/s, apply %.0f MB/s\n",
+                                         static_cast<int>(nRepeats),
+                                         static_cast<int>(oSample.size()),
+                                         fSampleBytes / nDeltaBytes,
+                                         fSampleBytes / std::max<timestamp_t>(nTimeEncode, 1),
+                                         fSampleBytes / std::max<timestamp_t>(nTimeApply, 1))
+                     .c_str();
+}
+
+namespace struct_versions {
+/// Two versions of a struct with a renamed, a widened, an added and a removed element.
+const char* strTestDesc = "<?xml version=\"1.0\" encoding=\"iso-8859-1\" standalone=\"no\"?>"
+                          "<adtf:ddl>"
+                          "<structs>"
+                          "<struct alignment=\"1\" name=\"pose_v1\" version=\"1\">"
+                          "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" bytepos=\"0\" "
+                          "name=\"id\" type=\"tUInt32\"/>"
+                          "<element alignment=\"1\" arraysize=\"3\" byteorder=\"LE\" bytepos=\"4\" "
+                          "name=\"position\" type=\"tFloat32\"/>"
+                          "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" "
+                          "bytepos=\"16\" name=\"heading\" type=\"tInt16\"/>"
+                          "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" "
+                          "bytepos=\"18\" name=\"quality\" type=\"tUInt8\"/>"
+                          "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" "
+                          "bytepos=\"19\" name=\"obsolete\" type=\"tUInt8\"/>"
+                          "</struct>"
+                          "<struct alignment=\"1\" name=\"pose_v2\" version=\"2\">"
+                          "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" bytepos=\"0\" "
+                          "name=\"id\" type=\"tUInt32\"/>"
+                          "<element alignment=\"1\" arraysize=\"3\" byteorder=\"LE\" bytepos=\"4\" "
+                          "name=\"pos\" type=\"tFloat32\"/>"
+                          "<element alignment=\"1\" arraysize=\"1\" byteorder=\"BE\" "
+                          "bytepos=\"16\" name=\"heading\" type=\"tFloat64\"/>"
+                          "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" "
+                          "bytepos=\"24\" name=\"quality\" type=\"tUInt8\"/>"
+                          "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" "
+                          "bytepos=\"25\" name=\"source\" type=\"tUInt16\" default=\"3\"/>"
+                          "</struct>"
+                          "</structs>"
+                          "</adtf:ddl>";
+} // namespace struct_versions
+
+/**
+ * @detail Check converting samples between two versions of a struct.
+ */
+TEST(CodecTest, TestStructConverter)
+{
+    const dd::DataDefinition oDD = DDString::fromXMLString(struct_versions::strTestDesc);
+    const dd::StructTypeAccess oV1 = oDD.getStructTypeAccess("pose_v1");
+    const dd::StructTypeAccess oV2 = oDD.getStructTypeAccess("pose_v2");
+    ASSERT_NE(a_util::result::SUCCESS, StructConverter().isValid());
+    ASSERT_EQ(-20,
+              StructConverter(oV1, oV2, {{"pos", "location"}}).isValid().getErrorCode());
+    ASSERT_EQ(-19,
+              StructConverter(DDString::fromXMLString(projection::createDescription())
+                                  .getStructTypeAccess("frame"),
+                              oV2)
+                  .isValid()
+                  .getErrorCode());
+
+    CodecFactory oV1Factory(oV1);
+    CodecFactory oV2Factory(oV2);
+    std::vector<uint8_t> oSource(oV1Factory.getStaticBufferSize(), 0);
+    StaticCodec oSourceCodec = oV1Factory.makeStaticCodecFor(oSource.data(), oSource.size());
+    access_element::setValue(oSourceCodec, "id", 4711);
+    access_element::setValue(oSourceCodec, "position[0]", 1.5f);
+    access_element::setValue(oSourceCodec, "position[2]", -2.5f);
+    access_element::setValue(oSourceCodec, "heading", -90);
+    access_element::setValue(oSourceCodec, "quality", 200);
+    access_element::setValue(oSourceCodec, "obsolete", 1);
+
+    for (const DataRepresentation eRep: {deserialized, serialized}) {
+        StructConverter oConverter(oV1, oV2, {{"pos", "position"}}, deserialized, eRep);
+        ASSERT_EQ(a_util::result::SUCCESS, oConverter.isValid());
+        ASSERT_EQ(oConverter.getSourceSize(), 20);
+        ASSERT_EQ(oConverter.getDestinationSize(), oV2Factory.getStaticBufferSize(eRep));
+        ASSERT_EQ(oConverter.getDefaultedElementCount(), 1);
+        ASSERT_EQ(oConverter.getConvertedElementCount(), 1);
+        ASSERT_EQ(oConverter.getCopiedElementCount(), 5);
+
+        std::vector<uint8_t> oDestination(oConverter.getDestinationSize(), 0xFF);
+        ASSERT_EQ(-5,
+                  oConverter.convert(oSource.data(), 10, oDestination.data(), oDestination.size())
+                      .getErrorCode());
+        ASSERT_EQ(
+            a_util::result::SUCCESS,
+            oConverter.convert(
+                oSource.data(), oSource.size(), oDestination.data(), oDestination.size()));
+
+        StaticDecoder oDecoder =
+            oV2Factory.makeStaticDecoderFor(oDestination.data(), oDestination.size(), eRep);
+        ASSERT_EQ(access_element::getValue(oDecoder, "id").asInt64(), 4711);
+        ASSERT_EQ(access_element::getValue(oDecoder, "pos[0]").asDouble(), 1.5);
+        ASSERT_EQ(access_element::getValue(oDecoder, "pos[1]").asDouble(), 0.0);
+        ASSERT_EQ(access_element::getValue(oDecoder, "pos[2]").asDouble(), -2.5);
+        ASSERT_EQ(access_element::getValue(oDecoder, "heading").asDouble(), -90.0);
+        ASSERT_EQ(access_element::getValue(oDecoder, "quality").asInt64(), 200);
+        ASSERT_EQ(access_element::getValue(oDecoder, "source").asInt64(), 3);
+    }
+
+    // values out of the range of the destination type are clamped, NaN becomes zero
+    StructConverter oBackConverter(oV2, oV1, {{"position", "pos"}});
+    ASSERT_EQ(a_util::result::SUCCESS, oBackConverter.isValid());
+    std::vector<uint8_t> oV2Sample(oV2Factory.getStaticBufferSize(), 0);
+    StaticCodec oV2Codec = oV2Factory.makeStaticCodecFor(oV2Sample.data(), oV2Sample.size());
+    std::vector<uint8_t> oV1Sample(oV1Factory.getStaticBufferSize(), 0);
+    for (const auto& oCase: std::vector<std::pair<double, int16_t>>{
+             {1e6, 32767},
+             {-1e6, -32768},
+             {1e300, 32767},
+             {std::numeric_limits<double>::quiet_NaN(), 0},
+             {-123.7, -123}}) {
+        access_element::setValue(oV2Codec, "heading", oCase.first);
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  oBackConverter.convert(
+                      oV2Sample.data(), oV2Sample.size(), oV1Sample.data(), oV1Sample.size()));
+        StaticDecoder oDecoder =
+            oV1Factory.makeStaticDecoderFor(oV1Sample.data(), oV1Sample.size());
+        ASSERT_EQ(access_element::getValue(oDecoder, "heading").asInt16(), oCase.second);
+    }
+}
+
+/**
+ * @detail Compare converting samples element by element by name to the compiled converter.
+ */
+TEST(CodecTest, TestStructConverterPerf)
+{
+    const dd::DataDefinition oDD = DDString::fromXMLString(struct_versions::strTestDesc);
+    const dd::StructTypeAccess oV1 = oDD.getStructTypeAccess("pose_v1");
+    const dd::StructTypeAccess oV2 = oDD.getStructTypeAccess("pose_v2");
+    CodecFactory oV1Factory(oV1);
+    CodecFactory oV2Factory(oV2);
+    StructConverter oConverter(oV1, oV2, {{"pos", "position"}});
+    ASSERT_EQ(a_util::result::SUCCESS, oConverter.isValid());
+
+    std::vector<uint8_t> oSource(oV1Factory.getStaticBufferSize(), 0);
+    std::vector<uint8_t> oExpected(oV2Factory.getStaticBufferSize(), 0);
+    std::vector<uint8_t> oDestination(oV2Factory.getStaticBufferSize(), 0);
+    StaticCodec oSourceCodec = oV1Factory.makeStaticCodecFor(oSource.data(), oSource.size());
+    StaticCodec oExpectedCodec =
+        oV2Factory.makeStaticCodecFor(oExpected.data(), oExpected.size());
+
+    const size_t nRepeats = 20000;
+    timestamp_t now = a_util::system::getCurrentMicroseconds();
+    for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+        access_element::setValue(oSourceCodec, "id", static_cast<uint32_t>(nRound));
+        for (size_t nElement = 0; nElement < oExpectedCodec.getElementCount(); ++nElement) {
+            const StructElement* pElement = nullptr;
+            oExpectedCodec.getElement(nElement, pElement);
+            std::string strSourceName = pElement->name;
+            if (strSourceName.compare(0, 4, "pos[") == 0) {
+                strSourceName.replace(0, 3, "position");
+            }
+            size_t nSourceIndex = 0;
+            if (isOk(access_element::findIndex(oSourceCodec, strSourceName, nSourceIndex))) {
+                a_util::variant::Variant oValue;
+                oSourceCodec.getElementValue(nSourceIndex, oValue);
+                oExpectedCodec.setElementValue(nElement, oValue);
+            }
+            else {
+                oExpectedCodec.setElementValue(nElement, a_util::variant::Variant(3));
+            }
+        }
+    }
+    timestamp_t nTimeElements = a_util::system::getCurrentMicroseconds() - now;
+
+    now = a_util::system::getCurrentMicroseconds();
+    for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+        access_element::setValue(oSourceCodec, "id", static_cast<uint32_t>(nRound));
+        oConverter.convert(
+            oSource.data(), oSource.size(), oDestination.data(), oDestination.size());
+    }
+    timestamp_t nTimeConverter = a_util::system::getCurrentMicroseconds() - now;
+    ASSERT_EQ(oDestination, oExpected);
+
+    std::cout << a_util::strings::format("%d conversions: element by element %lld us, "
+                                         "compiled %lld us\n",
+                                         static_cast<int>(nRepeats),
+                                         nTimeElements,
+                                         nTimeConverter)
+                     .c_str();
+}
+
+/// Splits data into fragments of the given sizes, the last fragment holds the rest.
+static std::vector<DataFragment> splitIntoFragments(const std::vector<uint8_t>& oData,
+                                                    const std::vector<size_t>& oSizes)
+{
+    std::vector<DataFragment> oFragments;
+    size_t nOffset = 0;
+    for (const size_t nSize: oSizes) {
+        oFragments.push_back({oData.data() + nOffset, nSize});
+        nOffset += nSize;
+    }
+    oFragments.push_back({oData.data() + nOffset, oData.size() - nOffset});
+    return oFragments;
+}
+
+/**
+ * @detail Check decoding data that is split into fragments at every possible position.
+ */
+TEST(CodecTest, TestFragmentedDecoder)
+{
+    CodecFactory oFactory("main", default_sample::strTestDesc);
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+    ASSERT_NE(a_util::result::SUCCESS, FragmentedDecoder().isValid());
+
+    for (const DataRepresentation eRep: {deserialized, serialized}) {
+        std::vector<uint8_t> oData = oFactory.getDefaultSample(eRep);
+        StaticCodec oCodec = oFactory.makeStaticCodecFor(oData.data(), oData.size(), eRep);
+        ASSERT_EQ(a_util::result::SUCCESS, access_element::setValue(oCodec, "counter", 0x12345678));
+        ASSERT_EQ(a_util::result::SUCCESS, access_element::setValue(oCodec, "scale", -0.125));
+        ASSERT_EQ(a_util::result::SUCCESS, access_element::setValue(oCodec, "zero", -2));
+
+        for (size_t nSplit = 0; nSplit <= oData.size(); ++nSplit) {
+            FragmentedDecoder oDecoder =
+                oFactory.makeFragmentedDecoderFor(splitIntoFragments(oData, {nSplit}), eRep);
+            ASSERT_EQ(a_util::result::SUCCESS, oDecoder.isValid());
+            ASSERT_EQ(oDecoder.getElementCount(), oCodec.getElementCount());
+            for (size_t nElement = 0; nElement < oCodec.getElementCount(); ++nElement) {
+                ASSERT_EQ(access_element::getValue(oDecoder, nElement),
+                          access_element::getValue(oCodec, nElement));
+            }
+            ASSERT_EQ(access_element::getValueAsString(oDecoder, "mode"), "FORTYTWO");
+            // elements within a single fragment are not copied
+            ASSERT_EQ(oDecoder.getElementAddress(0) != nullptr, nSplit == 0 || nSplit >= 4);
+        }
+
+        // one byte per fragment
+        FragmentedDecoder oDecoder = oFactory.makeFragmentedDecoderFor(
+            splitIntoFragments(oData, std::vector<size_t>(oData.size() - 1, 1)), eRep);
+        ASSERT_EQ(a_util::result::SUCCESS, oDecoder.isValid());
+        ASSERT_EQ(access_element::getValue(oDecoder, "scale").asDouble(), -0.125);
+
+        // too little data
+        oDecoder = oFactory.makeFragmentedDecoderFor({{oData.data(), oData.size() - 1}}, eRep);
+        ASSERT_EQ(-5, oDecoder.isValid().getErrorCode());
+    }
+}
+
+/**
+ * @detail Check decoding fragmented data with dynamic arrays.
+ */
+TEST(CodecTest, TestFragmentedDecoderDynamic)
+{
+    CodecFactory oFactory("frame", projection::createDescription());
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+    const uint32_t nSampleCount = 300;
+    std::vector<uint8_t> oData(12008 + nSampleCount * 2 + 4, 0);
+    std::memcpy(oData.data() + 12004, &nSampleCount, sizeof(nSampleCount));
+    Codec oCodec = oFactory.makeCodecFor(oData.data(), oData.size());
+    for (size_t nElement = 0; nElement < oCodec.getElementCount(); ++nElement) {
+        if (nElement != 3001) {
+            oCodec.setElementValue(nElement, a_util::variant::Variant(int16_t(nElement % 1000)));
+        }
+    }
+
+    // the array size and some array items span two fragments
+    FragmentedDecoder oDecoder =
+        oFactory.makeFragmentedDecoderFor(splitIntoFragments(oData, {12006, 2001, 3}));
+    ASSERT_EQ(a_util::result::SUCCESS, oDecoder.isValid());
+    ASSERT_EQ(oDecoder.getElementCount(), oCodec.getElementCount());
+    ASSERT_EQ(oDecoder.getBufferSize(), oData.size());
+    size_t nIndex = 0;
+    ASSERT_EQ(a_util::result::SUCCESS, oDecoder.findElementIndex("samples[250]", nIndex));
+    ASSERT_EQ(access_element::getValue(oDecoder, nIndex).asInt32(),
+              access_element::getValue(oCodec, "samples[250]").asInt32());
+    for (size_t nElement = 0; nElement < oCodec.getElementCount(); ++nElement) {
+        ASSERT_EQ(access_element::getValue(oDecoder, nElement),
+                  access_element::getValue(oCodec, nElement));
+    }
+
+    std::vector<int16_t> oSamples(nSampleCount);
+    ASSERT_EQ(a_util::result::SUCCESS,
+              oDecoder.getElementValues(nIndex - 250, nSampleCount, oSamples.data()));
+    ASSERT_EQ(oSamples[250], access_element::getValue(oCodec, "samples[250]").asInt32());
+}
+
+/**
+ * @detail Check that arrays are only accessed as a whole within a single fragment.
+ */
+TEST(CodecTest, TestFragmentedDecoderArray)
+{
+    const std::string strDescription =
+        "<?xml version=\"1.0\" encoding=\"iso-8859-1\" standalone=\"no\"?>"
+        "<structs>"
+        "<struct alignment=\"1\" name=\"main\" version=\"1\">"
+        "<element alignment=\"1\" arraysize=\"8\" byteorder=\"LE\" bytepos=\"0\" "
+        "name=\"values\" type=\"tUInt32\"/>"
+        "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" bytepos=\"32\" "
+        "name=\"after\" type=\"tUInt32\"/>"
+        "</struct>"
+        "</structs>";
+    CodecFactory oFactory("main", strDescription);
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+    std::vector<uint32_t> oValues = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    std::vector<uint8_t> oData(oValues.size() * sizeof(uint32_t));
+    std::memcpy(oData.data(), oValues.data(), oData.size());
+
+    for (const size_t nSplit: {size_t(0), size_t(32), size_t(36)}) {
+        FragmentedDecoder oDecoder =
+            oFactory.makeFragmentedDecoderFor(splitIntoFragments(oData, {nSplit}));
+        ASSERT_EQ(a_util::result::SUCCESS, oDecoder.isValid());
+        const void* pArray = nullptr;
+        size_t nSize = 0;
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  access_element::getArray(oDecoder, "values", pArray, nSize));
+        ASSERT_EQ(nSize, 32);
+        std::vector<uint32_t> oArray(8);
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  access_element::getArrayValue(oDecoder, "values", oArray.data()));
+        ASSERT_EQ(oArray, std::vector<uint32_t>(oValues.begin(), oValues.begin() + 8));
+    }
+
+    // the array straddles two fragments
+    std::vector<uint8_t> oFirst(oData.begin(), oData.begin() + 16);
+    std::vector<uint8_t> oSecond(oData.begin() + 16, oData.end());
+    FragmentedDecoder oDecoder = oFactory.makeFragmentedDecoderFor(
+        {{oFirst.data(), oFirst.size()}, {oSecond.data(), oSecond.size()}});
+    ASSERT_EQ(a_util::result::SUCCESS, oDecoder.isValid());
+    const void* pArray = nullptr;
+    size_t nSize = 0;
+    ASSERT_EQ(-19, access_element::getArray(oDecoder, "values", pArray, nSize).getErrorCode());
+    std::vector<uint32_t> oArray(8, 0);
+    ASSERT_EQ(-19,
+              access_element::getArrayValue(oDecoder, "values", oArray.data()).getErrorCode());
+    ASSERT_EQ(oArray, std::vector<uint32_t>(8, 0));
+
+    // the items can still be read one by one
+    size_t nIndex = 0;
+    ASSERT_EQ(a_util::result::SUCCESS, oDecoder.findElementIndex("values[0]", nIndex));
+    ASSERT_EQ(a_util::result::SUCCESS, oDecoder.getElementValues(nIndex, 8, oArray.data()));
+    ASSERT_EQ(oArray, std::vector<uint32_t>(oValues.begin(), oValues.begin() + 8));
+    ASSERT_EQ(access_element::getValue(oDecoder, "after").asUInt32(), 9);
+}
+
+/**
+ * @detail Compare copying fragments into one buffer before decoding to the fragmented decoder.
+ */
+TEST(CodecTest, TestFragmentedDecoderPerf)
+{
+    CodecFactory oFactory("frame", projection::createDescription());
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+    const uint32_t nSampleCount = 500;
+    std::vector<uint8_t> oData(12008 + nSampleCount * 2 + 4, 0);
+    std::memcpy(oData.data() + 12004, &nSampleCount, sizeof(nSampleCount));
+    const std::vector<DataFragment> oFragments =
+        splitIntoFragments(oData, {1400, 1400, 1400, 1400, 1400, 1400, 1400, 1400, 1400});
+    const std::vector<std::string> oNames = {
+        "counter", "signals[1500]", "sample_count", "checksum"};
+
+    const size_t nRepeats = 20000;
+    double fSum = 0;
+    std::vector<uint8_t> oBuffer;
+    timestamp_t now = a_util::system::getCurrentMicroseconds();
+    for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+        oBuffer.clear();
+        for (const DataFragment& sFragment: oFragments) {
+            const uint8_t* pData = static_cast<const uint8_t*>(sFragment.data);
+            oBuffer.insert(oBuffer.end(), pData, pData + sFragment.size);
+        }
+        Decoder oDecoder = oFactory.makeDecoderFor(oBuffer.data(), oBuffer.size());
+        for (const std::string& strName: oNames) {
+            fSum += access_element::getValue(oDecoder, strName).asDouble();
+        }
+    }
+    timestamp_t nTimeCopy = a_util::system::getCurrentMicroseconds() - now;
+
+    now = a_util::system::getCurrentMicroseconds();
+    for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+        FragmentedDecoder oDecoder = oFactory.makeFragmentedDecoderFor(oFragments);
+        for (const std::string& strName: oNames) {
+            fSum -= access_element::getValue(oDecoder, strName).asDouble();
+        }
+    }
+    timestamp_t nTimeFragmented = a_util::system::getCurrentMicroseconds() - now;
+
+    ASSERT_EQ(fSum, 0.0);
+    std::cout << a_util::strings::format("%d samples in %d fragments: copy and decode %lld us, "
+                                         "fragmented decoder %lld us\n",
+                                         static_cast<int>(nRepeats),
+                                         static_cast<int>(oFragments.size()),
+                                         nTimeCopy,
+                                         nTimeFragmented)
+                     .c_str();
+}
+
+namespace enum_names {
+struct tMain {
+    int32_t nDense;
+    int64_t nSparse;
+    uint64_t nBig;
+    int32_t nPlain;
+};
+
+/// An enum with many close values, one with few far apart values and one with unsigned values.
+static std::string makeTestDesc()
+{
+    std::string strEnums = "<enum name=\"tDense\" type=\"tInt32\">";
+    for (int nValue = 0; nValue < 200; ++nValue) {
+        strEnums += a_util::strings::format(
+            "<element name=\"VALUE_%d\" value=\"%d\"/>", nValue, nValue - 100);
+    }
+    strEnums += "<element name=\"ALIAS_OF_VALUE_0\" value=\"-100\"/>"
+                "</enum>"
+                "<enum name=\"tSparse\" type=\"tInt64\">"
+                "<element name=\"MINUS_FIVE\" value=\"-5\"/>"
+                "<element name=\"MILLION\" value=\"1000000\"/>"
+                "<element name=\"HUGE\" value=\"4000000000000\"/>"
+                "</enum>"
+                "<enum name=\"tBig\" type=\"tUInt64\">"
+                "<element name=\"ZERO\" value=\"0\"/>"
+                "<element name=\"ALMOST_MAX\" value=\"18446744073709551614\"/>"
+                "</enum>";
+
+    return "<?xml version=\"1.0\" encoding=\"iso-8859-1\" standalone=\"no\"?>"
+           "<adtf:ddl>"
+           "<enums>" +
+           strEnums +
+           "</enums>"
+           "<structs>"
+           "<struct alignment=\"1\" name=\"main\" version=\"2\">"
+           "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" bytepos=\"0\" "
+           "name=\"dense\" type=\"tDense\"/>"
+           "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" bytepos=\"4\" "
+           "name=\"sparse\" type=\"tSparse\"/>"
+           "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" bytepos=\"12\" "
+           "name=\"big\" type=\"tBig\"/>"
+           "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" bytepos=\"20\" "
+           "name=\"plain\" type=\"tInt32\"/>"
+           "</struct>"
+           "</structs>"
+           "</adtf:ddl>";
+}
+
+} // namespace enum_names
+
+/**
+ * @detail Check the precomputed enum value names of dense, sparse and unsigned enums.
+ */
+TEST(CodecTest, TestEnumValueNames)
+{
+    CodecFactory oFactory("main", enum_names::makeTestDesc());
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+
+    std::vector<uint8_t> oData(24, 0);
+    Codec oCodec = oFactory.makeCodecFor(oData.data(), oData.size());
+    ASSERT_EQ(a_util::result::SUCCESS, oCodec.isValid());
+
+    const std::vector<std::pair<int32_t, std::string>> oDenseValues = {
+        {-100, "ALIAS_OF_VALUE_0"}, {-1, "VALUE_99"}, {0, "VALUE_100"}, {99, "VALUE_199"}};
+    for (const auto& oValue: oDenseValues) {
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  access_element::setValue(oCodec, "dense", oValue.first));
+        ASSERT_EQ(access_element::getValueAsString(oCodec, "dense"), oValue.second);
+        ASSERT_EQ(access_element::getEnumValueName(oCodec, "dense"), oValue.second);
+    }
+    access_element::setValue(oCodec, "dense", static_cast<int32_t>(100));
+    ASSERT_EQ(access_element::getValueAsString(oCodec, "dense"), "100");
+    ASSERT_EQ(access_element::getEnumValueName(oCodec, "dense"), "");
+
+    const std::vector<std::pair<int64_t, std::string>> oSparseValues = {
+        {-5, "MINUS_FIVE"}, {1000000, "MILLION"}, {4000000000000, "HUGE"}};
+    for (const auto& oValue: oSparseValues) {
+        access_element::setValue(oCodec, "sparse", oValue.first);
+        ASSERT_EQ(access_element::getValueAsString(oCodec, "sparse"), oValue.second);
+    }
+    access_element::setValue(oCodec, "sparse", static_cast<int64_t>(5));
+    ASSERT_EQ(access_element::getValueAsString(oCodec, "sparse"), "5");
+
+    access_element::setValue(oCodec, "big", UINT64_MAX - 1);
+    ASSERT_EQ(access_element::getValueAsString(oCodec, "big"), "ALMOST_MAX");
+    const uint64_t nZero = 0;
+    access_element::setValue(oCodec, "big", nZero);
+    ASSERT_EQ(access_element::getEnumValueName(oCodec, "big"), "ZERO");
+
+    access_element::setValue(oCodec, "plain", static_cast<int32_t>(-1));
+    ASSERT_EQ(access_element::getValueAsString(oCodec, "plain"), "-1");
+    ASSERT_EQ(access_element::getEnumValueName(oCodec, "plain"), "");
+    ASSERT_EQ(access_element::getEnumValueName(oCodec, "unknown"), "");
+}
+
+/**
+ * @detail Compare the precomputed enum value names with searching the enum for the value.
+ */
+TEST(CodecTest, TestEnumValueNamesPerf)
+{
+    CodecFactory oFactory("main", enum_names::makeTestDesc());
+    std::vector<uint8_t> oData(24, 0);
+    Codec oCodec = oFactory.makeCodecFor(oData.data(), oData.size());
+    size_t nDense = 0;
+    ASSERT_EQ(a_util::result::SUCCESS, access_element::findIndex(oCodec, "dense", nDense));
+    const StructElement* pElement = nullptr;
+    ASSERT_EQ(a_util::result::SUCCESS, oCodec.getElement(nDense, pElement));
+
+    const size_t nRepeats = 100000;
+    size_t nNameLength = 0;
+    timestamp_t now = a_util::system::getCurrentMicroseconds();
+    for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+        oCodec.setElementValue(nDense, a_util::variant::Variant(int32_t(nRound % 200) - 100));
+        a_util::variant::Variant oValue;
+        oCodec.getElementValue(nDense, oValue);
+        for (const auto& oEnumValue: *pElement->p_enum) {
+            if (oEnumValue.second.asInt32() == oValue.getInt32()) {
+                nNameLength += oEnumValue.first.size();
+                break;
+            }
+        }
+    }
+    timestamp_t nTimeSearch = a_util::system::getCurrentMicroseconds() - now;
+
+    size_t nPrecomputedNameLength = 0;
+    now = a_util::system::getCurrentMicroseconds();
+    for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+        oCodec.setElementValue(nDense, a_util::variant::Variant(int32_t(nRound % 200) - 100));
+        nPrecomputedNameLength += access_element::getEnumValueName(oCodec, nDense).size();
+    }
+    timestamp_t nTimePrecomputed = a_util::system::getCurrentMicroseconds() - now;
+    ASSERT_EQ(nNameLength, nPrecomputedNameLength);
+
+    std::cout << a_util::strings::format("%d enum values: search %lld us, precomputed %lld us\n",
+                                         static_cast<int>(nRepeats),
+                                         nTimeSearch,
+                                         nTimePrecomputed)
+                     .c_str();
+}
+
+namespace object_list {
+const char* strTestDesc = "<?xml version=\"1.0\" encoding=\"iso-8859-1\" standalone=\"no\"?>"
+                          "<adtf:ddl>"
+                          "<structs>"
+                          "<struct alignment=\"4\" name=\"object\" version=\"1\">"
+                          "<element alignment=\"4\" arraysize=\"1\" byteorder=\"LE\" bytepos=\"0\" "
+                          "name=\"id\" type=\"tInt32\"/>"
+                          "<element alignment=\"4\" arraysize=\"1\" byteorder=\"BE\" bytepos=\"4\" "
+                          "name=\"x\" type=\"tFloat32\"/>"
+                          "</struct>"
+                          "<struct alignment=\"4\" name=\"main\" version=\"1\">"
+                          "<element alignment=\"4\" arraysize=\"1\" byteorder=\"LE\" bytepos=\"0\" "
+                          "name=\"count\" type=\"tUInt32\"/>"
+                          "<element alignment=\"4\" arraysize=\"count\" byteorder=\"LE\" "
+                          "bytepos=\"4\" name=\"objects\" type=\"object\"/>"
+                          "<element alignment=\"2\" arraysize=\"1\" byteorder=\"LE\" "
+                          "bytepos=\"-1\" name=\"tag_count\" type=\"tUInt16\"/>"
+                          "<element alignment=\"1\" arraysize=\"tag_count\" byteorder=\"LE\" "
+                          "bytepos=\"-1\" name=\"tags\" type=\"tUInt8\"/>"
+                          "<element alignment=\"4\" arraysize=\"1\" byteorder=\"BE\" "
+                          "bytepos=\"-1\" name=\"checksum\" type=\"tUInt32\"/>"
+                          "</struct>"
+                          "</structs>"
+                          "</adtf:ddl>";
+
+/// Creates a sample with the given numbers of objects and tags.
+static a_util::memory::MemoryBuffer makeSample(const CodecFactory& oFactory,
+                                               size_t nObjects,
+                                               size_t nTags,
+                                               DataRepresentation eRep)
+{
+    // the position of the tag count depends on the number of objects
+    a_util::memory::MemoryBuffer oLarge(4096);
+    oFactory.makeCodecFor(oLarge.getPtr(), oLarge.getSize(), eRep)
+        .setElementValue(0, a_util::variant::Variant(static_cast<uint32_t>(nObjects)));
+    {
+        Codec oCodec = oFactory.makeCodecFor(oLarge.getPtr(), oLarge.getSize(), eRep);
+        access_element::setValue(oCodec, "tag_count", static_cast<uint16_t>(nTags));
+    }
+    a_util::memory::MemoryBuffer oSample(
+        oFactory.makeDecoderFor(oLarge.getPtr(), oLarge.getSize(), eRep).getBufferSize(eRep));
+    a_util::memory::copy(oSample.getPtr(), oSample.getSize(), oLarge.getPtr(), oSample.getSize());
+
+    Codec oCodec = oFactory.makeCodecFor(oSample.getPtr(), oSample.getSize(), eRep);
+    for (size_t nObject = 0; nObject < nObjects; ++nObject) {
+        const std::string strObject = a_util::strings::format("objects[%d].", nObject);
+        access_element::setValue(oCodec, strObject + "id", static_cast<int32_t>(nObject + 1));
+        access_element::setValue(oCodec, strObject + "x", 0.5f * (nObject + 1));
+    }
+    for (size_t nTag = 0; nTag < nTags; ++nTag) {
+        access_element::setValue(
+            oCodec, a_util::strings::format("tags[%d]", nTag), static_cast<uint8_t>(nTag + 10));
+    }
+    access_element::setValue(oCodec, "checksum", static_cast<uint32_t>(0xC0FFEE));
+    return oSample;
+}
+
+/// Checks the codec against a decoder created from scratch and the values of makeSample.
+static void checkSample(const CodecFactory& oFactory,
+                        const Codec& oCodec,
+                        size_t nObjects,
+                        size_t nKeptObjects,
+                        size_t nTags,
+                        size_t nKeptTags,
+                        DataRepresentation eRep)
+{
+    Decoder oDecoder = oFactory.makeDecoderFor(
+        oCodec.getElementAddress(0), oCodec.getBufferSize(eRep), eRep);
+    ASSERT_EQ(a_util::result::SUCCESS, oDecoder.isValid());
+    ASSERT_EQ(a_util::result::SUCCESS, oCodec.isValid());
+    ASSERT_EQ(oDecoder.getBufferSize(eRep), oCodec.getBufferSize(eRep));
+    ASSERT_EQ(oDecoder.getElementCount(), oCodec.getElementCount());
+    for (size_t nElement = 0; nElement < oCodec.getElementCount(); ++nElement) {
+        const StructElement* pExpected = nullptr;
+        const StructElement* pElement = nullptr;
+        ASSERT_EQ(a_util::result::SUCCESS, oDecoder.getElement(nElement, pExpected));
+        ASSERT_EQ(a_util::result::SUCCESS, oCodec.getElement(nElement, pElement));
+        ASSERT_EQ(pExpected->name, pElement->name);
+        ASSERT_EQ(access_element::getValue(oDecoder, pElement->name).asDouble(),
+                  access_element::getValue(oCodec, pElement->name).asDouble());
+    }
+
+    ASSERT_EQ(access_element::getValue(oCodec, "count").asUInt64(), nObjects);
+    for (size_t nObject = 0; nObject < nObjects; ++nObject) {
+        const std::string strObject = a_util::strings::format("objects[%d].", nObject);
+        const int32_t nExpected = nObject < nKeptObjects ? static_cast<int32_t>(nObject + 1) : 0;
+        ASSERT_EQ(access_element::getValue(oCodec, strObject + "id").asInt32(), nExpected);
+        ASSERT_EQ(access_element::getValue(oCodec, strObject + "x").asDouble(), 0.5 * nExpected);
+    }
+    ASSERT_EQ(access_element::getValue(oCodec, "tag_count").asUInt64(), nTags);
+    for (size_t nTag = 0; nTag < nTags; ++nTag) {
+        ASSERT_EQ(access_element::getValue(oCodec, a_util::strings::format("tags[%d]", nTag))
+                      .asInt32(),
+                  nTag < nKeptTags ? static_cast<int32_t>(nTag + 10) : 0);
+    }
+    ASSERT_EQ(access_element::getValue(oCodec, "checksum").asUInt32(), 0xC0FFEEu);
+}
+
+} // namespace object_list
+
+/**
+ * @detail Check resizing dynamic arrays of a codec, moving the following data.
+ */
+TEST(CodecTest, TestResizeDynamicArray)
+{
+    CodecFactory oFactory("main", object_list::strTestDesc);
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+
+    for (DataRepresentation eRep: {deserialized, serialized}) {
+        a_util::memory::MemoryBuffer oBuffer = object_list::makeSample(oFactory, 2, 3, eRep);
+        Codec oCodec = oFactory.makeCodecFor(oBuffer.getPtr(), oBuffer.getSize(), eRep);
+        ASSERT_NO_FATAL_FAILURE(object_list::checkSample(oFactory, oCodec, 2, 2, 3, 3, eRep));
+
+        // growing beyond the buffer, then shrinking and growing within it
+        ASSERT_EQ(a_util::result::SUCCESS, oCodec.resizeDynamicArray("count", 5, oBuffer));
+        ASSERT_EQ(oCodec.getElementAddress(0), oBuffer.getPtr());
+        ASSERT_GE(oBuffer.getSize(), oCodec.getBufferSize(eRep));
+        ASSERT_NO_FATAL_FAILURE(object_list::checkSample(oFactory, oCodec, 5, 2, 3, 3, eRep));
+        ASSERT_EQ(a_util::result::SUCCESS, oCodec.resizeDynamicArray("count", 1, oBuffer));
+        ASSERT_NO_FATAL_FAILURE(object_list::checkSample(oFactory, oCodec, 1, 1, 3, 3, eRep));
+        ASSERT_EQ(a_util::result::SUCCESS, oCodec.resizeDynamicArray("count", 3, oBuffer));
+        ASSERT_NO_FATAL_FAILURE(object_list::checkSample(oFactory, oCodec, 3, 1, 3, 3, eRep));
+
+        // the single byte tags change the alignment of the checksum
+        ASSERT_EQ(a_util::result::SUCCESS, oCodec.resizeDynamicArray("tag_count", 6, oBuffer));
+        ASSERT_NO_FATAL_FAILURE(object_list::checkSample(oFactory, oCodec, 3, 1, 6, 3, eRep));
+        ASSERT_EQ(a_util::result::SUCCESS, oCodec.resizeDynamicArray("tag_count", 0, oBuffer));
+        ASSERT_NO_FATAL_FAILURE(object_list::checkSample(oFactory, oCodec, 3, 1, 0, 0, eRep));
+        ASSERT_EQ(a_util::result::SUCCESS, oCodec.resizeDynamicArray("count", 0, oBuffer));
+        ASSERT_NO_FATAL_FAILURE(object_list::checkSample(oFactory, oCodec, 0, 0, 0, 0, eRep));
+        ASSERT_EQ(a_util::result::SUCCESS, oCodec.resizeDynamicArray("count", 2, oBuffer));
+        ASSERT_NO_FATAL_FAILURE(object_list::checkSample(oFactory, oCodec, 2, 0, 0, 0, eRep));
+
+        ASSERT_EQ(oCodec.resizeDynamicArray("unknown", 1, oBuffer).getErrorCode(), -20);
+        ASSERT_EQ(oCodec.resizeDynamicArray("checksum", 1, oBuffer).getErrorCode(), -5);
+        ASSERT_EQ(oCodec.resizeDynamicArray("tag_count", 70000, oBuffer).getErrorCode(), -5);
+        a_util::memory::MemoryBuffer oOtherBuffer(oBuffer.getSize());
+        ASSERT_EQ(oCodec.resizeDynamicArray("count", 1, oOtherBuffer).getErrorCode(), -5);
+        ASSERT_NO_FATAL_FAILURE(object_list::checkSample(oFactory, oCodec, 2, 0, 0, 0, eRep));
+    }
+}
+
+/**
+ * @detail Check resizing dynamic arrays which share their size element beyond the buffer.
+ */
+TEST(CodecTest, TestResizeSharedDynamicArrays)
+{
+    const std::string strDesc =
+        "<?xml version=\"1.0\" encoding=\"iso-8859-1\" standalone=\"no\"?>"
+        "<struct alignment=\"1\" name=\"main\" version=\"1\">"
+        "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" bytepos=\"0\" "
+        "name=\"count\" type=\"tUInt32\"/>"
+        "<element alignment=\"1\" arraysize=\"count\" byteorder=\"LE\" bytepos=\"4\" "
+        "name=\"values\" type=\"tInt32\"/>"
+        "<element alignment=\"1\" arraysize=\"count\" byteorder=\"LE\" bytepos=\"-1\" "
+        "name=\"flags\" type=\"tUInt8\"/>"
+        "<element alignment=\"1\" arraysize=\"1\" byteorder=\"LE\" bytepos=\"-1\" "
+        "name=\"checksum\" type=\"tUInt32\"/>"
+        "</struct>";
+    CodecFactory oFactory("main", strDesc);
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+
+    a_util::memory::MemoryBuffer oBuffer(4 + 4 + 1 + 4);
+    a_util::memory::set(oBuffer.getPtr(), oBuffer.getSize(), 0, oBuffer.getSize());
+    Codec oCodec = oFactory.makeCodecFor(oBuffer.getPtr(), oBuffer.getSize());
+    ASSERT_EQ(a_util::result::SUCCESS, oCodec.setElementValue(0, a_util::variant::Variant(1u)));
+    oCodec = oFactory.makeCodecFor(oBuffer.getPtr(), oBuffer.getSize());
+    ASSERT_EQ(a_util::result::SUCCESS, access_element::setValue(oCodec, "values[0]", -7));
+    ASSERT_EQ(a_util::result::SUCCESS, access_element::setValue(oCodec, "flags[0]", 3));
+    ASSERT_EQ(a_util::result::SUCCESS, access_element::setValue(oCodec, "checksum", 0xC0FFEE));
+
+    ASSERT_EQ(a_util::result::SUCCESS, oCodec.resizeDynamicArray("count", 10, oBuffer));
+    ASSERT_EQ(oCodec.getElementAddress(0), oBuffer.getPtr());
+    ASSERT_EQ(oCodec.getBufferSize(), 4 + 40 + 10 + 4);
+    ASSERT_EQ(access_element::getValue(oCodec, "count").asUInt32(), 10u);
+    ASSERT_EQ(access_element::getValue(oCodec, "values[0]").asInt32(), -7);
+    ASSERT_EQ(access_element::getValue(oCodec, "values[9]").asInt32(), 0);
+    ASSERT_EQ(access_element::getValue(oCodec, "flags[0]").asInt32(), 3);
+    ASSERT_EQ(access_element::getValue(oCodec, "flags[9]").asInt32(), 0);
+    ASSERT_EQ(access_element::getValue(oCodec, "checksum").asUInt32(), 0xC0FFEEu);
+
+    // a failed resize leaves the data unchanged
+    a_util::memory::MemoryBuffer oOtherBuffer(oBuffer.getSize());
+    ASSERT_EQ(oCodec.resizeDynamicArray("count", 1, oOtherBuffer).getErrorCode(), -5);
+    ASSERT_EQ(access_element::getValue(oCodec, "count").asUInt32(), 10u);
+    ASSERT_EQ(access_element::getValue(oCodec, "flags[0]").asInt32(), 3);
+    ASSERT_EQ(access_element::getValue(oCodec, "checksum").asUInt32(), 0xC0FFEEu);
+}
+
+/**
+ * @detail Compare resizing a dynamic array with creating a new codec and copying the elements.
+ */
+TEST(CodecTest, TestResizeDynamicArrayPerf)
+{
+    CodecFactory oFactory("main", object_list::strTestDesc);
+    const size_t nRepeats = 2000;
+    const size_t nTags = 8;
+    a_util::memory::MemoryBuffer oInitial =
+        object_list::makeSample(oFactory, 40, nTags, deserialized);
+
+    a_util::memory::MemoryBuffer oBuffer = oInitial;
+    timestamp_t now = a_util::system::getCurrentMicroseconds();
+    for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+        const size_t nObjects = 20 + nRound % 41;
+        Decoder oDecoder = oFactory.makeDecoderFor(oBuffer.getPtr(), oBuffer.getSize());
+        a_util::memory::MemoryBuffer oHeader = oBuffer;
+        Codec oHeaderCodec = oFactory.makeCodecFor(oHeader.getPtr(), oHeader.getSize());
+        oHeaderCodec.setElementValue(0, a_util::variant::Variant(static_cast<uint32_t>(nObjects)));
+        // the new size needs the tag count at its new position, so it is set in two steps
+        a_util::memory::MemoryBuffer oResized(oBuffer.getSize() + 41 * 8);
+        a_util::memory::copy(oResized.getPtr(), oResized.getSize(), oHeader.getPtr(), 4);
+        {
+            Codec oCodec = oFactory.makeCodecFor(oResized.getPtr(), oResized.getSize());
+            access_element::setValue(oCodec, "tag_count", static_cast<uint16_t>(nTags));
+        }
+        Codec oCodec = oFactory.makeCodecFor(oResized.getPtr(), oResized.getSize());
+        for (size_t nElement = 0; nElement < oCodec.getElementCount(); ++nElement) {
+            const StructElement* pElement = nullptr;
+            oCodec.getElement(nElement, pElement);
+            size_t nSource = 0;
+            if (isOk(access_element::findIndex(oDecoder, pElement->name, nSource))) {
+                a_util::variant::Variant oValue;
+                oDecoder.getElementValue(nSource, oValue);
+                oCodec.setElementValue(nElement, oValue);
+            }
+        }
+        oCodec.setElementValue(0, a_util::variant::Variant(static_cast<uint32_t>(nObjects)));
+        oBuffer.swap(oResized);
+    }
+    timestamp_t nTimeRebuild = a_util::system::getCurrentMicroseconds() - now;
+    Decoder oRebuilt = oFactory.makeDecoderFor(oBuffer.getPtr(), oBuffer.getSize());
+    const uint32_t nRebuiltChecksum = access_element::getValue(oRebuilt, "checksum").asUInt32();
+
+    oBuffer = oInitial;
+    Codec oCodec = oFactory.makeCodecFor(oBuffer.getPtr(), oBuffer.getSize());
+    now = a_util::system::getCurrentMicroseconds();
+    for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+        oCodec.resizeDynamicArray("count", 20 + nRound % 41, oBuffer);
+    }
+    timestamp_t nTimeResize = a_util::system::getCurrentMicroseconds() - now;
+    ASSERT_EQ(access_element::getValue(oCodec, "checksum").asUInt32(), nRebuiltChecksum);
+    ASSERT_EQ(oCodec.getBufferSize(), oRebuilt.getBufferSize());
+
+    std::cout << a_util::strings::format("%d resizes: new codec and copy %lld us, "
+                                         "resizeDynamicArray %lld us\n",
+                                         static_cast<int>(nRepeats),
+                                         nTimeRebuild,
+                                         nTimeResize)
+                     .c_str();
+}
+
+/// Checks that a validated view reads the same values as the checked API of its decoder.
+static void checkValidatedView(const Decoder& oDecoder)
+{
+    ValidatedDecoderView oView(oDecoder);
+    ASSERT_EQ(a_util::result::SUCCESS, oView.isValid());
+    ASSERT_EQ(&oView.getDecoder(), &oDecoder);
+    ASSERT_EQ(oView.getElementCount(), oDecoder.getElementCount());
+    for (size_t nElement = 0; nElement < oDecoder.getElementCount(); ++nElement) {
+        a_util::variant::Variant oExpected;
+        ASSERT_EQ(a_util::result::SUCCESS, oDecoder.getElementValue(nElement, oExpected));
+        ASSERT_EQ(oExpected.asString(), oView.getElementValue(nElement).asString());
+
+        uint64_t nExpected = 0, nValue = 0;
+        ASSERT_EQ(a_util::result::SUCCESS, oDecoder.getElementValue(nElement, &nExpected));
+        oView.getElementValue(nElement, &nValue);
+        ASSERT_EQ(nExpected, nValue);
+    }
+}
+
+/**
+ * @detail Check the unchecked element access of validated views of static, dynamic and
+ *         projected decoders and codecs
+ */
+TEST(CodecTest, TestValidatedView)
+{
+    {
+        CodecFactory oFactory("main", handles::strTestDesc);
+        for (DataRepresentation eRep: {deserialized, serialized}) {
+            std::vector<uint8_t> oData(oFactory.getStaticBufferSize(eRep), 0);
+            StaticCodec oCodec = oFactory.makeStaticCodecFor(oData.data(), oData.size(), eRep);
+            ValidatedCodecView oView(oCodec);
+            ASSERT_EQ(a_util::result::SUCCESS, oView.isValid());
+            oView.setElementValue(0, a_util::variant::Variant(static_cast<uint16_t>(0x1234)));
+            oView.setElementValue(1, a_util::variant::Variant(static_cast<int32_t>(-5)));
+            const uint8_t nBits = 21;
+            oView.setElementValue(2, &nBits);
+            const double fValue = 3.5;
+            oView.setElementValue(3, &fValue);
+            oView.setElementValue(4, a_util::variant::Variant(static_cast<int16_t>(-300)));
+
+            ASSERT_EQ(access_element::getValue(oCodec, "u16").asUInt16(), 0x1234);
+            ASSERT_EQ(access_element::getValue(oCodec, "i32").asInt32(), -5);
+            ASSERT_EQ(access_element::getValue(oCodec, "bits").asUInt8(), 21);
+            ASSERT_EQ(access_element::getValue(oCodec, "f64").asDouble(), 3.5);
+            ASSERT_EQ(access_element::getValue(oCodec, "sbits").asInt16(), -300);
+            ASSERT_NO_FATAL_FAILURE(checkValidatedView(
+                oFactory.makeDecoderFor(oData.data(), oData.size(), eRep)));
+        }
+    }
+
+    CodecFactory oFactory("main", object_list::strTestDesc);
+    for (DataRepresentation eRep: {deserialized, serialized}) {
+        a_util::memory::MemoryBuffer oBuffer = object_list::makeSample(oFactory, 3, 5, eRep);
+        Codec oCodec = oFactory.makeCodecFor(oBuffer.getPtr(), oBuffer.getSize(), eRep);
+        ASSERT_NO_FATAL_FAILURE(checkValidatedView(oCodec));
+
+        // writing the dynamic checksum
+        ValidatedCodecView oView(oCodec);
+        size_t nChecksum = 0;
+        ASSERT_EQ(a_util::result::SUCCESS, oCodec.findElementIndex("checksum", nChecksum));
+        oView.setElementValue(nChecksum, a_util::variant::Variant(static_cast<uint32_t>(42)));
+        ASSERT_EQ(access_element::getValue(oCodec, "checksum").asUInt32(), 42u);
+
+        // projections onto dynamic elements
+        CodecFactory oProjection = oFactory.makeProjection({"count", "tags[4]", "checksum"});
+        ASSERT_EQ(a_util::result::SUCCESS, oProjection.isValid());
+        ASSERT_NO_FATAL_FAILURE(checkValidatedView(
+            oProjection.makeDecoderFor(oBuffer.getPtr(), oBuffer.getSize(), eRep)));
+
+        // the buffer is checked once for all elements
+        Decoder oSmallDecoder =
+            oFactory.makeDecoderFor(oBuffer.getPtr(), oBuffer.getSize() - 1, eRep);
+        ASSERT_NE(a_util::result::SUCCESS, ValidatedDecoderView(oSmallDecoder).isValid());
+    }
+    ASSERT_EQ(ValidatedDecoderView().isValid().getErrorCode(), -37);
+}
+
+/**
+ * @detail Compare reading all elements of serialized samples with the checked API and through a
+ *         validated view
+ */
+TEST(CodecTest, TestValidatedViewPerf)
+{
+    CodecFactory oFactory("main", handles::strTestDesc);
+    std::vector<uint8_t> oData(oFactory.getStaticBufferSize(serialized));
+    for (size_t nByte = 0; nByte < oData.size(); ++nByte) {
+        oData[nByte] = static_cast<uint8_t>(nByte * 37);
+    }
+
+    const size_t nRepeats = 200000;
+    uint64_t nSumChecked = 0;
+    timestamp_t now = a_util::system::getCurrentMicroseconds();
+    for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+        StaticDecoder oDecoder =
+            oFactory.makeStaticDecoderFor(oData.data(), oData.size(), serialized);
+        if (isOk(oDecoder.isValid())) {
+            for (size_t nElement = 0; nElement < oDecoder.getElementCount(); ++nElement) {
+                uint64_t nValue = 0;
+                oDecoder.getElementValue(nElement, &nValue);
+                nSumChecked += nValue;
+            }
+        }
+    }
+    timestamp_t nTimeChecked = a_util::system::getCurrentMicroseconds() - now;
+
+    uint64_t nSumView = 0;
+    now = a_util::system::getCurrentMicroseconds();
+    for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+        StaticDecoder oDecoder =
+            oFactory.makeStaticDecoderFor(oData.data(), oData.size(), serialized);
+        ValidatedDecoderView oView(oDecoder);
+        if (isOk(oView.isValid())) {
+            for (size_t nElement = 0; nElement < oView.getElementCount(); ++nElement) {
+                uint64_t nValue = 0;
+                oView.getElementValue(nElement, &nValue);
+                nSumView += nValue;
+            }
+        }
+    }
+    timestamp_t nTimeView = a_util::system::getCurrentMicroseconds() - now;
+
+    ASSERT_EQ(nSumChecked, nSumView);
+    std::cout << a_util::strings::format(
+                     "%d serialized samples: checked access %lld us, validated view %lld us\n",
+                     static_cast<int>(nRepeats),
+                     nTimeChecked,
+                     nTimeView)
+                     .c_str();
+}
@@ -0,0 +1,194 @@
+/**
+ * @file
+ * Test implementation.
+ *
+ * Copyright @ 2021 VW Group. All rights reserved.
+ *
+ *     This Source Code Form is subject to the terms of the Mozilla
+ *     Public License, v. 2.0. If a copy of the MPL was not distributed
+ *     with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * If it is not possible or desirable to put the notice in a particular file, then
+ * You may include the notice in a location (such as a LICENSE file in a
+ * relevant directory) where a recipient would be likely to look for such a notice.
+ *
+ * You may add additional accurate notices of copyright ownership.
+ */
+
+#include "a_util/system.h"
+#include "codegen_test_types.h"
+#include "ddl/codec/codec_factory.h"
+#include "ddl/dd/ddfile.h"
+#include "ddl/serialization/serialization.h"
+
+#include <gtest/gtest.h>
+#include <cstring>
+
+using namespace ddl;
+using namespace ddl_test::generated;
+
+// the offset tables are usable at compile time
+static_assert(codegen::getElementCount<codegen_tWheel>() == 3, "invalid element count");
+static_assert(codegen::ElementTable<codegen_tWheel>::elements[1].serialized_bit_offset == 16,
+              "invalid serialized offset");
+static_assert(codegen::ElementTable<codegen_tVehicle>::elements[3].serialized_bit_size == 11,
+              "invalid serialized size");
+
+template <typename T>
+class CodegenTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        _dd = DDFile::fromXMLFile(TEST_FILES_DIR "/codegen.description");
+        _factory =
+            CodecFactory(_dd.getStructTypeAccess(codegen::CodecTraits<T>::getStructName()));
+        ASSERT_EQ(a_util::result::SUCCESS, _factory.isValid());
+    }
+
+    /// Fills a serialized buffer through the dynamic codec with different values per element.
+    std::vector<uint8_t> createSerializedSample(int64_t nSeed)
+    {
+        std::vector<uint8_t> oData(_factory.getStaticBufferSize(serialized), 0);
+        Codec oCodec = _factory.makeCodecFor(oData.data(), oData.size(), serialized);
+        EXPECT_EQ(a_util::result::SUCCESS, oCodec.isValid());
+        for (size_t nElement = 0; nElement < oCodec.getElementCount(); ++nElement) {
+            const StructElement* pElement = nullptr;
+            EXPECT_EQ(a_util::result::SUCCESS, oCodec.getElement(nElement, pElement));
+            const int64_t nValue = (nSeed + static_cast<int64_t>(nElement)) * -0x1234567;
+            a_util::variant::Variant oValue;
+            switch (pElement->type) {
+            case a_util::variant::VT_Bool:
+                oValue = ((nSeed + nElement) % 2) == 0;
+                break;
+            case a_util::variant::VT_Float:
+            case a_util::variant::VT_Double:
+                oValue = static_cast<double>(nValue) / 3.0;
+                break;
+            default:
+                oValue = nValue;
+                break;
+            }
+            EXPECT_EQ(a_util::result::SUCCESS, oCodec.setElementValue(nElement, oValue));
+        }
+        return oData;
+    }
+
+    dd::DataDefinition _dd;
+    CodecFactory _factory;
+};
+
+typedef ::testing::Types<codegen_tWheel, codegen_tVehicle, codegen_tSignals> tGeneratedTypes;
+TYPED_TEST_SUITE(CodegenTest, tGeneratedTypes);
+
+/**
+ * @detail Check that the generated sizes and offset tables match the codec factory.
+ */
+TYPED_TEST(CodegenTest, TestLayout)
+{
+    typedef codegen::CodecTraits<TypeParam> tTraits;
+    ASSERT_EQ(tTraits::getDeserializedSize(), sizeof(TypeParam));
+    ASSERT_EQ(tTraits::getDeserializedSize(), this->_factory.getStaticBufferSize(deserialized));
+    ASSERT_EQ(tTraits::getSerializedSize(), this->_factory.getStaticBufferSize(serialized));
+    ASSERT_EQ(codegen::getElementCount<TypeParam>(), this->_factory.getStaticElementCount());
+
+    TypeParam sValue;
+    StaticDecoder oDecoder =
+        this->_factory.makeStaticDecoderFor(&sValue, sizeof(sValue), deserialized);
+    ASSERT_EQ(a_util::result::SUCCESS, oDecoder.isValid());
+    for (size_t nElement = 0; nElement < codegen::getElementCount<TypeParam>(); ++nElement) {
+        const codegen::ElementInfo& sInfo = codegen::ElementTable<TypeParam>::elements[nElement];
+        const StructElement* pElement = nullptr;
+        ASSERT_EQ(a_util::result::SUCCESS, oDecoder.getElement(nElement, pElement));
+        ASSERT_EQ(pElement->name, sInfo.name);
+        ASSERT_EQ(static_cast<const uint8_t*>(oDecoder.getElementAddress(nElement)) -
+                      reinterpret_cast<const uint8_t*>(&sValue),
+                  sInfo.deserialized_byte_offset);
+    }
+}
+
+/**
+ * @detail Check that the generated serialization code is bit-for-bit compatible with the
+ * dynamic codec in both directions.
+ */
+TYPED_TEST(CodegenTest, TestRoundTrip)
+{
+    for (int64_t nSeed = 0; nSeed < 4; ++nSeed) {
+        const std::vector<uint8_t> oSerialized = this->createSerializedSample(nSeed);
+
+        // deserialization
+        a_util::memory::MemoryBuffer oCodecDeserialized;
+        Decoder oDecoder =
+            this->_factory.makeDecoderFor(oSerialized.data(), oSerialized.size(), serialized);
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  serialization::transformToBuffer(oDecoder, oCodecDeserialized, true));
+        ASSERT_EQ(oCodecDeserialized.getSize(), sizeof(TypeParam));
+
+        TypeParam sValue;
+        std::memset(&sValue, 0, sizeof(sValue));
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  codegen::deserialize(oSerialized.data(), oSerialized.size(), sValue));
+        ASSERT_EQ(0, std::memcmp(&sValue, oCodecDeserialized.getPtr(), sizeof(sValue)));
+
+        // serialization
+        a_util::memory::MemoryBuffer oCodecSerialized;
+        oDecoder = this->_factory.makeDecoderFor(&sValue, sizeof(sValue), deserialized);
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  serialization::transformToBuffer(oDecoder, oCodecSerialized, true));
+        ASSERT_EQ(oCodecSerialized.getSize(), oSerialized.size());
+
+        std::vector<uint8_t> oGeneratedSerialized(oSerialized.size(), 0);
+        ASSERT_EQ(a_util::result::SUCCESS,
+                  codegen::serialize(sValue, oGeneratedSerialized.data(), oSerialized.size()));
+        ASSERT_EQ(0,
+                  std::memcmp(oGeneratedSerialized.data(),
+                              oCodecSerialized.getPtr(),
+                              oGeneratedSerialized.size()));
+        ASSERT_EQ(oGeneratedSerialized, oSerialized);
+    }
+
+    TypeParam sValue;
+    std::vector<uint8_t> oBuffer(codegen::CodecTraits<TypeParam>::getSerializedSize());
+    ASSERT_EQ(codegen::detail::ERR_POINTER,
+              codegen::serialize(sValue, nullptr, oBuffer.size()));
+    ASSERT_EQ(codegen::detail::ERR_INVALID_ARG,
+              codegen::serialize(sValue, oBuffer.data(), oBuffer.size() - 1));
+    ASSERT_EQ(codegen::detail::ERR_INVALID_ARG,
+              codegen::deserialize(oBuffer.data(), oBuffer.size() - 1, sValue));
+}
+
+/**
+ * @detail Compare the serialization speed of the generated code with the dynamic codec.
+ */
+TEST(CodecTest, TestGeneratedCodecPerf)
+{
+    const dd::DataDefinition oDD = DDFile::fromXMLFile(TEST_FILES_DIR "/codegen.description");
+    CodecFactory oFactory(oDD.getStructTypeAccess("codegen::tVehicle"));
+    ASSERT_EQ(a_util::result::SUCCESS, oFactory.isValid());
+
+    codegen_tVehicle sVehicle;
+    std::memset(&sVehicle, 0, sizeof(sVehicle));
+    sVehicle.position = 12.5;
+    sVehicle.wheels[2].torque = -1000;
+    std::vector<uint8_t> oSerialized(oFactory.getStaticBufferSize(serialized));
+    a_util::memory::MemoryBuffer oCodecSerialized;
+
+    const size_t nRepeats = 100000;
+    timestamp_t now = a_util::system::getCurrentMicroseconds();
+    for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+        Decoder oDecoder = oFactory.makeDecoderFor(&sVehicle, sizeof(sVehicle), deserialized);
+        serialization::transformToBuffer(oDecoder, oCodecSerialized);
+    }
+    timestamp_t nTimeCodec = a_util::system::getCurrentMicroseconds() - now;
+
+    now = a_util::system::getCurrentMicroseconds();
+    for (size_t nRound = 0; nRound < nRepeats; ++nRound) {
+        codegen::serialize(sVehicle, oSerialized.data(), oSerialized.size());
+    }
+    timestamp_t nTimeGenerated = a_util::system::getCurrentMicroseconds() - now;
+
+    ASSERT_EQ(oCodecSerialized.getSize(), oSerialized.size());
+    ASSERT_EQ(0, std::memcmp(oCodecSerialized.getPtr(), oSerialized.data(), oSerialized.size()));
+    std::cout << a_util::strings::format(
+                     "serialize: Codec %lld us, generated %lld us\n", nTimeCodec, nTimeGenerated)
+                     .c_str();
+}
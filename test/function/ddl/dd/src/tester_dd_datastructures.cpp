@@ -17,10 +17,14 @@
  */
 
 #include "./../../_common/test_oo_ddl.h"
+#include "a_util/strings.h"
+#include "a_util/system.h"
 #include "ddl/dd/dd.h"
 
 #include <gtest/gtest.h>
+#include <iostream>
 #include <stdint.h>
+#include <vector>
 
 using namespace ddl::dd;
 
@@ -351,4 +355,292 @@ TEST(TesterUtilityDataStructureMap, observerMove)
     struct_type_elem_move->setName("elem1_changed");
     auto struct_type_elem_changed_move = struct_type_move->getElements().access("elem1_changed");
     ASSERT_TRUE(struct_type_elem_changed_move);
-}
\ No newline at end of file
+}
+
+/*****************************************************************************************
+ * Test compact storage
+ *****************************************************************************************/
+
+struct TestCustomInfo : datamodel::Info<TestCustomInfo> {
+    static constexpr const uint8_t INFO_TYPE_ID = InfoType::last_info + 1;
+    int _value = 0;
+};
+
+/**
+ * @detail Equal type and unit names of elements share their storage.
+ */
+TEST(TesterDataModelCompactStorage, internedStrings)
+{
+    datamodel::InternedString empty;
+    EXPECT_EQ(empty.get(), "");
+    EXPECT_EQ(empty, datamodel::InternedString(""));
+
+    const std::string type_name = "a.type.name.longer.than.the.short.string.buffer";
+    datamodel::InternedString interned1(type_name);
+    datamodel::InternedString interned2{std::string(type_name)};
+    EXPECT_EQ(interned1.get(), type_name);
+    EXPECT_EQ(interned1, interned2);
+    EXPECT_EQ(&interned1.get(), &interned2.get());
+    interned2 = "other";
+    EXPECT_NE(interned1, interned2);
+    EXPECT_EQ(interned2.get(), "other");
+
+    StructType::Element element1("elem1", type_name, {}, {});
+    StructType::Element element2("elem2", type_name, {}, {});
+    element1.setUnitName("unit");
+    element2.setUnitName("unit");
+    EXPECT_EQ(&element1.getTypeName(), &element2.getTypeName());
+    EXPECT_EQ(&element1.getUnitName(), &element2.getUnitName());
+    EXPECT_TRUE(element1 == element2);
+    element2.setScale("2.0");
+    EXPECT_EQ(element2.getScale(), "2.0");
+    EXPECT_FALSE(element1 == element2);
+}
+
+/**
+ * @detail A value is removed from the pool of interned strings with its last user.
+ */
+TEST(TesterDataModelCompactStorage, internedStringsReleased)
+{
+    const size_t pool_size = datamodel::InternedString::getPoolSize();
+    {
+        StructType::Element element1("elem1", "a.released.type.name", {}, {});
+        EXPECT_EQ(datamodel::InternedString::getPoolSize(), pool_size + 1);
+        StructType::Element element2 = element1;
+        element1.setTypeName("another.released.type.name");
+        EXPECT_EQ(datamodel::InternedString::getPoolSize(), pool_size + 2);
+        element2 = element1;
+        EXPECT_EQ(datamodel::InternedString::getPoolSize(), pool_size + 1);
+        EXPECT_EQ(element2.getTypeName(), "another.released.type.name");
+    }
+    EXPECT_EQ(datamodel::InternedString::getPoolSize(), pool_size);
+}
+
+/**
+ * @detail Infos of the predefined and of custom types are held within the info map.
+ */
+TEST(TesterDataModelCompactStorage, infoMap)
+{
+    StructType::Element element("elem", "tUInt8", {}, {});
+    EXPECT_EQ(element.getInfo<TestCustomInfo>(), nullptr);
+    EXPECT_EQ(element.getInfo<ElementTypeInfo>(), nullptr);
+
+    element.setInfo(std::make_shared<ElementTypeInfo>());
+    auto custom_info = std::make_shared<TestCustomInfo>();
+    custom_info->_value = 42;
+    element.setInfo(custom_info);
+    EXPECT_NE(element.getInfo<ElementTypeInfo>(), nullptr);
+    ASSERT_NE(element.getInfo<TestCustomInfo>(), nullptr);
+    EXPECT_EQ(element.getInfo<TestCustomInfo>()->_value, 42);
+
+    // copies share the infos, but setting an info does not change the original
+    StructType::Element copied_element = element;
+    EXPECT_EQ(copied_element.getInfo<ElementTypeInfo>(), element.getInfo<ElementTypeInfo>());
+    EXPECT_EQ(copied_element.getInfo<TestCustomInfo>(), custom_info.get());
+    copied_element.setInfo(std::make_shared<TestCustomInfo>());
+    EXPECT_EQ(copied_element.getInfo<TestCustomInfo>()->_value, 0);
+    EXPECT_EQ(element.getInfo<TestCustomInfo>()->_value, 42);
+
+    StructType::Element moved_element = std::move(copied_element);
+    EXPECT_EQ(moved_element.getInfo<ElementTypeInfo>(), element.getInfo<ElementTypeInfo>());
+    EXPECT_EQ(moved_element.getInfo<TestCustomInfo>()->_value, 0);
+}
+
+/*****************************************************************************************
+ * Test copies
+ *****************************************************************************************/
+
+namespace {
+
+class StructTypeChangeCounter : public datamodel::ModelObserver<StructType> {
+public:
+    void modelChanged(datamodel::ModelEventCode, StructType&, const std::string&) override
+    {
+        ++_changes;
+    }
+    size_t _changes = 0;
+};
+
+} // namespace
+
+/**
+ * @detail Copies share the datamodel until one of them is changed.
+ */
+TEST(TesterOODDL, checkCopyOnWrite)
+{
+    auto original_model = std::make_shared<datamodel::DataDefinition>();
+    DataDefinition original_dd(original_model);
+    original_dd.getDataTypes().add({"tUInt8", 8});
+    original_dd.getDataTypes().add({"tUInt32", 32});
+    const auto serialized_info = StructType::SerializedInfo({}, ByteOrder::e_le);
+    StructType inner("inner", "1", 1);
+    inner.getElements().add({"a", "tUInt8", {1}, serialized_info});
+    inner.getElements().add({"b", "tUInt32", {1}, serialized_info});
+    original_dd.getStructTypes().add(inner);
+    StructType outer("outer", "1", 1);
+    outer.getElements().add({"s", "inner", {1}, serialized_info, 2});
+    outer.getElements().add({"x", "tUInt8", {1}, serialized_info});
+    original_dd.getStructTypes().add(outer);
+    ASSERT_TRUE(original_dd.isValid());
+    ASSERT_EQ(original_dd.getStructTypeAccess("outer").getStaticStructSize(), 11);
+
+    // references and observers taken before the copy
+    auto& original_struct_types = original_dd.getStructTypes();
+    const auto original_outer = original_struct_types.access("outer");
+    StructTypeChangeCounter observer;
+    static_cast<datamodel::ModelSubject<StructType>*>(original_model.get())
+        ->attachObserver(&observer);
+
+    // copies of an unchanged datamodel share the types of one snapshot, the original keeps its own
+    const DataDefinition copied_dd = original_dd;
+    DataDefinition assigned_dd;
+    assigned_dd = copied_dd;
+    EXPECT_EQ(original_dd.getModel(), original_model);
+    EXPECT_NE(copied_dd.getModel(), original_model);
+    EXPECT_NE(assigned_dd.getModel(), copied_dd.getModel());
+    EXPECT_TRUE(copied_dd.getStructTypes().isShared("outer"));
+    EXPECT_FALSE(original_dd.getStructTypes().isShared("outer"));
+    EXPECT_NE(copied_dd.getStructTypes().get("outer"), original_outer);
+    EXPECT_EQ(assigned_dd.getStructTypes().get("outer"), copied_dd.getStructTypes().get("outer"));
+    EXPECT_EQ(DataDefinition(original_dd).getStructTypes().get("outer"),
+              copied_dd.getStructTypes().get("outer"));
+    EXPECT_TRUE(copied_dd.isValid());
+    EXPECT_EQ(copied_dd.getStructTypeAccess("outer").getStaticStructSize(), 11);
+
+    // reading through the non-const getters keeps the types shared
+    EXPECT_TRUE(assigned_dd.getStructTypes().contains("inner"));
+    EXPECT_EQ(assigned_dd.getStructTypes().get("inner")->getElements().getSize(), 2);
+    EXPECT_EQ(assigned_dd.getStructTypeAccess("outer").getStaticStructSize(), 11);
+    EXPECT_EQ(assigned_dd.getHeader().getLanguageVersion(), copied_dd.getVersion());
+    EXPECT_TRUE(assigned_dd.getStructTypes().isShared("inner"));
+    EXPECT_TRUE(assigned_dd.getStructTypes().isShared("outer"));
+
+    // the original is changed in place, also through the references taken before the copy
+    original_outer->getElements().access("x")->setTypeName("tUInt32");
+    original_struct_types.add(StructType("added", "1", 1));
+    EXPECT_EQ(original_dd.getModel(), original_model);
+    EXPECT_EQ(original_model->getStructTypes().get("outer"), original_outer);
+    EXPECT_EQ(original_dd.getStructTypeAccess("outer").getStaticStructSize(), 14);
+    EXPECT_GE(observer._changes, 2);
+    EXPECT_EQ(copied_dd.getStructTypeAccess("outer").getStaticStructSize(), 11);
+    EXPECT_EQ(copied_dd.getStructTypes().get("outer")->getElements().get("x")->getTypeName(),
+              "tUInt8");
+    EXPECT_FALSE(copied_dd.getStructTypes().contains("added"));
+    EXPECT_FALSE(assigned_dd.getStructTypes().contains("added"));
+    {
+        // a copy of the changed original shares the unchanged types with the former copies
+        const DataDefinition later_dd = original_dd;
+        EXPECT_EQ(later_dd.getStructTypeAccess("outer").getStaticStructSize(), 14);
+        EXPECT_TRUE(later_dd.getStructTypes().contains("added"));
+        EXPECT_NE(later_dd.getStructTypes().get("outer"), copied_dd.getStructTypes().get("outer"));
+        EXPECT_EQ(later_dd.getStructTypes().get("inner"), copied_dd.getStructTypes().get("inner"));
+    }
+
+    // a changed copy copies the changed type and its users only, its changes are validated
+    const auto observed_changes = observer._changes;
+    assigned_dd.getStructTypes().access("inner")->getElements().access("a")->setTypeName(
+        "tUInt32");
+    EXPECT_FALSE(assigned_dd.getStructTypes().isShared("inner"));
+    EXPECT_FALSE(assigned_dd.getStructTypes().isShared("outer"));
+    EXPECT_TRUE(assigned_dd.getDataTypes().isShared("tUInt32"));
+    EXPECT_EQ(assigned_dd.getDataTypes().get("tUInt32"), copied_dd.getDataTypes().get("tUInt32"));
+    EXPECT_EQ(assigned_dd.getStructTypeAccess("outer").getStaticStructSize(), 17);
+    EXPECT_EQ(copied_dd.getStructTypeAccess("outer").getStaticStructSize(), 11);
+    EXPECT_EQ(original_dd.getStructTypeAccess("outer").getStaticStructSize(), 14);
+
+    // a changed used type is seen by the users within the copy only
+    assigned_dd.getDataTypes().access("tUInt8")->setBitSize(16);
+    EXPECT_EQ(assigned_dd.getStructTypeAccess("outer").getStaticStructSize(), 18);
+    EXPECT_EQ(copied_dd.getStructTypeAccess("outer").getStaticStructSize(), 11);
+    EXPECT_EQ(original_dd.getStructTypeAccess("outer").getStaticStructSize(), 14);
+    assigned_dd.getStructTypes().access("inner")->getElements().access("a")->setTypeName(
+        "tUnknown");
+    EXPECT_FALSE(assigned_dd.getValidationProtocol().empty());
+    EXPECT_TRUE(copied_dd.getValidationProtocol().empty());
+    EXPECT_TRUE(original_dd.getValidationProtocol().empty());
+    EXPECT_EQ(observer._changes, observed_changes);
+
+    // the model set is still observed after a copy, also for changes made directly to it
+    original_model->getStructTypes().access("outer")->getElements().access("x")->setTypeName(
+        "tUInt8");
+    EXPECT_EQ(original_dd.getStructTypeAccess("outer").getStaticStructSize(), 11);
+    auto set_model = std::make_shared<datamodel::DataDefinition>(*original_model);
+    DataDefinition set_dd;
+    set_dd.setModel(set_model);
+    const DataDefinition copy_of_set_dd = set_dd;
+    set_model->getStructTypes().access("outer")->getElements().access("x")->setTypeName(
+        "tUInt32");
+    EXPECT_EQ(set_dd.getModel(), set_model);
+    EXPECT_EQ(set_dd.getStructTypeAccess("outer").getStaticStructSize(), 14);
+    EXPECT_EQ(copy_of_set_dd.getStructTypeAccess("outer").getStaticStructSize(), 11);
+
+    // a moved copy keeps sharing the types
+    DataDefinition kept_dd = original_dd;
+    DataDefinition moved_dd(std::move(kept_dd));
+    EXPECT_TRUE(moved_dd.getStructTypes().isShared("outer"));
+    moved_dd.getStructTypes().access("outer")->getElements().access("x")->setTypeName("tUInt32");
+    EXPECT_EQ(moved_dd.getStructTypeAccess("outer").getStaticStructSize(), 14);
+    EXPECT_EQ(original_dd.getStructTypeAccess("outer").getStaticStructSize(), 11);
+    EXPECT_EQ(DataDefinition(original_dd).getStructTypeAccess("outer").getStaticStructSize(), 11);
+}
+
+/**
+ * @detail Copies share the unchanged types, so neither copying nor a change of a copy copies or
+ * validates the whole datamodel.
+ */
+TEST(TesterOODDL, checkCopyPerformance)
+{
+    const size_t nStructCount = 2000;
+    DataDefinition original_dd;
+    original_dd.getDataTypes().add({"tUInt32", 32});
+    const auto serialized_info = StructType::SerializedInfo({}, ByteOrder::e_le);
+    for (size_t nStruct = 0; nStruct < nStructCount; ++nStruct) {
+        StructType struct_type(a_util::strings::format("s%d", nStruct), "1", 1);
+        for (size_t nElement = 0; nElement < 10; ++nElement) {
+            struct_type.getElements().add(
+                {a_util::strings::format("e%d", nElement), "tUInt32", {1}, serialized_info});
+        }
+        original_dd.getStructTypes().add(struct_type);
+    }
+    ASSERT_TRUE(original_dd.isValid());
+
+    // the first copy takes the snapshot, the others share it
+    const size_t nRepeats = 100;
+    std::vector<DataDefinition> oCopies;
+    oCopies.reserve(nRepeats + 1);
+    timestamp_t now = a_util::system::getCurrentMicroseconds();
+    oCopies.push_back(original_dd);
+    const timestamp_t nFirstCopy = a_util::system::getCurrentMicroseconds() - now;
+    now = a_util::system::getCurrentMicroseconds();
+    for (size_t nRound = 1; nRound < nRepeats; ++nRound) {
+        oCopies.push_back(original_dd);
+    }
+    const timestamp_t nCopies = a_util::system::getCurrentMicroseconds() - now;
+
+    // a change of the original copies the changed type only into the next snapshot
+    original_dd.getStructTypes().access("s1")->getElements().access("e0")->setArraySize(2);
+    now = a_util::system::getCurrentMicroseconds();
+    oCopies.push_back(original_dd);
+    const timestamp_t nCopyAfterChange = a_util::system::getCurrentMicroseconds() - now;
+
+    // a change of a copy copies the changed type only
+    now = a_util::system::getCurrentMicroseconds();
+    oCopies.front().getStructTypes().access("s0")->getElements().access("e0")->setTypeName(
+        "tUnknown");
+    const timestamp_t nWrite = a_util::system::getCurrentMicroseconds() - now;
+
+    std::cout << a_util::strings::format("first copy: %lld, %d more copies: %lld, "
+                                         "copy after a change: %lld, write: %lld",
+                                         nFirstCopy,
+                                         nRepeats - 1,
+                                         nCopies,
+                                         nCopyAfterChange,
+                                         nWrite)
+                     .c_str()
+              << std::endl;
+    EXPECT_EQ(oCopies.back().getStructTypeAccess("s1").getStaticStructSize(), 44);
+    EXPECT_EQ(oCopies.back().getStructTypes().get("s2"), oCopies[1].getStructTypes().get("s2"));
+    EXPECT_FALSE(oCopies.front().getValidationProtocol().empty());
+    EXPECT_TRUE(oCopies[1].getValidationProtocol().empty());
+    EXPECT_TRUE(original_dd.getValidationProtocol().empty());
+}
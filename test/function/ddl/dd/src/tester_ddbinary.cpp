@@ -0,0 +1,178 @@
+/**
+ * @file
+ * Implementation of the tester for the binary DataDefinition cache.
+ *
+ * Copyright @ 2021 VW Group. All rights reserved.
+ *
+ *     This Source Code Form is subject to the terms of the Mozilla
+ *     Public License, v. 2.0. If a copy of the MPL was not distributed
+ *     with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *
+ * If it is not possible or desirable to put the notice in a particular file, then
+ * You may include the notice in a location (such as a LICENSE file in a
+ * relevant directory) where a recipient would be likely to look for such a notice.
+ *
+ * You may add additional accurate notices of copyright ownership.
+ *
+ */
+
+#include "a_util/filesystem.h"
+#include "ddl/dd/ddbinary.h"
+#include "ddl/dd/ddcompare.h"
+#include "ddl/dd/ddfile.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <gtest/gtest.h>
+
+namespace {
+
+void checkSamePositions(const ddl::dd::DataDefinition& expected,
+                        const ddl::dd::DataDefinition& loaded)
+{
+    for (const auto& struct_type: expected.getStructTypes()) {
+        auto expected_access = expected.getStructTypeAccess(struct_type.first);
+        auto loaded_access = loaded.getStructTypeAccess(struct_type.first);
+        ASSERT_TRUE(loaded_access);
+        EXPECT_EQ(expected_access.getStaticStructSize(), loaded_access.getStaticStructSize());
+        EXPECT_EQ(expected_access.getStaticSerializedBitSize(),
+                  loaded_access.getStaticSerializedBitSize());
+        auto loaded_element = loaded_access.begin();
+        for (const auto& expected_element: expected_access) {
+            ASSERT_NE(loaded_element, loaded_access.end());
+            EXPECT_EQ(expected_element.getTypeOfType(), loaded_element->getTypeOfType());
+            EXPECT_EQ(expected_element.isDynamic(), loaded_element->isDynamic());
+            EXPECT_EQ(expected_element.isAfterDynamic(), loaded_element->isAfterDynamic());
+            if (!expected_element.isAfterDynamic()) {
+                EXPECT_EQ(expected_element.getDeserializedBytePos(),
+                          loaded_element->getDeserializedBytePos());
+                EXPECT_EQ(expected_element.getSerializedBitOffset(),
+                          loaded_element->getSerializedBitOffset());
+            }
+            EXPECT_EQ(expected_element.getSerializedBitSize(),
+                      loaded_element->getSerializedBitSize());
+            ++loaded_element;
+        }
+        EXPECT_EQ(loaded_element, loaded_access.end());
+    }
+}
+
+} // namespace
+
+/**
+ * @detail Writing a DataDefinition into the binary form and reading it back.
+ */
+TEST(TesterDDBinary, roundTrip)
+{
+    using namespace ddl;
+    for (const auto file: {TEST_FILES_DIR "/adtf.description",
+                           TEST_FILES_DIR "/adtf_dynamic.description",
+                           TEST_FILES_DIR "/adtf_v40.description"}) {
+        DataDefinition dd_xml;
+        ASSERT_NO_THROW(dd_xml = DDFile::fromXMLFile(file););
+
+        const auto binary = DDBinary::toBinary(dd_xml, 42);
+        DataDefinition dd_binary;
+        ASSERT_NO_THROW(dd_binary = DDBinary::fromBinary(binary.data(), binary.size(), 42););
+
+        EXPECT_TRUE(dd_binary.isValid(DataDefinition::ValidationLevel::good_enough));
+        EXPECT_EQ(dd_xml.isValid(), dd_binary.isValid());
+        EXPECT_EQ(dd_xml.getValidationProtocol().size(), dd_binary.getValidationProtocol().size());
+        EXPECT_EQ(dd_xml.getHeader(), dd_binary.getHeader());
+        EXPECT_TRUE(isOk(DDCompare::isEqual(dd_xml, dd_binary, DDCompare::dcf_everything)))
+            << file;
+        checkSamePositions(dd_xml, dd_binary);
+    }
+}
+
+/**
+ * @detail A DataDefinition read from the binary form keeps track of changes.
+ */
+TEST(TesterDDBinary, changeAfterLoad)
+{
+    using namespace ddl;
+    DataDefinition dd_xml;
+    ASSERT_NO_THROW(dd_xml = DDFile::fromXMLFile(TEST_FILES_DIR "/adtf.description"););
+    const auto binary = DDBinary::toBinary(dd_xml, 0);
+    DataDefinition dd_binary = DDBinary::fromBinary(binary.data(), binary.size(), 0);
+
+    // the dependencies are restored, so renaming a data type renames it in the structs using it
+    dd_xml.getDataTypes().access("tUInt32")->setName("tUInt32_renamed");
+    dd_binary.getDataTypes().access("tUInt32")->setName("tUInt32_renamed");
+    const auto& elements = dd_binary.getStructTypes().get("tMediaTypeInfo")->getElements();
+    EXPECT_TRUE(std::any_of(elements.cbegin(), elements.cend(), [](const auto& element) {
+        return element->getTypeName() == "tUInt32_renamed";
+    }));
+    EXPECT_TRUE(dd_binary.isValid());
+    EXPECT_TRUE(isOk(DDCompare::isEqual(dd_xml, dd_binary, DDCompare::dcf_everything)));
+}
+
+/**
+ * @detail Stale or corrupt binary data is rejected.
+ */
+TEST(TesterDDBinary, rejectStaleData)
+{
+    using namespace ddl;
+    DataDefinition dd_xml;
+    ASSERT_NO_THROW(dd_xml = DDFile::fromXMLFile(TEST_FILES_DIR "/adtf.description"););
+    auto binary = DDBinary::toBinary(dd_xml, 1);
+
+    EXPECT_THROW(DDBinary::fromBinary(binary.data(), binary.size(), 2), dd::Error);
+    EXPECT_THROW(DDBinary::fromBinary(binary.data(), binary.size() - 1, 1), dd::Error);
+    EXPECT_THROW(DDBinary::fromBinary(binary.data(), 10, 1), dd::Error);
+    binary[binary.size() / 2] ^= 0xFF;
+    EXPECT_THROW(DDBinary::fromBinary(binary.data(), binary.size(), 1), dd::Error);
+}
+
+/**
+ * @detail Loading a file through the binary cache, which is rewritten if the file changed.
+ */
+TEST(TesterDDBinary, fromXMLFileCached)
+{
+    using namespace ddl;
+    const std::string xml_file = TEST_FILES_WRITE_DIR "/adtf_cached.description";
+    const std::string cache_file = TEST_FILES_WRITE_DIR "/adtf_cached.description.bin";
+    std::remove(cache_file.c_str());
+    std::string content;
+    ASSERT_EQ(a_util::filesystem::readTextFile(TEST_FILES_DIR "/adtf.description", content),
+              a_util::filesystem::OK);
+    ASSERT_EQ(a_util::filesystem::writeTextFile(xml_file, content), a_util::filesystem::OK);
+
+    // the first load writes the cache
+    DataDefinition dd_first = DDBinary::fromXMLFileCached(xml_file, cache_file);
+    EXPECT_TRUE(a_util::filesystem::exists(cache_file));
+    EXPECT_TRUE(isOk(
+        DDCompare::isEqual(DDFile::fromXMLFile(xml_file), dd_first, DDCompare::dcf_everything)));
+    DataDefinition dd_cached = DDBinary::fromXMLFileCached(xml_file, cache_file);
+    EXPECT_TRUE(isOk(DDCompare::isEqual(dd_first, dd_cached, DDCompare::dcf_everything)));
+
+    // a changed file is loaded again and replaces the stale cache
+    const std::string old_description = "ADTF Common Description File";
+    const std::string new_description = "Changed Description File";
+    const auto description_pos = content.find(old_description);
+    ASSERT_NE(description_pos, std::string::npos);
+    content.replace(description_pos, old_description.size(), new_description);
+    ASSERT_EQ(a_util::filesystem::writeTextFile(xml_file, content), a_util::filesystem::OK);
+    DataDefinition dd_changed = DDBinary::fromXMLFileCached(xml_file, cache_file);
+    EXPECT_EQ(dd_changed.getHeader().getDescription(), new_description);
+    dd_cached = DDBinary::fromXMLFileCached(xml_file, cache_file);
+    EXPECT_EQ(dd_cached.getHeader().getDescription(), new_description);
+
+    // a corrupt cache is replaced as well
+    ASSERT_EQ(a_util::filesystem::writeTextFile(cache_file, "no cache"), a_util::filesystem::OK);
+    dd_cached = DDBinary::fromXMLFileCached(xml_file, cache_file);
+    EXPECT_TRUE(isOk(DDCompare::isEqual(dd_changed, dd_cached, DDCompare::dcf_everything)));
+    std::string cache_content;
+    ASSERT_EQ(a_util::filesystem::readTextFile(cache_file, cache_content), a_util::filesystem::OK);
+    EXPECT_NE(cache_content, "no cache");
+
+    // an invalid file is reported with its path
+    ASSERT_EQ(a_util::filesystem::writeTextFile(xml_file, "<adtf:ddl>"), a_util::filesystem::OK);
+    try {
+        DDBinary::fromXMLFileCached(xml_file, cache_file);
+        FAIL() << "invalid file loaded";
+    }
+    catch (const dd::Error& error) {
+        EXPECT_NE(std::string(error.what()).find(xml_file), std::string::npos);
+    }
+}
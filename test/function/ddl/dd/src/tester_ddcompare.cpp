@@ -19,6 +19,7 @@
 #include "./../../_common/test_oo_ddl.h"
 #include "a_util/xml.h"
 #include "ddl/dd/ddcompare.h"
+#include "ddl/dd/ddfile.h"
 #include "ddl/dd/ddstring.h"
 #include "ddl_definitions.h"
 
@@ -857,3 +858,71 @@ TEST(TesterDDCompare, TestisEqualDescriptionsWithStringMethods)
         }
     }
 }
+
+/**
+ * @detail The fingerprints of struct types used to short-circuit the comparison.
+ */
+TEST(TesterDDCompare, TestFingerprints)
+{
+    using namespace ddl;
+    DataDefinition dd1 = DDFile::fromXMLFile(TEST_FILES_DIR "/adtf.description");
+    DataDefinition dd2 = DDFile::fromXMLFile(TEST_FILES_DIR "/adtf.description");
+    const auto get_fingerprints = [](const DataDefinition& dd, const std::string& struct_name) {
+        const auto struct_type = dd.getStructTypes().get(struct_name);
+        const auto type_info = struct_type->getInfo<dd::TypeInfo>();
+        return std::make_pair(type_info->getLayoutFingerprint(*struct_type, *dd.getModel()),
+                              type_info->getFullFingerprint(*struct_type, *dd.getModel()));
+    };
+
+    const auto is_equal_struct = [](const DataDefinition& dd1,
+                                    const DataDefinition& dd2,
+                                    uint32_t flags) {
+        return DDCompare::isEqual(*dd1.getStructTypes().get("adtf.core.media_type"),
+                                  dd1,
+                                  *dd2.getStructTypes().get("adtf.core.media_type"),
+                                  dd2,
+                                  flags);
+    };
+
+    // independently loaded descriptions have the same fingerprints
+    const auto fingerprints1 = get_fingerprints(dd1, "adtf.core.media_type");
+    ASSERT_TRUE(fingerprints1.first);
+    ASSERT_TRUE(fingerprints1.second);
+    EXPECT_NE(*fingerprints1.first, *fingerprints1.second);
+    EXPECT_EQ(fingerprints1, get_fingerprints(dd2, "adtf.core.media_type"));
+    EXPECT_NE(fingerprints1, get_fingerprints(dd1, "tMediaTypeInfo"));
+    EXPECT_EQ(a_util::result::SUCCESS,
+              is_equal_struct(dd1, dd2, DDCompare::icf_everything));
+
+    // a changed name of a used struct type element changes the full fingerprint only
+    dd2.getStructTypes().access("tMediaTypeInfo")->getElements().access("ui32Flags")->setName(
+        "ui32Changed");
+    auto fingerprints2 = get_fingerprints(dd2, "adtf.core.media_type");
+    EXPECT_EQ(fingerprints1.first, fingerprints2.first);
+    EXPECT_NE(fingerprints1.second, fingerprints2.second);
+    EXPECT_EQ(a_util::result::SUCCESS,
+              DDCompare::isBinaryEqual(
+                  "adtf.core.media_type", dd1, "adtf.core.media_type", dd2, false));
+    const auto result = is_equal_struct(dd1, dd2, DDCompare::icf_everything);
+    EXPECT_NE(a_util::result::SUCCESS, result);
+    // the detailed comparison describes the difference
+    EXPECT_NE(std::string(result.getDescription()).find("ui32Flags"), std::string::npos);
+    EXPECT_EQ(a_util::result::SUCCESS,
+              is_equal_struct(dd1, dd2, DDCompare::icf_memory));
+
+    // a changed data type changes the layout
+    dd2.getStructTypes().access("tMediaTypeInfo")->getElements().access("ui32Changed")->setTypeName(
+        "tUInt16");
+    fingerprints2 = get_fingerprints(dd2, "adtf.core.media_type");
+    EXPECT_NE(fingerprints1.first, fingerprints2.first);
+    EXPECT_NE(a_util::result::SUCCESS,
+              DDCompare::isBinaryEqual(
+                  "adtf.core.media_type", dd1, "adtf.core.media_type", dd2, false));
+
+    // invalid struct types have no fingerprints
+    dd2.getStructTypes().access("tMediaTypeInfo")->getElements().access("ui32Changed")->setTypeName(
+        "tUnknown");
+    fingerprints2 = get_fingerprints(dd2, "adtf.core.media_type");
+    EXPECT_FALSE(fingerprints2.first);
+    EXPECT_FALSE(fingerprints2.second);
+}
@@ -17,6 +17,8 @@
  */
 
 #include "../../_common/test_oo_ddl.h"
+#include "a_util/strings.h"
+#include "ddl/datamodel/xml_datamodel.h"
 #include "ddl/dd/dd.h"
 #include "ddl/dd/dddatatype.h"
 #include "ddl/dd/ddstring.h"
@@ -389,4 +391,135 @@ TEST(TesterOODDL, checkTypeCalculations)
     // its valid again
     my_dd.validate();
     ASSERT_TRUE(my_dd.isValid());
-}
\ No newline at end of file
+}
+/**
+ * @detail Validating and calculating the struct types on several threads has the same result as
+ * doing it sequentially, even for recursions and invalid struct types.
+ */
+TEST(TesterOODDL, checkParallelValidationAndCalculation)
+{
+    using namespace ddl;
+    // every struct type uses the one with half its index, so the waves grow from wave to wave.
+    // The predefined base units are not declared, they are added while validating.
+    std::string description = "<?xml version=\"1.0\" encoding=\"iso-8859-1\" standalone=\"no\"?>"
+                              "<adtf:ddl><units><unit name=\"speed\"><numerator>1</numerator>"
+                              "<denominator>1</denominator><offset>0</offset>"
+                              "<refUnit name=\"Metre\" power=\"1\" prefix=\"kilo\"/></unit>"
+                              "</units><datatypes><datatype name=\"tUInt32\" size=\"32\"/>"
+                              "<datatype name=\"tUInt8\" size=\"8\"/></datatypes><structs>";
+    const char* units[] = {"", "Second", "speed", "Kilogram"};
+    for (size_t index = 0; index < 600; ++index) {
+        description += a_util::strings::format(
+            "<struct alignment=\"4\" name=\"s%d\" version=\"1\">"
+            "<element name=\"first\" type=\"%s\" arraysize=\"%d\">"
+            "<deserialized alignment=\"4\"/><serialized bytepos=\"-1\" byteorder=\"LE\"/>"
+            "</element><element name=\"second\" type=\"tUInt8\" arraysize=\"1\" unit=\"%s\">"
+            "<deserialized alignment=\"1\"/><serialized bytepos=\"-1\" byteorder=\"LE\"/>"
+            "</element></struct>",
+            static_cast<int>(index),
+            index == 0 ? "tUInt32" : a_util::strings::format("s%d", index / 2).c_str(),
+            static_cast<int>(index % 3 + 1),
+            units[index % 4]);
+    }
+    // an invalid struct type is left over for the sequential validation
+    description += "<struct alignment=\"4\" name=\"invalid\" version=\"1\">"
+                   "<element name=\"first\" type=\"s1\" arraysize=\"1\">"
+                   "<deserialized alignment=\"3\"/><serialized bytepos=\"-1\" byteorder=\"LE\"/>"
+                   "</element></struct></structs></adtf:ddl>";
+    const auto generated_model = dd::datamodel::fromXMLString(description);
+    const auto recursion_model =
+        dd::datamodel::fromXMLFile(TEST_FILES_DIR "/adtf_recursion.description");
+    const auto adtf_model = dd::datamodel::fromXMLFile(TEST_FILES_DIR "/adtf.description");
+
+    for (const auto* model: {&generated_model, &recursion_model, &adtf_model}) {
+        dd::DataDefinition sequential_dd;
+        sequential_dd.setModel(std::make_shared<dd::datamodel::DataDefinition>(*model));
+        dd::DataDefinition parallel_dd;
+        parallel_dd.setModel(std::make_shared<dd::datamodel::DataDefinition>(*model), 4);
+
+        const auto check_equal = [&sequential_dd, &parallel_dd]() {
+            EXPECT_EQ(sequential_dd.isValid(), parallel_dd.isValid());
+            EXPECT_EQ(sequential_dd.getValidationProtocol().size(),
+                      parallel_dd.getValidationProtocol().size());
+            EXPECT_EQ(sequential_dd.getModel()->getBaseUnits().getSize(),
+                      parallel_dd.getModel()->getBaseUnits().getSize());
+            for (const auto& struct_type: sequential_dd.getStructTypes()) {
+                const auto sequential_access =
+                    sequential_dd.getStructTypeAccess(struct_type.first);
+                const auto parallel_access = parallel_dd.getStructTypeAccess(struct_type.first);
+                ASSERT_EQ(static_cast<bool>(sequential_access),
+                          static_cast<bool>(parallel_access));
+                if (!sequential_access) {
+                    continue;
+                }
+                EXPECT_EQ(sequential_access.getStaticStructSize(),
+                          parallel_access.getStaticStructSize())
+                    << struct_type.first;
+                EXPECT_EQ(sequential_access.getStaticSerializedBitSize(),
+                          parallel_access.getStaticSerializedBitSize())
+                    << struct_type.first;
+            }
+        };
+        check_equal();
+        EXPECT_EQ(model == &adtf_model, parallel_dd.isValid());
+        if (model == &generated_model) {
+            EXPECT_TRUE(parallel_dd.getModel()->getBaseUnits().contains("Second"));
+            EXPECT_TRUE(parallel_dd.getModel()->getBaseUnits().contains("Kilogram"));
+        }
+
+        // forced again on the already validated and calculated types
+        sequential_dd.validate(true);
+        sequential_dd.calculatePositions("", dd::TypeOfType::invalid_type, true);
+        parallel_dd.validate(true, 4);
+        parallel_dd.calculatePositions("", dd::TypeOfType::invalid_type, true, 4);
+        check_equal();
+    }
+}
+
+/**
+ * @detail Elements resolved by their path are kept up to date while changing the struct types.
+ */
+TEST(TesterOODDL, checkElementByPathAfterChanges)
+{
+    using namespace ddl;
+
+    dd::DataDefinition my_dd;
+    my_dd.getDataTypes().add({"tUInt8", 8});
+    my_dd.getDataTypes().add({"tUInt16", 16});
+    my_dd.getDataTypes().add({"tUInt32", 32});
+    const auto serialized_info = dd::StructType::SerializedInfo({}, dd::ByteOrder::e_le);
+    dd::StructType inner("inner", "1", 1);
+    inner.getElements().add({"a", "tUInt8", {1}, serialized_info});
+    inner.getElements().add({"b", "tUInt32", {1}, serialized_info, 3});
+    my_dd.getStructTypes().add(inner);
+    dd::StructType outer("outer", "1", 1);
+    outer.getElements().add({"x", "tUInt8", {1}, serialized_info});
+    outer.getElements().add({"s", "inner", {1}, serialized_info, 2});
+    my_dd.getStructTypes().add(outer);
+
+    // a second lookup of the same path uses the index
+    for (size_t lookup = 0; lookup < 2; ++lookup) {
+        const auto outer_access = my_dd.getStructTypeAccess("outer");
+        const auto element_access = outer_access.getElementByPath("s[1].b");
+        ASSERT_TRUE(element_access);
+        EXPECT_EQ(element_access.getElement().getName(), "b");
+        EXPECT_EQ(element_access.getDeserializedBytePos(), 15);
+        EXPECT_FALSE(outer_access.getElementByPath("s[1].c"));
+    }
+
+    // the positions within a used struct type change
+    my_dd.getStructTypes().access("inner")->getElements().access("a")->setTypeName("tUInt16");
+    EXPECT_EQ(
+        my_dd.getStructTypeAccess("outer").getElementByPath("s[1].b").getDeserializedBytePos(), 17);
+
+    // the elements of a used struct type are renamed, added or removed
+    my_dd.getStructTypes().access("inner")->getElements().access("b")->setName("c");
+    EXPECT_FALSE(my_dd.getStructTypeAccess("outer").getElementByPath("s[1].b"));
+    EXPECT_EQ(
+        my_dd.getStructTypeAccess("outer").getElementByPath("s[1].c").getDeserializedBytePos(), 17);
+    my_dd.getStructTypes().access("inner")->getElements().remove("c");
+    EXPECT_FALSE(my_dd.getStructTypeAccess("outer").getElementByPath("s[1].c"));
+    my_dd.getStructTypes().access("inner")->getElements().add(
+        {"c", "tUInt8", {1}, serialized_info});
+    EXPECT_TRUE(my_dd.getStructTypeAccess("outer").getElementByPath("s[1].c"));
+}
@@ -377,3 +377,63 @@ TEST(TesterDDLFile, detectStreamMetaTypesWithRecursion)
     ASSERT_TRUE(contains_recursion_keyword)
         << "The keyword 'recursion' was not found in problems, expecting it";
 }
+
+/**
+ * @detail Changing a type revalidates and recalculates only the types depending on it, in an
+ * order where every struct type is updated after the struct types it uses.
+ */
+TEST(TesterOODDL, checkRevalidationOfDependentTypes)
+{
+    using namespace ddl;
+
+    dd::DataDefinition my_dd;
+    my_dd.getDataTypes().add({"tUInt8", 8});
+    my_dd.getDataTypes().add({"tUInt32", 32});
+    my_dd.getEnumTypes().add({"tEnum", "tUInt8", {{"value_1", "1"}}});
+    const auto add_struct =
+        [&my_dd](const std::string& name,
+                 const std::vector<std::pair<std::string, std::string>>& elements) {
+            dd::StructType struct_type(name, "1", 1);
+            for (const auto& element: elements) {
+                struct_type.getElements().add(
+                    {element.first,
+                     element.second,
+                     {1},
+                     dd::StructType::SerializedInfo({}, dd::ByteOrder::e_le)});
+            }
+            my_dd.getStructTypes().add(struct_type);
+        };
+    add_struct("A", {{"a", "tUInt8"}, {"e", "tEnum"}});
+    add_struct("B", {{"first", "A"}, {"b", "tUInt32"}});
+    // C uses A directly and via B
+    add_struct("C", {{"b", "B"}, {"a", "A"}});
+    add_struct("D", {{"d", "tUInt32"}});
+    my_dd.validate();
+    ASSERT_TRUE(my_dd.isValid());
+
+    const auto expect_sizes = [&my_dd](size_t a, size_t b, size_t c) {
+        EXPECT_EQ(my_dd.getStructTypeAccess("A").getStaticStructSize(), a);
+        EXPECT_EQ(my_dd.getStructTypeAccess("B").getStaticStructSize(), b);
+        EXPECT_EQ(my_dd.getStructTypeAccess("C").getStaticStructSize(), c);
+        EXPECT_EQ(my_dd.getStructTypeAccess("D").getStaticStructSize(), 4u);
+    };
+    expect_sizes(2, 6, 8);
+
+    // the change of the data type reaches A directly and via the enum type
+    my_dd.getDataTypes().access("tUInt8")->setBitSize(16);
+    expect_sizes(4, 8, 12);
+
+    my_dd.getStructTypes().access("A")->getElements().access("a")->setTypeName("tUInt32");
+    expect_sizes(6, 10, 16);
+
+    // the dependencies follow a renamed type
+    my_dd.getStructTypes().access("A")->setName("A_renamed");
+    EXPECT_EQ(my_dd.getStructTypes().get("C")->getElements().get("a")->getTypeName(), "A_renamed");
+    my_dd.getStructTypes().access("A_renamed")->getElements().access("a")->setTypeName("tUInt8");
+    EXPECT_EQ(my_dd.getStructTypeAccess("A_renamed").getStaticStructSize(), 4u);
+    EXPECT_EQ(my_dd.getStructTypeAccess("B").getStaticStructSize(), 8u);
+    EXPECT_EQ(my_dd.getStructTypeAccess("C").getStaticStructSize(), 12u);
+
+    my_dd.validate();
+    EXPECT_TRUE(my_dd.isValid());
+}